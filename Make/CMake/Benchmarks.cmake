@@ -0,0 +1,47 @@
+set(BENCHMARKS_ROOT_DIR "${BHUMAN_PREFIX}/Src/Apps/Benchmarks")
+if(BUILD_DESKTOP)
+  set(BENCHMARKS_OUTPUT_DIR "${OUTPUT_PREFIX}/Build/${PLATFORM}/Benchmarks/$<CONFIG>")
+elseif(BUILD_NAO)
+  set(BENCHMARKS_OUTPUT_DIR "${OUTPUT_PREFIX}/Build/Linux/Nao/$<CONFIG>")
+else()
+  set(BENCHMARKS_OUTPUT_DIR "${OUTPUT_PREFIX}/Build/Linux/Booster/$<CONFIG>")
+endif()
+
+file(GLOB_RECURSE BENCHMARKS_SOURCES CONFIGURE_DEPENDS
+    "${BENCHMARKS_ROOT_DIR}/*.cpp" "${BENCHMARKS_ROOT_DIR}/*.h")
+
+if(BUILD_DESKTOP)
+  add_executable(Benchmarks ${BENCHMARKS_SOURCES})
+  set_property(TARGET Benchmarks PROPERTY XCODE_ATTRIBUTE_LD_RUNPATH_SEARCH_PATHS "@executable_path/../../../../Util/onnxruntime/lib/${PLATFORM}")
+else()
+  # The robot builds only build the benchmarks if they are explicitly requested, e.g. with "--target Benchmarks".
+  add_executable(Benchmarks${TARGET_SUFFIX} EXCLUDE_FROM_ALL ${BENCHMARKS_SOURCES})
+  set_property(TARGET Benchmarks${TARGET_SUFFIX} PROPERTY RUNTIME_OUTPUT_NAME benchmarks)
+  target_compile_options(Benchmarks${TARGET_SUFFIX} PRIVATE $<$<CONFIG:Develop>:-UNDEBUG>)
+  if(MACOS)
+    if(BUILD_NAO)
+      set_property(TARGET Benchmarks${TARGET_SUFFIX} PROPERTY XCODE_ATTRIBUTE_LDPLUSPLUS_x86_64 "${CMAKE_CURRENT_SOURCE_DIR}/../../Util/Buildchain/macOS/bin/link")
+    else()
+      set_property(TARGET Benchmarks${TARGET_SUFFIX} PROPERTY XCODE_ATTRIBUTE_LDPLUSPLUS_arm64 "${CMAKE_CURRENT_SOURCE_DIR}/../../Util/Buildchain/macOS/bin/link")
+    endif()
+  endif()
+endif()
+
+set_property(TARGET Benchmarks${TARGET_SUFFIX} PROPERTY RUNTIME_OUTPUT_DIRECTORY "${BENCHMARKS_OUTPUT_DIR}")
+set_property(TARGET Benchmarks${TARGET_SUFFIX} PROPERTY FOLDER Apps)
+
+target_include_directories(Benchmarks${TARGET_SUFFIX} PRIVATE "${BENCHMARKS_ROOT_DIR}")
+
+target_link_libraries(Benchmarks${TARGET_SUFFIX} PRIVATE B-Human${TARGET_SUFFIX})
+target_link_libraries(Benchmarks${TARGET_SUFFIX} PRIVATE Framework${TARGET_SUFFIX})
+target_link_libraries(Benchmarks${TARGET_SUFFIX} PRIVATE Math${TARGET_SUFFIX})
+target_link_libraries(Benchmarks${TARGET_SUFFIX} PRIVATE Platform${TARGET_SUFFIX})
+target_link_libraries(Benchmarks${TARGET_SUFFIX} PRIVATE Streaming${TARGET_SUFFIX})
+target_link_libraries(Benchmarks${TARGET_SUFFIX} PRIVATE Flags::Default)
+
+source_group(TREE "${BENCHMARKS_ROOT_DIR}" FILES ${BENCHMARKS_SOURCES})
+
+if(WINDOWS)
+  add_custom_command(TARGET Benchmarks POST_BUILD
+      COMMAND ${CMAKE_COMMAND} -E copy_if_different ${CONTROLLER_DYLIBS} "$<TARGET_FILE:FFTW::FFTW>" "$<TARGET_FILE:FFTW::FFTWF>" "$<TARGET_FILE_DIR:Benchmarks>")
+endif()
@@ -14,6 +14,7 @@ set(DEBUGGING_SOURCES
     "${DEBUGGING_ROOT_DIR}/DebugDrawings.h"
     "${DEBUGGING_ROOT_DIR}/DebugDrawings3D.h"
     "${DEBUGGING_ROOT_DIR}/Debugging.h"
+    "${DEBUGGING_ROOT_DIR}/DebugImages.cpp"
     "${DEBUGGING_ROOT_DIR}/DebugImages.h"
     "${DEBUGGING_ROOT_DIR}/DebugRequest.cpp"
     "${DEBUGGING_ROOT_DIR}/DebugRequest.h"
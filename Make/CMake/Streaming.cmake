@@ -15,6 +15,8 @@ set(STREAMING_SOURCES
     "${STREAMING_ROOT_DIR}/InOut.h"
     "${STREAMING_ROOT_DIR}/InStreams.cpp"
     "${STREAMING_ROOT_DIR}/InStreams.h"
+    "${STREAMING_ROOT_DIR}/LZ4.cpp"
+    "${STREAMING_ROOT_DIR}/LZ4.h"
     "${STREAMING_ROOT_DIR}/MessageIDs.h"
     "${STREAMING_ROOT_DIR}/MessageQueue.cpp"
     "${STREAMING_ROOT_DIR}/MessageQueue.h"
@@ -26,6 +28,8 @@ set(STREAMING_SOURCES
     "${STREAMING_ROOT_DIR}/SimpleMap.h"
     "${STREAMING_ROOT_DIR}/Streamable.cpp"
     "${STREAMING_ROOT_DIR}/Streamable.h"
+    "${STREAMING_ROOT_DIR}/TypeConverter.cpp"
+    "${STREAMING_ROOT_DIR}/TypeConverter.h"
     "${STREAMING_ROOT_DIR}/TypeInfo.cpp"
     "${STREAMING_ROOT_DIR}/TypeInfo.h"
     "${STREAMING_ROOT_DIR}/TypeRegistry.cpp"
@@ -0,0 +1,176 @@
+/**
+ * @file Benchmark.cpp
+ *
+ * This file implements a minimal framework for microbenchmarks of hot kernels.
+ */
+
+#include "Benchmark.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+void Benchmark::Run::addResult(std::vector<double>& nsPerOp, std::size_t bytesPerOp, std::size_t iterations, const std::string& input)
+{
+  std::sort(nsPerOp.begin(), nsPerOp.end());
+  const std::size_t middle = nsPerOp.size() / 2;
+  const double median = nsPerOp.empty() ? 0.0 : nsPerOp.size() & 1 ? nsPerOp[middle] : 0.5 * (nsPerOp[middle - 1] + nsPerOp[middle]);
+
+  Result& result = results.emplace_back();
+  result.name = name;
+  result.input = input.empty() ? defaultInput : input;
+  result.nsPerOp = median;
+  result.bytesPerSecond = bytesPerOp && median > 0.0 ? static_cast<double>(bytesPerOp) * 1e9 / median : 0.0;
+  result.iterations = iterations;
+}
+
+Benchmark::Benchmark(const char* group, const char* name, Function function) :
+  name(std::string(group) + "." + name), function(function)
+{
+  getBenchmarks().push_back(this);
+}
+
+std::vector<const Benchmark*>& Benchmark::getBenchmarks()
+{
+  static std::vector<const Benchmark*> benchmarks;
+  return benchmarks;
+}
+
+std::vector<Benchmark::Result> Benchmark::runAll(const std::string& filter, const std::string& input, double minBatchTime, int repetitions)
+{
+  std::vector<const Benchmark*> benchmarks = getBenchmarks();
+  std::sort(benchmarks.begin(), benchmarks.end(), [](const Benchmark* a, const Benchmark* b) {return a->name < b->name;});
+
+  std::vector<Result> results;
+  for(const Benchmark* benchmark : benchmarks)
+    if(filter.empty() || benchmark->name.find(filter) != std::string::npos)
+    {
+      Run run;
+      run.name = benchmark->name;
+      run.defaultInput = input;
+      run.minBatchTime = minBatchTime * 1e9;
+      run.repetitions = std::max(1, repetitions);
+      benchmark->function(run);
+      results.insert(results.end(), run.results.begin(), run.results.end());
+    }
+  return results;
+}
+
+bool Benchmark::write(const std::vector<Result>& results, const std::string& fileName)
+{
+  std::ofstream stream(fileName);
+  if(!stream.is_open())
+    return false;
+
+  // Writes a string as JSON string literal.
+  const auto quote = [&stream](const std::string& string)
+  {
+    stream << '"';
+    for(const char c : string)
+      if(c == '"' || c == '\\')
+        stream << '\\' << c;
+      else if(static_cast<unsigned char>(c) < 0x20)
+      {
+        char escaped[7];
+        std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+        stream << escaped;
+      }
+      else
+        stream << c;
+    stream << '"';
+  };
+
+  stream << "{\"platform\": ";
+  quote(getPlatform());
+  stream << ", \"results\": [\n";
+  for(std::size_t i = 0; i < results.size(); ++i)
+  {
+    const Result& result = results[i];
+    stream << "{\"name\": ";
+    quote(result.name);
+    stream << ", \"input\": ";
+    quote(result.input);
+    stream << ", \"nsPerOp\": " << result.nsPerOp << ", \"bytesPerSecond\": " << result.bytesPerSecond
+           << ", \"iterations\": " << result.iterations << "}" << (i + 1 < results.size() ? ",\n" : "\n");
+  }
+  stream << "]}\n";
+  return stream.good();
+}
+
+bool Benchmark::read(const std::string& fileName, std::vector<Result>& results)
+{
+  std::ifstream stream(fileName);
+  if(!stream.is_open())
+    return false;
+
+  // Only lines written by write() are supported, i.e. each result is a line of its own.
+  const auto string = [](const std::string& line, const char* key) -> std::string
+  {
+    const std::size_t start = line.find(std::string("\"") + key + "\": \"");
+    if(start == std::string::npos)
+      return "";
+    std::string result;
+    for(std::size_t i = start + std::strlen(key) + 5; i < line.size() && line[i] != '"'; ++i)
+      if(line[i] == '\\' && line.compare(i + 1, 1, "u") == 0)
+      {
+        // write() only uses \u escapes for control characters.
+        result += static_cast<char>(std::strtoul(line.substr(i + 2, 4).c_str(), nullptr, 16));
+        i += 5;
+      }
+      else if(line[i] == '\\' && i + 1 < line.size())
+        result += line[++i];
+      else
+        result += line[i];
+    return result;
+  };
+  const auto number = [](const std::string& line, const char* key) -> double
+  {
+    const std::size_t start = line.find(std::string("\"") + key + "\": ");
+    if(start == std::string::npos)
+      return 0.0;
+    std::istringstream value(line.substr(start + std::strlen(key) + 4));
+    double result = 0.0;
+    value >> result;
+    return result;
+  };
+
+  results.clear();
+  std::string line;
+  while(std::getline(stream, line))
+    if(line.starts_with("{\"name\": "))
+    {
+      Result& result = results.emplace_back();
+      result.name = string(line, "name");
+      result.input = string(line, "input");
+      result.nsPerOp = number(line, "nsPerOp");
+      result.bytesPerSecond = number(line, "bytesPerSecond");
+      result.iterations = static_cast<std::size_t>(number(line, "iterations"));
+    }
+  return true;
+}
+
+std::string Benchmark::getPlatform()
+{
+  std::string platform;
+#if defined WINDOWS
+  platform = "Windows";
+#elif defined MACOS
+  platform = "macOS";
+#else
+  platform = "Linux";
+#endif
+#if defined __x86_64__ || defined _M_X64
+  platform += " x86_64";
+#elif defined __aarch64__ || defined _M_ARM64
+  platform += " arm64";
+#endif
+#if defined __clang__
+  platform += " clang " __clang_version__;
+#elif defined __GNUC__
+  platform += " gcc " __VERSION__;
+#elif defined _MSC_VER
+  platform += " msvc " + std::to_string(_MSC_VER);
+#endif
+  return platform;
+}
@@ -0,0 +1,162 @@
+/**
+ * @file Benchmark.h
+ *
+ * This file declares a minimal framework for microbenchmarks of hot kernels.
+ * Benchmarks are defined with the macro BENCHMARK, similar to GTEST_TEST.
+ * Each benchmark measures one kernel by repeatedly executing it in batches
+ * that are long enough to be timed reliably. The median time per operation
+ * of several batches is reported, which is robust against outliers caused
+ * by other processes.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class Benchmark
+{
+public:
+  /** The result of a benchmark. */
+  struct Result
+  {
+    std::string name; /**< The name of the benchmark ("group.name"). */
+    std::string input; /**< A description of the input used. */
+    double nsPerOp = 0.0; /**< The median time per operation (in ns). */
+    double bytesPerSecond = 0.0; /**< The throughput (in bytes/s) or 0 if the benchmark did not specify it. */
+    std::size_t iterations = 0; /**< The number of operations per batch. */
+  };
+
+  /** The interface a benchmark uses to measure its kernel. */
+  class Run
+  {
+  public:
+    /**
+     * Measures a kernel. The result is stored in this run.
+     * @param kernel The kernel. It is called without parameters.
+     * @param bytesPerOp The number of bytes processed per call to compute the throughput. 0 if not applicable.
+     * @param input A description of the input. If empty, the input of the run is used.
+     */
+    template<typename Kernel>
+    void measure(Kernel&& kernel, std::size_t bytesPerOp = 0, const std::string& input = "")
+    {
+      // Determine the number of iterations per batch.
+      std::size_t iterations = 1;
+      while(true)
+      {
+        const double ns = time(kernel, iterations);
+        if(ns >= minBatchTime || iterations >= maxIterations)
+          break;
+        iterations = ns <= 0.0 ? iterations * 10 : std::min(iterations * 10, static_cast<std::size_t>(static_cast<double>(iterations) * minBatchTime * 1.2 / ns) + 1);
+      }
+
+      std::vector<double> nsPerOp;
+      for(int i = 0; i < repetitions; ++i)
+        nsPerOp.push_back(time(kernel, iterations) / static_cast<double>(iterations));
+      addResult(nsPerOp, bytesPerOp, iterations, input);
+    }
+
+    /** Returns the description of the default input. */
+    const std::string& getInput() const {return defaultInput;}
+
+  private:
+    friend class Benchmark;
+
+    std::string name; /**< The name of the benchmark. */
+    std::string defaultInput; /**< The description of the default input. */
+    double minBatchTime; /**< The minimum duration of a batch (in ns). */
+    int repetitions; /**< The number of batches measured. */
+    static constexpr std::size_t maxIterations = 1000000000; /**< The maximum number of operations per batch. */
+    std::vector<Result> results; /**< The results of this run. */
+
+    /**
+     * Measures the time of a batch.
+     * @return The duration (in ns).
+     */
+    template<typename Kernel>
+    static double time(Kernel& kernel, std::size_t iterations)
+    {
+      const auto start = std::chrono::steady_clock::now();
+      for(std::size_t i = 0; i < iterations; ++i)
+        kernel();
+      return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    /** Adds a result based on the measured times per operation. */
+    void addResult(std::vector<double>& nsPerOp, std::size_t bytesPerOp, std::size_t iterations, const std::string& input);
+  };
+
+  using Function = void (*)(Run&);
+
+  /**
+   * Prevents the compiler from removing the computation of a value that is not used otherwise.
+   * @param value The value.
+   */
+  template<typename T>
+  static void keep(const T& value)
+  {
+#if defined __GNUC__ || defined __clang__
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+#endif
+  }
+
+  /**
+   * Registers a benchmark. Used by the macro BENCHMARK.
+   * @param group The group of the benchmark.
+   * @param name The name of the benchmark.
+   * @param function The function that executes the benchmark.
+   */
+  Benchmark(const char* group, const char* name, Function function);
+
+  /**
+   * Executes all benchmarks whose name contains a filter.
+   * @param filter The filter. All benchmarks are executed if it is empty.
+   * @param input A description of the input used.
+   * @param minBatchTime The minimum duration of a batch (in s).
+   * @param repetitions The number of batches measured per kernel.
+   * @return The results.
+   */
+  static std::vector<Result> runAll(const std::string& filter, const std::string& input, double minBatchTime, int repetitions);
+
+  /**
+   * Writes results in JSON format. Each result is written to a single line.
+   * @param results The results.
+   * @param fileName The name of the file.
+   * @return Could the file be written?
+   */
+  static bool write(const std::vector<Result>& results, const std::string& fileName);
+
+  /**
+   * Reads results written by write().
+   * @param fileName The name of the file.
+   * @param results The results read.
+   * @return Could the file be read?
+   */
+  static bool read(const std::string& fileName, std::vector<Result>& results);
+
+  /** Returns a description of the platform the benchmarks were compiled for. */
+  static std::string getPlatform();
+
+private:
+  std::string name; /**< The name of the benchmark ("group.name"). */
+  Function function; /**< The function that executes the benchmark. */
+
+  static std::vector<const Benchmark*>& getBenchmarks();
+};
+
+/**
+ * Defines a benchmark. It must be followed by the body of a function that
+ * gets the parameter "Benchmark::Run& run".
+ * @param group The group of the benchmark, e.g. the library the kernel is part of.
+ * @param name The name of the benchmark.
+ */
+#define BENCHMARK(group, name) \
+  static void _benchmark_##group##_##name(Benchmark::Run& run); \
+  static Benchmark _benchmarkRegistration_##group##_##name(#group, #name, &_benchmark_##group##_##name); \
+  static void _benchmark_##group##_##name([[maybe_unused]] Benchmark::Run& run)
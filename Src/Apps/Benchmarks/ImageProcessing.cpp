@@ -0,0 +1,88 @@
+/**
+ * @file ImageProcessing.cpp
+ *
+ * Benchmarks of the image processing kernels that run on every camera image.
+ */
+
+#include "Benchmark.h"
+#include "Inputs.h"
+#include "ImageProcessing/PatchUtilities.h"
+#include "ImageProcessing/Resize.h"
+#include "ImageProcessing/Sobel.h"
+
+BENCHMARK(ImageProcessing, shrinkY)
+{
+  const GrayscaledImage& src = Inputs::getGrayscaledImage();
+  GrayscaledImage dest;
+  for(unsigned downScales = 1; downScales <= 3; ++downScales)
+    run.measure([&]
+    {
+      Resize::shrinkY(downScales, src, dest);
+      Benchmark::keep(dest[0][0]);
+    }, src.width * src.height, run.getInput() + " /" + std::to_string(1 << downScales));
+}
+
+BENCHMARK(ImageProcessing, shrinkUV)
+{
+  const YUYVImage& src = Inputs::getCameraImage();
+  Image<unsigned short> dest;
+  for(unsigned downScales = 1; downScales <= 2; ++downScales)
+    run.measure([&]
+    {
+      Resize::shrinkUV(downScales, src, dest);
+      Benchmark::keep(dest[0][0]);
+    }, src.width * src.height * sizeof(PixelTypes::YUYVPixel), run.getInput() + " /" + std::to_string(1 << downScales));
+}
+
+BENCHMARK(ImageProcessing, sobel)
+{
+  const GrayscaledImage& gray = Inputs::getGrayscaledImage();
+  const Sobel::Image1D& src = gray;
+  Sobel::SobelImage dest;
+  run.measure([&]
+  {
+    Sobel::sobelSSE(src, dest);
+    Benchmark::keep(dest[0][0].index);
+  }, src.width * src.height);
+}
+
+BENCHMARK(ImageProcessing, extractPatch)
+{
+  // Ball patches as extracted by the BallAndPenaltyMarkPerceptor.
+  const GrayscaledImage& src = Inputs::getGrayscaledImage();
+  const Vector2i center(static_cast<int>(src.width) / 2, static_cast<int>(src.height) / 2);
+  GrayscaledImage dest;
+  FOREACH_ENUM(PatchUtilities::ExtractionMode, mode)
+    run.measure([&]
+    {
+      PatchUtilities::extractPatch(center, Vector2i(84, 84), Vector2i(32, 32), src, dest, mode);
+      Benchmark::keep(dest[0][0]);
+    }, 0, run.getInput() + " " + TypeRegistry::getEnumName(mode));
+}
+
+BENCHMARK(ImageProcessing, normalizeContrast)
+{
+  const GrayscaledImage& src = Inputs::getGrayscaledImage();
+  GrayscaledImage patch;
+  PatchUtilities::extractPatch(Vector2i(static_cast<int>(src.width) / 2, static_cast<int>(src.height) / 2), Vector2i(84, 84), Vector2i(32, 32), src, patch);
+  GrayscaledImage work;
+  run.measure([&]
+  {
+    work = patch;
+    PatchUtilities::normalizeContrast(work);
+    Benchmark::keep(work[0][0]);
+  }, 32 * 32, "32x32 patch");
+}
+
+BENCHMARK(ImageProcessing, extractInput)
+{
+  // The input of the field boundary network.
+  const YUYVImage& src = Inputs::getCameraImage();
+  const Vector2i patchSize(static_cast<int>(src.width) / 8, static_cast<int>(src.height) / 8);
+  std::vector<std::uint8_t> input(patchSize.x() * patchSize.y() * 3);
+  run.measure([&]
+  {
+    PatchUtilities::extractInput<std::uint8_t, false>(src, patchSize, input.data());
+    Benchmark::keep(input[0]);
+  }, input.size());
+}
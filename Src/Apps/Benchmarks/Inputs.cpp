@@ -0,0 +1,90 @@
+/**
+ * @file Inputs.cpp
+ *
+ * This file implements the inputs shared by the benchmarks.
+ */
+
+#include "Inputs.h"
+#include <algorithm>
+#include <fstream>
+#include <random>
+
+namespace Inputs
+{
+  static YUYVImage cameraImage;
+  static GrayscaledImage grayscaledImage;
+  static std::string description;
+
+  /** Derives the grayscaled image from the camera image. */
+  static void updateGrayscaledImage()
+  {
+    grayscaledImage.setResolution(cameraImage.width * 2, cameraImage.height, 1);
+    for(unsigned y = 0; y < cameraImage.height; ++y)
+    {
+      const PixelTypes::YUYVPixel* src = cameraImage[y];
+      PixelTypes::GrayscaledPixel* dest = grayscaledImage[y];
+      for(unsigned x = 0; x < cameraImage.width; ++x, ++src)
+      {
+        *dest++ = src->y0;
+        *dest++ = src->y1;
+      }
+    }
+  }
+}
+
+void Inputs::createCameraImage(unsigned width, unsigned height)
+{
+  // A field-like image: a green background with white lines, a few dark
+  // blobs, and noise, so that data-dependent kernels do not take shortcuts.
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int> noise(-8, 8);
+  const auto clip = [](int value) {return static_cast<unsigned char>(std::max(0, std::min(255, value)));};
+  cameraImage.setResolution(width / 2, height);
+  for(unsigned y = 0; y < cameraImage.height; ++y)
+    for(unsigned x = 0; x < cameraImage.width; ++x)
+    {
+      const unsigned px = x * 2;
+      const bool line = (px + y) % 160 < 6 || y % 120 < 4;
+      const int dx = static_cast<int>(px % 80) - 40;
+      const int dy = static_cast<int>(y % 60) - 30;
+      const bool blob = ((px / 80) + (y / 60)) % 7 == 0 && dx * dx + dy * dy < 400;
+      const int luminance = line ? 200 : blob ? 30 : 90 + static_cast<int>(y * 40 / height);
+      PixelTypes::YUYVPixel& pixel = cameraImage[y][x];
+      pixel.y0 = clip(luminance + noise(generator));
+      pixel.y1 = clip(luminance + noise(generator));
+      pixel.u = clip((line || blob ? 128 : 100) + noise(generator) / 2);
+      pixel.v = clip((line || blob ? 128 : 110) + noise(generator) / 2);
+    }
+  updateGrayscaledImage();
+  description = "synthetic " + std::to_string(width) + "x" + std::to_string(height);
+}
+
+bool Inputs::loadCameraImage(const std::string& fileName, unsigned width, unsigned height)
+{
+  std::ifstream stream(fileName, std::ios::binary);
+  if(!stream.is_open())
+    return false;
+  cameraImage.setResolution(width / 2, height);
+  for(unsigned y = 0; y < cameraImage.height; ++y)
+    if(!stream.read(reinterpret_cast<char*>(cameraImage[y]), cameraImage.width * sizeof(PixelTypes::YUYVPixel)))
+      return false;
+  updateGrayscaledImage();
+  const std::size_t slash = fileName.find_last_of("/\\");
+  description = (slash == std::string::npos ? fileName : fileName.substr(slash + 1)) + " " + std::to_string(width) + "x" + std::to_string(height);
+  return true;
+}
+
+const YUYVImage& Inputs::getCameraImage()
+{
+  return cameraImage;
+}
+
+const GrayscaledImage& Inputs::getGrayscaledImage()
+{
+  return grayscaledImage;
+}
+
+const std::string& Inputs::getDescription()
+{
+  return description;
+}
@@ -0,0 +1,40 @@
+/**
+ * @file Inputs.h
+ *
+ * This file declares the inputs shared by the benchmarks. By default, a
+ * synthetic but deterministic camera image is used. Alternatively, a raw
+ * camera image can be loaded to measure the kernels with real data.
+ */
+
+#pragma once
+
+#include "ImageProcessing/Image.h"
+#include <string>
+
+namespace Inputs
+{
+  /**
+   * Creates a synthetic camera image.
+   * @param width The width of the image (in pixels, i.e. twice the number of YUYV pixels).
+   * @param height The height of the image (in pixels).
+   */
+  void createCameraImage(unsigned width, unsigned height);
+
+  /**
+   * Loads a camera image from a file that contains the raw YUYV data.
+   * @param fileName The name of the file.
+   * @param width The width of the image (in pixels, i.e. twice the number of YUYV pixels).
+   * @param height The height of the image (in pixels).
+   * @return Could the image be loaded?
+   */
+  bool loadCameraImage(const std::string& fileName, unsigned width, unsigned height);
+
+  /** Returns the camera image. */
+  const YUYVImage& getCameraImage();
+
+  /** Returns the luminance of the camera image in full resolution. It has a padding of one pixel. */
+  const GrayscaledImage& getGrayscaledImage();
+
+  /** Returns a description of the input. */
+  const std::string& getDescription();
+}
@@ -0,0 +1,124 @@
+/**
+ * @file Main.cpp
+ *
+ * This file implements the command line interface of the benchmarks.
+ *
+ * Usage: Benchmarks [options]
+ *   --filter=<text>        Only run benchmarks whose name contains the text.
+ *   --image=<file>         Use a raw YUYV camera image instead of a synthetic one.
+ *   --width=<pixels>       The width of the camera image (default: 640).
+ *   --height=<pixels>      The height of the camera image (default: 480).
+ *   --min-time=<seconds>   The minimum duration of a batch (default: 0.05).
+ *   --repetitions=<count>  The number of batches measured per kernel (default: 7).
+ *   --json=<file>          Write the results to a JSON file.
+ *   --compare=<file>       Compare the results with a JSON file written before.
+ *   --tolerance=<ratio>    The relative slowdown accepted in comparisons (default: 0.1).
+ *
+ * The exit code is 1 if a comparison found a kernel that became slower than
+ * accepted.
+ */
+
+#include "Benchmark.h"
+#include "Inputs.h"
+#include "Platform/SystemCall.h"
+#include "Streaming/FunctionList.h"
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+
+int main(int argc, char** argv)
+{
+  std::string filter, image, json, compare;
+  unsigned width = 640, height = 480;
+  double minTime = 0.05, tolerance = 0.1;
+  int repetitions = 7;
+  for(int i = 1; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    const std::size_t equals = arg.find('=');
+    const std::string key = arg.substr(0, equals);
+    const std::string value = equals == std::string::npos ? "" : arg.substr(equals + 1);
+    if(key == "--filter")
+      filter = value;
+    else if(key == "--image")
+      image = value;
+    else if(key == "--width")
+      width = static_cast<unsigned>(std::atoi(value.c_str()));
+    else if(key == "--height")
+      height = static_cast<unsigned>(std::atoi(value.c_str()));
+    else if(key == "--min-time")
+      minTime = std::atof(value.c_str());
+    else if(key == "--repetitions")
+      repetitions = std::atoi(value.c_str());
+    else if(key == "--json")
+      json = value;
+    else if(key == "--compare")
+      compare = value;
+    else if(key == "--tolerance")
+      tolerance = std::atof(value.c_str());
+    else
+    {
+      std::fprintf(stderr, "Unknown option %s\n", arg.c_str());
+      return 2;
+    }
+  }
+
+  FunctionList::execute();
+
+  if(image.empty())
+    Inputs::createCameraImage(width, height);
+  else if(!Inputs::loadCameraImage(image, width, height))
+  {
+    std::fprintf(stderr, "Cannot load %s\n", image.c_str());
+    return 2;
+  }
+
+  std::vector<Benchmark::Result> baseline;
+  if(!compare.empty() && !Benchmark::read(compare, baseline))
+  {
+    std::fprintf(stderr, "Cannot read %s\n", compare.c_str());
+    return 2;
+  }
+  std::map<std::string, double> baselineNsPerOp;
+  for(const Benchmark::Result& result : baseline)
+    baselineNsPerOp[result.name + " " + result.input] = result.nsPerOp;
+
+  std::printf("%s\n", Benchmark::getPlatform().c_str());
+  const std::vector<Benchmark::Result> results = Benchmark::runAll(filter, Inputs::getDescription(), minTime, repetitions);
+
+  bool slower = false;
+  std::printf("%-40s %-32s %14s %12s%s\n", "Benchmark", "Input", "ns/op", "MB/s", compare.empty() ? "" : "     ratio");
+  for(const Benchmark::Result& result : results)
+  {
+    std::printf("%-40s %-32s %14.1f ", result.name.c_str(), result.input.c_str(), result.nsPerOp);
+    if(result.bytesPerSecond > 0.0)
+      std::printf("%12.1f", result.bytesPerSecond / 1e6);
+    else
+      std::printf("%12s", "-");
+    if(!compare.empty())
+    {
+      const auto entry = baselineNsPerOp.find(result.name + " " + result.input);
+      if(entry != baselineNsPerOp.end() && entry->second > 0.0)
+      {
+        const double ratio = result.nsPerOp / entry->second;
+        std::printf(" %9.3f%s", ratio, ratio > 1.0 + tolerance ? " SLOWER" : "");
+        slower |= ratio > 1.0 + tolerance;
+      }
+      else
+        std::printf(" %9s", "new");
+    }
+    std::printf("\n");
+  }
+
+  if(!json.empty() && !Benchmark::write(results, json))
+  {
+    std::fprintf(stderr, "Cannot write %s\n", json.c_str());
+    return 2;
+  }
+  return slower ? 1 : 0;
+}
+
+SystemCall::Mode SystemCall::getMode()
+{
+  return simulatedRobot;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file Math.cpp
+ *
+ * Benchmarks of the filters used by the state estimators.
+ */
+
+#include "Benchmark.h"
+#include "Math/UnscentedKalmanFilter.h"
+
+namespace
+{
+  /** A nonlinear motion of a point that moves with a velocity and turns. */
+  void dynamicModel(Vector5f& state)
+  {
+    const float dt = 0.012f;
+    const float c = std::cos(state(4) * dt);
+    const float s = std::sin(state(4) * dt);
+    const Vector2f velocity(c * state(2) - s * state(3), s * state(2) + c * state(3));
+    state.head<2>() += velocity * dt;
+    state.segment<2>(2) = velocity * 0.99f;
+  }
+
+  /** Measures the distance and the bearing of the point. */
+  Vector2f measurementModel(const Vector5f& state)
+  {
+    return Vector2f(state.head<2>().norm(), std::atan2(state(1), state(0)));
+  }
+
+  const Vector5f start(1000.f, -500.f, 200.f, 100.f, 1.f);
+  const Matrix5f initialCovariance = Vector5f(100.f, 100.f, 50.f, 50.f, 0.1f).asDiagonal();
+  const Matrix5f dynamicNoise = Vector5f(1.f, 1.f, 10.f, 10.f, 0.01f).asDiagonal();
+  const Matrix2f measurementNoise = Vector2f(25.f, 0.001f).asDiagonal();
+}
+
+BENCHMARK(Math, ukfPredictUpdate)
+{
+  UKF<5> dynamic(start);
+  run.measure([&]
+  {
+    dynamic.init(start, initialCovariance);
+    dynamic.predict(dynamicModel, dynamicNoise);
+    dynamic.update<2>(Vector2f(1100.f, -0.45f), measurementModel, measurementNoise);
+    Benchmark::keep(dynamic.mean);
+  }, 0, "UKF<5>");
+
+  FixedUKF<5> fixed(start);
+  run.measure([&]
+  {
+    fixed.init(start, initialCovariance);
+    fixed.predict(dynamicModel, dynamicNoise);
+    fixed.update<2>(Vector2f(1100.f, -0.45f), measurementModel, measurementNoise);
+    Benchmark::keep(fixed.mean);
+  }, 0, "FixedUKF<5>");
+}
+
+BENCHMARK(Math, ukfBatch)
+{
+  std::vector<FixedUKF<5>> filters(10, FixedUKF<5>(start));
+  const std::vector<Vector2f> measurements(filters.size(), Vector2f(1100.f, -0.45f));
+  run.measure([&]
+  {
+    for(FixedUKF<5>& filter : filters)
+      filter.init(start, initialCovariance);
+    FixedUKF<5>::predict(filters, dynamicModel, dynamicNoise);
+    FixedUKF<5>::update<2>(filters, measurements, measurementModel, measurementNoise);
+    Benchmark::keep(filters.back().mean);
+  }, 0, "10 x FixedUKF<5>");
+}
@@ -0,0 +1,59 @@
+/**
+ * @file Modeling.cpp
+ *
+ * Benchmarks of the kernels of the world model.
+ */
+
+#include "Benchmark.h"
+#include "Tools/Modeling/BallRollModel.h"
+#include "Tools/Modeling/ObstacleAssociation.h"
+#include <random>
+
+namespace
+{
+  struct Point
+  {
+    Vector2f center;
+  };
+
+  std::vector<Point> randomPoints(std::mt19937& generator, std::size_t n, float range)
+  {
+    std::uniform_real_distribution<float> coordinate(-range, range);
+    std::vector<Point> points;
+    for(std::size_t i = 0; i < n; ++i)
+      points.push_back({Vector2f(coordinate(generator), coordinate(generator))});
+    return points;
+  }
+}
+
+BENCHMARK(Modeling, interceptTimes)
+{
+  std::mt19937 generator(42);
+  std::vector<Vector2f> robots;
+  for(const Point& point : randomPoints(generator, 10, 4500.f))
+    robots.push_back(point.center);
+  BallRollModel model(-0.13f);
+  std::vector<float> times;
+  run.measure([&]
+  {
+    model.setBall(Vector2f(-1000.f, 500.f), Vector2f(1500.f, -300.f));
+    model.getInterceptTimes(robots, 300.f, 100.f, times);
+    Benchmark::keep(times[0]);
+  }, 0, "10 robots");
+}
+
+BENCHMARK(Modeling, obstacleAssociation)
+{
+  std::mt19937 generator(4711);
+  ObstacleAssociation association;
+  for(std::size_t n : {10, 60})
+  {
+    const std::vector<Point> hypotheses = randomPoints(generator, n, 4500.f);
+    const std::vector<Point> measurements = randomPoints(generator, n / 2, 4500.f);
+    run.measure([&]
+    {
+      association.index(hypotheses);
+      Benchmark::keep(association.assign(measurements, [](const Point&) {return 500.f;}).size());
+    }, 0, std::to_string(n) + " hypotheses");
+  }
+}
@@ -0,0 +1,51 @@
+/**
+ * @file Streaming.cpp
+ *
+ * Benchmarks of the serialization used for logging and debugging.
+ */
+
+#include "Benchmark.h"
+#include "Representations/BehaviorControl/ActivationGraph.h"
+#include "Streaming/InStreams.h"
+#include "Streaming/OutStreams.h"
+
+namespace
+{
+  /** Creates an activation graph of a typical size. */
+  ActivationGraph createActivationGraph()
+  {
+    ActivationGraph activationGraph;
+    for(int i = 0; i < 50; ++i)
+      activationGraph.graph.emplace_back("Option" + std::to_string(i), i % 8, "state" + std::to_string(i % 5), i * 100, i * 10,
+                                         std::vector<std::string>{"target = (1000, 500)", "speed = 1"});
+    return activationGraph;
+  }
+}
+
+BENCHMARK(Streaming, writeActivationGraph)
+{
+  const ActivationGraph activationGraph = createActivationGraph();
+  OutBinaryMemory sizeStream;
+  sizeStream << activationGraph;
+  std::vector<char> buffer(sizeStream.size());
+  run.measure([&]
+  {
+    OutBinaryMemory stream(buffer.size(), buffer.data());
+    stream << activationGraph;
+    Benchmark::keep(buffer[0]);
+  }, buffer.size(), "50 nodes");
+}
+
+BENCHMARK(Streaming, readActivationGraph)
+{
+  const ActivationGraph activationGraph = createActivationGraph();
+  OutBinaryMemory buffer;
+  buffer << activationGraph;
+  ActivationGraph copy;
+  run.measure([&]
+  {
+    InBinaryMemory stream(buffer.data(), buffer.size());
+    stream >> copy;
+    Benchmark::keep(copy.graph.size());
+  }, buffer.size(), "50 nodes");
+}
@@ -0,0 +1,63 @@
+#include "Tools/BehaviorControl/RatingGrid.h"
+
+#include <gtest/gtest.h>
+#include <random>
+
+GTEST_TEST(RatingGrid, reproducesNodesAndLinearFunctions)
+{
+  const auto linear = [](const Vector2f& p) {return 0.5f + 0.0001f * p.x() - 0.0002f * p.y();};
+  RatingGrid grid(Vector2f(-4500.f, -3000.f), Vector2f(4500.f, 3000.f), 250.f);
+
+  EXPECT_NEAR(grid.interpolate(Vector2f(-4500.f, -3000.f), linear), linear(Vector2f(-4500.f, -3000.f)), 1e-5f);
+  EXPECT_NEAR(grid.interpolate(Vector2f(4500.f, 3000.f), linear), linear(Vector2f(4500.f, 3000.f)), 1e-5f);
+
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<float> x(-4500.f, 4500.f);
+  std::uniform_real_distribution<float> y(-3000.f, 3000.f);
+  for(int i = 0; i < 1000; ++i)
+  {
+    const Vector2f point(x(generator), y(generator));
+    EXPECT_NEAR(grid.interpolate(point, linear), linear(point), 1e-5f);
+  }
+
+  // Outside the grid, the rating is clamped and does not change.
+  EXPECT_NEAR(grid.interpolate(Vector2f(6000.f, 0.f), linear), linear(Vector2f(4500.f, 0.f)), 1e-5f);
+}
+
+GTEST_TEST(RatingGrid, approximatesSmoothRatings)
+{
+  const auto rating = [](const Vector2f& p) {return std::sin(p.x() / 700.f) * std::cos(p.y() / 900.f);};
+  RatingGrid grid(Vector2f(-4500.f, -3000.f), Vector2f(4500.f, 3000.f), 200.f);
+  std::mt19937 generator(4711);
+  std::uniform_real_distribution<float> x(-4400.f, 4400.f);
+  std::uniform_real_distribution<float> y(-2900.f, 2900.f);
+  for(int i = 0; i < 1000; ++i)
+  {
+    const Vector2f point(x(generator), y(generator));
+    EXPECT_NEAR(grid.interpolate(point, rating), rating(point), 0.05f);
+  }
+}
+
+GTEST_TEST(RatingGrid, nodesAreEvaluatedOnceUntilInvalidated)
+{
+  int calls = 0;
+  float offset = 0.f;
+  const auto rating = [&](const Vector2f&) {++calls; return offset;};
+  RatingGrid grid(Vector2f::Zero(), Vector2f(1000.f, 1000.f), 100.f);
+
+  grid.interpolate(Vector2f(150.f, 150.f), rating);
+  EXPECT_EQ(calls, 4);
+  grid.interpolate(Vector2f(160.f, 140.f), rating);
+  grid.interpolate(Vector2f(250.f, 150.f), rating);
+  EXPECT_EQ(calls, 6);
+
+  grid.fill(rating);
+  EXPECT_EQ(calls, 121);
+  grid.fill(rating);
+  EXPECT_EQ(calls, 121);
+
+  grid.invalidate();
+  offset = 1.f;
+  EXPECT_EQ(grid.interpolate(Vector2f(150.f, 150.f), rating), 1.f);
+  EXPECT_EQ(calls, 125);
+}
@@ -0,0 +1,178 @@
+#include "Math/Constants.h"
+#include "Math/Eigen.h"
+#include "MathBase/Angle.h"
+#include "Streaming/AutoStreamable.h"
+#include "Tools/Communication/CompressedTeamCommunicationStreams.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+STREAMABLE(CompressedTeamCommunicationExample,
+{,
+  (bool)(true) aBool,
+  (int)(-3) anInteger,
+  (unsigned char)(200) aByte,
+  (float)(1234.5f) aFloat,
+  (Angle)(1.f) anAngle,
+  (Vector2f)(Vector2f(-100.f, 300.f)) aVector,
+  (std::vector<short>)({1, -2, 3}) aList,
+  (unsigned)(1000) aTimestamp,
+  (double)(0.25) aDouble,
+});
+
+/** The root of the example, which plays the role of the TeamMessage. */
+STREAMABLE(CompressedTeamCommunicationExampleMessage,
+{,
+  (CompressedTeamCommunicationExample) theExample,
+});
+
+namespace
+{
+  const char* exampleTypes = R"(
+CompressedTeamCommunicationExample
+{
+  aBool: Boolean
+  anInteger: Integer(min=-5, max=9)
+  aByte: Integer
+  aFloat: Float(min=-5000, max=5000, bits=11)
+  anAngle: Angle(bits=7)
+  aVector: Vector<Float(min=-1000, max=1000, bits=9)>(n=2)
+  aList: Integer(min=-4, max=4)[:5]
+  aTimestamp: Timestamp(bits=8, shift=3, reference=relativePast)
+  aDouble: Float
+}
+
+CompressedTeamCommunicationExampleMessage
+{
+  theExample: CompressedTeamCommunicationExample
+}
+)";
+
+  constexpr unsigned baseTimestamp = 20000;
+
+  /** Packs bits one at a time, i.e. in the way the streams did before they transferred whole bytes. */
+  struct ReferenceWriter
+  {
+    std::vector<std::uint8_t> container;
+    std::size_t offset = 0;
+
+    void write(std::uint64_t value, unsigned bits)
+    {
+      container.resize((offset + bits + 7) / 8, 0);
+      for(unsigned i = 0; i < bits; ++i, ++offset)
+        container[offset / 8] |= static_cast<std::uint8_t>(((value >> i) & 1) << (offset % 8));
+    }
+
+    void write(double value, double min, double max, unsigned bits)
+    {
+      write(static_cast<std::uint64_t>((std::max(min, std::min(value, max)) - min) / (max - min) * ((1LL << bits) - 1) + 0.5f), bits);
+    }
+  };
+
+  /** Encodes the example as specified in exampleTypes using the reference writer. */
+  std::vector<std::uint8_t> referenceEncoding(const CompressedTeamCommunicationExample& example)
+  {
+    ReferenceWriter writer;
+    writer.write(example.aBool ? 1 : 0, 1);
+    writer.write(static_cast<std::uint64_t>(std::clamp(example.anInteger, -5, 9) + 5), 4);
+    writer.write(example.aByte, 8);
+    writer.write(example.aFloat, -5000.0, 5000.0, 11);
+    writer.write(static_cast<float>(example.anAngle), -Constants::pi, Constants::pi, 7);
+    writer.write(example.aVector.x(), -1000.0, 1000.0, 9);
+    writer.write(example.aVector.y(), -1000.0, 1000.0, 9);
+    writer.write(std::min(example.aList.size(), std::size_t(5)), 3);
+    for(std::size_t i = 0; i < std::min(example.aList.size(), std::size_t(5)); ++i)
+      writer.write(static_cast<std::uint64_t>(std::clamp<int>(example.aList[i], -4, 4) + 4), 4);
+    writer.write(std::min((baseTimestamp - std::min(baseTimestamp, example.aTimestamp)) >> 3, 255u), 8);
+    std::uint64_t bitsOfDouble;
+    std::memcpy(&bitsOfDouble, &example.aDouble, sizeof(bitsOfDouble));
+    writer.write(bitsOfDouble, 64);
+    return writer.container;
+  }
+
+  CompressedTeamCommunicationExample randomExample(std::mt19937& generator)
+  {
+    std::uniform_real_distribution<float> real(-1.f, 1.f);
+    auto integer = [&generator](int min, int max) { return std::uniform_int_distribution<int>(min, max)(generator); };
+    CompressedTeamCommunicationExample example;
+    example.aBool = integer(0, 1) != 0;
+    example.anInteger = integer(-8, 12);
+    example.aByte = static_cast<unsigned char>(integer(0, 255));
+    example.aFloat = real(generator) * 6000.f;
+    example.anAngle = real(generator) * pi;
+    example.aVector = Vector2f(real(generator), real(generator)) * 1200.f;
+    example.aList.resize(integer(0, 7));
+    for(short& element : example.aList)
+      element = static_cast<short>(integer(-6, 6));
+    example.aTimestamp = baseTimestamp - static_cast<unsigned>(integer(0, 255) * 8);
+    example.aDouble = real(generator);
+    return example;
+  }
+}
+
+GTEST_TEST(CompressedTeamCommunicationStreams, bitIdenticalEncoding)
+{
+  CompressedTeamCommunication::TypeRegistry registry;
+  registry.addTypes(exampleTypes);
+  registry.compile();
+  const CompressedTeamCommunication::Type* type = registry.getTypeByName("CompressedTeamCommunicationExampleMessage");
+  ASSERT_NE(type, nullptr);
+
+  std::mt19937 generator(42);
+  for(int i = 0; i < 1000; ++i)
+  {
+    const CompressedTeamCommunicationExample example = i ? randomExample(generator) : CompressedTeamCommunicationExample();
+    std::vector<std::uint8_t> container;
+    CompressedTeamCommunicationOut stream(container, baseTimestamp, type, true);
+    Streaming::streamIt(stream, "theExample", example);
+    EXPECT_EQ(container, referenceEncoding(example));
+  }
+}
+
+GTEST_TEST(CompressedTeamCommunicationStreams, roundTrip)
+{
+  CompressedTeamCommunication::TypeRegistry registry;
+  registry.addTypes(exampleTypes);
+  registry.compile();
+  const CompressedTeamCommunication::Type* type = registry.getTypeByName("CompressedTeamCommunicationExampleMessage");
+  ASSERT_NE(type, nullptr);
+
+  std::mt19937 generator(4711);
+  for(int i = 0; i < 1000; ++i)
+  {
+    const CompressedTeamCommunicationExample example = randomExample(generator);
+    std::vector<std::uint8_t> container;
+    {
+      CompressedTeamCommunicationOut stream(container, baseTimestamp, type, true);
+      Streaming::streamIt(stream, "theExample", example);
+    }
+
+    // Decoding must yield the same values as quantizing the original ones.
+    CompressedTeamCommunicationExample decoded;
+    {
+      CompressedTeamCommunicationIn stream(container, baseTimestamp, type, [](unsigned u) { return u; });
+      Streaming::streamIt(stream, "theExample", decoded);
+    }
+    EXPECT_EQ(decoded.aBool, example.aBool);
+    EXPECT_EQ(decoded.anInteger, std::clamp(example.anInteger, -5, 9));
+    EXPECT_EQ(decoded.aByte, example.aByte);
+    EXPECT_NEAR(decoded.aFloat, std::clamp(example.aFloat, -5000.f, 5000.f), 10000.f / 2047.f);
+    EXPECT_NEAR(decoded.anAngle, example.anAngle, 2.f * pi / 127.f);
+    EXPECT_NEAR(decoded.aVector.x(), std::clamp(example.aVector.x(), -1000.f, 1000.f), 2000.f / 511.f);
+    EXPECT_NEAR(decoded.aVector.y(), std::clamp(example.aVector.y(), -1000.f, 1000.f), 2000.f / 511.f);
+    ASSERT_EQ(decoded.aList.size(), std::min(example.aList.size(), std::size_t(5)));
+    for(std::size_t j = 0; j < decoded.aList.size(); ++j)
+      EXPECT_EQ(decoded.aList[j], std::clamp<short>(example.aList[j], -4, 4));
+    EXPECT_EQ(decoded.aTimestamp, example.aTimestamp);
+    EXPECT_EQ(decoded.aDouble, example.aDouble);
+
+    // Encoding the decoded values again must reproduce the message bit by bit.
+    std::vector<std::uint8_t> reencoded;
+    CompressedTeamCommunicationOut stream(reencoded, baseTimestamp, type, true);
+    Streaming::streamIt(stream, "theExample", decoded);
+    EXPECT_EQ(reencoded, container);
+  }
+}
@@ -0,0 +1,107 @@
+#include "Debugging/DebugImages.h"
+#include "Streaming/InStreams.h"
+#include "Streaming/OutStreams.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+  /** Writes an image with an encoding and reads it back like the receiver of the message would do. */
+  void roundTrip(const Image<PixelTypes::GrayscaledPixel>& image, const DebugImageEncoding& encoding, DebugImage& result)
+  {
+    OutBinaryMemory out;
+    out << DebugImage(image).encode(encoding);
+    InBinaryMemory in(out.data(), out.size());
+    result.isEncoded = !encoding.isRaw();
+    in >> result;
+  }
+}
+
+GTEST_TEST(DebugImages, Raw)
+{
+  Image<PixelTypes::GrayscaledPixel> image(5, 3);
+  for(unsigned y = 0; y < image.height; ++y)
+    for(unsigned x = 0; x < image.width; ++x)
+      image[y][x] = static_cast<PixelTypes::GrayscaledPixel>(y * 10 + x);
+
+  DebugImage result;
+  roundTrip(image, DebugImageEncoding(), result);
+  ASSERT_EQ(5, result.width);
+  ASSERT_EQ(3, result.height);
+  for(unsigned y = 0; y < image.height; ++y)
+    for(unsigned x = 0; x < image.width; ++x)
+      EXPECT_EQ(image[y][x], result.getView<PixelTypes::GrayscaledPixel>()[y][x]);
+}
+
+GTEST_TEST(DebugImages, RawFormatIsUnchanged)
+{
+  Image<PixelTypes::GrayscaledPixel> image(5, 3);
+  for(unsigned y = 0; y < image.height; ++y)
+    for(unsigned x = 0; x < image.width; ++x)
+      image[y][x] = static_cast<PixelTypes::GrayscaledPixel>(y * 10 + x);
+
+  // Images that are not encoded are streamed as before encodings were introduced.
+  const DebugImage debugImage(image);
+  OutBinaryMemory expected;
+  expected << debugImage.type << debugImage.width << debugImage.height;
+  expected.write(image[0], image.width * image.height);
+
+  OutBinaryMemory actual;
+  actual << DebugImage(image).encode(DebugImageEncoding());
+  ASSERT_EQ(expected.size(), actual.size());
+  EXPECT_EQ(0, std::memcmp(expected.data(), actual.data(), expected.size()));
+}
+
+GTEST_TEST(DebugImages, Encoded)
+{
+  Image<PixelTypes::GrayscaledPixel> image(8, 6);
+  for(unsigned y = 0; y < image.height; ++y)
+    for(unsigned x = 0; x < image.width; ++x)
+      image[y][x] = static_cast<PixelTypes::GrayscaledPixel>(y * 40 + x);
+
+  DebugImageEncoding encoding;
+  encoding.downScale = 2;
+  encoding.left = 1;
+  encoding.top = 2;
+  encoding.right = 6;
+  encoding.bits = 4;
+
+  DebugImage result;
+  roundTrip(image, encoding, result);
+  ASSERT_EQ(8, result.width);
+  ASSERT_EQ(6, result.height);
+  const auto pixels = result.getView<PixelTypes::GrayscaledPixel>();
+  for(unsigned y = 0; y < image.height; ++y)
+    for(unsigned x = 0; x < image.width; ++x)
+      if(y < 2 || x < 1 || x >= 6)
+        EXPECT_EQ(0, pixels[y][x]);
+      else
+      {
+        // The pixel at the top left of each 2x2 block is sent with 4 bits.
+        const unsigned value = image[y - (y - 2) % 2][x - (x - 1) % 2] >> 4;
+        EXPECT_EQ(value << 4 | value, pixels[y][x]);
+      }
+}
+
+GTEST_TEST(DebugImages, RateLimited)
+{
+  Image<PixelTypes::GrayscaledPixel> image(4, 2);
+  for(unsigned y = 0; y < image.height; ++y)
+    for(unsigned x = 0; x < image.width; ++x)
+      image[y][x] = static_cast<PixelTypes::GrayscaledPixel>(y * 4 + x);
+
+  // The rate limit is sent with the image, even if all pixels are sent as they are.
+  DebugImageEncoding encoding;
+  encoding.maxRate = 5.f;
+  EXPECT_FALSE(encoding.isRaw());
+
+  DebugImage result;
+  roundTrip(image, encoding, result);
+  EXPECT_EQ(5.f, result.maxRate);
+  for(unsigned y = 0; y < image.height; ++y)
+    for(unsigned x = 0; x < image.width; ++x)
+      EXPECT_EQ(image[y][x], result.getView<PixelTypes::GrayscaledPixel>()[y][x]);
+
+  roundTrip(image, DebugImageEncoding(), result);
+  EXPECT_EQ(0.f, result.maxRate);
+}
@@ -0,0 +1,65 @@
+#include "ImageProcessing/Resize.h"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace
+{
+  /**
+   * Compares shrinkYInterleaved with shrinking each plane separately.
+   * If \c halfSizeChroma is set, all planes but the first have half the width and height.
+   */
+  void compare(unsigned width, unsigned height, unsigned downScales, unsigned numOfPlanes, bool halfSizeChroma = false)
+  {
+    std::mt19937 random(width * height + downScales);
+    std::vector<Image<PixelTypes::GrayscaledPixel>> planes;
+    for(unsigned i = 0; i < numOfPlanes; ++i)
+      planes.emplace_back(i && halfSizeChroma ? width / 2 : width, i && halfSizeChroma ? height / 2 : height);
+    for(Image<PixelTypes::GrayscaledPixel>& plane : planes)
+      for(unsigned y = 0; y < plane.height; ++y)
+        for(unsigned x = 0; x < plane.width; ++x)
+          plane[y][x] = static_cast<PixelTypes::GrayscaledPixel>(random());
+
+    std::vector<Image<PixelTypes::GrayscaledPixel>> thumbnails(numOfPlanes);
+    for(unsigned i = 0; i < numOfPlanes; ++i)
+    {
+      const unsigned planeDownScales = i && halfSizeChroma ? downScales - 1 : downScales;
+      if(planeDownScales)
+        Resize::shrinkY(planeDownScales, planes[i], thumbnails[i]);
+      else
+        thumbnails[i] = planes[i]; // shrinkY does not support not shrinking at all.
+    }
+
+    const unsigned destWidth = width >> downScales;
+    const unsigned destHeight = height >> downScales;
+    std::vector<PixelTypes::GrayscaledPixel> interleaved(destWidth * destHeight * numOfPlanes);
+    if(numOfPlanes == 1)
+      Resize::shrinkYInterleaved(downScales, {&planes[0]}, interleaved.data());
+    else
+      Resize::shrinkYInterleaved(downScales, {&planes[0], &planes[1], &planes[2]}, interleaved.data());
+
+    for(unsigned y = 0; y < destHeight; ++y)
+      for(unsigned x = 0; x < destWidth; ++x)
+        for(unsigned i = 0; i < numOfPlanes; ++i)
+          ASSERT_EQ(thumbnails[i][y][x], interleaved[(y * destWidth + x) * numOfPlanes + i]);
+  }
+}
+
+GTEST_TEST(Resize, ShrinkYInterleaved)
+{
+  compare(640, 480, 3, 3);
+  compare(320, 240, 2, 3);
+  compare(640, 480, 1, 3);
+  compare(640, 480, 4, 3);
+  compare(480, 64, 3, 3);
+  compare(640, 480, 3, 1);
+}
+
+GTEST_TEST(Resize, ShrinkYInterleavedHalfSizeChroma)
+{
+  compare(640, 480, 3, 3, true);
+  compare(640, 480, 2, 3, true);
+  compare(640, 480, 4, 3, true);
+  compare(320, 240, 1, 3, true);
+}
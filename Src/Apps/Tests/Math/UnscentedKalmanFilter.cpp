@@ -0,0 +1,123 @@
+#include "Math/UnscentedKalmanFilter.h"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace
+{
+  /** A nonlinear motion of a point that moves with a velocity and turns. */
+  void dynamicModel(Vector5f& state)
+  {
+    const float dt = 0.012f;
+    const float c = std::cos(state(4) * dt);
+    const float s = std::sin(state(4) * dt);
+    const Vector2f velocity(c * state(2) - s * state(3), s * state(2) + c * state(3));
+    state.head<2>() += velocity * dt;
+    state.segment<2>(2) = velocity * 0.99f;
+  }
+
+  /** Measures the distance and the bearing of the point. */
+  Vector2f measurementModel(const Vector5f& state)
+  {
+    return Vector2f(state.head<2>().norm(), std::atan2(state(1), state(0)));
+  }
+
+  /** Measures the speed of the point. */
+  float speedModel(const Vector5f& state)
+  {
+    return state.segment<2>(2).norm();
+  }
+
+  Matrix5f initialCovariance()
+  {
+    return Vector5f(100.f, 100.f, 50.f, 50.f, 0.1f).asDiagonal();
+  }
+
+  void expectNear(const Vector5f& a, const Vector5f& b)
+  {
+    EXPECT_LT((a - b).norm(), 1e-4f * std::max(1.f, b.norm())) << a.transpose() << " vs " << b.transpose();
+  }
+
+  void expectNear(const Matrix5f& a, const Matrix5f& b)
+  {
+    EXPECT_LT((a - b).norm(), 1e-4f * std::max(1.f, b.norm())) << a << "\nvs\n" << b;
+  }
+}
+
+GTEST_TEST(UnscentedKalmanFilter, fixedMatchesDynamic)
+{
+  std::mt19937 generator(42);
+  std::normal_distribution<float> noise;
+  const Vector5f start(1000.f, -500.f, 200.f, 100.f, 1.f);
+  const Matrix5f dynamicNoise = Vector5f(1.f, 1.f, 10.f, 10.f, 0.01f).asDiagonal();
+  const Matrix2f measurementNoise = Vector2f(25.f, 0.001f).asDiagonal();
+
+  UKF<5> reference(start);
+  FixedUKF<5> fixed(start);
+  reference.init(start, initialCovariance());
+  fixed.init(start, initialCovariance());
+
+  Vector5f truth = start;
+  for(int i = 0; i < 500; ++i)
+  {
+    dynamicModel(truth);
+    reference.predict(dynamicModel, dynamicNoise);
+    fixed.predict(dynamicModel, dynamicNoise);
+    expectNear(fixed.mean, reference.mean);
+    expectNear(fixed.cov, reference.cov);
+
+    const Vector2f measurement = measurementModel(truth) + Vector2f(5.f * noise(generator), 0.03f * noise(generator));
+    reference.update<2>(measurement, measurementModel, measurementNoise);
+    fixed.update<2>(measurement, measurementModel, measurementNoise);
+    expectNear(fixed.mean, reference.mean);
+    expectNear(fixed.cov, reference.cov);
+
+    if(i % 3 == 0)
+    {
+      const float speed = speedModel(truth) + noise(generator);
+      reference.update(speed, speedModel, 4.f);
+      fixed.update(speed, speedModel, 4.f);
+      expectNear(fixed.mean, reference.mean);
+      expectNear(fixed.cov, reference.cov);
+    }
+
+    // Keep the filters in sync, so that errors do not accumulate.
+    fixed.init(reference.mean, reference.cov);
+  }
+}
+
+GTEST_TEST(UnscentedKalmanFilter, batchMatchesSingle)
+{
+  std::mt19937 generator(4711);
+  std::uniform_real_distribution<float> position(-3000.f, 3000.f);
+  const Matrix5f dynamicNoise = Vector5f(1.f, 1.f, 10.f, 10.f, 0.01f).asDiagonal();
+  const Matrix2f measurementNoise = Vector2f(25.f, 0.001f).asDiagonal();
+
+  std::vector<FixedUKF<5>> batch;
+  std::vector<FixedUKF<5>> single;
+  for(int i = 0; i < 10; ++i)
+  {
+    const Vector5f start(position(generator), position(generator), 100.f, -100.f, 0.5f);
+    batch.emplace_back(start);
+    batch.back().init(start, initialCovariance());
+  }
+  single = batch;
+
+  for(int i = 0; i < 50; ++i)
+  {
+    std::vector<Vector2f> measurements;
+    for(const FixedUKF<5>& filter : single)
+      measurements.emplace_back(measurementModel(filter.mean) + Vector2f(10.f, 0.01f));
+
+    FixedUKF<5>::predict(batch, dynamicModel, dynamicNoise);
+    FixedUKF<5>::update<2>(batch, measurements, measurementModel, measurementNoise);
+    for(std::size_t j = 0; j < single.size(); ++j)
+    {
+      single[j].predict(dynamicModel, dynamicNoise);
+      single[j].update<2>(measurements[j], measurementModel, measurementNoise);
+      EXPECT_TRUE(batch[j].mean == single[j].mean);
+      EXPECT_TRUE(batch[j].cov == single[j].cov);
+    }
+  }
+}
@@ -0,0 +1,99 @@
+#include "Tools/Modeling/BallPhysics.h"
+#include "Tools/Modeling/BallRollModel.h"
+
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+
+namespace
+{
+  constexpr float friction = -0.13f;
+
+  /** Determines the intercept time by propagating the ball with BallPhysics in small steps. */
+  float referenceInterceptTime(const Vector2f& position, const Vector2f& velocity, const Vector2f& robot, float robotSpeed, float reach)
+  {
+    const float timeUntilStop = BallPhysics::computeTimeUntilBallStops(velocity, friction);
+    for(float t = 0.f; t < timeUntilStop + 0.001f; t += 0.0005f)
+      if((BallPhysics::propagateBallPosition(position, velocity, t, friction) - robot).norm() - reach - robotSpeed * t <= 0.f)
+        return t;
+    return std::max(timeUntilStop, ((BallPhysics::getEndPosition(position, velocity, friction) - robot).norm() - reach) / robotSpeed);
+  }
+}
+
+GTEST_TEST(BallRollModel, matchesBallPhysics)
+{
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<float> coordinate(-4500.f, 4500.f);
+  std::uniform_real_distribution<float> velocity(-3000.f, 3000.f);
+  std::uniform_real_distribution<float> time(0.f, 30.f);
+  std::uniform_real_distribution<float> distance(0.f, 20000.f);
+  BallRollModel model(friction);
+
+  for(int i = 0; i < 1000; ++i)
+  {
+    const Vector2f ballPosition(coordinate(generator), coordinate(generator));
+    const Vector2f ballVelocity = i % 10 ? Vector2f(velocity(generator), velocity(generator)) : Vector2f::Zero();
+    model.setBall(ballPosition, ballVelocity);
+
+    EXPECT_NEAR(model.getTimeUntilStop(), BallPhysics::computeTimeUntilBallStops(ballVelocity, friction), 1e-4f);
+    EXPECT_LT((model.getEndPosition() - BallPhysics::getEndPosition(ballPosition, ballVelocity, friction)).norm(), 0.5f);
+
+    for(int j = 0; j < 10; ++j)
+    {
+      const float t = time(generator);
+      EXPECT_LT((model.getPosition(t) - BallPhysics::propagateBallPosition(ballPosition, ballVelocity, t, friction)).norm(), 0.5f);
+
+      const float d = distance(generator);
+      const float expected = BallPhysics::timeForDistance(ballVelocity, d, friction);
+      const float actual = model.getTimeForDistance(d);
+      if(expected == std::numeric_limits<float>::max() || actual == std::numeric_limits<float>::max())
+      {
+        // Both must agree that the ball does not get that far, unless the distance is very close to the end position.
+        if(std::abs(d - (model.getEndPosition() - ballPosition).norm()) > 1.f)
+        {
+          EXPECT_EQ(actual, expected);
+        }
+      }
+      else
+        EXPECT_NEAR(actual, expected, 1e-3f * std::max(1.f, expected));
+    }
+  }
+}
+
+GTEST_TEST(BallRollModel, interceptTime)
+{
+  std::mt19937 generator(4711);
+  std::uniform_real_distribution<float> coordinate(-4500.f, 4500.f);
+  std::uniform_real_distribution<float> velocity(-2000.f, 2000.f);
+  BallRollModel model(friction);
+  std::vector<Vector2f> robots;
+  std::vector<float> times;
+
+  for(int i = 0; i < 100; ++i)
+  {
+    const Vector2f ballPosition(coordinate(generator), coordinate(generator));
+    const Vector2f ballVelocity(velocity(generator), velocity(generator));
+    model.setBall(ballPosition, ballVelocity);
+
+    robots.clear();
+    for(int j = 0; j < 10; ++j)
+      robots.emplace_back(coordinate(generator), coordinate(generator));
+    model.getInterceptTimes(robots, 300.f, 100.f, times);
+
+    ASSERT_EQ(times.size(), robots.size());
+    for(std::size_t j = 0; j < robots.size(); ++j)
+    {
+      const float expected = referenceInterceptTime(ballPosition, ballVelocity, robots[j], 300.f, 100.f);
+      EXPECT_NEAR(times[j], expected, 0.002f * std::max(1.f, expected));
+
+      // The ball must be reachable at the time returned.
+      EXPECT_LE((model.getPosition(times[j]) - robots[j]).norm(), 100.f + 300.f * times[j] + 1.f);
+    }
+  }
+
+  // Robots that already touch the ball intercept it immediately, robots that do not move only if the ball passes them.
+  model.setBall(Vector2f::Zero(), Vector2f(1000.f, 0.f));
+  EXPECT_EQ(model.getInterceptTime(Vector2f(50.f, 0.f), 0.f, 100.f), 0.f);
+  EXPECT_NEAR(model.getInterceptTime(Vector2f(1100.f, 0.f), 0.f, 100.f), BallPhysics::timeForDistance(Vector2f(1000.f, 0.f), 1000.f, friction), 0.002f);
+  EXPECT_EQ(model.getInterceptTime(Vector2f(0.f, 1000.f), 0.f, 100.f), std::numeric_limits<float>::max());
+}
@@ -0,0 +1,184 @@
+#include "Modules/Modeling/BallStateEstimator/BallStateEstimateFilters.h"
+
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+  constexpr float friction = -0.13f;
+  constexpr float deltaTime = 0.012f;
+
+  /** A single hypothesis as it was filtered before all hypotheses were updated together. */
+  template<int stateSize>
+  struct Reference
+  {
+    using Vector = Eigen::Matrix<float, stateSize, 1>;
+    using Matrix = Eigen::Matrix<float, stateSize, stateSize>;
+
+    Vector x;
+    Matrix P;
+    float nllOfMeasurements = 0.f;
+    float nllWeighting = std::numeric_limits<float>::max();
+
+    void motionUpdate(const Matrix& A, const Vector& u, const Vector& squaredProcessCov, const Matrix& odometryRotationDeviationRotation)
+    {
+      x = A * x + u;
+      P = A * P * A.transpose();
+      P.diagonal() += squaredProcessCov;
+      P.diagonal() += (odometryRotationDeviationRotation * x - x).cwiseAbs2();
+      if constexpr(stateSize == 4)
+      {
+        Vector2f newPosition = x.template head<2>();
+        Vector2f newVelocity = x.template tail<2>();
+        BallPhysics::applyFrictionToPositionAndVelocity(newPosition, newVelocity, deltaTime, friction);
+        x << newPosition, newVelocity;
+      }
+    }
+
+    void measurementUpdate(const Vector2f& measurement, const Matrix2f& measurementCov)
+    {
+      nllOfMeasurements += BallLocatorTools::getNLLOfPosition(measurement, measurementCov, x.template head<2>());
+      nllWeighting = nllOfMeasurements + BallLocatorTools::getNLLOfMean(P.template topLeftCorner<2, 2>());
+      const Eigen::Matrix<float, stateSize, 2> K = P.template leftCols<2>() * (P.template topLeftCorner<2, 2>() + measurementCov).inverse();
+      x += K * (measurement - x.template head<2>());
+      P -= K * P.template topRows<2>();
+    }
+  };
+
+  /** Creates a random rotation matrix. */
+  Matrix2f rotation(float angle)
+  {
+    return (Matrix2f() << std::cos(angle), std::sin(angle), -std::sin(angle), std::cos(angle)).finished();
+  }
+
+  /** Compares all hypotheses with their references. */
+  template<int stateSize>
+  void compare(const BallStateEstimates<stateSize>& balls, const std::vector<Reference<stateSize>>& references)
+  {
+    ASSERT_EQ(static_cast<int>(references.size()), balls.size);
+    for(int i = 0; i < balls.size; ++i)
+    {
+      const Reference<stateSize>& reference = references[i];
+      for(int r = 0; r < stateSize; ++r)
+      {
+        EXPECT_NEAR(reference.x(r), balls.x(r, i), 1e-3f * std::max(1.f, std::abs(reference.x(r))));
+        for(int c = 0; c < stateSize; ++c)
+          EXPECT_NEAR(reference.P(r, c), balls.getCovariance(i)(r, c), 1e-3f * std::max(1.f, std::abs(reference.P(r, c))));
+      }
+      EXPECT_NEAR(reference.nllOfMeasurements, balls.nllOfMeasurements(i), 1e-3f * std::max(1.f, reference.nllOfMeasurements));
+      if(reference.nllWeighting == std::numeric_limits<float>::max())
+        EXPECT_EQ(reference.nllWeighting, balls.nllWeighting(i));
+      else
+        EXPECT_NEAR(reference.nllWeighting, balls.nllWeighting(i), 1e-3f * std::max(1.f, std::abs(reference.nllWeighting)));
+    }
+  }
+}
+
+GTEST_TEST(BallStateEstimateFilters, matchesSingleHypothesisFilters)
+{
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<float> coordinate(-3000.f, 3000.f);
+  std::uniform_real_distribution<float> velocity(-2000.f, 2000.f);
+  std::uniform_real_distribution<float> variance(100.f, 10000.f);
+  std::uniform_real_distribution<float> angle(-0.05f, 0.05f);
+  std::uniform_real_distribution<float> step(-20.f, 20.f);
+  std::normal_distribution<float> noise(0.f, 50.f);
+
+  StationaryBallKalmanFilters stationaryBalls;
+  RollingBallKalmanFilters rollingBalls;
+  std::vector<Reference<2>> stationaryReferences;
+  std::vector<Reference<4>> rollingReferences;
+  const Vector4f squaredProcessCov(1.f, 1.f, 100.f, 100.f);
+
+  for(int frame = 0; frame < 200; ++frame)
+  {
+    // Add hypotheses from time to time, as BallStateEstimator does.
+    if(frame % 20 == 0)
+    {
+      const Vector2f position(coordinate(generator), coordinate(generator));
+      const Matrix2f cov = Vector2f(variance(generator), variance(generator)).asDiagonal();
+      const int i = stationaryBalls.add();
+      stationaryBalls.x.col(i) = position.array();
+      stationaryBalls.setCovariance(i, cov);
+      stationaryReferences.push_back({position, cov});
+
+      const Vector4f state(position.x(), position.y(), velocity(generator), velocity(generator));
+      Matrix4f rollingCov = Matrix4f::Identity();
+      rollingCov.topLeftCorner<2, 2>() = cov;
+      rollingCov.bottomRightCorner<2, 2>() = Vector2f(variance(generator), variance(generator)).asDiagonal();
+      const int j = rollingBalls.add();
+      rollingBalls.x.col(j) = state.array();
+      rollingBalls.setCovariance(j, rollingCov);
+      rollingReferences.push_back({state, rollingCov});
+    }
+
+    // Odometry
+    const Matrix2f odometryRotation = rotation(angle(generator));
+    const Vector2f odometryTranslation(step(generator), step(generator));
+    const Matrix2f odometryRotationDeviationRotation = rotation(0.1f * angle(generator));
+    const Vector4f odometryTranslationCov = (Vector4f() << odometryTranslation.cwiseAbs2() * 0.01f, 0.f, 0.f).finished();
+
+    stationaryBalls.motionUpdate(squaredProcessCov, odometryTranslationCov, odometryRotation, odometryTranslation, odometryRotationDeviationRotation);
+    for(Reference<2>& reference : stationaryReferences)
+      reference.motionUpdate(odometryRotation, odometryTranslation, squaredProcessCov.head<2>() + odometryTranslationCov.head<2>(), odometryRotationDeviationRotation);
+
+    Matrix4f movingMotionMatrix = Matrix4f::Identity();
+    movingMotionMatrix.topRightCorner<2, 2>() = Matrix2f::Identity() * deltaTime;
+    Matrix4f movingOdometryRotation = Matrix4f::Zero();
+    movingOdometryRotation.topLeftCorner<2, 2>() = odometryRotation;
+    movingOdometryRotation.bottomRightCorner<2, 2>() = odometryRotation;
+    Matrix4f movingOdometryRotationDeviationRotation = Matrix4f::Zero();
+    movingOdometryRotationDeviationRotation.topLeftCorner<2, 2>() = odometryRotationDeviationRotation;
+    movingOdometryRotationDeviationRotation.bottomRightCorner<2, 2>() = odometryRotationDeviationRotation;
+    const Matrix4f movingA = movingOdometryRotation * movingMotionMatrix;
+    const Vector4f movingOdometryTranslation = (Vector4f() << odometryTranslation, 0.f, 0.f).finished();
+
+    rollingBalls.motionUpdate(movingA, movingOdometryTranslation, squaredProcessCov, odometryTranslationCov,
+                              movingOdometryRotationDeviationRotation, friction, deltaTime);
+    for(Reference<4>& reference : rollingReferences)
+      reference.motionUpdate(movingA, movingOdometryTranslation, squaredProcessCov + odometryTranslationCov, movingOdometryRotationDeviationRotation);
+
+    // Measurement near the first hypothesis
+    if(frame % 3)
+    {
+      const Vector2f measurement = stationaryReferences.front().x + Vector2f(noise(generator), noise(generator));
+      const Matrix2f measurementCov = (Matrix2f() << 2500.f, 300.f, 300.f, 1600.f).finished();
+      stationaryBalls.measurementUpdate(measurement, measurementCov, 50.f);
+      rollingBalls.measurementUpdate(measurement, measurementCov, 50.f);
+      for(Reference<2>& reference : stationaryReferences)
+        reference.measurementUpdate(measurement, measurementCov);
+      for(Reference<4>& reference : rollingReferences)
+        reference.measurementUpdate(measurement, measurementCov);
+    }
+
+    compare(stationaryBalls, stationaryReferences);
+    compare(rollingBalls, rollingReferences);
+  }
+}
+
+GTEST_TEST(BallStateEstimateFilters, keepBest)
+{
+  StationaryBallKalmanFilters balls;
+  for(int i = 0; i < 10; ++i)
+  {
+    const int j = balls.add();
+    balls.x.col(j) = Vector2f(static_cast<float>(i), 0.f).array();
+    balls.nllWeighting(j) = static_cast<float>((i * 7) % 10);
+    balls.numOfMeasurements[j] = i;
+  }
+  balls.keepBest(3);
+  ASSERT_EQ(3, balls.size);
+  for(int i = 0; i < balls.size; ++i)
+  {
+    EXPECT_EQ(static_cast<float>(i), balls.nllWeighting(i));
+    EXPECT_EQ((i * 3) % 10, balls.numOfMeasurements[i]);
+    EXPECT_EQ(static_cast<float>((i * 3) % 10), balls.x(0, i));
+  }
+
+  balls.remove(0);
+  ASSERT_EQ(2, balls.size);
+  EXPECT_EQ(1.f, balls.nllWeighting(0));
+  EXPECT_EQ(2.f, balls.nllWeighting(1));
+}
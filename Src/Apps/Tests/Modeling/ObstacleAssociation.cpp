@@ -0,0 +1,125 @@
+#include "Tools/Modeling/ObstacleAssociation.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+  struct Point
+  {
+    Vector2f center;
+  };
+
+  std::vector<Point> randomPoints(std::mt19937& generator, std::size_t n, float range)
+  {
+    std::uniform_real_distribution<float> coordinate(-range, range);
+    std::vector<Point> points;
+    for(std::size_t i = 0; i < n; ++i)
+      points.push_back({Vector2f(coordinate(generator), coordinate(generator))});
+    return points;
+  }
+
+  /** Assigns the closest gated pairs first by checking all pairs. */
+  std::vector<std::size_t> referenceAssignment(const std::vector<Point>& measurements, const std::vector<Point>& hypotheses, float gate)
+  {
+    std::vector<std::size_t> assignment(measurements.size(), ObstacleAssociation::none);
+    std::vector<bool> assigned(hypotheses.size(), false);
+    while(true)
+    {
+      float bestDistanceSquared = sqr(gate);
+      std::size_t bestMeasurement = ObstacleAssociation::none;
+      std::size_t bestHypothesis = ObstacleAssociation::none;
+      for(std::size_t i = 0; i < measurements.size(); ++i)
+        if(assignment[i] == ObstacleAssociation::none)
+          for(std::size_t j = 0; j < hypotheses.size(); ++j)
+            if(!assigned[j])
+            {
+              const float distanceSquared = (measurements[i].center - hypotheses[j].center).squaredNorm();
+              if(distanceSquared < bestDistanceSquared || (distanceSquared == bestDistanceSquared && bestMeasurement == ObstacleAssociation::none))
+              {
+                bestDistanceSquared = distanceSquared;
+                bestMeasurement = i;
+                bestHypothesis = j;
+              }
+            }
+      if(bestMeasurement == ObstacleAssociation::none)
+        return assignment;
+      assignment[bestMeasurement] = bestHypothesis;
+      assigned[bestHypothesis] = true;
+    }
+  }
+}
+
+GTEST_TEST(ObstacleAssociation, nearMatchesBruteForce)
+{
+  std::mt19937 generator(42);
+  ObstacleAssociation association(500.f);
+  for(std::size_t n : {0, 1, 10, 60, 200})
+  {
+    const std::vector<Point> hypotheses = randomPoints(generator, n, 5000.f);
+    association.index(hypotheses);
+    for(const Point& query : randomPoints(generator, 50, 6000.f))
+      for(float radius : {0.f, 100.f, 700.f, 3000.f, 20000.f})
+      {
+        std::vector<std::size_t> expected;
+        for(std::size_t i = 0; i < hypotheses.size(); ++i)
+          if((hypotheses[i].center - query.center).squaredNorm() <= sqr(radius))
+            expected.push_back(i);
+        EXPECT_EQ(association.near(query.center, radius), expected);
+      }
+  }
+}
+
+GTEST_TEST(ObstacleAssociation, assignMatchesBruteForce)
+{
+  std::mt19937 generator(4711);
+  ObstacleAssociation association;
+  for(int i = 0; i < 200; ++i)
+  {
+    const std::vector<Point> hypotheses = randomPoints(generator, i % 70, 4500.f);
+    const std::vector<Point> measurements = randomPoints(generator, i % 23, 4500.f);
+    const float gate = 200.f + 10.f * static_cast<float>(i);
+    association.index(hypotheses);
+    EXPECT_EQ(association.assign(measurements, [gate](const Point&) {return gate;}),
+              referenceAssignment(measurements, hypotheses, gate));
+  }
+}
+
+GTEST_TEST(ObstacleAssociation, closerPairsArePreferred)
+{
+  // A nearest neighbour search per measurement would assign the hypothesis to the first measurement.
+  const std::vector<Point> hypotheses = {{Vector2f(0.f, 0.f)}, {Vector2f(1000.f, 0.f)}};
+  const std::vector<Point> measurements = {{Vector2f(400.f, 0.f)}, {Vector2f(-100.f, 0.f)}};
+  ObstacleAssociation association;
+  association.index(hypotheses);
+  const std::vector<std::size_t>& assignment = association.assign(measurements, [](const Point&) {return 500.f;});
+  ASSERT_EQ(assignment.size(), 2u);
+  EXPECT_EQ(assignment[0], ObstacleAssociation::none);
+  EXPECT_EQ(assignment[1], 0u);
+}
+
+GTEST_TEST(ObstacleAssociation, nonFiniteCoordinatesAreHandled)
+{
+  std::mt19937 generator(815);
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const float inf = std::numeric_limits<float>::infinity();
+  for(std::size_t n : {5, 60})
+  {
+    std::vector<Point> hypotheses = randomPoints(generator, n, 5000.f);
+    hypotheses[0].center = Vector2f(nan, 0.f);
+    hypotheses[1].center = Vector2f(1e30f, -inf);
+    ObstacleAssociation association(500.f);
+    association.index(hypotheses);
+    for(std::size_t i = 2; i < n; ++i)
+    {
+      const std::vector<std::size_t>& candidates = association.near(hypotheses[i].center, 1.f);
+      EXPECT_NE(std::find(candidates.begin(), candidates.end(), i), candidates.end());
+      EXPECT_EQ(std::find(candidates.begin(), candidates.end(), 0u), candidates.end());
+      EXPECT_EQ(std::find(candidates.begin(), candidates.end(), 1u), candidates.end());
+    }
+    EXPECT_TRUE(association.near(Vector2f(nan, nan), 1000.f).empty());
+    EXPECT_TRUE(association.near(Vector2f(-1e30f, 0.f), 1000.f).empty());
+  }
+}
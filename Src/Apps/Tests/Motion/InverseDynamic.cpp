@@ -0,0 +1,134 @@
+#include "Tools/Motion/InverseDynamic.h"
+
+#include <gtest/gtest.h>
+#include <random>
+
+namespace
+{
+  RobotDimensions dimensions()
+  {
+    RobotDimensions robotDimensions;
+    robotDimensions.yHipOffset = 50.f;
+    robotDimensions.hipPitchToRollOffset = Vector3f(10.f, 0.f, -20.f);
+    robotDimensions.upperLegLength = 100.f;
+    robotDimensions.xOffsetHipToKnee = 5.f;
+    robotDimensions.lowerLegLength = 102.9f;
+    robotDimensions.zOffsetAnklePitchToRoll = -10.f;
+    robotDimensions.hipToNeckOffset = Vector3f(0.f, 0.f, 211.5f);
+    robotDimensions.armOffset = Vector3f(0.f, 98.f, 185.f);
+    robotDimensions.yOffsetElbowToShoulder = 15.f;
+    robotDimensions.upperArmLength = 105.f;
+    robotDimensions.xOffsetElbowToWrist = 55.95f;
+    return robotDimensions;
+  }
+
+  MassCalibration masses()
+  {
+    MassCalibration massCalibration;
+    for(int i = 0; i < Limbs::numOfLimbs; ++i)
+    {
+      MassCalibration::MassInfo& massInfo = massCalibration.masses[i];
+      massInfo.mass = 100.f + 10.f * i;
+      massInfo.offset = Vector3f(5.f, -2.f, 3.f + i);
+      massInfo.inertiaMatrix = Vector3f(1e5f, 2e5f, 3e5f).asDiagonal();
+      massInfo.inertiaMatrix += massInfo.mass * (massInfo.offset.squaredNorm() * Matrix3f::Identity() - massInfo.offset * massInfo.offset.transpose());
+    }
+    return massCalibration;
+  }
+
+  JointDynamics randomDynamics(std::mt19937& generator)
+  {
+    std::uniform_real_distribution<float> angle(-0.5f, 0.5f);
+    std::uniform_real_distribution<float> velocity(-3.f, 3.f);
+    std::uniform_real_distribution<float> acceleration(-30.f, 30.f);
+    JointDynamics jointDynamics;
+    for(int i = 0; i < Joints::numOfJoints; ++i)
+    {
+      jointDynamics.angles[i] = angle(generator);
+      jointDynamics.velocities[i] = velocity(generator);
+      jointDynamics.accelerations[i] = acceleration(generator);
+    }
+    return jointDynamics;
+  }
+
+  /** Checks whether two torques are the same up to rounding errors relative to the largest torque. */
+  void expectNear(float expected, float actual, float scale, Joints::Joint joint)
+  {
+    EXPECT_NEAR(expected, actual, 1e-4f * scale) << TypeRegistry::getEnumName(joint);
+  }
+}
+
+GTEST_TEST(InverseDynamic, dynamicsMatchTorques)
+{
+  const RobotDimensions robotDimensions = dimensions();
+  const MassCalibration massCalibration = masses();
+  const Vector3f gravity(1000.f, -500.f, -9810.f);
+  std::mt19937 generator(42);
+
+  FOREACH_ENUM(Settings::RobotType, robotType)
+    for(int i = 0; i < 10; ++i)
+    {
+      JointDynamics jointDynamics = randomDynamics(generator);
+      InverseDynamic::calculateJointTorques(jointDynamics, gravity, robotDimensions, massCalibration, robotType);
+      const JointDynamics torques = jointDynamics;
+      InverseDynamic::calculateJointTorques(jointDynamics, gravity, robotDimensions, massCalibration, robotType, true, false);
+      const JointDynamics biasTorques = jointDynamics;
+      InverseDynamic::calculateJointTorques(jointDynamics, gravity, robotDimensions, massCalibration, robotType, false, false);
+      const JointDynamics gravityTorques = jointDynamics;
+
+      InverseDynamic::Dynamics dynamics;
+      InverseDynamic::calculateDynamics(jointDynamics, dynamics, gravity, robotDimensions, massCalibration, robotType);
+
+      const float scale = dynamics.biasTorques.cwiseAbs().maxCoeff();
+      ASSERT_GT(scale, 0.f);
+      FOREACH_ENUM(Joints::Joint, joint)
+      {
+        expectNear(torques.torques[joint], jointDynamics.torques[joint], scale, joint);
+        expectNear(biasTorques.torques[joint], dynamics.biasTorques(joint), scale, joint);
+        expectNear(gravityTorques.torques[joint], dynamics.gravityTorques(joint), scale, joint);
+      }
+
+      // Each column of the mass matrix is the change of the torques caused by a unit acceleration of a single joint.
+      const float massScale = dynamics.massMatrix.cwiseAbs().maxCoeff();
+      FOREACH_ENUM(Joints::Joint, column)
+      {
+        JointDynamics unitAcceleration = jointDynamics;
+        unitAcceleration.accelerations.fill(0_deg);
+        unitAcceleration.accelerations[column] = 1.f;
+        InverseDynamic::calculateJointTorques(unitAcceleration, Vector3f::Zero(), robotDimensions, massCalibration, robotType, false, true);
+        FOREACH_ENUM(Joints::Joint, row)
+          EXPECT_NEAR(unitAcceleration.torques[row], dynamics.massMatrix(row, column), 1e-4f * massScale)
+              << TypeRegistry::getEnumName(row) << " " << TypeRegistry::getEnumName(column);
+      }
+      EXPECT_TRUE(dynamics.massMatrix.isApprox(dynamics.massMatrix.transpose()));
+
+      // Without velocities, the bias torques only compensate gravity.
+      InverseDynamic::calculateDynamics(jointDynamics, dynamics, gravity, robotDimensions, massCalibration, robotType, false, false);
+      FOREACH_ENUM(Joints::Joint, joint)
+      {
+        expectNear(gravityTorques.torques[joint], jointDynamics.torques[joint], scale, joint);
+        EXPECT_EQ(dynamics.gravityTorques(joint), dynamics.biasTorques(joint));
+      }
+    }
+}
+
+GTEST_TEST(InverseDynamic, headGravityTorques)
+{
+  const RobotDimensions robotDimensions = dimensions();
+  const MassCalibration massCalibration = masses();
+  const Vector3f gravity(0.f, 0.f, -9810.f);
+
+  // At zero angles, the head pitch joint carries the weight of the head at the x offset of its center of mass.
+  const MassCalibration::MassInfo& head = massCalibration.masses[Limbs::head];
+  const float expected = head.offset.cross(head.mass * gravity).y();
+  FOREACH_ENUM(Settings::RobotType, robotType)
+  {
+    JointDynamics jointDynamics;
+    jointDynamics.angles.fill(0_deg);
+    jointDynamics.velocities.fill(0_deg);
+    jointDynamics.accelerations.fill(0_deg);
+    InverseDynamic::calculateJointTorques(jointDynamics, gravity, robotDimensions, massCalibration, robotType);
+    EXPECT_NEAR(expected, jointDynamics.torques[Joints::headPitch], 1e-4f * std::abs(expected));
+    EXPECT_NEAR(0.f, jointDynamics.torques[Joints::headYaw], 1e-4f * std::abs(expected));
+  }
+}
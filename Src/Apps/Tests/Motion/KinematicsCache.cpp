@@ -0,0 +1,170 @@
+#include "Representations/Configuration/MassCalibration.h"
+#include "Representations/Configuration/RobotDimensions.h"
+#include "Representations/Infrastructure/JointAngles.h"
+#include "Representations/Sensing/RobotModel.h"
+#include "Tools/Motion/ForwardKinematic.h"
+#include "Tools/Motion/KinematicsCache.h"
+#include "MathBase/Rotation.h"
+
+#include <gtest/gtest.h>
+#include <random>
+
+namespace
+{
+  RobotDimensions dimensions()
+  {
+    RobotDimensions robotDimensions;
+    robotDimensions.yHipOffset = 50.f;
+    robotDimensions.hipPitchToRollOffset = Vector3f(10.f, 0.f, -20.f);
+    robotDimensions.upperLegLength = 100.f;
+    robotDimensions.xOffsetHipToKnee = 5.f;
+    robotDimensions.lowerLegLength = 102.9f;
+    robotDimensions.zOffsetAnklePitchToRoll = -10.f;
+    robotDimensions.footHeight = 45.19f;
+    robotDimensions.hipToNeckOffset = Vector3f(0.f, 0.f, 211.5f);
+    robotDimensions.armOffset = Vector3f(0.f, 98.f, 185.f);
+    robotDimensions.yOffsetElbowToShoulder = 15.f;
+    robotDimensions.upperArmLength = 105.f;
+    robotDimensions.xOffsetElbowToWrist = 55.95f;
+    return robotDimensions;
+  }
+
+  MassCalibration masses()
+  {
+    MassCalibration massCalibration;
+    massCalibration.totalMass = 0.f;
+    for(int i = 0; i < Limbs::numOfLimbs; ++i)
+    {
+      massCalibration.masses[i].mass = 100.f + 10.f * i;
+      massCalibration.masses[i].offset = Vector3f(5.f, -2.f, 3.f + i);
+      massCalibration.totalMass += massCalibration.masses[i].mass;
+    }
+    return massCalibration;
+  }
+
+  JointAngles randomAngles(std::mt19937& generator)
+  {
+    std::uniform_real_distribution<float> angle(-0.5f, 0.5f);
+    JointAngles jointAngles;
+    for(int i = 0; i < Joints::numOfJoints; ++i)
+      jointAngles.angles[i] = angle(generator);
+    return jointAngles;
+  }
+
+  /** Computes the whole model from scratch in the same way as RobotModel::setJointData does. */
+  RobotModel reference(const JointAngles& jointAngles, const RobotDimensions& robotDimensions, const MassCalibration& massCalibration,
+                       Settings::RobotType robotType)
+  {
+    RobotModel robotModel;
+    ForwardKinematic::calculateHeadChain(jointAngles, robotDimensions, robotModel.limbs);
+    ForwardKinematic::calculateArmChain(Arms::left, jointAngles, robotDimensions, robotModel.limbs, robotType);
+    ForwardKinematic::calculateArmChain(Arms::right, jointAngles, robotDimensions, robotModel.limbs, robotType);
+    ForwardKinematic::calculateLegChain(Legs::left, jointAngles, robotDimensions, robotModel.limbs, robotType);
+    ForwardKinematic::calculateLegChain(Legs::right, jointAngles, robotDimensions, robotModel.limbs, robotType);
+    robotModel.soleLeft = robotModel.limbs[Limbs::footLeft] + Vector3f(0.f, 0.f, -robotDimensions.footHeight);
+    robotModel.soleRight = robotModel.limbs[Limbs::footRight] + Vector3f(0.f, 0.f, -robotDimensions.footHeight);
+    robotModel.updateCenterOfMass(massCalibration);
+    return robotModel;
+  }
+
+  void expectEqual(const RobotModel& a, const RobotModel& b)
+  {
+    for(int i = 0; i < Limbs::numOfLimbs; ++i)
+    {
+      EXPECT_TRUE(a.limbs[i].translation.isApprox(b.limbs[i].translation)) << TypeRegistry::getEnumName(static_cast<Limbs::Limb>(i));
+      EXPECT_TRUE(a.limbs[i].rotation.isApprox(b.limbs[i].rotation)) << TypeRegistry::getEnumName(static_cast<Limbs::Limb>(i));
+    }
+    EXPECT_TRUE(a.soleLeft.translation.isApprox(b.soleLeft.translation));
+    EXPECT_TRUE(a.soleRight.translation.isApprox(b.soleRight.translation));
+    EXPECT_TRUE(a.centerOfMass.isApprox(b.centerOfMass));
+  }
+}
+
+GTEST_TEST(KinematicsCache, matchesForwardKinematic)
+{
+  const RobotDimensions robotDimensions = dimensions();
+  const MassCalibration massCalibration = masses();
+  std::mt19937 generator(42);
+
+  for(Settings::RobotType robotType : {Settings::nao, Settings::t1})
+  {
+    KinematicsCache kinematicsCache;
+    RobotModel robotModel;
+    JointAngles jointAngles = randomAngles(generator);
+    EXPECT_EQ(kinematicsCache.update(robotModel, jointAngles, robotDimensions, massCalibration, robotType), KinematicsCache::numOfChains);
+    expectEqual(robotModel, reference(jointAngles, robotDimensions, massCalibration, robotType));
+
+    EXPECT_EQ(kinematicsCache.update(robotModel, jointAngles, robotDimensions, massCalibration, robotType), 0u);
+
+    jointAngles.angles[Joints::headPitch] += 0.1f;
+    EXPECT_EQ(kinematicsCache.update(robotModel, jointAngles, robotDimensions, massCalibration, robotType), 1u);
+    expectEqual(robotModel, reference(jointAngles, robotDimensions, massCalibration, robotType));
+
+    jointAngles.angles[Joints::rElbowRoll] += 0.1f;
+    jointAngles.variance[Joints::lKneePitch] = 0.01f;
+    EXPECT_EQ(kinematicsCache.update(robotModel, jointAngles, robotDimensions, massCalibration, robotType), 2u);
+    expectEqual(robotModel, reference(jointAngles, robotDimensions, massCalibration, robotType));
+
+    jointAngles.angles[Joints::waistYaw] += 0.1f;
+    EXPECT_EQ(kinematicsCache.update(robotModel, jointAngles, robotDimensions, massCalibration, robotType), 2u);
+    expectEqual(robotModel, reference(jointAngles, robotDimensions, massCalibration, robotType));
+
+    for(int i = 0; i < 100; ++i)
+    {
+      jointAngles = randomAngles(generator);
+      kinematicsCache.update(robotModel, jointAngles, robotDimensions, massCalibration, robotType);
+      expectEqual(robotModel, reference(jointAngles, robotDimensions, massCalibration, robotType));
+    }
+
+    // Changed dimensions require a complete recomputation.
+    RobotDimensions changedDimensions = robotDimensions;
+    changedDimensions.upperLegLength += 1.f;
+    EXPECT_EQ(kinematicsCache.update(robotModel, jointAngles, changedDimensions, massCalibration, robotType), KinematicsCache::numOfChains);
+    expectEqual(robotModel, reference(jointAngles, changedDimensions, massCalibration, robotType));
+    EXPECT_EQ(kinematicsCache.update(robotModel, jointAngles, changedDimensions, massCalibration, robotType), 0u);
+    changedDimensions.footHeight += 1.f;
+    EXPECT_EQ(kinematicsCache.update(robotModel, jointAngles, changedDimensions, massCalibration, robotType), 0u);
+    expectEqual(robotModel, reference(jointAngles, changedDimensions, massCalibration, robotType));
+
+    // Another model or an invalidated cache must be computed completely.
+    RobotModel otherModel;
+    EXPECT_EQ(kinematicsCache.update(otherModel, jointAngles, robotDimensions, massCalibration, robotType), KinematicsCache::numOfChains);
+    kinematicsCache.invalidate();
+    EXPECT_EQ(kinematicsCache.update(otherModel, jointAngles, robotDimensions, massCalibration, robotType), KinematicsCache::numOfChains);
+  }
+}
+
+GTEST_TEST(KinematicsCache, legJacobian)
+{
+  const RobotDimensions robotDimensions = dimensions();
+  const MassCalibration massCalibration = masses();
+  std::mt19937 generator(4711);
+  constexpr float delta = 1e-3f;
+
+  for(Settings::RobotType robotType : {Settings::nao, Settings::t1})
+    for(int i = 0; i < 20; ++i)
+    {
+      const JointAngles jointAngles = randomAngles(generator);
+      KinematicsCache kinematicsCache;
+      RobotModel robotModel;
+      kinematicsCache.update(robotModel, jointAngles, robotDimensions, massCalibration, robotType);
+
+      FOREACH_ENUM(Legs::Leg, leg)
+      {
+        const Matrix6f jacobian = kinematicsCache.getLegJacobian(leg, robotDimensions);
+        const Pose3f& sole = leg == Legs::left ? robotModel.soleLeft : robotModel.soleRight;
+        FOREACH_ENUM(Joints::LegJoint, legJoint)
+        {
+          JointAngles changed = jointAngles;
+          changed.angles[Joints::combine(leg, legJoint)] += delta;
+          const RobotModel changedModel = reference(changed, robotDimensions, massCalibration, robotType);
+          const Pose3f& changedSole = leg == Legs::left ? changedModel.soleLeft : changedModel.soleRight;
+
+          const Vector3f translationalVelocity = (changedSole.translation - sole.translation) / delta;
+          const Vector3f angularVelocity = Rotation::AngleAxis::pack(AngleAxisf(changedSole.rotation * sole.rotation.inverse())) / delta;
+          EXPECT_LT((jacobian.block<3, 1>(0, legJoint) - translationalVelocity).norm(), 2.f);
+          EXPECT_LT((jacobian.block<3, 1>(3, legJoint) - angularVelocity).norm(), 1e-2f);
+        }
+      }
+    }
+}
@@ -0,0 +1,72 @@
+#include "Streaming/LZ4.h"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+  /** Compresses and decompresses data and returns the compressed size. */
+  std::size_t roundTrip(const std::string& data)
+  {
+    std::vector<char> compressed(LZ4::compressBound(data.size()));
+    const std::size_t size = LZ4::compress(data.data(), data.size(), compressed.data());
+    EXPECT_LE(size, compressed.size());
+
+    std::string decompressed(data.size(), '\0');
+    EXPECT_TRUE(LZ4::decompress(compressed.data(), size, decompressed.data(), decompressed.size()));
+    EXPECT_EQ(data, decompressed);
+    return size;
+  }
+}
+
+GTEST_TEST(LZ4, Small)
+{
+  roundTrip("");
+  roundTrip("a");
+  roundTrip("abcdefghijkl");
+  roundTrip("abcdabcdabcdabcd");
+}
+
+GTEST_TEST(LZ4, Repetitive)
+{
+  std::string data;
+  for(int i = 0; i < 10000; ++i)
+    data += "frame " + std::to_string(i % 17) + ";";
+  EXPECT_LT(roundTrip(data), data.size() / 10);
+
+  // Runs of a single byte are overlapping matches.
+  EXPECT_LT(roundTrip(std::string(100000, 'x')), 1000u);
+}
+
+GTEST_TEST(LZ4, Random)
+{
+  std::mt19937 random(42);
+  std::string data(100000, '\0');
+  for(char& c : data)
+    c = static_cast<char>(random());
+  EXPECT_LE(roundTrip(data), LZ4::compressBound(data.size()));
+
+  // Mostly random data with some repetitions (like an image).
+  for(std::size_t i = 0; i < data.size(); ++i)
+    if(i % 64 < 32)
+      data[i] = static_cast<char>(i / 64);
+  EXPECT_LT(roundTrip(data), data.size());
+}
+
+GTEST_TEST(LZ4, Corrupt)
+{
+  const std::string data(1000, 'y');
+  std::vector<char> compressed(LZ4::compressBound(data.size()));
+  const std::size_t size = LZ4::compress(data.data(), data.size(), compressed.data());
+  std::string decompressed(data.size(), '\0');
+
+  // Wrong sizes are detected.
+  EXPECT_FALSE(LZ4::decompress(compressed.data(), size, decompressed.data(), decompressed.size() - 1));
+  EXPECT_FALSE(LZ4::decompress(compressed.data(), size - 1, decompressed.data(), decompressed.size()));
+
+  // Offsets before the beginning are detected.
+  const char invalid[] = {0x10, 'a', 2, 0, 0x00};
+  EXPECT_FALSE(LZ4::decompress(invalid, sizeof(invalid), decompressed.data(), 5));
+}
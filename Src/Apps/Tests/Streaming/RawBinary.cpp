@@ -0,0 +1,120 @@
+#include "Math/Eigen.h"
+#include "MathBase/Angle.h"
+#include "Streaming/AutoStreamable.h"
+#include "Streaming/Enum.h"
+#include "Streaming/InStreams.h"
+#include "Streaming/OutStreams.h"
+
+#include <gtest/gtest.h>
+#include <cstring>
+
+namespace
+{
+  STREAMABLE(RawBinaryExample,
+  {
+    ENUM(Letter,
+    {,
+      a,
+      b,
+      c,
+    }),
+
+    (int)(-42) anInt,
+    (unsigned short)(4711) anUnsignedShort,
+    (float)(3.14f) aFloat,
+    (Angle)(1.5f) anAngle,
+    (Vector2f)(1.f, 2.f) aVector,
+    (Matrix2f)(Matrix2f::Identity()) aMatrix,
+    (Letter)(c) aLetter,
+    (short[3]) anArray,
+    (std::array<Angle, 2>) anotherArray,
+  });
+
+  STREAMABLE(MixedExample,
+  {,
+    (int)(7) anInt,
+    (bool)(true) aBool,
+    (std::vector<float>)({1.f, 2.f}) aVector,
+  });
+
+  /** Writes the attributes one by one, i.e. without the raw binary path. */
+  std::string writeAttributes(const RawBinaryExample& e)
+  {
+    OutBinaryMemory stream;
+    Streaming::Streamer<int>::write(stream, "anInt", e.anInt);
+    Streaming::Streamer<unsigned short>::write(stream, "anUnsignedShort", e.anUnsignedShort);
+    Streaming::Streamer<float>::write(stream, "aFloat", e.aFloat);
+    Streaming::Streamer<Angle>::write(stream, "anAngle", e.anAngle);
+    Streaming::Streamer<Vector2f>::write(stream, "aVector", e.aVector);
+    Streaming::Streamer<Matrix2f>::write(stream, "aMatrix", e.aMatrix);
+    Streaming::Streamer<RawBinaryExample::Letter>::write(stream, "aLetter", e.aLetter);
+    Streaming::Streamer<short[3]>::write(stream, "anArray", e.anArray);
+    Streaming::Streamer<std::array<Angle, 2>>::write(stream, "anotherArray", e.anotherArray);
+    return std::string(stream.data(), stream.size());
+  }
+
+  template<typename T> std::string write(const T& t)
+  {
+    OutBinaryMemory stream;
+    stream << t;
+    return std::string(stream.data(), stream.size());
+  }
+}
+
+GTEST_TEST(RawBinary, Classification)
+{
+  EXPECT_TRUE(Streaming::IsRawBinary<int>::value);
+  EXPECT_TRUE(Streaming::IsRawBinary<Angle>::value);
+  EXPECT_TRUE(Streaming::IsRawBinary<Vector3f>::value);
+  EXPECT_TRUE(Streaming::IsRawBinary<Quaternionf>::value);
+  EXPECT_TRUE(Streaming::IsRawBinary<RawBinaryExample::Letter>::value);
+  EXPECT_TRUE(Streaming::IsRawBinary<float[4]>::value);
+  EXPECT_FALSE(Streaming::IsRawBinary<bool>::value);
+  EXPECT_FALSE(Streaming::IsRawBinary<std::vector<float>>::value);
+  EXPECT_FALSE(Streaming::IsRawBinary<RawBinaryExample>::value);
+}
+
+GTEST_TEST(RawBinary, SameFormat)
+{
+  RawBinaryExample e;
+  e.anArray[0] = 1;
+  e.anArray[1] = -2;
+  e.anArray[2] = 3;
+  e.anotherArray = {0.5_rad, -0.25_rad};
+  EXPECT_EQ(writeAttributes(e), write(e));
+}
+
+GTEST_TEST(RawBinary, RoundTrip)
+{
+  RawBinaryExample e;
+  e.anInt = 123;
+  e.aFloat = -1.f;
+  e.aVector = Vector2f(3.f, 4.f);
+  e.aLetter = RawBinaryExample::b;
+  e.anArray[0] = e.anArray[1] = e.anArray[2] = 9;
+  e.anotherArray = {1_rad, 2_rad};
+  const std::string data = write(e);
+
+  RawBinaryExample f;
+  InBinaryMemory stream(data.data(), data.size());
+  stream >> f;
+  EXPECT_EQ(data, write(f));
+  EXPECT_EQ(123, f.anInt);
+  EXPECT_EQ(RawBinaryExample::b, f.aLetter);
+  EXPECT_EQ(Vector2f(3.f, 4.f), f.aVector);
+}
+
+GTEST_TEST(RawBinary, Fallback)
+{
+  MixedExample e;
+  e.aBool = false;
+  const std::string data = write(e);
+  EXPECT_EQ(sizeof(int) + sizeof(char) + sizeof(unsigned) + 2 * sizeof(float), data.size());
+
+  MixedExample f;
+  InBinaryMemory stream(data.data(), data.size());
+  stream >> f;
+  EXPECT_EQ(7, f.anInt);
+  EXPECT_FALSE(f.aBool);
+  EXPECT_EQ(e.aVector, f.aVector);
+}
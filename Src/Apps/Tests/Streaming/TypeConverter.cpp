@@ -0,0 +1,161 @@
+#include "Streaming/AutoStreamable.h"
+#include "Streaming/InStreams.h"
+#include "Streaming/OutStreams.h"
+#include "Streaming/TypeConverter.h"
+#include "Streaming/TypeInfo.h"
+
+#include <gtest/gtest.h>
+#include <cstring>
+
+namespace
+{
+  STREAMABLE(TypeConverterExample,
+  {,
+    (int)(1) anInt,
+    (float)(2.f) aFloat,
+    (std::vector<short>)({3, 4}) aVector,
+  });
+
+  /** Creates type information without the types of the type registry. */
+  TypeInfo createTypeInfo()
+  {
+    TypeInfo typeInfo(false);
+    typeInfo.primitives = {"bool", "char", "short", "int", "unsigned", "float", "double", "std::string"};
+    return typeInfo;
+  }
+
+  /** The specification of TypeConverterExample as it is compiled in. */
+  TypeInfo createCurrent()
+  {
+    TypeInfo typeInfo = createTypeInfo();
+    typeInfo.classes["TypeConverterExample"] = {{"int", "anInt"}, {"float", "aFloat"}, {"short*", "aVector"}};
+    return typeInfo;
+  }
+
+  /** Appends the binary representation of a value to a buffer. */
+  template<typename T> void add(std::string& buffer, const T& value)
+  {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  /** Reads the binary representation of a value from a buffer at a position. */
+  template<typename T> T get(const std::vector<char>& buffer, std::size_t offset)
+  {
+    T value;
+    std::memcpy(&value, buffer.data() + offset, sizeof(value));
+    return value;
+  }
+}
+
+GTEST_TEST(TypeConverter, Copy)
+{
+  const TypeInfo from = createCurrent();
+  const TypeInfo to = createCurrent();
+  TypeConverter converter(from, to, "TypeConverterExample");
+  EXPECT_TRUE(converter.isCopy());
+
+  std::string data;
+  add(data, 5);
+  add(data, 6.f);
+  add(data, 1u);
+  add(data, static_cast<short>(7));
+  std::vector<char> result;
+  ASSERT_TRUE(converter.convert(data.data(), data.size(), nullptr, 0, result));
+  EXPECT_EQ(data, std::string(result.data(), result.size()));
+
+  // Truncated data is rejected.
+  EXPECT_FALSE(converter.convert(data.data(), data.size() - 1, nullptr, 0, result));
+}
+
+GTEST_TEST(TypeConverter, ReorderAndWiden)
+{
+  // The attributes were swapped and their types were narrower before.
+  TypeInfo from = createTypeInfo();
+  from.classes["TypeConverterExample"] = {{"short", "aFloat"}, {"char", "removed"}, {"short*", "aVector"}, {"short", "anInt"}};
+  const TypeInfo to = createCurrent();
+  TypeConverter converter(from, to, "TypeConverterExample");
+  EXPECT_FALSE(converter.isCopy());
+
+  std::string data;
+  add(data, static_cast<short>(-8));
+  add(data, 'x');
+  add(data, 2u);
+  add(data, static_cast<short>(9));
+  add(data, static_cast<short>(10));
+  add(data, static_cast<short>(11));
+
+  TypeConverterExample example;
+  ASSERT_TRUE(converter.convert(data.data(), data.size(), example));
+  EXPECT_EQ(11, example.anInt);
+  EXPECT_EQ(-8.f, example.aFloat);
+  EXPECT_EQ((std::vector<short>{9, 10}), example.aVector);
+}
+
+GTEST_TEST(TypeConverter, KeepMissing)
+{
+  // "aFloat" did not exist and "anInt" had an incompatible type.
+  TypeInfo from = createTypeInfo();
+  from.classes["TypeConverterExample"] = {{"std::string", "anInt"}, {"short*", "aVector"}};
+  const TypeInfo to = createCurrent();
+  TypeConverter converter(from, to, "TypeConverterExample");
+
+  std::string data;
+  add(data, 3u);
+  data += "abc";
+  add(data, 3u);
+  add(data, static_cast<short>(5));
+  add(data, static_cast<short>(6));
+  add(data, static_cast<short>(7));
+
+  TypeConverterExample example;
+  example.anInt = 42;
+  example.aFloat = 0.5f;
+  ASSERT_TRUE(converter.convert(data.data(), data.size(), example));
+  EXPECT_EQ(42, example.anInt);
+  EXPECT_EQ(0.5f, example.aFloat);
+  EXPECT_EQ((std::vector<short>{5, 6, 7}), example.aVector);
+}
+
+GTEST_TEST(TypeConverter, Enumerations)
+{
+  TypeInfo from = createTypeInfo();
+  from.enums["Letter"] = {"a", "b", "c"};
+  from.classes["Record"] = {{"Letter[3]", "letters"}};
+  TypeInfo to = createTypeInfo();
+  to.enums["Letter"] = {"c", "a"};
+  to.classes["Record"] = {{"Letter*", "letters"}, {"double", "value"}};
+  TypeConverter converter(from, to, "Record");
+
+  const std::string data = {0, 1, 2};
+  std::string defaults;
+  add(defaults, 1u);
+  defaults += static_cast<char>(1);
+  add(defaults, 2.5);
+
+  std::vector<char> result;
+  ASSERT_TRUE(converter.convert(data.data(), data.size(), defaults.data(), defaults.size(), result));
+  ASSERT_EQ(sizeof(unsigned) + 3 + sizeof(double), result.size());
+  EXPECT_EQ(3u, get<unsigned>(result, 0));
+  EXPECT_EQ(1, result[4]); // a -> a
+  EXPECT_EQ(0, result[5]); // b is unknown -> no default -> 0
+  EXPECT_EQ(0, result[6]); // c -> c
+  EXPECT_EQ(2.5, get<double>(result, 7));
+}
+
+GTEST_TEST(TypeConverter, Saturate)
+{
+  TypeInfo from = createTypeInfo();
+  from.classes["Record"] = {{"float", "small"}, {"int", "flag"}};
+  TypeInfo to = createTypeInfo();
+  to.classes["Record"] = {{"short", "small"}, {"bool", "flag"}};
+  TypeConverter converter(from, to, "Record");
+
+  std::string data;
+  add(data, 1e6f);
+  add(data, 3);
+  std::vector<char> result;
+  ASSERT_TRUE(converter.convert(data.data(), data.size(), nullptr, 0, result));
+  ASSERT_EQ(sizeof(short) + 1, result.size());
+  EXPECT_EQ(std::numeric_limits<short>::max(), get<short>(result, 0));
+  EXPECT_EQ(1, result[2]);
+}
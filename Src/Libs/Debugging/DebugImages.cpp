@@ -0,0 +1,128 @@
+/**
+ * @file DebugImages.cpp
+ *
+ * This file implements the encoding and decoding of debug images.
+ */
+
+#include "DebugImages.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
+/**
+ * Can the bytes of a pixel type be quantized, i.e. do they represent
+ * intensities?
+ * @param type The pixel type.
+ * @return Is quantization supported?
+ */
+static bool isQuantizable(PixelTypes::PixelType type)
+{
+  return type == PixelTypes::RGB || type == PixelTypes::BGRA || type == PixelTypes::YUYV
+         || type == PixelTypes::YUV || type == PixelTypes::Grayscale || type == PixelTypes::Hue;
+}
+
+void DebugImage::reserve(size_t size)
+{
+  if(isReference || !data || size > maxSize)
+  {
+    if(!isReference && data)
+      Memory::alignedFree(data);
+    isReference = false;
+    data = Memory::alignedMalloc(size, 32);
+    maxSize = size;
+  }
+}
+
+void DebugImage::read(In& stream)
+{
+  STREAM(type);
+  STREAM(width);
+  STREAM(height);
+
+  const size_t pixelSize = PixelTypes::pixelSize(type);
+  const size_t size = width * height * pixelSize;
+  reserve(size);
+  if(!isEncoded)
+  {
+    maxRate = 0.f;
+    stream.read(data, size);
+    return;
+  }
+
+  DebugImageEncoding encoding;
+  stream >> encoding;
+  maxRate = encoding.maxRate;
+  const unsigned downScale = std::max(1u, static_cast<unsigned>(encoding.downScale));
+  const unsigned right = std::min(width, encoding.right);
+  const unsigned bottom = std::min(height, encoding.bottom);
+  const unsigned left = std::min(right, static_cast<unsigned>(encoding.left));
+  const unsigned top = std::min(bottom, static_cast<unsigned>(encoding.top));
+  const unsigned bits = std::clamp(static_cast<unsigned>(encoding.bits), 1u, 8u);
+
+  // Bytes are expanded by repeating their most significant bits, i.e. 0 and 255 stay the same.
+  std::array<unsigned char, 256> expand;
+  for(unsigned i = 0; i < 256; ++i)
+  {
+    const unsigned value = i >> (8 - bits);
+    unsigned result = 0;
+    for(int shift = 8 - bits; shift > -static_cast<int>(bits); shift -= bits)
+      result |= shift >= 0 ? value << shift : value >> -shift;
+    expand[i] = static_cast<unsigned char>(result);
+  }
+
+  // Pixels outside the region are black. Each pixel received is replicated downScale x downScale times.
+  std::memset(data, 0, size);
+  std::vector<unsigned char> row((right - left + downScale - 1) / downScale * pixelSize);
+  for(unsigned y = top; y < bottom; y += downScale)
+  {
+    stream.read(row.data(), row.size());
+    if(bits < 8)
+      for(unsigned char& byte : row)
+        byte = expand[byte];
+    unsigned char* const first = static_cast<unsigned char*>(data) + (y * width + left) * pixelSize;
+    unsigned char* dest = first;
+    const unsigned char* src = row.data();
+    for(unsigned x = left; x < right; x += downScale, src += pixelSize)
+      for(unsigned i = 0; i < downScale && x + i < right; ++i, dest += pixelSize)
+        std::memcpy(dest, src, pixelSize);
+    for(unsigned i = 1; i < downScale && y + i < bottom; ++i)
+      std::memcpy(first + i * width * pixelSize, first, (right - left) * pixelSize);
+  }
+}
+
+void DebugImage::write(Out& stream) const
+{
+  STREAM(type);
+  STREAM(width);
+  STREAM(height);
+
+  const size_t pixelSize = PixelTypes::pixelSize(type);
+  if(!encoding)
+  {
+    stream.write(data, width * height * pixelSize);
+    return;
+  }
+
+  // Clip the region to the image and only quantize intensities.
+  DebugImageEncoding clipped = *encoding;
+  clipped.downScale = std::max(static_cast<unsigned char>(1), clipped.downScale);
+  clipped.right = clipped.right ? std::min(width, clipped.right) : width;
+  clipped.bottom = clipped.bottom ? std::min(height, clipped.bottom) : height;
+  clipped.left = std::min(clipped.left, clipped.right);
+  clipped.top = std::min(clipped.top, clipped.bottom);
+  clipped.bits = isQuantizable(type) ? std::clamp(clipped.bits, static_cast<unsigned char>(1), static_cast<unsigned char>(8)) : 8;
+  stream << clipped;
+
+  const unsigned char mask = static_cast<unsigned char>(0xff << (8 - clipped.bits));
+  std::vector<unsigned char> row((clipped.right - clipped.left + clipped.downScale - 1) / clipped.downScale * pixelSize);
+  for(unsigned y = clipped.top; y < clipped.bottom; y += clipped.downScale)
+  {
+    const unsigned char* src = static_cast<const unsigned char*>(data) + (y * width + clipped.left) * pixelSize;
+    unsigned char* dest = row.data();
+    for(unsigned x = clipped.left; x < clipped.right; x += clipped.downScale, src += clipped.downScale * pixelSize)
+      for(size_t i = 0; i < pixelSize; ++i)
+        *dest++ = src[i] & mask;
+    stream.write(row.data(), row.size());
+  }
+}
@@ -8,23 +8,71 @@
 #pragma once
 
 #include "Debugging/Debugging.h"
+#include "Debugging/Modify.h"
 #include "ImageProcessing/Image.h"
 #include "ImageProcessing/PixelTypes.h"
 #include "Platform/Memory.h"
-#include "Streaming/Streamable.h"
+#include "Platform/Time.h"
+#include "Streaming/AutoStreamable.h"
 #include <type_traits>
 
+/**
+ * How a debug image is encoded on the robot to reduce the bandwidth needed.
+ * It can be modified per debug image under the name of its debug request,
+ * e.g. "set debug images:CameraImage downScale = 2; left = 0; top = 0; right = 0; bottom = 0; bits = 4; maxRate = 5;".
+ * Encoded images are sent as idEncodedDebugImage and the receiver decodes them to
+ * their original size. Images sent at a limited rate are always encoded, so that the
+ * receiver knows how long to keep them.
+ */
+STREAMABLE(DebugImageEncoding,
+{
+  unsigned lastTimestamp = 0; /**< When was the last image sent? */
+
+  /**
+   * Checks whether the rate limit allows sending an image now.
+   * If so, the current time is remembered.
+   * @return Should the image be sent?
+   */
+  bool isDue()
+  {
+    if(maxRate > 0.f && lastTimestamp && Time::getTimeSince(lastTimestamp) < static_cast<int>(1000.f / maxRate))
+      return false;
+    lastTimestamp = Time::getCurrentSystemTime();
+    return true;
+  }
+
+  /** Does this encoding only copy the image in every frame? */
+  bool isRaw() const {return downScale <= 1 && !left && !top && !right && !bottom && bits >= 8 && maxRate <= 0.f;},
+
+  (unsigned char)(1) downScale, /**< Only every n-th pixel is sent in both dimensions. */
+  (unsigned short)(0) left, /**< The left border of the region sent (in pixels as stored in the image). */
+  (unsigned short)(0) top, /**< The top border of the region sent. */
+  (unsigned short)(0) right, /**< The right border (exclusive) of the region sent. 0 means the width of the image. */
+  (unsigned short)(0) bottom, /**< The bottom border (exclusive) of the region sent. 0 means the height of the image. */
+  (unsigned char)(8) bits, /**< The number of most significant bits sent per byte channel. Fewer bits compress better. */
+  (float)(0.f) maxRate, /**< The maximum number of images sent per second. 0 means no limit. */
+});
+
 struct DebugImage : public Streamable
 {
 private:
   size_t maxSize = 0;
 
+  /**
+   * Reserves memory for the pixels unless there is enough already.
+   * @param size The number of bytes needed.
+   */
+  void reserve(size_t size);
+
 public:
   void* data = nullptr;
   unsigned short width;
   unsigned short height;
   bool isReference = false;
   PixelTypes::PixelType type;
+  const DebugImageEncoding* encoding = nullptr; /**< How this image is encoded when written. nullptr means raw. */
+  bool isEncoded = false; /**< Is this image read in the encoded format, i.e. was it received as idEncodedDebugImage? */
+  float maxRate = 0.f; /**< The maximum number of images per second with which this image was sent. 0 means in every frame. Only set when read. */
 
   DebugImage() = default;
   DebugImage(const Image<PixelTypes::RGBPixel>& image)
@@ -90,14 +138,7 @@ public:
   void from(const Image<PixelTypes::YUYVPixel>& image)
   {
     size_t size = image.width * image.height * sizeof(PixelTypes::YUYVPixel);
-    if(isReference || !data || size > maxSize)
-    {
-      if(!isReference && data)
-        Memory::alignedFree(data);
-      isReference = false;
-      data = Memory::alignedMalloc(size, 32);
-      maxSize = size;
-    }
+    reserve(size);
     width = static_cast<unsigned short>(image.width);
     height = static_cast<unsigned short>(image.height);
     type = PixelTypes::PixelType::YUYV;
@@ -107,14 +148,7 @@ public:
   void from(const Image<PixelTypes::GrayscaledPixel>& image)
   {
     size_t size = image.width * image.height * sizeof(PixelTypes::GrayscaledPixel);
-    if(isReference || !data || size > maxSize)
-    {
-      if(!isReference && data)
-        Memory::alignedFree(data);
-      isReference = false;
-      data = Memory::alignedMalloc(size, 32);
-      maxSize = size;
-    }
+    reserve(size);
     width = static_cast<unsigned short>(image.width);
     height = static_cast<unsigned short>(image.height);
     type = PixelTypes::PixelType::Grayscale;
@@ -126,42 +160,32 @@ public:
     return type == PixelTypes::YUYV ? width * 2 : width;
   }
 
-protected:
   /**
-   * Read this object from a stream.
-   * @param stream The stream from which the object is read.
+   * Sets the encoding used when this image is written.
+   * @param encoding The encoding. It must exist as long as this image is written.
+   * @return This image.
    */
-  void read(In& stream) override
+  DebugImage& encode(const DebugImageEncoding& encoding)
   {
-    STREAM(type);
-    STREAM(width);
-    STREAM(height);
-
-    const size_t size = width * height * PixelTypes::pixelSize(type);
-    if(isReference || !data || size > maxSize)
-    {
-      if(!isReference && data)
-        Memory::alignedFree(data);
-      isReference = false;
-      data = Memory::alignedMalloc(size, 32);
-      maxSize = size;
-    }
-    stream.read(data, size);
+    this->encoding = encoding.isRaw() ? nullptr : &encoding;
+    return *this;
   }
 
+protected:
+  /**
+   * Read this object from a stream. If isEncoded is set, the image is
+   * decoded to its original size.
+   * @param stream The stream from which the object is read.
+   */
+  void read(In& stream) override;
+
   /**
-   * Write this object to a stream.
+   * Write this object to a stream. If an encoding is set, only the pixels
+   * selected by it are written. Such an image must be sent as
+   * idEncodedDebugImage.
    * @param stream The stream to which the object is written.
    */
-  void write(Out& stream) const override
-  {
-    STREAM(type);
-    STREAM(width);
-    STREAM(height);
-
-    const size_t size = width * height * PixelTypes::pixelSize(type);
-    stream.write(data, size);
-  }
+  void write(Out& stream) const override;
 
 private:
   static void reg()
@@ -184,8 +208,21 @@ private:
   do \
     _SEND_DEBUG_IMAGE_EXPAND(_SEND_DEBUG_IMAGE_EXPAND(_SEND_DEBUG_IMAGE_THIRD(__VA_ARGS__, _SEND_DEBUG_IMAGE_WITH_METHOD, _SEND_DEBUG_IMAGE_WITHOUT_METHOD))(id, __VA_ARGS__)) \
     while(false)
-#define _SEND_DEBUG_IMAGE_WITHOUT_METHOD(id, image) DEBUG_RESPONSE("debug images:" id) OUTPUT(idDebugImage, bin, id << DebugImage(image));
-#define _SEND_DEBUG_IMAGE_WITH_METHOD(id, image, method) DEBUG_RESPONSE("debug images:" id) OUTPUT(idDebugImage, bin, id << DebugImage(image, method));
+#define _SEND_DEBUG_IMAGE_WITHOUT_METHOD(id, image) _SEND_DEBUG_IMAGE_ENCODED(id, DebugImage(image))
+#define _SEND_DEBUG_IMAGE_WITH_METHOD(id, image, method) _SEND_DEBUG_IMAGE_ENCODED(id, DebugImage(image, method))
+#define _SEND_DEBUG_IMAGE_ENCODED(id, debugImage) \
+  DEBUG_RESPONSE("debug images:" id) \
+  { \
+    thread_local DebugImageEncoding _encoding; \
+    MODIFY("debug images:" id, _encoding); \
+    if(_encoding.isDue()) \
+    { \
+      if(_encoding.isRaw()) \
+        OUTPUT(idDebugImage, bin, id << debugImage); \
+      else \
+        OUTPUT(idEncodedDebugImage, bin, id << debugImage.encode(_encoding)); \
+    } \
+  }
 
 #define _SEND_DEBUG_IMAGE_THIRD(first, second, third, ...) third
 #define _SEND_DEBUG_IMAGE_EXPAND(s) s // needed for Visual Studio
@@ -8,6 +8,12 @@
 
 #include "TcpConnection.h"
 #include "Platform/BHAssert.h"
+#include "Streaming/LZ4.h"
+#include <cstring>
+#include <limits>
+
+/** Packets smaller than this are not compressed. */
+static constexpr int minCompressedSize = 256;
 
 void TcpConnection::connect(const char* ip, int port, Handshake handshake, int maxPacketSendSize, int maxPacketReceiveSize)
 {
@@ -48,8 +54,26 @@ bool TcpConnection::sendAndReceive(const unsigned char* dataToSend, int sendSize
   if((handshake != receiver || ack) &&
      isConnected() && sendSize > 0)
   {
-    if(tcpComm->send(reinterpret_cast<unsigned char*>(&sendSize), sizeof(sendSize)) && // sends size of block
-       tcpComm->send(dataToSend, sendSize))                           // sends data
+    // Compress larger packets. The uncompressed size precedes the compressed data.
+    // A negative size marks the packet as compressed.
+    const unsigned char* data = dataToSend;
+    int size = sendSize;
+    int header = sendSize;
+    if(sendSize >= minCompressedSize)
+    {
+      compressed.resize(sizeof(int) + LZ4::compressBound(sendSize));
+      std::memcpy(compressed.data(), &sendSize, sizeof(sendSize));
+      const std::size_t compressedSize = sizeof(int) + LZ4::compress(dataToSend, sendSize, compressed.data() + sizeof(int));
+      if(compressedSize < static_cast<std::size_t>(sendSize))
+      {
+        data = compressed.data();
+        size = static_cast<int>(compressedSize);
+        header = -size;
+      }
+    }
+
+    if(tcpComm->send(reinterpret_cast<unsigned char*>(&header), sizeof(header)) && // sends size of block
+       tcpComm->send(data, size))                                                 // sends data
     {
       ack = false;
       return true;
@@ -77,6 +101,29 @@ int TcpConnection::receive(unsigned char*& buffer)
       ack = true;
       return 0; // nothing to read (maybe heartbeat)
     }
+    else if(size < 0)
+    {
+      // A compressed packet: the uncompressed size is followed by the compressed data.
+      // -size would overflow for the smallest int.
+      int uncompressedSize;
+      if(size == std::numeric_limits<int>::min() || -size <= static_cast<int>(sizeof(uncompressedSize)) || -size > MAX_PACKAGE_SIZE)
+        return -1;
+      compressed.resize(-size);
+      if(!tcpComm->receive(compressed.data(), -size, true))
+        return -1;
+      std::memcpy(&uncompressedSize, compressed.data(), sizeof(uncompressedSize));
+      if(uncompressedSize <= 0 || uncompressedSize > MAX_PACKAGE_SIZE)
+        return -1;
+
+      buffer = new unsigned char[uncompressedSize];
+      if(!LZ4::decompress(compressed.data() + sizeof(uncompressedSize), -size - sizeof(uncompressedSize), buffer, uncompressedSize))
+      {
+        delete[] buffer;
+        return -1;
+      }
+      ack = true;
+      return uncompressedSize;
+    }
     else
     {
       // prevent from allocating too much buffer
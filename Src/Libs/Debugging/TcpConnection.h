@@ -10,12 +10,15 @@
 
 #include "Network/TcpComm.h"
 #include <memory>
+#include <vector>
 
 #define MAX_PACKAGE_SIZE 67108864 // max packet size that can be received. prevent from allocating too much buffer (max ~64 MB)
 
 /**
  * @class TcpConnection
  * The class implements a tcp connection.
+ * Larger packets are sent compressed (LZ4). They are marked by a negative
+ * size and are decompressed transparently when received.
  */
 class TcpConnection
 {
@@ -32,6 +35,7 @@ private:
   bool ack = false;
   bool client = false;;
   Handshake handshake = noHandshake; /**< The handshake mode. */
+  std::vector<unsigned char> compressed; /**< A buffer for compressing packets to be sent. */
 
 public:
   TcpConnection() = default;
@@ -107,6 +111,14 @@ public:
    */
   int getOverallBytesReceived() const { return tcpComm ? tcpComm->getOverallBytesReceived() : 0; }
 
+  /**
+   * The function states whether the communication partner has answered since
+   * the last packet was sent. In handshake mode "receiver", no further packet
+   * can be sent before that happened.
+   * @return Was the last packet sent acknowledged?
+   */
+  bool isAcknowledged() const { return ack; }
+
   /**
    * The functions sends a heartbeat.
    * @return Was the heartbeat successfully sent?
@@ -109,6 +109,9 @@ bool Debug::main()
     stream << moduleGraphCreator->config;
   }
 
+  DEBUG_RESPONSE_ONCE("debug:memoryUsage")
+    sendMemoryUsage();
+
   DEBUG_RESPONSE_ONCE("moduleGraph:moduleOrder")
   {
     // Shows the execution order of all threads.
@@ -133,8 +136,8 @@ bool Debug::main()
       for(std::size_t j = 0; j < moduleGraphCreator->received[i].size(); j++)
       {
         text.append("\n  " + moduleGraphCreator->config.threads[j].name + ":");
-        for(const std::string& rep : moduleGraphCreator->received[i][j])
-          text.append("\n    " + rep);
+        for(const char* rep : moduleGraphCreator->received[i][j])
+          text.append(std::string("\n    ") + rep);
       }
       text.append("\n");
     }
@@ -191,32 +194,37 @@ bool Debug::main()
 
 void Debug::removeRepetitions()
 {
-  std::unordered_map<std::string, std::array<size_t, numOfMessageIDs>> messagesPerTypeAndThread;
-  std::unordered_map<std::string, std::unordered_map<std::string, size_t>> debugDataPerIdAndThread;
-  std::string thread = "unknown";
-  std::string id;
+  for(MessageCounts& counts : messageCounts)
+  {
+    counts.messagesPerType.fill(0);
+    counts.debugDataPerId.assign(counts.debugDataPerId.size(), 0);
+  }
+  debugDataIdsInQueue.clear();
 
-  size_t* messagesPerType = messagesPerTypeAndThread[thread].data();
-  std::unordered_map<std::string, size_t>* debugDataPerId = &debugDataPerIdAndThread[thread];
+  MessageCounts* counts = &getMessageCounts("unknown");
   for(MessageQueue::Message message : *debugSender)
   {
     if(message.id() == idFrameBegin)
     {
-      message.bin() >> thread;
-      messagesPerType = messagesPerTypeAndThread[thread].data();
-      debugDataPerId = &debugDataPerIdAndThread[thread];
+      message.bin() >> messageThread;
+      counts = &getMessageCounts(messageThread);
     }
     if(message.id() == idDebugDataResponse)
     {
-      message.bin() >> id;
-      ++(*debugDataPerId)[id];
+      // The string id is only looked up once. The filter below uses the interned id recorded here.
+      message.bin() >> messageId;
+      const unsigned id = debugDataIds.try_emplace(messageId, static_cast<unsigned>(debugDataIds.size())).first->second;
+      debugDataIdsInQueue.push_back(id);
+      if(id >= counts->debugDataPerId.size())
+        counts->debugDataPerId.resize(id + 1, 0);
+      ++counts->debugDataPerId[id];
     }
     else
-      ++messagesPerType[message.id()];
+      ++counts->messagesPerType[message.id()];
   }
 
-  messagesPerType = messagesPerTypeAndThread["unknown"].data();
-  debugDataPerId = &debugDataPerIdAndThread["unknown"];
+  counts = &getMessageCounts("unknown");
+  auto debugDataId = debugDataIdsInQueue.begin();
   size_t originalSize = 0;
   size_t sizeAfterFrameBegin = 0;
 
@@ -227,14 +235,13 @@ void Debug::removeRepetitions()
     {
       case idFrameBegin:
         originalSize = debugSender->size();
-        message.bin() >> thread;
+        message.bin() >> messageThread;
         sizeAfterFrameBegin = debugSender->size();
-        messagesPerType = messagesPerTypeAndThread[thread].data();
-        debugDataPerId = &debugDataPerIdAndThread[thread];
+        counts = &getMessageCounts(messageThread);
         return true;
 
       case idFrameFinished:
-        --messagesPerType[idFrameFinished];
+        --counts->messagesPerType[idFrameFinished];
         if(debugSender->size() == sizeAfterFrameBegin)
         {
           debugSender->resize(originalSize);
@@ -244,7 +251,7 @@ void Debug::removeRepetitions()
           return true;
 
       case idText:
-        return --messagesPerType[idText] <= 20;
+        return --counts->messagesPerType[idText] <= 20;
 
       // accept always, thread id is not important
       case idNumOfDataMessageIDs:
@@ -260,25 +267,48 @@ void Debug::removeRepetitions()
 
       // only the latest messages for debug data per id
       case idDebugDataResponse:
-        message.bin() >> id;
-        return --(*debugDataPerId)[id] == 0;
+        return --counts->debugDataPerId[*debugDataId++] == 0;
 
       // only the latest messages for infrastructure
       default:
         if(message.id() >= numOfDataMessageIDs)
-          return --messagesPerType[message.id()] == 0;
+          return --counts->messagesPerType[message.id()] == 0;
         [[fallthrough]];
 
       // data only from latest frame
       case idStopwatch:
       case idDebugImage:
+      case idEncodedDebugImage:
       case idDebugDrawing:
       case idDebugDrawing3D:
-        return messagesPerType[idFrameFinished] == 1;
+        return counts->messagesPerType[idFrameFinished] == 1;
     }
   });
 }
 
+Debug::MessageCounts& Debug::getMessageCounts(const std::string& thread)
+{
+  for(MessageCounts& counts : messageCounts)
+    if(counts.thread == thread)
+      return counts;
+  messageCounts.emplace_back();
+  messageCounts.back().thread = thread;
+  messageCounts.back().messagesPerType.fill(0);
+  return messageCounts.back();
+}
+
+void Debug::sendMemoryUsage()
+{
+  std::string text = "Peak memory usage: " + std::to_string(SystemCall::getPeakMemoryUsage() / 1024) + " KB";
+  for(const DebugReceiver<MessageQueue>& receiver : receivers)
+    text += "\n  " + receiver.senderThreadName + " -> " + getName() + ": " + std::to_string(receiver.peakSize() / 1024)
+            + " of " + std::to_string(receiver.maxSize() / 1024) + " KB";
+  for(const DebugSender<MessageQueue>& sender : senders)
+    text += "\n  " + getName() + " -> " + sender.receiverThreadName + ": " + std::to_string(sender.peakSize() / 1024)
+            + " of " + std::to_string(sender.maxSize() / 1024) + " KB";
+  OUTPUT_TEXT(text);
+}
+
 bool Debug::handleMessage(const MessageQueue::Message message)
 {
   switch(message.id())
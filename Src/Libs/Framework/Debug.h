@@ -19,7 +19,9 @@
 #include "Framework/ModuleGraphCreator.h"
 #include "Framework/ThreadFrame.h"
 
+#include <array>
 #include <unordered_map>
+#include <vector>
 
 /**
  * @class Debug
@@ -44,6 +46,20 @@ private:
   std::list<DebugSender<MessageQueue>> senders; /**< The list of all senders of this thread. */
   std::unordered_map<std::string, DebugSender<MessageQueue>*> senderMap;
 
+  /** The number of messages per type of a thread found in the outgoing queue. */
+  struct MessageCounts
+  {
+    std::string thread; /**< The name of the thread. */
+    std::array<size_t, numOfMessageIDs> messagesPerType; /**< The number of messages per message id. */
+    std::vector<size_t> debugDataPerId; /**< The number of debug data responses per interned debug data id. */
+  };
+
+  std::vector<MessageCounts> messageCounts; /**< The message counts of all threads. Kept between cycles to avoid allocations. */
+  std::unordered_map<std::string, unsigned> debugDataIds; /**< Interned debug data ids. Only grows when a new id shows up. */
+  std::vector<unsigned> debugDataIdsInQueue; /**< The interned ids of all debug data responses in the outgoing queue in their order. */
+  std::string messageThread; /**< Buffer for reading thread names in removeRepetitions(). */
+  std::string messageId; /**< Buffer for reading debug data ids in removeRepetitions(). */
+
   std::unique_ptr<ModuleGraphCreator> moduleGraphCreator; /**< Calculates the execution order of the modules of all threads and their data exchange. */
   Configuration config; /**< The initial configuration of all threads. */
 
@@ -55,6 +71,16 @@ private:
    */
   void removeRepetitions();
 
+  /**
+   * Returns the message counts of a thread. They are created if they did not exist yet.
+   * @param thread The name of the thread.
+   * @return The message counts of that thread.
+   */
+  MessageCounts& getMessageCounts(const std::string& thread);
+
+  /** Sends the peak memory usage of this process and the peak sizes of the debug queues. */
+  void sendMemoryUsage();
+
 public:
   /**
    * The constructor.
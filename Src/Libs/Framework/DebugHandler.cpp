@@ -9,20 +9,74 @@
 #ifdef TARGET_ROBOT
 #include "DebugHandler.h"
 #include "Platform/BHAssert.h"
+#include "Platform/Time.h"
 #include "Streaming/InStreams.h"
 #include "Streaming/OutStreams.h"
+#include <algorithm>
+#include <array>
 #include <limits>
 
 DebugHandler::DebugHandler(MessageQueue& in, MessageQueue& out, int maxPacketSendSize, int maxPacketReceiveSize) :
   TcpConnection(0, 9999, TcpConnection::receiver, maxPacketSendSize, maxPacketReceiveSize),
   in(in),
-  out(out)
+  out(out),
+  budget(std::numeric_limits<size_t>::max())
 {}
 
+DebugHandler::Priority DebugHandler::getPriority(MessageID id)
+{
+  switch(id)
+  {
+    case idCameraImage:
+    case idJPEGImage:
+    case idDebugImage:
+    case idEncodedDebugImage:
+      return images;
+    case idDebugDrawing:
+    case idDebugDrawing3D:
+      return drawings;
+    default:
+      return others;
+  }
+}
+
+void DebugHandler::reduceToBudget()
+{
+  std::array<size_t, numOfPriorities> sizes;
+  sizes.fill(0);
+  for(MessageQueue::Message message : out)
+    sizes[getPriority(message.id())] += sizeof(MessageQueue::MessageHeader) + message.size();
+
+  // All messages with a priority of at least "level" fit. Messages with the
+  // priority directly below are kept in order as long as there is room left.
+  int level = others;
+  size_t used = sizes[others];
+  while(level > 0 && used + sizes[level - 1] <= budget)
+    used += sizes[--level];
+  size_t remaining = budget > used ? budget - used : 0;
+
+  out.filter([&](MessageQueue::const_iterator i)
+  {
+    const MessageQueue::Message message = *i;
+    const int priority = getPriority(message.id());
+    if(priority >= level)
+      return true;
+    const size_t size = sizeof(MessageQueue::MessageHeader) + message.size();
+    if(priority == level - 1 && size <= remaining)
+    {
+      remaining -= size;
+      return true;
+    }
+    return false;
+  });
+}
+
 void DebugHandler::communicate(bool send)
 {
   if(send && !sendData && !out.empty())
   {
+    if(out.size() > budget)
+      reduceToBudget();
     sendSize = out.size() + 8;
     OutBinaryMemory memory(sendSize);
     memory << out;
@@ -34,8 +88,23 @@ void DebugHandler::communicate(bool send)
   int receivedSize = 0;
 
   ASSERT(sendSize <= std::numeric_limits<int>::max());
-  if(sendAndReceive(sendData, static_cast<int>(sendSize), receivedData, receivedSize) && sendSize)
+  const bool sent = sendAndReceive(sendData, static_cast<int>(sendSize), receivedData, receivedSize) && sendSize;
+
+  // Adapt the budget to how long the remote side needed to acknowledge the previous packet.
+  if(sizeInFlight && (sent || isAcknowledged()))
+  {
+    const int roundTripTime = Time::getTimeSince(sendTimestamp);
+    if(roundTripTime > maxRoundTripTime)
+      budget = std::max(minBudget, sizeInFlight * maxRoundTripTime / roundTripTime);
+    else if(budget < out.maxSize())
+      budget = std::min(out.maxSize(), budget + budget / 4);
+    sizeInFlight = 0;
+  }
+
+  if(sent)
   {
+    sizeInFlight = isConnected() ? sendSize : 0;
+    sendTimestamp = Time::getCurrentSystemTime();
     delete [] sendData;
     sendData = nullptr;
     sendSize = 0;
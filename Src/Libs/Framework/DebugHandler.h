@@ -1,7 +1,10 @@
 /**
  * @file DebugHandler.h
  *
- * Class for debug communication over a TCP connection
+ * Class for debug communication over a TCP connection.
+ * The size of the packets sent is adapted to the time the remote side needs
+ * to acknowledge them. If the outgoing queue exceeds that size, debug images
+ * and then debug drawings are dropped first.
  *
  * @author Thomas Röfer
  */
@@ -15,11 +18,39 @@
 class DebugHandler : public TcpConnection
 {
 private:
+  /** The priorities of messages when packets must be reduced in size. */
+  enum Priority
+  {
+    images, /**< Debug images and images requested as representations. */
+    drawings, /**< Debug drawings. */
+    others, /**< Everything else, e.g. stopwatches, plots, and texts. It is never dropped. */
+    numOfPriorities
+  };
+
+  static constexpr int maxRoundTripTime = 200; /**< Packets acknowledged slower than this reduce the packet budget (in ms). */
+  static constexpr size_t minBudget = 1000000; /**< The packet budget will not be reduced below this size (in bytes). */
+
   MessageQueue& in; /**< Incoming debug data is stored here. */
   MessageQueue& out; /**< Outgoing debug data is stored here. */
 
   unsigned char* sendData = nullptr; /**< The data to send next. */
   size_t sendSize = 0; /**< The size of the data to send next. */
+  size_t budget; /**< The maximum size of the next packet before messages are dropped (uncompressed, in bytes). */
+  size_t sizeInFlight = 0; /**< The size of the packet waiting for an acknowledgement (uncompressed, in bytes). 0 if there is none. */
+  unsigned sendTimestamp = 0; /**< When was the packet waiting for an acknowledgement sent? */
+
+  /**
+   * Determines the priority of a message.
+   * @param id The id of the message.
+   * @return The priority.
+   */
+  static Priority getPriority(MessageID id);
+
+  /**
+   * Drops messages of low priorities from the outgoing queue until it fits
+   * into the current packet budget.
+   */
+  void reduceToBudget();
 
 public:
   /**
@@ -10,6 +10,7 @@
 #include "ModuleGraphRunner.h"
 #ifdef TARGET_ROBOT
 #include "Platform/Time.h"
+#include <chrono>
 #endif
 
 thread_local ModuleGraphRunner* ModuleGraphRunner::instance = nullptr;
@@ -82,6 +83,7 @@ void ModuleGraphRunner::update(In& stream)
   }
 
   validConfiguration = true;
+  ++configurationVersion;
   stream >> nextTimestamp; // Use this timestamp after execute was called
   this->timestamp = 0; // Invalid until execute was called
 }
@@ -97,12 +99,14 @@ void ModuleGraphRunner::execute()
     if(!p.moduleState->instance)
       p.moduleState->instance = p.moduleState->module->createNew();
 #ifdef TARGET_ROBOT
-    unsigned timestamp = Time::getCurrentSystemTime();
+    const auto start = std::chrono::steady_clock::now();
 #endif
     if(p.moduleState->instance)
       p.update(*p.moduleState->instance);
 #ifdef TARGET_ROBOT
-    int duration = Time::getTimeSince(timestamp);
+    p.duration = static_cast<unsigned>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+    const unsigned timestamp = Time::getCurrentSystemTime();
+    const int duration = static_cast<int>(p.duration / 1000);
     if(timestamp > 110000 &&
        ((duration > 100 &&
          !Global::getDebugRequestTable().isActive("representation:JPEGImage") &&
@@ -51,6 +51,7 @@ private:
     const char* representation; /**< The representation that will be provided. */
     ModuleState* moduleState; /**< The moduleState that will give access to the module that provides the information. */
     void (*update)(Streamable&); /**< The update handler within the module. */
+    unsigned duration = 0; /**< The wall time the last update took (in µs). Only measured on the robot. */
 
     /**
      * Constructor.
@@ -78,6 +79,7 @@ private:
 
   unsigned timestamp = 0; /**< The timestamp of the last module request. Communication is only possible if both sides use the same timestamp. */
   unsigned nextTimestamp = 0; /**< The next timestamp used to verify communication. */
+  unsigned configurationVersion = 0; /**< Counts the module configurations received. */
 
 public:
   /**
@@ -117,6 +119,13 @@ public:
    */
   bool hasChanged() const { return !timestamp; }
 
+  /**
+   * Returns a number that changes whenever a new module configuration was
+   * received. It allows caching information derived from the configuration.
+   * @return The version of the module configuration.
+   */
+  unsigned getConfigurationVersion() const { return configurationVersion; }
+
   /**
    * The function destroys all modules. It can be called to destroy the modules
    * before the destructor is called.
@@ -134,6 +143,17 @@ public:
    */
   void execute();
 
+  /**
+   * Calls a function for each provider executed with the time its last
+   * update took. The times are only measured on the robot and are 0 otherwise.
+   * @param f The function called as f(const char* representation, unsigned duration in µs).
+   */
+  template<typename F> void forEachProviderDuration(F f) const
+  {
+    for(const Provider& p : providers)
+      f(p.representation, p.duration);
+  }
+
   /**
    * The function reads a packet from a stream.
    * @param stream A stream containing representations received from another thread.
@@ -8,21 +8,28 @@
 
 #include "Resize.h"
 #include "ImageProcessing/SIMD.h"
+#include "Platform/BHAssert.h"
+#include <algorithm>
 #include <array>
+#include <cstring>
 
-void Resize::shrinkY(const unsigned int downScales, const Image<PixelTypes::GrayscaledPixel>& src, PixelTypes::GrayscaledPixel* dest)
+/**
+ * Shrinks consecutive pixels horizontally by 2^downScales.
+ * @param downScales The number of times the width is halved.
+ * @param pSrc The pixels to shrink. They must be 16-byte aligned.
+ * @param size The number of pixels. The size of each step must be
+ *             divisible by 128 (3 halvings) or 64 (less halvings).
+ * @param dest The shrunk pixels are written here. It must be 16-byte aligned
+ *             and provide space for size / 2 pixels, because intermediate
+ *             results are also stored there.
+ */
+static void shrinkYHorizontally(const unsigned int downScales, const __m128i* pSrc, size_t size, PixelTypes::GrayscaledPixel* dest)
 {
-  const __m128i* pSrc = reinterpret_cast<const __m128i*>(src[0]);
-
-  size_t srcWidth = src.width;
-  size_t srcHeight = src.height;
-
-  // Shrink horizontally
   size_t downScalesLeft = downScales;
   for(; downScalesLeft > 2; downScalesLeft -= 3)
   {
     __m128i* pDest = reinterpret_cast<__m128i*>(dest);
-    for(size_t n = srcWidth * srcHeight / (8 * 16); n; --n)
+    for(size_t n = size / (8 * 16); n; --n)
     {
       const __m128i shrunk = _mm_packus_epi16(
                                _mm_srli_epi16(
@@ -55,13 +62,13 @@ void Resize::shrinkY(const unsigned int downScales, const Image<PixelTypes::Gray
       pSrc += 8;
       _mm_store_si128(pDest++, shrunk);
     }
-    srcWidth >>= 3;
+    size >>= 3;
     pSrc = reinterpret_cast<const __m128i*>(dest);
   }
   if(downScalesLeft > 1)
   {
     __m128i* pDest = reinterpret_cast<__m128i*>(dest);
-    for(size_t n = srcWidth * srcHeight / (4 * 16); n; --n)
+    for(size_t n = size / (4 * 16); n; --n)
     {
       __m128i p0 = _mm_load_si128(pSrc);
       const __m128i p1 = _mm_load_si128(pSrc + 1);
@@ -85,14 +92,14 @@ void Resize::shrinkY(const unsigned int downScales, const Image<PixelTypes::Gray
                       )
                      );
     }
-    srcWidth >>= 2;
+    size >>= 2;
     pSrc = reinterpret_cast<const __m128i*>(dest);
     downScalesLeft -= 2;
   }
   if(downScalesLeft)
   {
     __m128i* pDest = reinterpret_cast<__m128i*>(dest);
-    for(size_t n = srcWidth * srcHeight / (4 * 16); n; --n)
+    for(size_t n = size / (4 * 16); n; --n)
     {
       const __m128i p0 = _mm_load_si128(pSrc);
       const __m128i p1 = _mm_load_si128(pSrc + 1);
@@ -112,11 +119,19 @@ void Resize::shrinkY(const unsigned int downScales, const Image<PixelTypes::Gray
                      );
       pDest += 2;
     }
-    srcWidth >>= 1;
   }
+}
+
+void Resize::shrinkY(const unsigned int downScales, const Image<PixelTypes::GrayscaledPixel>& src, PixelTypes::GrayscaledPixel* dest)
+{
+  // Shrink horizontally
+  shrinkYHorizontally(downScales, reinterpret_cast<const __m128i*>(src[0]), src.width * src.height, dest);
+  size_t srcWidth = src.width >> downScales;
+  size_t srcHeight = src.height;
+  const __m128i* pSrc;
 
   // Shrink vertically
-  downScalesLeft = downScales;
+  size_t downScalesLeft = downScales;
   if(size_t overshoot = srcWidth % 16) // Row does not fit into SSE registers
   {
     overshoot = 16 - overshoot;
@@ -206,6 +221,122 @@ void Resize::shrinkY(const unsigned int downScales, const Image<PixelTypes::Gray
   }
 }
 
+/**
+ * Averages two rows of pixels, rounding up like _mm_avg_epu8.
+ * @param a The first row. The result is also written here.
+ * @param b The second row.
+ * @param width The number of pixels per row.
+ */
+static void averageRows(PixelTypes::GrayscaledPixel* a, const PixelTypes::GrayscaledPixel* b, const size_t width)
+{
+  size_t x = 0;
+  for(; x + 16 <= width; x += 16)
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(a + x),
+                     _mm_avg_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + x)),
+                                  _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + x))));
+  for(; x < width; ++x)
+    a[x] = static_cast<PixelTypes::GrayscaledPixel>((a[x] + b[x] + 1) >> 1);
+}
+
+void Resize::shrinkYInterleaved(const unsigned int downScales, std::initializer_list<const Image<PixelTypes::GrayscaledPixel>*> planes,
+                                PixelTypes::GrayscaledPixel* dest)
+{
+  ASSERT(planes.size() > 0);
+  ASSERT(planes.size() <= 3);
+  const Image<PixelTypes::GrayscaledPixel>& first = **planes.begin();
+  const size_t destWidth = first.width >> downScales;
+  const size_t destHeight = first.height >> downScales;
+  const size_t numOfPlanes = planes.size();
+
+  // Smaller planes are shrunk less, so that all results have the same size.
+  std::array<unsigned, 3> planeDownScales;
+  size_t maxBlockSize = 0;
+  size_t plane = 0;
+  for(const Image<PixelTypes::GrayscaledPixel>* image : planes)
+  {
+    unsigned& scales = planeDownScales[plane++];
+    for(scales = downScales; scales && image->width >> scales < destWidth; --scales);
+    ASSERT(image->width >> scales == destWidth && image->height >> scales == destHeight);
+    ASSERT(image->width % 16 == 0);
+    const size_t blockSize = static_cast<size_t>(image->width) << scales;
+    ASSERT(!scales || blockSize % (scales > 2 ? 128 : 64) == 0);
+    maxBlockSize = std::max(maxBlockSize, blockSize);
+  }
+
+  // Each block of rows that forms one row of the result is shrunk horizontally into a buffer
+  // that stays in the cache. The rows are then combined vertically in the same order as in
+  // shrinkY and the result is interleaved into the destination.
+  thread_local Image<PixelTypes::GrayscaledPixel> buffer;
+  buffer.setResolution(static_cast<unsigned>(maxBlockSize / 2 + destWidth * numOfPlanes), 1);
+  PixelTypes::GrayscaledPixel* const rows = buffer[0];
+  PixelTypes::GrayscaledPixel* const shrunk = rows + maxBlockSize / 2;
+
+  // Shuffle masks that pick the bytes of three planes for each of the three output registers.
+  struct InterleaveMasks
+  {
+    alignas(16) char masks[9][16];
+  };
+  static const InterleaveMasks interleaveMasks = []
+  {
+    InterleaveMasks result;
+    for(int i = 0; i < 3; ++i)
+      for(int plane = 0; plane < 3; ++plane)
+        for(int j = 0; j < 16; ++j)
+          result.masks[i * 3 + plane][j] = (i * 16 + j) % 3 == plane ? static_cast<char>((i * 16 + j) / 3) : -1;
+    return result;
+  }();
+  const auto mask = [](int index) {return _mm_load_si128(reinterpret_cast<const __m128i*>(interleaveMasks.masks[index]));};
+
+  for(size_t y = 0; y < destHeight; ++y)
+  {
+    plane = 0;
+    for(const Image<PixelTypes::GrayscaledPixel>* image : planes)
+    {
+      const unsigned scales = planeDownScales[plane];
+      if(!scales)
+      {
+        std::memcpy(shrunk + plane++ * destWidth, (*image)[y], destWidth);
+        continue;
+      }
+      shrinkYHorizontally(scales, reinterpret_cast<const __m128i*>((*image)[y << scales]), static_cast<size_t>(image->width) << scales, rows);
+
+      size_t numOfRows = size_t(1) << scales;
+      size_t downScalesLeft = scales;
+      for(; downScalesLeft > 1; downScalesLeft -= 2, numOfRows >>= 2)
+        for(size_t row = 0; row < numOfRows / 4; ++row)
+        {
+          PixelTypes::GrayscaledPixel* const p0 = rows + row * 4 * destWidth;
+          averageRows(p0, p0 + destWidth, destWidth);
+          averageRows(p0 + 2 * destWidth, p0 + 3 * destWidth, destWidth);
+          averageRows(p0, p0 + 2 * destWidth, destWidth);
+          if(row)
+            std::memcpy(rows + row * destWidth, p0, destWidth);
+        }
+      if(downScalesLeft)
+        averageRows(rows, rows + destWidth, destWidth);
+      std::memcpy(shrunk + plane++ * destWidth, rows, destWidth);
+    }
+
+    PixelTypes::GrayscaledPixel* pDest = dest + y * destWidth * numOfPlanes;
+    size_t x = 0;
+    if(numOfPlanes == 3)
+      for(; x + 16 <= destWidth; x += 16, pDest += 48)
+      {
+        const __m128i p0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shrunk + x));
+        const __m128i p1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shrunk + destWidth + x));
+        const __m128i p2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shrunk + 2 * destWidth + x));
+        for(int i = 0; i < 3; ++i)
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(pDest) + i,
+                           _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(p0, mask(i * 3)),
+                                                     _mm_shuffle_epi8(p1, mask(i * 3 + 1))),
+                                        _mm_shuffle_epi8(p2, mask(i * 3 + 2))));
+      }
+    for(; x < destWidth; ++x)
+      for(size_t plane = 0; plane < numOfPlanes; ++plane)
+        *pDest++ = shrunk[plane * destWidth + x];
+  }
+}
+
 void Resize::shrinkUV(const unsigned int downScales, const Image<PixelTypes::YUYVPixel>& src, unsigned short* dest)
 {
   const size_t srcSize = src.width * src.height * 2;
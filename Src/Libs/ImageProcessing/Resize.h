@@ -10,6 +10,7 @@
 
 #include "ImageProcessing/Image.h"
 #include "ImageProcessing/PixelTypes.h"
+#include <initializer_list>
 
 namespace Resize
 {
@@ -22,6 +23,23 @@ namespace Resize
     shrinkY(downScales, src, dest[0]);
   }
 
+  /**
+   * Shrinks up to three planes like \c shrinkY and writes them
+   * interleaved into the destination, i.e. all values of the first pixel,
+   * then all values of the second pixel, etc. The results are identical to
+   * shrinking each plane separately and interleaving the results afterwards,
+   * but each plane is only read once and the intermediate results stay in the
+   * cache. This is suitable to fill the input of a neural network.
+   * @param downScales The number of times the width and height of the first plane are halved.
+   * @param planes The planes. Their width must be a multiple of 16. Planes that are smaller
+   *               than the first one by a power of two, e.g. chroma planes of half the size,
+   *               are halved fewer times, so that all results have the same size.
+   * @param dest The interleaved result. It only needs to provide space for the
+   *             shrunk planes.
+   */
+  void shrinkYInterleaved(const unsigned int downScales, std::initializer_list<const Image<PixelTypes::GrayscaledPixel>*> planes,
+                          PixelTypes::GrayscaledPixel* dest);
+
   void shrinkUV(const unsigned int downScales, const Image<PixelTypes::YUYVPixel>& src, unsigned short* dest);
 
   inline void shrinkUV(const unsigned int downScales, const Image<PixelTypes::YUYVPixel>& src, Image<unsigned short>& dest)
@@ -67,11 +67,13 @@ namespace ImageExport
    * @param outDevice The I/O device to write to.
    * @param fileFormat The name of the target format ("PNG", "JPG", ...)
    * @param mode Keep Raw ? Convert to RGB? Convert to Gray?
+   * @param quality The quality (0 = smallest ... 100 = largest file) or -1 for the default
+   *                of the file format. For PNG, higher values compress faster.
    * @return Was writing successful?
    */
   template<typename Pixel>
   inline bool exportImage(const Image<Pixel>& image, QIODevice& outDevice, const char* fileFormat,
-                          const ExportMode mode = raw)
+                          const ExportMode mode = raw, const int quality = -1)
   {
     QImage::Format format = (mode == grayscale) ? QImage::Format_Grayscale8 : QImage::Format_RGB888;
     QImage img(image.width * Pixel::numPixel(), image.height, format);
@@ -91,7 +93,7 @@ namespace ImageExport
             pSrc->raw(p);
         }
     }
-    return img.save(&outDevice, fileFormat);
+    return img.save(&outDevice, fileFormat, quality);
   }
 
   /**
@@ -618,3 +618,22 @@ Out& operator<<(Out& stream, const Eigen::AngleAxis<T>& angleAxis)
 
   return stream;
 }
+
+namespace Streaming
+{
+  /**
+   * Fixed-size Eigen matrices, 2D arrays, and quaternions are streamed in
+   * the order of their coefficients in memory, i.e. they can be written to
+   * binary streams as a whole if their elements can.
+   */
+  template<typename T, int ROWS, int COLS, int OPTIONS>
+  struct IsRawBinary<Eigen::Matrix<T, ROWS, COLS, OPTIONS, ROWS, COLS>> : std::bool_constant<
+    ROWS != Eigen::Dynamic && COLS != Eigen::Dynamic && IsRawBinary<T>::value &&
+    sizeof(Eigen::Matrix<T, ROWS, COLS, OPTIONS, ROWS, COLS>) == sizeof(T) * ROWS * COLS> {};
+  template<typename T, int OPTIONS>
+  struct IsRawBinary<Eigen::Array<T, 2, 1, OPTIONS, 2, 1>> : std::bool_constant<
+    IsRawBinary<T>::value && sizeof(Eigen::Array<T, 2, 1, OPTIONS, 2, 1>) == sizeof(T) * 2> {};
+  template<typename T, int OPTIONS>
+  struct IsRawBinary<Eigen::Quaternion<T, OPTIONS>> : std::bool_constant<
+    IsRawBinary<T>::value && sizeof(Eigen::Quaternion<T, OPTIONS>) == sizeof(T) * 4> {};
+}
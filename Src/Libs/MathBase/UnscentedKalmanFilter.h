@@ -14,6 +14,7 @@
 #include "Platform/BHAssert.h"
 
 #include <functional>
+#include <iterator>
 #include <limits>
 
 /**
@@ -42,6 +43,53 @@ namespace impl
     static State run(const Array& sigmaPoints);
   };
 
+  /**
+   * A helper function to validate if a covariance is still a covariance.
+   * The validation is done via asserts.
+   * @param cov, the covariance to check
+   */
+  template<unsigned DOF>
+  inline void covarianceMatrixValidation([[maybe_unused]] const Eigen::Matrix<float, DOF, DOF>& cov)
+  {
+    for(unsigned i = 0; i < DOF; ++i)
+    {
+      ASSERT(cov(i, i) > 0.f);
+      ASSERT(std::isfinite(cov(i, i)));
+      ASSERT(std::isnormal(cov(i, i)));
+
+      for(unsigned j = i + 1; j < DOF; ++j)
+      {
+        ASSERT(cov(i, j) == cov(j, i));
+        ASSERT(std::isfinite(cov(j, i)));
+      }
+    }
+  }
+
+  /**
+   * A helper function to fix a covariance by forcing the symmetric property.
+   * @param cov, the covariance to fix
+   */
+  template<unsigned DOF>
+  inline void fixCovarianceMatrix(Eigen::Matrix<float, DOF, DOF>& cov)
+  {
+    constexpr float covOffset = 1e-7f;
+
+    float smallestCov = cov(0, 0);
+    for(unsigned i = 1; i < DOF; ++i)
+      smallestCov = std::min(smallestCov, cov(i, i));
+    if(smallestCov <= 0.f)
+      for(unsigned i = 0; i < DOF; ++i)
+        cov(i, i) += -smallestCov + covOffset;
+
+    for(unsigned i = 0; i < DOF; ++i)
+    {
+      for(unsigned j = i + 1; j < DOF; ++j)
+      {
+        cov(i, j) = cov(j, i) = (cov(i, j) + cov(j, i)) * .5f;
+      }
+    }
+  }
+
   /**
    * The class for the Unscented Kalman Filter for hypotheses generation by using
    * Kalman filtering using Sigma Points.
@@ -64,7 +112,6 @@ namespace impl
 
   private:
     SigmaArray<State> sigmaPoints; // The array for the sigma points
-    static constexpr float covOffset = 1e-7f;
 
   public:
     /**
@@ -118,19 +165,6 @@ namespace impl
      * @return the state that is the new mean
      */
     State meanOfSigmaPoints() const;
-
-    /**
-     * A helper function to validate if a covariance is still a covariance.
-     * The validation is done via asserts.
-     * @param cov, the covariance to check
-     */
-    void covarianceMatrixValidation(const CovarianceType& cov) const;
-
-    /**
-     * A helper function to fix a covariance by forcing the symmetric property.
-     * @param cov, the covariance to fix
-     */
-    void fixCovarianceMatrix(CovarianceType& cov);
   };
 
   /**
@@ -185,8 +219,8 @@ namespace impl
     cov *= 0.5f;
     cov += noise;
 
-    fixCovarianceMatrix(cov);
-    covarianceMatrixValidation(cov);
+    fixCovarianceMatrix<DOF>(cov);
+    covarianceMatrixValidation<DOF>(cov);
   }
 
   /**
@@ -245,8 +279,8 @@ namespace impl
     mean += K * (measurement - z);
     cov -= K * sigmaZ * K.transpose();
 
-    fixCovarianceMatrix(cov);
-    covarianceMatrixValidation(cov);
+    fixCovarianceMatrix<DOF>(cov);
+    covarianceMatrixValidation<DOF>(cov);
   }
 
   /**
@@ -294,8 +328,8 @@ namespace impl
     mean += K * (measurement - z);
     cov -= K * sigmaZ * K.transpose();
 
-    fixCovarianceMatrix(cov);
-    covarianceMatrixValidation(cov);
+    fixCovarianceMatrix<DOF>(cov);
+    covarianceMatrixValidation<DOF>(cov);
   }
 
   /**
@@ -333,51 +367,6 @@ namespace impl
     return MeanOfSigmaPoints<State, DOF, SigmaArray<State>, IsManifold>::run(sigmaPoints);
   }
 
-  /**
-   * A helper function to validate if a covariance is still a covariance.
-   * The validation is done via asserts.
-   * @param cov, the covariance to check
-   */
-  template<typename State, unsigned DOF, bool IsManifold>
-  inline void UnscentedKalmanFilter<State, DOF, IsManifold>::covarianceMatrixValidation([[maybe_unused]] const CovarianceType& cov) const
-  {
-    for(unsigned i = 0; i < DOF; ++i)
-    {
-      ASSERT(cov(i, i) > 0.f);
-      ASSERT(std::isfinite(cov(i, i)));
-      ASSERT(std::isnormal(cov(i, i)));
-
-      for(unsigned j = i + 1; j < DOF; ++j)
-      {
-        ASSERT(cov(i, j) == cov(j, i));
-        ASSERT(std::isfinite(cov(j, i)));
-      }
-    }
-  }
-
-  /**
-   * A helper function to fix a covariance by forcing the symmetric property.
-   * @param cov, the covariance to fix
-   */
-  template<typename State, unsigned DOF, bool IsManifold>
-  inline void UnscentedKalmanFilter<State, DOF, IsManifold>::fixCovarianceMatrix(CovarianceType& cov)
-  {
-    float smallestCov = cov(0, 0);
-    for(unsigned i = 1; i < DOF; ++i)
-      smallestCov = std::min(smallestCov, cov(i, i));
-    if(smallestCov <= 0.f)
-      for(unsigned i = 0; i < DOF; ++i)
-        cov(i, i) += -smallestCov + covOffset;
-
-    for(unsigned i = 0; i < DOF; ++i)
-    {
-      for(unsigned j = i + 1; j < DOF; ++j)
-      {
-        cov(i, j) = cov(j, i) = (cov(i, j) + cov(j, i)) * .5f;
-      }
-    }
-  }
-
   /**
    * A struct to run a calculation of mean for given sigma points with manifold.
    */
@@ -430,6 +419,214 @@ namespace impl
       return sum / static_cast<float>(sigmaPoints.size());
     }
   };
+
+  /**
+   * A variant of the Unscented Kalman Filter for plain vector states. The models are
+   * passed as arbitrary callables that are inlined instead of being called through
+   * std::function, and the sigma points are kept in a single fixed-size matrix.
+   * The results are the same as the ones of UnscentedKalmanFilter<..., false>.
+   */
+  template<unsigned DOF>
+  class FixedUnscentedKalmanFilter
+  {
+  public:
+    static constexpr unsigned numOfSigmaPoints = DOF * 2 + 1;
+    using State = Eigen::Matrix<float, DOF, 1>; // The state vector
+    using CovarianceType = Eigen::Matrix<float, DOF, DOF>; // The covariance size to use
+    template<unsigned N>
+    using Vectorf = Eigen::Matrix<float, N, 1>; // The vector size to use
+
+  private:
+    template<unsigned N>
+    using SigmaMatrix = Eigen::Matrix<float, N, numOfSigmaPoints>; // The matrix type for the sigma points, one per column
+
+  public:
+    State mean; // The mean of the hypothesis that is generated
+    CovarianceType cov = CovarianceType::Zero(); // The covariance of the hypothesis to quantify the certainty
+
+  private:
+    SigmaMatrix<DOF> sigmaPoints; // The sigma points
+
+  public:
+    /**
+     * The constructor for the filter that requires an initial state to start with.
+     * @param initState, the state to initialize the filter
+     */
+    FixedUnscentedKalmanFilter(const State& initState) :
+      mean(initState)
+    {
+      sigmaPoints.colwise() = initState;
+    }
+
+    /**
+     * Initialization function to start the process. Setting the mean, covariance and sigma points.
+     * @param initState, the mean to be set
+     * @param initNoise, the noise (as a variance) to initialize the covariance
+     */
+    void init(const State& initState, const CovarianceType& initNoise)
+    {
+      mean = initState;
+      cov = initNoise;
+      sigmaPoints.colwise() = initState;
+    }
+
+    /**
+     * The prediction step to propagate the whole hypothesis with a given dynamic model and an operation specific noise.
+     * @param dynamicModel, a callable void(State&) to propagate the state
+     * @param noise, the propagation specific noise (as a variance) to quantify the uncertainty
+     */
+    template<typename DynamicModel>
+    void predict(const DynamicModel& dynamicModel, const CovarianceType& noise)
+    {
+      ASSERT((noise.array() >= 0.f).all());
+      ASSERT(noise.trace() > 0.f);
+      predictUnchecked(dynamicModel, noise);
+    }
+
+    /**
+     * The multi dimensional update step to integrate a measurement into an existing hypothesis.
+     * @param measurement, a vector that stores all relevant data of a measurement
+     * @param measurementModel, a callable Vectorf<N>(const State&) that returns a measurement for a state
+     * @param measurementNoise, the measurement specific noise (as a variance) to quantify the uncertainty
+     */
+    template<unsigned N, typename MeasurementModel>
+    void update(const Vectorf<N>& measurement, const MeasurementModel& measurementModel, const Eigen::Matrix<float, N, N>& measurementNoise)
+    {
+      ASSERT((measurementNoise.diagonal().array() >= 0.f).all());
+      ASSERT(measurementNoise.trace() > 0.f);
+      updateUnchecked<N>(measurement, measurementModel, measurementNoise);
+    }
+
+    /**
+     * The single dimensional update step to integrate a measurement into an existing hypothesis.
+     * @param measurement, a float value that represents a measurement
+     * @param measurementModel, a callable float(const State&) that returns a measurement for a state
+     * @param measurementNoise, the measurement specific noise (as a variance) to quantify the uncertainty
+     */
+    template<typename MeasurementModel>
+    void update(float measurement, const MeasurementModel& measurementModel, float measurementNoise)
+    {
+      ASSERT(measurementNoise > 0.f);
+      updateUnchecked<1>(Vectorf<1>(measurement), [&measurementModel](const State& state) {return Vectorf<1>(measurementModel(state));},
+                         Eigen::Matrix<float, 1, 1>(measurementNoise));
+    }
+
+    /**
+     * The prediction step for several filters that share the same dynamic model and noise.
+     * @param filters, a range of filters
+     * @param dynamicModel, a callable void(State&) to propagate the state
+     * @param noise, the propagation specific noise (as a variance) to quantify the uncertainty
+     */
+    template<typename Filters, typename DynamicModel>
+    static void predict(Filters& filters, const DynamicModel& dynamicModel, const CovarianceType& noise)
+    {
+      ASSERT((noise.array() >= 0.f).all());
+      ASSERT(noise.trace() > 0.f);
+      for(FixedUnscentedKalmanFilter& filter : filters)
+        filter.predictUnchecked(dynamicModel, noise);
+    }
+
+    /**
+     * The update step for several filters that share the same measurement model and noise.
+     * @param filters, a range of filters
+     * @param measurements, a range with one measurement per filter
+     * @param measurementModel, a callable Vectorf<N>(const State&) that returns a measurement for a state
+     * @param measurementNoise, the measurement specific noise (as a variance) to quantify the uncertainty
+     */
+    template<unsigned N, typename Filters, typename Measurements, typename MeasurementModel>
+    static void update(Filters& filters, const Measurements& measurements, const MeasurementModel& measurementModel,
+                       const Eigen::Matrix<float, N, N>& measurementNoise)
+    {
+      ASSERT((measurementNoise.diagonal().array() >= 0.f).all());
+      ASSERT(measurementNoise.trace() > 0.f);
+      ASSERT(std::size(filters) == std::size(measurements));
+      auto measurement = std::begin(measurements);
+      for(FixedUnscentedKalmanFilter& filter : filters)
+        filter.template updateUnchecked<N>(*measurement++, measurementModel, measurementNoise);
+    }
+
+  private:
+    /** The prediction step without checking the noise. */
+    template<typename DynamicModel>
+    void predictUnchecked(const DynamicModel& dynamicModel, const CovarianceType& noise)
+    {
+      updateSigmaPoints();
+
+      for(unsigned i = 0; i < numOfSigmaPoints; ++i)
+      {
+        State sigmaPoint = sigmaPoints.col(i);
+        dynamicModel(sigmaPoint);
+        sigmaPoints.col(i) = sigmaPoint;
+      }
+
+      mean = sigmaPoints.rowwise().sum() / static_cast<float>(numOfSigmaPoints);
+
+      const SigmaMatrix<DOF> dist = sigmaPoints.colwise() - mean;
+      cov = dist * dist.transpose() * 0.5f + noise;
+
+      fixCovarianceMatrix<DOF>(cov);
+      covarianceMatrixValidation<DOF>(cov);
+    }
+
+    /** The update step without checking the noise. */
+    template<unsigned N, typename MeasurementModel>
+    void updateUnchecked(const Vectorf<N>& measurement, const MeasurementModel& measurementModel, const Eigen::Matrix<float, N, N>& measurementNoise)
+    {
+      using MeasurementCovarianceType = Eigen::Matrix<float, N, N>;
+      using MixedCovarianceType = Eigen::Matrix<float, DOF, N>;
+
+      updateSigmaPoints();
+
+      SigmaMatrix<N> Z;
+      for(unsigned i = 0; i < numOfSigmaPoints; ++i)
+      {
+        const State sigmaPoint = sigmaPoints.col(i);
+        Z.col(i) = measurementModel(sigmaPoint);
+      }
+
+      const Vectorf<N> z = Z.rowwise().sum() / static_cast<float>(numOfSigmaPoints);
+      const SigmaMatrix<N> distZ = Z.colwise() - z;
+
+      const MeasurementCovarianceType sigmaZ = distZ * distZ.transpose() * 0.5f + measurementNoise;
+      const MixedCovarianceType sigmaXZ = (sigmaPoints.colwise() - mean) * distZ.transpose() * 0.5f;
+
+      //The kalman gain. sigmaZ is symmetric, so K^T = sigmaZ^-1 * sigmaXZ^T can be solved via Cholesky instead of inverting sigmaZ.
+      MixedCovarianceType K = MixedCovarianceType::Zero();
+      if constexpr(N == 1)
+        K = sigmaXZ * (1.f / sigmaZ(0, 0));
+      else
+      {
+        const Eigen::LLT<MeasurementCovarianceType> llt = sigmaZ.llt();
+        if(llt.info() == Eigen::ComputationInfo::Success)
+          K = llt.solve(sigmaXZ.transpose()).transpose();
+      }
+      ASSERT(K.allFinite());
+
+      //Derive the mean and the covariance using the kalman gain
+      mean += K * (measurement - z);
+      cov -= K * sigmaZ * K.transpose();
+
+      fixCovarianceMatrix<DOF>(cov);
+      covarianceMatrixValidation<DOF>(cov);
+    }
+
+    /**
+     * The helper function to calculate sigma points using the given mean and the covariance.
+     */
+    void updateSigmaPoints()
+    {
+      Eigen::LLT<CovarianceType> llt = cov.llt();
+      if(llt.info() == Eigen::ComputationInfo::Success)
+      {
+        const CovarianceType l = llt.matrixL();
+        sigmaPoints.col(0) = mean;
+        sigmaPoints.template middleCols<DOF>(1) = l.colwise() + mean;
+        sigmaPoints.template rightCols<DOF>() = (-l).colwise() + mean;
+      }
+      else
+        sigmaPoints.colwise() = mean;
+    }
+  };
 }
 
 /**
@@ -440,3 +637,6 @@ using UKF = impl::UnscentedKalmanFilter<Eigen::Matrix<float, DOF, 1>, DOF, false
 
 template<typename Manifold_>
 using UKFM = impl::UnscentedKalmanFilter<Manifold_, Manifold_::DOF, true>;
+
+template<unsigned DOF>
+using FixedUKF = impl::FixedUnscentedKalmanFilter<DOF>;
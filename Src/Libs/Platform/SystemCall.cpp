@@ -25,6 +25,7 @@
 #include <netdb.h>
 #include <arpa/inet.h>
 #include <cstring>
+#include <sys/resource.h>
 #ifdef LINUX
 #include <sys/sysinfo.h>
 #include <sys/statvfs.h>
@@ -100,6 +101,22 @@ void SystemCall::getLoad(float& mem, float load[3])
 #endif
 }
 
+unsigned long long SystemCall::getPeakMemoryUsage()
+{
+#ifdef WINDOWS
+  return 0; // Not implemented yet
+#else
+  struct rusage usage;
+  if(getrusage(RUSAGE_SELF, &usage) == -1)
+    return 0;
+#ifdef MACOS
+  return static_cast<unsigned long long>(usage.ru_maxrss);
+#else
+  return static_cast<unsigned long long>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
 unsigned long long SystemCall::getFreeDiskSpace(const char* path)
 {
   std::string fullPath = File::isAbsolute(path) ? path : std::string(File::getBHDir()) + "/Config/" + path;
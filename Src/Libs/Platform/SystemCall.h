@@ -31,6 +31,12 @@ public:
   /** Returns the load and the physical memory usage in percent */
   static void getLoad(float& mem, float load[3]);
 
+  /**
+   * Returns the peak resident memory of this process.
+   * @return The peak memory usage in bytes or 0 if unknown.
+   */
+  static unsigned long long getPeakMemoryUsage();
+
   /**
    * Returns the free disk space on a volume.
    * @param path A path to a directory or file on the volume.
@@ -0,0 +1,61 @@
+/**
+ * @file Platform/TripleBuffer.h
+ *
+ * This file declares a lock-free buffer that hands the latest value over
+ * from a single producer thread to a single consumer thread. Neither side
+ * ever blocks, so the producer cannot delay the consumer by holding a lock
+ * and vice versa. Values the consumer did not fetch in time are overwritten
+ * by newer ones, which is reported to the producer.
+ */
+
+#pragma once
+
+#include <atomic>
+
+template<typename T> class TripleBuffer
+{
+  static constexpr unsigned char indexMask = 3; /**< The bits of the shared state that contain the buffer index. */
+  static constexpr unsigned char fresh = 4; /**< The bit of the shared state that is set if the buffer was not read yet. */
+
+  T buffers[3]; /**< The buffers: one is written, one is read, and one is exchanged. */
+  std::atomic<unsigned char> middle = 1; /**< The index of the buffer exchanged plus the flag whether it contains a new value. */
+  unsigned char back = 0; /**< The index of the buffer written by the producer. */
+  unsigned char front = 2; /**< The index of the buffer read by the consumer. */
+
+public:
+  /**
+   * Returns the buffer the producer can fill. It still contains an older
+   * value, so it has to be overwritten completely.
+   * @return The buffer to write to. Only valid until the next call to publish().
+   */
+  T& writeBuffer() {return buffers[back];}
+
+  /**
+   * Makes the value written available to the consumer (producer only).
+   * @return Was a value overwritten that the consumer has not fetched?
+   */
+  bool publish()
+  {
+    const unsigned char previous = middle.exchange(static_cast<unsigned char>(back | fresh), std::memory_order_acq_rel);
+    back = previous & indexMask;
+    return (previous & fresh) != 0;
+  }
+
+  /**
+   * Fetches the latest value published, if there is one (consumer only).
+   * @return Was there a new value?
+   */
+  bool fetch()
+  {
+    if(!(middle.load(std::memory_order_relaxed) & fresh))
+      return false;
+    front = middle.exchange(front, std::memory_order_acq_rel) & indexMask;
+    return true;
+  }
+
+  /**
+   * Returns the value fetched last (consumer only).
+   * @return The value. It stays unchanged until fetch() is called again.
+   */
+  const T& readBuffer() const {return buffers[front];}
+};
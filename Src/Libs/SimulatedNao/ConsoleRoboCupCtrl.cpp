@@ -822,7 +822,7 @@ void ConsoleRoboCupCtrl::help(In& stream)
   list("  ar {<feature>} off | on : Switches automatic referee on or off.", pattern, true);
   list("  call <file> [<file>] : Execute a script file. If the optional script file is present, execute it instead.", pattern, true);
   if(!is2D)
-    list("  ci off | on | <fps> : Switch the calculation of images on or off or activate it and set the frame rate.", pattern, true);
+    list("  ci off | on | auto | [on | auto] <fps> : Switch the calculation of images off, on, or on only for cameras whose images are used, optionally with a frame rate.", pattern, true);
   list("  cls : Clear console window.", pattern, true);
   list("  dt off | on | <fps> : Delay time of a simulation step to real time or a certain number of frames per second.", pattern, true);
   list("  echo <text> : Print text into console window. Useful in console.con.", pattern, true);
@@ -979,21 +979,24 @@ bool ConsoleRoboCupCtrl::calcImage(In& stream)
     calculateImage = false;
     return true;
   }
-  else if(state == "on" || state == "")
+  else if(state == "on" || state == "auto" || state == "")
   {
-    calculateImageFps = FRAMES_PER_SECOND;
-    calculateImage = true;
-    return true;
+    calculateImageOnDemand = state != "on";
+    stream >> state;
+    if(state == "on" || state == "auto")
+      state = "";
   }
+  if(state == "")
+    calculateImageFps = FRAMES_PER_SECOND;
   else
   {
     for(char c : state)
       if(!isdigit(c))
         return false;
     calculateImageFps = std::max(1, atoi(state.c_str()));
-    calculateImage = true;
-    return true;
   }
+  calculateImage = true;
+  return true;
 }
 
 void ConsoleRoboCupCtrl::print(const std::string& text)
@@ -1127,6 +1130,7 @@ void ConsoleRoboCupCtrl::createCompletion()
   {
     "ci off",
     "ci on",
+    "ci auto",
     "si reset"
   };
 
@@ -29,6 +29,7 @@ class ConsoleRoboCupCtrl : public RoboCupCtrl
 public:
   DECLARE_SYNC;
   bool calculateImage = true; /**< Decides whether images are calculated by the simulator. */
+  bool calculateImageOnDemand = true; /**< Only calculate the images of a robot's camera if its thread actually uses them. */
   unsigned calculateImageFps; /**< Declares the simulated image frame rate. */
   unsigned globalNextImageTimestamp = 0;  /**< The theoretical timestamp of the next image to be calculated shared among all robots to synchronize image calculation. */
 
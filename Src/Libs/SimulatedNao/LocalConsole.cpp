@@ -16,6 +16,7 @@
 #include "Representations/Sensing/FallDownState.h"
 #include "Representations/Sensing/GroundContactState.h"
 #include "Framework/Debug.h"
+#include <algorithm>
 
 LocalConsole::LocalConsole(const Settings& settings, const std::string& robotName, ConsoleRoboCupCtrl* ctrl, const std::string& logFile, Debug* debug) :
   RobotConsole(settings, robotName, ctrl,
@@ -217,16 +218,19 @@ void LocalConsole::update()
         }
         nextImageTimestamp = newNextImageTimestamp;
 
-        if((imageCalculated = ctrl->calculateImage))
+        simulatedRobot->getCameraInfo(cameraInfo);
+        if((imageCalculated = isImageRequired(cameraInfo)))
           simulatedRobot->getImage(cameraImage, cameraInfo);
         else
-        {
-          simulatedRobot->getCameraInfo(cameraInfo);
           cameraImage.timestamp = now;
-        }
         simulatedRobot->getRobotPose(robotPose);
         simulatedRobot->getWorldState(worldState);
         simulatedRobot->toggleCamera();
+
+        // Tell the simulator in advance whether the next camera must be rendered.
+        CameraInfo nextCameraInfo;
+        simulatedRobot->getCameraInfo(nextCameraInfo);
+        simulatedRobot->setImageRequired(isImageRequired(nextCameraInfo));
       }
       else
         simulatedRobot->getRobotPose(robotPose);
@@ -277,6 +281,24 @@ void LocalConsole::update()
     ctrl->printStatusText((QString::fromStdString(robotName) + ": " + statusText).toUtf8());
 }
 
+bool LocalConsole::isImageRequired(const CameraInfo& cameraInfo) const
+{
+  if(!ctrl->calculateImage)
+    return false;
+  else if(!ctrl->calculateImageOnDemand || moduleInfo.config().empty()
+          || std::find(moduleInfo.config.defaultRepresentations.begin(), moduleInfo.config.defaultRepresentations.end(), "CameraImage")
+             != moduleInfo.config.defaultRepresentations.end())
+    return true;
+
+  const std::string threadName = cameraInfo.getThreadName();
+  for(const Configuration::Thread& thread : moduleInfo.config())
+    if(thread.name == threadName)
+      return std::find_if(thread.representationProviders.begin(), thread.representationProviders.end(),
+                          [](const Configuration::RepresentationProvider& rp) {return rp.representation == "CameraImage";})
+             != thread.representationProviders.end();
+  return false;
+}
+
 DebugReceiver<MessageQueue>* LocalConsole::connectReceiverWithRobot(Debug* debug)
 {
   DebugReceiver<MessageQueue>* receiver = new DebugReceiver<MessageQueue>(this, debug->getName());
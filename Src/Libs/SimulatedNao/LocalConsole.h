@@ -82,6 +82,15 @@ public:
   void update() override;
 
 private:
+  /**
+   * Determines whether images of a camera must be calculated, i.e. whether
+   * image calculation is switched on and, if it should only happen on demand,
+   * whether the thread of the camera uses the \c CameraImage.
+   * @param cameraInfo The information about the camera.
+   * @return Should images of this camera be calculated?
+   */
+  bool isImageRequired(const CameraInfo& cameraInfo) const;
+
   /**
    * The function connects the robot to the returned receiver.
    *
@@ -19,7 +19,57 @@
 #include "Representations/Perception/ImagePreprocessing/CameraMatrix.h"
 #include "Representations/Perception/ImagePreprocessing/ImageCoordinateSystem.h"
 #include "Representations/Sensing/FallDownState.h"
+#include <QBuffer>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <filesystem>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+  /** Lookup tables for computing the CRC-32 of PNG chunks eight bytes at a time ("slicing-by-8"). */
+  const std::array<std::array<unsigned, 256>, 8> crcTables = []
+  {
+    std::array<std::array<unsigned, 256>, 8> tables;
+    for(unsigned n = 0; n < 256; ++n)
+    {
+      unsigned c = n;
+      for(unsigned k = 0; k < 8; ++k)
+        c = c & 1 ? 0xedb88320 ^ (c >> 1) : c >> 1;
+      tables[0][n] = c;
+    }
+    for(unsigned n = 0; n < 256; ++n)
+      for(unsigned t = 1; t < 8; ++t)
+        tables[t][n] = tables[0][tables[t - 1][n] & 0xff] ^ (tables[t - 1][n] >> 8);
+    return tables;
+  }();
+
+  /**
+   * Continues the computation of a CRC-32.
+   * @param crc The CRC so far (0xffffffff at the beginning).
+   * @param data The data added.
+   * @param size The number of bytes added.
+   * @return The CRC including the data. It must be xor'ed with 0xffffffff at the end.
+   */
+  unsigned updateCRC(unsigned crc, const void* data, size_t size)
+  {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for(; size >= 8; size -= 8, p += 8)
+    {
+      unsigned low, high;
+      std::memcpy(&low, p, 4);
+      std::memcpy(&high, p + 4, 4);
+      low ^= crc;
+      crc = crcTables[7][low & 0xff] ^ crcTables[6][(low >> 8) & 0xff] ^ crcTables[5][(low >> 16) & 0xff] ^ crcTables[4][low >> 24]
+            ^ crcTables[3][high & 0xff] ^ crcTables[2][(high >> 8) & 0xff] ^ crcTables[1][(high >> 16) & 0xff] ^ crcTables[0][high >> 24];
+    }
+    for(; size; --size)
+      crc = crcTables[0][(crc ^ *p++) & 0xff] ^ (crc >> 8);
+    return crc;
+  }
+}
 
 LogExtractor::LogExtractor(LogPlayer& logPlayer) : logPlayer(logPlayer) {}
 
@@ -92,62 +142,100 @@ bool LogExtractor::saveAudioFile(const std::string& fileName)
 
 bool LogExtractor::saveImages(const std::string& path, const bool raw, const bool onlyPlaying, const int takeEachNthFrame = 1)
 {
-  class CRCLut : public std::array<unsigned int, 256>
+  /** An image selected for export. It is converted and written by a worker thread. */
+  struct Job
   {
-  public:
-    CRCLut() : std::array<unsigned int, 256>()
-    {
-      for(unsigned int n = 0; n < 256; n++)
-      {
-        unsigned int c = n;
-        for(unsigned int k = 0; k < 8; k++)
-        {
-          if(c & 1)
-            c = 0xedb88320L ^ (c >> 1);
-          else
-            c = c >> 1;
-        }
-        (*this)[n] = c;
-      }
-    }
+    std::string fileName; /**< The name of the PNG file to write. */
+    std::unique_ptr<JPEGImage> jpegImage; /**< The image to export if it was logged compressed. */
+    std::unique_ptr<CameraImage> cameraImage; /**< The image to export if it was logged uncompressed. */
+    std::string metaData; /**< The data written into the "bhMn" chunk. */
   };
 
-  class CRC
-  {
-  private:
-    unsigned int crc;
+  const Log log(logPlayer);
+  std::string folderPath = File::isAbsolute(path.c_str()) ? path : std::string(File::getBHDir()) + "/Config/" + path;
+  std::filesystem::create_directories(folderPath);
 
-  public:
-    CRC() : crc(0xffffffff) {}
-    CRC(const unsigned int initialCrc) : crc(initialCrc) {}
+  // The workers take jobs from a bounded queue to limit the memory used for images waiting for export.
+  const unsigned numOfWorkers = std::max(1u, std::thread::hardware_concurrency());
+  const std::size_t maxJobs = 2 * numOfWorkers;
+  std::deque<Job> jobs;
+  std::mutex mutex;
+  std::condition_variable jobAdded;
+  std::condition_variable jobTaken;
+  bool done = false;
+  std::atomic<bool> success = true;
 
-    CRC update(const CRCLut& lut, const void* data, const size_t size) const
+  const auto work = [&]
+  {
+    CameraImage unpackedJPEGImage;
+    QByteArray png;
+    for(;;)
     {
-      const unsigned char* dataPtr = reinterpret_cast<const unsigned char*>(data);
-      unsigned int crc = this->crc;
+      Job job;
+      {
+        std::unique_lock lock(mutex);
+        jobAdded.wait(lock, [&] {return done || !jobs.empty();});
+        if(jobs.empty())
+          return;
+        job = std::move(jobs.front());
+        jobs.pop_front();
+      }
+      jobTaken.notify_one();
 
-      for(size_t i = 0; i < size; i++)
-        crc = lut[(crc ^ dataPtr[i]) & 0xff] ^ (crc >> 8);
+      const CameraImage* imageToExport = job.cameraImage.get();
+      if(job.jpegImage)
+      {
+        job.jpegImage->toCameraImage(unpackedJPEGImage);
+        imageToExport = &unpackedJPEGImage;
+      }
 
-      return CRC(crc);
-    }
+      // Encode the image in memory with a fast deflate level.
+      png.clear();
+      QBuffer buffer(&png);
+      buffer.open(QIODevice::WriteOnly);
+      if(!ImageExport::exportImage(*imageToExport, buffer, "PNG", raw ? ImageExport::raw : ImageExport::rgb, 80))
+      {
+        success = false;
+        continue;
+      }
 
-    unsigned int finish() const
-    {
-      return crc ^ 0xffffffff;
+      // Insert the metadata chunk before the IEND chunk.
+      const std::array<char, 12> endChunk{0, 0, 0, 0, 'I', 'E', 'N', 'D', char(0xae), char(0x42), char(0x60), char(0x82)};
+      png.chop(endChunk.size());
+      const unsigned size = static_cast<unsigned>(job.metaData.size());
+      for(size_t i = 0; i < 4; i++)
+        png.append(reinterpret_cast<const char*>(&size)[3 - i]);
+      png.append("bhMn", 4);
+      png.append(job.metaData.data(), job.metaData.size());
+      const unsigned crc = updateCRC(updateCRC(0xffffffff, "bhMn", 4), job.metaData.data(), job.metaData.size()) ^ 0xffffffff;
+      for(size_t i = 0; i < 4; i++)
+        png.append(reinterpret_cast<const char*>(&crc)[3 - i]);
+      png.append(endChunk.data(), endChunk.size());
+
+      // Files only get their final name when they are complete, so an interrupted export can be resumed.
+      const std::string tempFileName = job.fileName + ".part";
+      QFile qFile(tempFileName.c_str());
+      if(!qFile.open(QIODevice::WriteOnly) || qFile.write(png) != png.size())
+        success = false;
+      else
+      {
+        qFile.close();
+        std::error_code error;
+        std::filesystem::rename(tempFileName, job.fileName, error);
+        if(error)
+          success = false;
+      }
     }
   };
 
-  const Log log(logPlayer);
-  std::string folderPath = File::isAbsolute(path.c_str()) ? path : std::string(File::getBHDir()) + "/Config/" + path;
-  std::filesystem::create_directories(folderPath);
-
-  const CRCLut crcLut;
+  std::vector<std::thread> workers;
+  for(unsigned i = 0; i < numOfWorkers; ++i)
+    workers.emplace_back(work);
 
+  // The frames are selected sequentially, because the selection depends on previous frames.
   int skippedImageCount = 0;
   GameState theGameState;
   FallDownState theFallDownState;
-  CameraImage theUnpackedJPEGImage;
 
   for(Log::Frame frame : log)
   {
@@ -173,42 +261,45 @@ bool LogExtractor::saveImages(const std::string& path, const bool raw, const boo
       if(skippedImageCount)
         continue;
 
-      const CameraImage* imageToExport = &theUnpackedJPEGImage;
+      Job job;
+      unsigned timestamp;
       if(frame.contains(idJPEGImage))
-        frame[idJPEGImage].cast<JPEGImage>().toCameraImage(theUnpackedJPEGImage);
+      {
+        job.jpegImage = std::make_unique<JPEGImage>(frame[idJPEGImage].cast<JPEGImage>());
+        timestamp = job.jpegImage->timestamp;
+      }
       else
-        imageToExport = &frame[idCameraImage].cast<CameraImage>();
-
-      // Open PNG file
-      const std::string filename = ImageExport::expandImageFileName(folderPath + TypeRegistry::getEnumName(theCameraInfo.camera), imageToExport->timestamp);
-      QFile qFile(filename.c_str());
-      qFile.open(QIODevice::WriteOnly);
-
-      // Write image
-      ImageExport::exportImage(*imageToExport, qFile, "PNG", raw ? ImageExport::raw : ImageExport::rgb);
+      {
+        job.cameraImage = std::make_unique<CameraImage>(frame[idCameraImage].cast<CameraImage>());
+        timestamp = job.cameraImage->timestamp;
+      }
 
-      // Remove IEND chunk
-      qFile.resize(qFile.size() - 12);
+      // Images that were already exported completely are skipped.
+      job.fileName = ImageExport::expandImageFileName(folderPath + TypeRegistry::getEnumName(theCameraInfo.camera), timestamp);
+      if(std::filesystem::exists(job.fileName))
+        continue;
 
-      // Write metadata
       OutBinaryMemory metaData;
       metaData << frame[idCameraInfo].cast<CameraInfo>();
       metaData << frame[idCameraMatrix].cast<CameraMatrix>();
       metaData << frame[idImageCoordinateSystem].cast<ImageCoordinateSystem>();
-      const unsigned int size = static_cast<unsigned int>(metaData.size());
-      for(size_t i = 0; i < 4; i++)
-        qFile.putChar(reinterpret_cast<const char*>(&size)[3 - i]);
-      qFile.write("bhMn");
-      qFile.write(metaData.data(), metaData.size());
-      const unsigned int crc = CRC().update(crcLut, "bhMn", 4).update(crcLut, metaData.data(), metaData.size()).finish();
-      for(size_t i = 0; i < 4; i++)
-        qFile.putChar(reinterpret_cast<const char*>(&crc)[3 - i]);
+      job.metaData.assign(metaData.data(), metaData.size());
 
-      // Write IEND chunk
-      const std::array<char, 12> endChunk{ 0, 0, 0, 0, 'I', 'E', 'N', 'D', char(0xae), char(0x42), char(0x60), char(0x82) };
-      qFile.write(endChunk.data(), endChunk.size());
-      qFile.close();
+      {
+        std::unique_lock lock(mutex);
+        jobTaken.wait(lock, [&] {return jobs.size() < maxJobs;});
+        jobs.emplace_back(std::move(job));
+      }
+      jobAdded.notify_one();
     }
   }
-  return true;
+
+  {
+    std::lock_guard lock(mutex);
+    done = true;
+  }
+  jobAdded.notify_all();
+  for(std::thread& worker : workers)
+    worker.join();
+  return success;
 }
@@ -691,11 +691,18 @@ bool RobotConsole::handleMessage(MessageQueue::Message message)
       ++currentFrame;
       ThreadData& data = threadData[threadName];
 
-      data.images.clear();
+      // Images sent at a limited rate are kept until the next one is overdue. All others are only shown for a single frame.
+      for(auto i = data.images.begin(); i != data.images.end();)
+        if(i->second.image && i->second.image->maxRate > 0.f
+           && Time::getTimeSince(i->second.timestamp) < static_cast<int>(2000.f / i->second.image->maxRate))
+          ++i;
+        else
+          i = data.images.erase(i);
 
       for(auto& [name, incomplete] : incompleteImages)
       {
         ImagePtr& imagePtr = data.images[name];
+        delete imagePtr.image;
         imagePtr.image = incomplete.image;
         imagePtr.timestamp = incomplete.timestamp;
         imagePtr.threadName = threadName;
@@ -886,11 +893,13 @@ bool RobotConsole::handleMessage(MessageQueue::Message message)
       return true;
     }
     case idDebugImage:
+    case idEncodedDebugImage:
     {
       std::string id;
       stream >> id;
       if(!incompleteImages[id].image)
         incompleteImages[id].image = new DebugImage();
+      incompleteImages[id].image->isEncoded = message.id() == idEncodedDebugImage;
       stream >> *incompleteImages[id].image;
       incompleteImages[id].timestamp = Time::getCurrentSystemTime();
       break;
@@ -122,6 +122,14 @@ public:
    */
   virtual void toggleCamera() = 0;
 
+  /**
+   * Sets whether the images of the currently selected camera are actually
+   * used. Cameras whose images are not used are not rendered together with
+   * the cameras of the other robots.
+   * @param required Are the images of the camera used?
+   */
+  virtual void setImageRequired(bool required) = 0;
+
   /**
    * Determines the sensor data of the simulated robot.
    * @param fsrSensorData The determined FSR sensor data.
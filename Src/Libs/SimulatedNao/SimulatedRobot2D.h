@@ -32,6 +32,7 @@ protected:
   void getAndSetJointData(const JointRequest& jointRequest, JointSensorData& jointSensorData) const override;
   void setJointRequest(const JointRequest& jointRequest, const bool isPuppet) const override;
   void toggleCamera() override;
+  void setImageRequired(bool) override {}
 
   void getSensorData(FsrSensorData& fsrSensorData, RawInertialSensorData& rawInertialSensorData) override;
   void getAndSetMotionData(const MotionRequest& motionRequest, MotionInfo& motionInfo) override;
@@ -236,7 +236,14 @@ void SimulatedRobot3D::getImage(CameraImage& cameraImage, CameraInfo& cameraInfo
 
   if(cameraSensor)
   {
-    reinterpret_cast<SimRobotCore3::SensorPort*>(cameraSensor)->renderCameraImages(activeCameras, activeCameraCount);
+    // Render all cameras whose images are used in a single pass, including this one.
+    activeCameras[activeCameraIndex] = reinterpret_cast<SimRobotCore3::SensorPort*>(cameraSensor);
+    SimRobotCore3::SensorPort* cameras[sizeof(activeCameras) / sizeof(activeCameras[0])];
+    unsigned cameraCount = 0;
+    for(unsigned i = 0; i < activeCameraCount; ++i)
+      if(activeCameras[i])
+        cameras[cameraCount++] = activeCameras[i];
+    reinterpret_cast<SimRobotCore3::SensorPort*>(cameraSensor)->renderCameraImages(cameras, cameraCount);
 
     ASSERT(!cameraImage.isReference());
 
@@ -272,7 +279,13 @@ void SimulatedRobot3D::getCameraInfo(CameraInfo& cameraInfo)
 void SimulatedRobot3D::toggleCamera()
 {
   cameraSensor = cameraSensor == lowerCameraSensor || !lowerCameraSensor ? upperCameraSensor : lowerCameraSensor;
-  activeCameras[activeCameraIndex] = reinterpret_cast<SimRobotCore3::SensorPort*>(cameraSensor);
+  activeCameras[activeCameraIndex] = imageRequired ? reinterpret_cast<SimRobotCore3::SensorPort*>(cameraSensor) : nullptr;
+}
+
+void SimulatedRobot3D::setImageRequired(bool required)
+{
+  imageRequired = required;
+  activeCameras[activeCameraIndex] = imageRequired ? reinterpret_cast<SimRobotCore3::SensorPort*>(cameraSensor) : nullptr;
 }
 
 void SimulatedRobot3D::setJointCalibration(const JointCalibration& jointCalibration)
@@ -34,6 +34,7 @@ protected:
   void getAndSetJointData(const JointRequest& jointRequest, JointSensorData& jointSensorData) const override;
   void setJointRequest(const JointRequest& jointRequest, const bool isPuppet) const override;
   void toggleCamera() override;
+  void setImageRequired(bool required) override;
   void getSensorData(FsrSensorData& fsrSensorData, RawInertialSensorData& rawInertialSensorData) override;
   void getAndSetMotionData(const MotionRequest& motionRequest, MotionInfo& motionInfo) override;
   void moveRobot(const Vector3f& pos, const Vector3f& rot, bool changeRotation, bool resetDynamics) override;
@@ -52,6 +53,7 @@ private:
   static SimRobotCore3::SensorPort* activeCameras[robotsPerTeam * 2]; /**< An array of all activated cameras */
   static unsigned activeCameraCount; /**< Total count of constructed cameras */
   unsigned activeCameraIndex; /**< Index of this robot in the \c activeCameras array */
+  bool imageRequired = true; /**< Are the images of the selected camera used? Otherwise, it is not in the \c activeCameras array. */
 
   SimRobot::Object* jointSensors[Joints::numOfJoints] = {nullptr}; /**< The handles to the sensor ports of the joints. */
   SimRobot::Object* jointVelocitySensors[Joints::numOfJoints] = {nullptr}; /**< The handles to the velocity sensor ports of the joints. */
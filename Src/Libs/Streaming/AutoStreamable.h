@@ -253,6 +253,9 @@
 /** Generate streaming code from declaration. */
 #define _STREAM_SER(seq) {auto& _var = _STREAM_VAR(seq); Streaming::streamIt(stream, #seq, _var);}
 
+/** Generate an argument for reading or writing all attributes at once. */
+#define _STREAM_RAW(seq) , _STREAM_VAR(seq)
+
 /** Generate the actual declaration. */
 #define _STREAM_DECL(seq) decltype(Streaming::TypeWrapper<_STREAM_DECL_I seq))>::type) _STREAM_VAR(seq) _STREAM_INIT(seq);
 #define _STREAM_DECL_I(...) _STREAM_VAR(__VA_ARGS__) _STREAM_DROP(_STREAM_DROP(
@@ -273,8 +276,8 @@
   struct name : public base \
   _STREAM_UNWRAP header; \
   _STREAM_STREAMABLE_I(_STREAM_TUPLE_SIZE(__VA_ARGS__), name, base, readBase, writeBase, __VA_ARGS__)
-#define _STREAM_STREAMABLE_I(n, name, base, readBase, writeBase, ...) _STREAM_STREAMABLE_II(n, name, base, readBase, writeBase, (_STREAM_SER, __VA_ARGS__), (_STREAM_DECL, __VA_ARGS__), (_STREAM_REG, __VA_ARGS__))
-#define _STREAM_STREAMABLE_II(n, theName, base, readBase, writeBase, params1, params2, params3) \
+#define _STREAM_STREAMABLE_I(n, name, base, readBase, writeBase, ...) _STREAM_STREAMABLE_II(n, name, base, readBase, writeBase, (_STREAM_SER, __VA_ARGS__), (_STREAM_DECL, __VA_ARGS__), (_STREAM_REG, __VA_ARGS__), (_STREAM_RAW, __VA_ARGS__))
+#define _STREAM_STREAMABLE_II(n, theName, base, readBase, writeBase, params1, params2, params3, params4) \
     _STREAM_ATTR_##n params2 \
   protected: \
     friend struct Streaming::OnRead<theName, true>; \
@@ -283,14 +286,20 @@
       static_cast<void>(stream); \
       PUBLISH(_reg); \
       readBase; \
-      _STREAM_ATTR_##n params1 \
+      if(!Streaming::readRawBinary(stream _STREAM_ATTR_##n params4)) \
+      { \
+        _STREAM_ATTR_##n params1 \
+      } \
       Streaming::onRead(*this); \
     } \
     void write(Out& stream) const override \
     { \
       static_cast<void>(stream); \
       writeBase; \
-      _STREAM_ATTR_##n params1 \
+      if(!Streaming::writeRawBinary(stream _STREAM_ATTR_##n params4)) \
+      { \
+        _STREAM_ATTR_##n params1 \
+      } \
     } \
   private: \
     static void _reg() \
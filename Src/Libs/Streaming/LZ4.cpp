@@ -0,0 +1,172 @@
+/**
+ * @file LZ4.cpp
+ *
+ * This file implements functions that compress and decompress blocks of data
+ * in the LZ4 block format. Each sequence consists of a token (4 bits literal
+ * length, 4 bits match length - 4), an optionally extended literal length,
+ * the literals, a 2 byte offset, and an optionally extended match length.
+ * The last sequence only contains literals.
+ */
+
+#include "LZ4.h"
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+  constexpr std::size_t minMatch = 4; /**< The minimum length of a match. */
+  constexpr std::size_t lastLiterals = 5; /**< The number of bytes at the end that must be literals. */
+  constexpr std::size_t matchFindLimit = 12; /**< The last match must start this number of bytes before the end. */
+  constexpr std::size_t maxOffset = 65535; /**< The maximum distance of a match. */
+  constexpr unsigned hashBits = 12; /**< The number of bits of the hash of 4 bytes. */
+
+  std::uint32_t read32(const unsigned char* p)
+  {
+    std::uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+  }
+
+  unsigned hash(std::uint32_t sequence)
+  {
+    return (sequence * 2654435761u) >> (32 - hashBits);
+  }
+
+  /** Writes the part of a length that does not fit into the token. */
+  void writeLength(unsigned char*& out, std::size_t length)
+  {
+    for(; length >= 255; length -= 255)
+      *out++ = 255;
+    *out++ = static_cast<unsigned char>(length);
+  }
+
+  /** Reads the part of a length that did not fit into the token. */
+  bool readLength(const unsigned char*& in, const unsigned char* end, std::size_t& length)
+  {
+    unsigned char value;
+    do
+    {
+      if(in == end)
+        return false;
+      value = *in++;
+      length += value;
+    }
+    while(value == 255);
+    return true;
+  }
+
+  /** Writes the literals and the match of a sequence. A match length of 0 marks the last sequence. */
+  void writeSequence(unsigned char*& out, const unsigned char* literals, std::size_t literalLength, std::size_t offset, std::size_t matchLength)
+  {
+    unsigned char* token = out++;
+    *token = static_cast<unsigned char>((literalLength < 15 ? literalLength : 15) << 4);
+    if(literalLength >= 15)
+      writeLength(out, literalLength - 15);
+    std::memcpy(out, literals, literalLength);
+    out += literalLength;
+    if(matchLength)
+    {
+      *out++ = static_cast<unsigned char>(offset);
+      *out++ = static_cast<unsigned char>(offset >> 8);
+      matchLength -= minMatch;
+      *token |= static_cast<unsigned char>(matchLength < 15 ? matchLength : 15);
+      if(matchLength >= 15)
+        writeLength(out, matchLength - 15);
+    }
+  }
+}
+
+std::size_t LZ4::compress(const void* source, std::size_t size, void* destination)
+{
+  const unsigned char* const begin = static_cast<const unsigned char*>(source);
+  const unsigned char* const end = begin + size;
+  unsigned char* out = static_cast<unsigned char*>(destination);
+  const unsigned char* anchor = begin;
+
+  if(size > matchFindLimit)
+  {
+    const unsigned char* const matchLimit = end - matchFindLimit;
+    const unsigned char* const matchEnd = end - lastLiterals;
+    std::uint32_t table[1 << hashBits] = {0}; // Positions relative to begin.
+    const unsigned char* p = begin + 1;
+    while(p < matchLimit)
+    {
+      const std::uint32_t sequence = read32(p);
+      std::uint32_t& entry = table[hash(sequence)];
+      const unsigned char* match = begin + entry;
+      entry = static_cast<std::uint32_t>(p - begin);
+      if(match >= p || static_cast<std::size_t>(p - match) > maxOffset || read32(match) != sequence)
+      {
+        // Skip faster through data that does not compress.
+        p += 1 + ((p - anchor) >> 6);
+        continue;
+      }
+
+      // Extend the match backwards and forwards.
+      const std::size_t offset = p - match;
+      while(p > anchor && match > begin && p[-1] == match[-1])
+      {
+        --p;
+        --match;
+      }
+      const unsigned char* const start = p;
+      p += minMatch;
+      match += minMatch;
+      while(p < matchEnd && *p == *match)
+      {
+        ++p;
+        ++match;
+      }
+
+      writeSequence(out, anchor, start - anchor, offset, p - start);
+      anchor = p;
+    }
+  }
+
+  writeSequence(out, anchor, end - anchor, 0, 0);
+  return out - static_cast<unsigned char*>(destination);
+}
+
+bool LZ4::decompress(const void* source, std::size_t size, void* destination, std::size_t destinationSize)
+{
+  const unsigned char* in = static_cast<const unsigned char*>(source);
+  const unsigned char* const end = in + size;
+  unsigned char* const begin = static_cast<unsigned char*>(destination);
+  unsigned char* out = begin;
+  unsigned char* const outEnd = begin + destinationSize;
+
+  while(in < end)
+  {
+    const unsigned char token = *in++;
+    std::size_t literalLength = token >> 4;
+    if((literalLength == 15 && !readLength(in, end, literalLength))
+       || literalLength > static_cast<std::size_t>(end - in) || literalLength > static_cast<std::size_t>(outEnd - out))
+      return false;
+    std::memcpy(out, in, literalLength);
+    in += literalLength;
+    out += literalLength;
+    if(in == end)
+      break;
+
+    if(end - in < 2)
+      return false;
+    const std::size_t offset = in[0] | in[1] << 8;
+    in += 2;
+    std::size_t matchLength = token & 15;
+    if(!offset || offset > static_cast<std::size_t>(out - begin) || (matchLength == 15 && !readLength(in, end, matchLength)))
+      return false;
+    matchLength += minMatch;
+    if(matchLength > static_cast<std::size_t>(outEnd - out))
+      return false;
+
+    // Matches can overlap the bytes they produce, which repeats a pattern.
+    const unsigned char* match = out - offset;
+    if(offset >= matchLength)
+      std::memcpy(out, match, matchLength);
+    else
+      for(std::size_t i = 0; i < matchLength; ++i)
+        out[i] = match[i];
+    out += matchLength;
+  }
+  return out == outEnd;
+}
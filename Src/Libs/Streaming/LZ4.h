@@ -0,0 +1,44 @@
+/**
+ * @file LZ4.h
+ *
+ * This file declares functions that compress and decompress blocks of data
+ * in the LZ4 block format. The compressor is a simple greedy one that trades
+ * compression ratio for speed, which makes it suitable for compressing data
+ * that is sent every frame. It has no dependencies, so it is also available
+ * on the robots.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace LZ4
+{
+  /**
+   * Returns the maximum size of a compressed block.
+   * @param size The size of the uncompressed data in bytes.
+   * @return The number of bytes the destination of \c compress must provide.
+   */
+  constexpr std::size_t compressBound(std::size_t size) {return size + size / 255 + 16;}
+
+  /**
+   * Compresses a block of data.
+   * @param source The data to compress.
+   * @param size The size of the data in bytes.
+   * @param destination The compressed data is written here. It must provide
+   *                    \c compressBound(size) bytes.
+   * @return The size of the compressed data in bytes.
+   */
+  std::size_t compress(const void* source, std::size_t size, void* destination);
+
+  /**
+   * Decompresses a block of data.
+   * @param source The compressed data.
+   * @param size The size of the compressed data in bytes.
+   * @param destination The decompressed data is written here.
+   * @param destinationSize The size of the decompressed data in bytes.
+   * @return Was the compressed data valid and did it decompress to exactly
+   *         \c destinationSize bytes?
+   */
+  bool decompress(const void* source, std::size_t size, void* destination, std::size_t destinationSize);
+}
@@ -125,6 +125,7 @@ ENUM(MessageID,
   idDebugResponse,
   idDrawingManager,
   idDrawingManager3D,
+  idEncodedDebugImage,
   idLogResponse,
   idModuleRequest,
   idModuleTable,
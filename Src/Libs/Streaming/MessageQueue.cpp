@@ -46,6 +46,7 @@ size_t MessageQueue::calcMaxCapacity(MessageID id) const
   constexpr unsigned unprotected = bit(idDebugDrawing - numOfDataMessageIDs)
     | bit(idDebugDrawing3D - numOfDataMessageIDs)
     | bit(idDebugImage - numOfDataMessageIDs)
+    | bit(idEncodedDebugImage - numOfDataMessageIDs)
     | bit(idPlot - numOfDataMessageIDs)
     | bit(idText - numOfDataMessageIDs);
 
@@ -58,7 +59,10 @@ bool MessageQueue::ensureCapacity(size_t capacity, size_t maxCapacity)
   if(capacity > maxCapacity)
     return false;
   else if(capacity <= this->capacity)
+  {
+    peakUsed = std::max(peakUsed, capacity);
     return true;
+  }
 #ifndef TARGET_ROBOT
   else
   {
@@ -71,6 +75,7 @@ bool MessageQueue::ensureCapacity(size_t capacity, size_t maxCapacity)
     {
       buffer = newBuffer;
       this->capacity = newCapacity;
+      peakUsed = std::max(peakUsed, capacity);
       return true;
     }
   }
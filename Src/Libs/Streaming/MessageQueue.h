@@ -81,6 +81,7 @@ class MessageQueue : public Streamable
   size_t maxCapacity; /**< The maximum capacity of the queue in bytes. \c capacity cannot grow more than this. */
   size_t protectedCapacity = 0; /**< A part of the maximum capacity that is reserved for certain message types (in bytes). */
   char* buffer = nullptr; /**< The memory block of size \c capacity containing the messages. */
+  size_t peakUsed = 0; /**< The largest size the queue ever had (in bytes). */
   bool ownBuffer = true; /**< Is the memory block maintained by this class? */
 
   /**
@@ -175,6 +176,12 @@ public:
      */
     size_t size() const {return reinterpret_cast<const MessageHeader*>(buffer)->size;}
 
+    /**
+     * Returns the message's data.
+     * @return The address of the first byte after the \c MessageHeader .
+     */
+    const char* data() const {return buffer + sizeof(MessageHeader);}
+
     /**
      * Returns a stream that allows reading the message in binary format.
      * @return The binary stream.
@@ -192,6 +199,12 @@ public:
   struct OutBinary : public OutStream<OutQueue, ::OutBinary>
   {
     OutBinary(MessageID id, MessageQueue& queue) {open(id, queue);}
+
+    /**
+     * The function returns whether this is a binary stream.
+     * @return Does it output data in binary format?
+     */
+    bool isBinary() const override {return true;}
   };
 
   /** Stream for adding a message in textual format. */
@@ -300,6 +313,18 @@ public:
    */
   size_t size() const {return used;}
 
+  /**
+   * Returns the largest size the queue ever had.
+   * @return The size in bytes.
+   */
+  size_t peakSize() const {return peakUsed;}
+
+  /**
+   * Returns the maximum size the queue can reach.
+   * @return The size in bytes.
+   */
+  size_t maxSize() const {return maxCapacity;}
+
   /**
    * Changes the size of the queue.
    * @param size The new size of the queue. Must be smaller or equal to the
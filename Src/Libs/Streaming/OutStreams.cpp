@@ -25,6 +25,8 @@ void OutBinary::writeString(const char* d, PhysicalOutStream& stream)
   stream.writeToStream(d, size);
 }
 
+static_assert(sizeof(Angle) == sizeof(float), "Streaming::IsRawBinary<Angle> requires this");
+
 void OutBinary::writeAngle(const Angle& d, PhysicalOutStream& stream)
 {
   writeFloat(d, stream);
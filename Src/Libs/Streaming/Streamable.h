@@ -13,8 +13,10 @@
 #include "Streaming/InOut.h"
 #include "Streaming/TypeRegistry.h"
 #include <array>
+#include <cstring>
 #include <list>
 #include <optional>
+#include <type_traits>
 #include <vector>
 
 /** Register the class that is specified as parameter. */
@@ -412,6 +414,85 @@ namespace Streaming
     }
   };
 
+  /**
+   * Is a type written to binary streams exactly as it is represented in memory?
+   * This is the case for numbers, enums streamed as unsigned char or int, angles,
+   * and fixed-size arrays of such types. bool is excluded, because it is
+   * normalized when read.
+   * @tparam T The type.
+   */
+  template<typename T> struct IsRawBinary : std::bool_constant<
+    std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char> ||
+    std::is_same_v<T, short> || std::is_same_v<T, unsigned short> ||
+    std::is_same_v<T, int> || std::is_same_v<T, unsigned int> ||
+    std::is_same_v<T, float> || std::is_same_v<T, double> ||
+    (std::is_enum_v<T> && (sizeof(T) == sizeof(unsigned char) || sizeof(T) == sizeof(int)))> {};
+  template<> struct IsRawBinary<Angle> : std::true_type {};
+  template<typename E, size_t N> struct IsRawBinary<E[N]> : IsRawBinary<E> {};
+  template<typename E, size_t N> struct IsRawBinary<std::array<E, N>> : IsRawBinary<E> {};
+
+  /** The maximum number of bytes collected on the stack before writing or reading them at once. */
+  constexpr size_t maxRawBinaryBufferSize = 1024;
+
+  /**
+   * Writes attributes to a binary stream as they are represented in memory,
+   * bypassing the formatting of each single value. The result is identical
+   * to streaming them one by one.
+   * @param stream The stream to write to.
+   * @param t The attributes.
+   * @return Were the attributes written? This is only the case if all of them
+   *         are raw binary and the stream is binary.
+   */
+  template<typename... T> bool writeRawBinary(Out& stream, const T&... t)
+  {
+    if constexpr(sizeof...(T) > 0 && (IsRawBinary<T>::value && ...))
+    {
+      if(stream.isBinary())
+      {
+        if constexpr((sizeof(T) + ...) <= maxRawBinaryBufferSize)
+        {
+          char buffer[(sizeof(T) + ...)];
+          char* p = buffer;
+          ((std::memcpy(p, static_cast<const void*>(&t), sizeof(T)), p += sizeof(T)), ...);
+          stream.write(buffer, sizeof(buffer));
+        }
+        else
+          (stream.write(&t, sizeof(T)), ...);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Reads attributes from a binary stream as they are represented in memory.
+   * The counterpart of writeRawBinary.
+   * @param stream The stream to read from.
+   * @param t The attributes.
+   * @return Were the attributes read? This is only the case if all of them
+   *         are raw binary and the stream is binary.
+   */
+  template<typename... T> bool readRawBinary(In& stream, T&... t)
+  {
+    if constexpr(sizeof...(T) > 0 && (IsRawBinary<T>::value && ...))
+    {
+      if(stream.isBinary())
+      {
+        if constexpr((sizeof(T) + ...) <= maxRawBinaryBufferSize)
+        {
+          char buffer[(sizeof(T) + ...)];
+          stream.read(buffer, sizeof(buffer));
+          const char* p = buffer;
+          ((std::memcpy(static_cast<void*>(&t), p, sizeof(T)), p += sizeof(T)), ...);
+        }
+        else
+          (stream.read(static_cast<void*>(&t), sizeof(T)), ...);
+        return true;
+      }
+    }
+    return false;
+  }
+
   /** Read variable from a stream. */
   template<typename S> void streamIt(In& stream, const char* name, S& s)
   {
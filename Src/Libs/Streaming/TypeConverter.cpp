@@ -0,0 +1,568 @@
+/**
+ * @file TypeConverter.cpp
+ *
+ * This file implements a class that converts data streamed in binary format
+ * according to one specification of a type into the binary format of
+ * another specification of the same type.
+ */
+
+#include "TypeConverter.h"
+#include "Streaming/InStreams.h"
+#include "Streaming/OutStreams.h"
+#include "Streaming/TypeInfo.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+/** The primitive types as they are represented in binary streams. */
+enum class Primitive : unsigned char
+{
+  boolean, character, signedCharacter, unsignedCharacter,
+  shortInteger, unsignedShortInteger, integer, unsignedInteger,
+  floatingPoint, doubleFloatingPoint, string, unknown
+};
+
+/** How a value of a type is represented in a binary stream. */
+struct TypeConverter::Layout
+{
+  enum Kind {primitive, staticArray, dynamicArray, record} kind = record;
+  static constexpr std::size_t variable = std::numeric_limits<std::size_t>::max();
+  std::size_t size = variable; /**< The size of all values of this type in bytes or "variable". */
+  Primitive primitiveType = Primitive::unknown; /**< The type if this is a primitive. */
+  bool isEnum = false; /**< Is this an enumeration (streamed as unsigned char)? */
+  const std::vector<std::string>* constants = nullptr; /**< The names of the constants if this is an enumeration. */
+  const Layout* element = nullptr; /**< The type of the elements if this is an array. */
+  std::size_t count = 0; /**< The number of elements if this is a static array. */
+  std::vector<const Layout*> attributes; /**< The types of the attributes if this is a record. */
+
+  /**
+   * Appends a value that only consists of zeros, i.e. numbers are 0 and
+   * strings and dynamic arrays are empty.
+   * @param buffer The buffer the value is appended to.
+   */
+  void appendZero(std::vector<char>& buffer) const;
+};
+
+/** The steps to convert a value of one type into another. */
+struct TypeConverter::Plan
+{
+  enum Kind
+  {
+    copy, /**< Both types are compatible. The data is copied. */
+    keep, /**< The types are incompatible. The default is used. */
+    primitive, /**< Convert between two primitive types. */
+    enumeration, /**< Map the constants of an enumeration by their names. */
+    array, /**< Convert an array (static or dynamic) element-wise. */
+    record /**< Convert attributes matched by their names. */
+  } kind = keep;
+
+  static constexpr unsigned char unmapped = 255;
+  const Layout* from = nullptr; /**< The layout of the data converted. */
+  const Layout* to = nullptr; /**< The layout of the result. */
+  std::vector<unsigned char> constants; /**< Maps constants of "from" to constants of "to" or "unmapped". */
+  const Plan* element = nullptr; /**< The plan for the elements of arrays. */
+  std::vector<std::pair<int, const Plan*>> attributes; /**< For each attribute of "to" the index in "from" (or -1) and its plan. */
+  bool inOrder = true; /**< Are the attributes matched in the same order in both types? */
+};
+
+/** A position in binary data. If "position" is nullptr, there is no data. */
+struct TypeConverter::Reader
+{
+  const char* position; /**< The next byte to read. */
+  const char* end; /**< The end of the data. */
+
+  /**
+   * Skips a value.
+   * @param layout The layout of the value.
+   * @return Was the value in the data?
+   */
+  bool skip(const Layout& layout)
+  {
+    if(layout.size != Layout::variable)
+    {
+      if(static_cast<std::size_t>(end - position) < layout.size)
+        return false;
+      position += layout.size;
+      return true;
+    }
+    switch(layout.kind)
+    {
+      case Layout::primitive:
+      {
+        unsigned length;
+        if(layout.primitiveType != Primitive::string || !read(&length, sizeof(length))
+           || static_cast<std::size_t>(end - position) < length)
+          return false;
+        position += length;
+        return true;
+      }
+      case Layout::staticArray:
+        for(std::size_t i = 0; i < layout.count; ++i)
+          if(!skip(*layout.element))
+            return false;
+        return true;
+      case Layout::dynamicArray:
+      {
+        unsigned count;
+        if(!read(&count, sizeof(count)))
+          return false;
+        for(unsigned i = 0; i < count; ++i)
+          if(!skip(*layout.element))
+            return false;
+        return true;
+      }
+      default:
+        for(const Layout* attribute : layout.attributes)
+          if(!skip(*attribute))
+            return false;
+        return true;
+    }
+  }
+
+  /**
+   * Reads a number of bytes.
+   * @param p The memory the bytes are copied to.
+   * @param size The number of bytes.
+   * @return Were there enough bytes?
+   */
+  bool read(void* p, std::size_t size)
+  {
+    if(static_cast<std::size_t>(end - position) < size)
+      return false;
+    std::memcpy(p, position, size);
+    position += size;
+    return true;
+  }
+};
+
+namespace
+{
+  /** Appends bytes to a buffer. */
+  void append(std::vector<char>& buffer, const void* p, std::size_t size)
+  {
+    const char* begin = static_cast<const char*>(p);
+    buffer.insert(buffer.end(), begin, begin + size);
+  }
+
+  /** Returns the primitive type of a type name. */
+  Primitive getPrimitive(const std::string& type)
+  {
+    static const std::unordered_map<std::string, Primitive> primitives =
+    {
+      {"bool", Primitive::boolean},
+      {"char", Primitive::character},
+      {"signed char", Primitive::signedCharacter},
+      {"unsigned char", Primitive::unsignedCharacter},
+      {"short", Primitive::shortInteger},
+      {"unsigned short", Primitive::unsignedShortInteger},
+      {"int", Primitive::integer},
+      {"unsigned", Primitive::unsignedInteger},
+      {"unsigned int", Primitive::unsignedInteger},
+      {"float", Primitive::floatingPoint},
+      {"Angle", Primitive::floatingPoint},
+      {"double", Primitive::doubleFloatingPoint},
+      {"std::string", Primitive::string}
+    };
+    const auto primitive = primitives.find(type);
+    return primitive == primitives.end() ? Primitive::unknown : primitive->second;
+  }
+
+  /** Returns the size of a primitive type in binary streams or 0 if it is variable. */
+  std::size_t getSize(Primitive primitive)
+  {
+    switch(primitive)
+    {
+      case Primitive::boolean:
+      case Primitive::character:
+      case Primitive::signedCharacter:
+      case Primitive::unsignedCharacter:
+        return 1;
+      case Primitive::shortInteger:
+      case Primitive::unsignedShortInteger:
+        return 2;
+      case Primitive::integer:
+      case Primitive::unsignedInteger:
+      case Primitive::floatingPoint:
+        return 4;
+      case Primitive::doubleFloatingPoint:
+        return 8;
+      default:
+        return 0;
+    }
+  }
+
+  /** Reads a primitive number as double. */
+  double readNumber(Primitive primitive, const char* p)
+  {
+    const auto get = [p](auto value) {std::memcpy(&value, p, sizeof(value)); return static_cast<double>(value);};
+    switch(primitive)
+    {
+      case Primitive::boolean: return get(char()) != 0.0 ? 1.0 : 0.0;
+      case Primitive::character: return get(char());
+      case Primitive::signedCharacter: return get(static_cast<signed char>(0));
+      case Primitive::unsignedCharacter: return get(static_cast<unsigned char>(0));
+      case Primitive::shortInteger: return get(short());
+      case Primitive::unsignedShortInteger: return get(static_cast<unsigned short>(0));
+      case Primitive::integer: return get(int());
+      case Primitive::unsignedInteger: return get(0u);
+      case Primitive::floatingPoint: return get(0.f);
+      default: return get(0.0);
+    }
+  }
+
+  /** Writes a double as a primitive number, saturating integers. */
+  void writeNumber(Primitive primitive, double value, std::vector<char>& buffer)
+  {
+    const auto put = [&buffer](auto type, double value)
+    {
+      using T = decltype(type);
+      if constexpr(std::is_integral_v<T>)
+      {
+        const double clipped = std::max(static_cast<double>(std::numeric_limits<T>::min()),
+                                        std::min(static_cast<double>(std::numeric_limits<T>::max()), value));
+        type = static_cast<T>(clipped == clipped ? clipped : 0.0);
+      }
+      else
+        type = static_cast<T>(value);
+      append(buffer, &type, sizeof(type));
+    };
+    switch(primitive)
+    {
+      case Primitive::boolean: put(char(), value != 0.0 ? 1.0 : 0.0); break;
+      case Primitive::character: put(char(), value); break;
+      case Primitive::signedCharacter: put(static_cast<signed char>(0), value); break;
+      case Primitive::unsignedCharacter: put(static_cast<unsigned char>(0), value); break;
+      case Primitive::shortInteger: put(short(), value); break;
+      case Primitive::unsignedShortInteger: put(static_cast<unsigned short>(0), value); break;
+      case Primitive::integer: put(int(), value); break;
+      case Primitive::unsignedInteger: put(0u, value); break;
+      case Primitive::floatingPoint: put(0.f, value); break;
+      default: put(0.0, value); break;
+    }
+  }
+}
+
+void TypeConverter::Layout::appendZero(std::vector<char>& buffer) const
+{
+  if(size != variable)
+    buffer.resize(buffer.size() + size, 0);
+  else if(kind == staticArray)
+    for(std::size_t i = 0; i < count; ++i)
+      element->appendZero(buffer);
+  else if(kind == record)
+    for(const Layout* attribute : attributes)
+      attribute->appendZero(buffer);
+  else
+    buffer.resize(buffer.size() + sizeof(unsigned), 0);
+}
+
+TypeConverter::TypeConverter(const TypeInfo& from, const TypeInfo& to, const std::string& type) :
+  plan(getPlan(from, to, type, type))
+{}
+
+TypeConverter::~TypeConverter() = default;
+
+bool TypeConverter::isCopy() const
+{
+  return plan->kind == Plan::copy;
+}
+
+bool TypeConverter::convert(const char* data, std::size_t size, Streamable& object)
+{
+  if(plan->kind != Plan::copy)
+  {
+    // The current values of the object are used for everything that cannot be converted.
+    OutBinaryMemory stream(defaultsCapacity);
+    stream << object;
+    defaultsCapacity = std::max(defaultsCapacity, stream.size());
+    if(!convert(data, size, stream.data(), stream.size(), result))
+      return false;
+    data = result.data();
+    size = result.size();
+  }
+  InBinaryMemory stream(data, size);
+  stream >> object;
+  return true;
+}
+
+bool TypeConverter::convert(const char* data, std::size_t size, const char* defaults, std::size_t defaultsSize, std::vector<char>& result)
+{
+  result.clear();
+  Reader from{data, data + size};
+  Reader to{defaults, defaults ? defaults + defaultsSize : nullptr};
+  offsets.clear();
+  return execute(*plan, from, to, result);
+}
+
+const TypeConverter::Layout* TypeConverter::getLayout(const TypeInfo& typeInfo, std::unordered_map<std::string, std::unique_ptr<Layout>>& layouts, const std::string& type)
+{
+  std::unique_ptr<Layout>& entry = layouts[type];
+  if(entry)
+    return entry.get();
+
+  // Register before the recursion to support recursive types.
+  entry = std::make_unique<Layout>();
+  Layout& layout = *entry;
+  if(!type.empty() && type.back() == ']')
+  {
+    const std::size_t endOfType = type.find_last_of('[');
+    layout.kind = Layout::staticArray;
+    layout.count = static_cast<std::size_t>(std::atoi(type.c_str() + endOfType + 1));
+    layout.element = getLayout(typeInfo, layouts, type.substr(0, endOfType));
+    if(layout.element->size != Layout::variable)
+      layout.size = layout.count * layout.element->size;
+  }
+  else if(!type.empty() && type.back() == '*')
+  {
+    layout.kind = Layout::dynamicArray;
+    layout.element = getLayout(typeInfo, layouts, type.substr(0, type.size() - 1));
+  }
+  else if(typeInfo.primitives.find(type) != typeInfo.primitives.end())
+  {
+    layout.kind = Layout::primitive;
+    layout.primitiveType = getPrimitive(type);
+    if(const std::size_t size = getSize(layout.primitiveType); size)
+      layout.size = size;
+  }
+  else if(const auto enumeration = typeInfo.enums.find(type); enumeration != typeInfo.enums.end())
+  {
+    layout.kind = Layout::primitive;
+    layout.primitiveType = Primitive::unsignedCharacter;
+    layout.isEnum = true;
+    layout.constants = &enumeration->second;
+    layout.size = 1;
+  }
+  else if(const auto record = typeInfo.classes.find(type); record != typeInfo.classes.end())
+  {
+    std::size_t size = 0;
+    for(const TypeInfo::Attribute& attribute : record->second)
+    {
+      layout.attributes.push_back(getLayout(typeInfo, layouts, attribute.type));
+      size = size == Layout::variable || layout.attributes.back()->size == Layout::variable
+             ? Layout::variable : size + layout.attributes.back()->size;
+    }
+    layout.size = size;
+  }
+  // Unknown types are primitives of variable size that cannot be skipped.
+  else
+    layout.kind = Layout::primitive;
+  return &layout;
+}
+
+const TypeConverter::Plan* TypeConverter::getPlan(const TypeInfo& from, const TypeInfo& to, const std::string& fromType, const std::string& toType)
+{
+  std::unique_ptr<Plan>& entry = plans[fromType + "\n" + toType];
+  if(entry)
+    return entry.get();
+
+  // Register before the recursion to support recursive types.
+  entry = std::make_unique<Plan>();
+  Plan& plan = *entry;
+  plan.from = getLayout(from, fromLayouts, fromType);
+  plan.to = getLayout(to, toLayouts, toType);
+  const Layout& fromLayout = *plan.from;
+  const Layout& toLayout = *plan.to;
+
+  if(to.areTypesEqual(from, toType, fromType))
+    plan.kind = Plan::copy;
+  else if((fromLayout.kind == Layout::staticArray || fromLayout.kind == Layout::dynamicArray)
+          && (toLayout.kind == Layout::staticArray || toLayout.kind == Layout::dynamicArray))
+  {
+    plan.kind = Plan::array;
+    plan.element = getPlan(from, to,
+                           fromType.substr(0, fromLayout.kind == Layout::staticArray ? fromType.find_last_of('[') : fromType.size() - 1),
+                           toType.substr(0, toLayout.kind == Layout::staticArray ? toType.find_last_of('[') : toType.size() - 1));
+  }
+  else if(fromLayout.kind == Layout::primitive && toLayout.kind == Layout::primitive)
+  {
+    if(fromLayout.isEnum && toLayout.isEnum)
+    {
+      plan.kind = Plan::enumeration;
+      plan.constants.resize(fromLayout.constants->size(), Plan::unmapped);
+      for(std::size_t i = 0; i < fromLayout.constants->size(); ++i)
+      {
+        const auto constant = std::find(toLayout.constants->begin(), toLayout.constants->end(), (*fromLayout.constants)[i]);
+        if(constant != toLayout.constants->end() && constant - toLayout.constants->begin() < Plan::unmapped)
+          plan.constants[i] = static_cast<unsigned char>(constant - toLayout.constants->begin());
+      }
+    }
+    else if(!fromLayout.isEnum && !toLayout.isEnum
+            && fromLayout.size != Layout::variable && toLayout.size != Layout::variable)
+      plan.kind = fromLayout.primitiveType == toLayout.primitiveType ? Plan::copy : Plan::primitive;
+  }
+  else if(fromLayout.kind == Layout::record && toLayout.kind == Layout::record)
+  {
+    plan.kind = Plan::record;
+    const std::vector<TypeInfo::Attribute>& fromAttributes = from.classes.find(fromType)->second;
+    const std::vector<TypeInfo::Attribute>& toAttributes = to.classes.find(toType)->second;
+    int last = -1;
+    for(const TypeInfo::Attribute& attribute : toAttributes)
+    {
+      const auto match = std::find_if(fromAttributes.begin(), fromAttributes.end(),
+                                      [&attribute](const TypeInfo::Attribute& a) {return a.name == attribute.name;});
+      if(match == fromAttributes.end())
+        plan.attributes.emplace_back(-1, nullptr);
+      else
+      {
+        const int index = static_cast<int>(match - fromAttributes.begin());
+        plan.attributes.emplace_back(index, getPlan(from, to, match->type, attribute.type));
+        plan.inOrder &= index > last;
+        last = index;
+      }
+    }
+  }
+  return &plan;
+}
+
+bool TypeConverter::execute(const Plan& plan, Reader& from, Reader& defaults, std::vector<char>& result)
+{
+  // Appends the default for a value. Without defaults, zeros are appended.
+  const auto appendDefault = [&result](const Layout& layout, Reader& defaults)
+  {
+    if(!defaults.position)
+    {
+      layout.appendZero(result);
+      return true;
+    }
+    const char* start = defaults.position;
+    if(!defaults.skip(layout))
+      return false;
+    append(result, start, defaults.position - start);
+    return true;
+  };
+
+  switch(plan.kind)
+  {
+    case Plan::copy:
+    {
+      const char* start = from.position;
+      if(!from.skip(*plan.from) || (defaults.position && !defaults.skip(*plan.to)))
+        return false;
+      append(result, start, from.position - start);
+      return true;
+    }
+
+    case Plan::keep:
+      return from.skip(*plan.from) && appendDefault(*plan.to, defaults);
+
+    case Plan::primitive:
+    {
+      if(static_cast<std::size_t>(from.end - from.position) < plan.from->size
+         || (defaults.position && !defaults.skip(*plan.to)))
+        return false;
+      writeNumber(plan.to->primitiveType, readNumber(plan.from->primitiveType, from.position), result);
+      from.position += plan.from->size;
+      return true;
+    }
+
+    case Plan::enumeration:
+    {
+      unsigned char constant;
+      if(!from.read(&constant, 1))
+        return false;
+      if(constant < plan.constants.size() && plan.constants[constant] != Plan::unmapped)
+      {
+        result.push_back(static_cast<char>(plan.constants[constant]));
+        return !defaults.position || defaults.skip(*plan.to);
+      }
+      else
+        return appendDefault(*plan.to, defaults);
+    }
+
+    case Plan::array:
+    {
+      unsigned fromCount = static_cast<unsigned>(plan.from->count);
+      if(plan.from->kind == Layout::dynamicArray && !from.read(&fromCount, sizeof(fromCount)))
+        return false;
+      unsigned defaultsCount = 0;
+      if(defaults.position)
+      {
+        defaultsCount = static_cast<unsigned>(plan.to->count);
+        if(plan.to->kind == Layout::dynamicArray && !defaults.read(&defaultsCount, sizeof(defaultsCount)))
+          return false;
+      }
+      unsigned toCount = static_cast<unsigned>(plan.to->count);
+      if(plan.to->kind == Layout::dynamicArray)
+      {
+        toCount = fromCount;
+        append(result, &toCount, sizeof(toCount));
+      }
+
+      Reader none{nullptr, nullptr};
+      for(unsigned i = 0; i < std::max({fromCount, toCount, defaultsCount}); ++i)
+      {
+        Reader& defaultElement = i < defaultsCount ? defaults : none;
+        if(i < toCount)
+        {
+          if(!(i < fromCount ? execute(*plan.element, from, defaultElement, result)
+                             : appendDefault(*plan.to->element, defaultElement)))
+            return false;
+        }
+        else if((i < fromCount && !from.skip(*plan.from->element))
+                || (i < defaultsCount && !defaults.skip(*plan.to->element)))
+          return false;
+      }
+      return true;
+    }
+
+    case Plan::record:
+    {
+      const std::vector<const Layout*>& fromAttributes = plan.from->attributes;
+      if(plan.inOrder)
+      {
+        std::size_t next = 0;
+        for(std::size_t i = 0; i < plan.attributes.size(); ++i)
+        {
+          const auto& [index, attributePlan] = plan.attributes[i];
+          if(index < 0)
+          {
+            if(!appendDefault(*plan.to->attributes[i], defaults))
+              return false;
+          }
+          else
+          {
+            for(; next < static_cast<std::size_t>(index); ++next)
+              if(!from.skip(*fromAttributes[next]))
+                return false;
+            if(!execute(*attributePlan, from, defaults, result))
+              return false;
+            ++next;
+          }
+        }
+        for(; next < fromAttributes.size(); ++next)
+          if(!from.skip(*fromAttributes[next]))
+            return false;
+      }
+      else
+      {
+        // Determine where each attribute starts before converting them in the target order.
+        const std::size_t base = offsets.size();
+        for(const Layout* attribute : fromAttributes)
+        {
+          offsets.push_back(from.position);
+          if(!from.skip(*attribute))
+            return false;
+        }
+        for(std::size_t i = 0; i < plan.attributes.size(); ++i)
+        {
+          const auto& [index, attributePlan] = plan.attributes[i];
+          if(index < 0)
+          {
+            if(!appendDefault(*plan.to->attributes[i], defaults))
+              return false;
+          }
+          else
+          {
+            Reader attribute{offsets[base + index], from.end};
+            if(!execute(*attributePlan, attribute, defaults, result))
+              return false;
+          }
+        }
+        offsets.resize(base);
+      }
+      return true;
+    }
+  }
+  return false;
+}
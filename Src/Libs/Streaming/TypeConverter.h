@@ -0,0 +1,105 @@
+/**
+ * @file TypeConverter.h
+ *
+ * This file declares a class that converts data streamed in binary format
+ * according to one specification of a type (e.g. from a log file) into the
+ * binary format of another specification of the same type (usually the
+ * current one). The differences between both specifications are analyzed
+ * only once when the converter is constructed. The resulting plan copies
+ * unchanged parts as a whole, converts numbers between primitive types,
+ * maps enumeration constants by their names, matches attributes of classes
+ * by their names, and resizes arrays. Attributes that cannot be converted
+ * keep the values they had before.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Streamable;
+struct TypeInfo;
+
+class TypeConverter
+{
+public:
+  /**
+   * Constructor. Analyzes the differences between both specifications.
+   * @param from The type information the data to be converted follows.
+   * @param to The type information of the result.
+   * @param type The name of the type converted. It must be the same in both specifications.
+   */
+  TypeConverter(const TypeInfo& from, const TypeInfo& to, const std::string& type);
+
+  ~TypeConverter();
+
+  /**
+   * Converts data and reads it into an object.
+   * @param data The data following the type information "from".
+   * @param size The size of the data in bytes.
+   * @param object The object of the type converted that is following the type information "to".
+   *               Attributes that cannot be converted keep their previous values.
+   * @return Did the data contain the type converted? If not, the object was not changed.
+   */
+  bool convert(const char* data, std::size_t size, Streamable& object);
+
+  /**
+   * Converts data.
+   * @param data The data following the type information "from".
+   * @param size The size of the data in bytes.
+   * @param defaults The values for attributes that cannot be converted following
+   *                 the type information "to". If nullptr, they are set to zero.
+   * @param defaultsSize The size of the defaults in bytes.
+   * @param result The data converted following the type information "to".
+   * @return Did the data and the defaults contain the type converted?
+   */
+  bool convert(const char* data, std::size_t size, const char* defaults, std::size_t defaultsSize, std::vector<char>& result);
+
+  /** Returns whether the conversion just copies the data, i.e. both specifications are compatible. */
+  bool isCopy() const;
+
+private:
+  struct Layout;
+  struct Plan;
+  struct Reader;
+
+  std::unordered_map<std::string, std::unique_ptr<Layout>> fromLayouts; /**< The layouts of the types in the specification "from". */
+  std::unordered_map<std::string, std::unique_ptr<Layout>> toLayouts; /**< The layouts of the types in the specification "to". */
+  std::unordered_map<std::string, std::unique_ptr<Plan>> plans; /**< The plans for all pairs of types, indexed by "from\nto". */
+  const Plan* plan; /**< The plan for the type converted. */
+  std::vector<const char*> offsets; /**< Stack of the positions of attributes of records that are read out of order. */
+  std::size_t defaultsCapacity = 1024; /**< The buffer size reserved for the current values of an object converted. */
+  std::vector<char> result; /**< The buffer for the conversion result of an object converted. */
+
+  /**
+   * Determines the layout of a type.
+   * @param typeInfo The type information containing the type.
+   * @param layouts The layouts already determined for this type information.
+   * @param type The name of the type.
+   * @return The layout.
+   */
+  static const Layout* getLayout(const TypeInfo& typeInfo, std::unordered_map<std::string, std::unique_ptr<Layout>>& layouts, const std::string& type);
+
+  /**
+   * Determines the plan for converting a type.
+   * @param from The type information the data to be converted follows.
+   * @param to The type information of the result.
+   * @param fromType The name of the type in the specification "from".
+   * @param toType The name of the type in the specification "to".
+   * @return The plan.
+   */
+  const Plan* getPlan(const TypeInfo& from, const TypeInfo& to, const std::string& fromType, const std::string& toType);
+
+  /**
+   * Executes a plan.
+   * @param plan The plan.
+   * @param from The data to be converted. Will be advanced behind the value converted.
+   * @param defaults The defaults. Will be advanced behind the value replaced if it contains data.
+   * @param result The result the converted value is appended to.
+   * @return Did the data and the defaults contain the type converted?
+   */
+  bool execute(const Plan& plan, Reader& from, Reader& defaults, std::vector<char>& result);
+};
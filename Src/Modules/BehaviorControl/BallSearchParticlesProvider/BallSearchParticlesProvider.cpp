@@ -9,6 +9,7 @@
 #include "BallSearchParticlesProvider.h"
 #include "Debugging/DebugDrawings.h"
 #include "Tools/BehaviorControl/Strategy/Agent.h"
+#include <algorithm>
 
 MAKE_MODULE(BallSearchParticlesProvider);
 
@@ -21,28 +22,32 @@ void BallSearchParticlesProvider::update(BallSearchParticles& theBallSearchParti
 
   if(theCameraMatrix.isValid)
   {
-    //builds the polygon of visible field parts of the robot
-    std::vector<Vector2f> polygon;
-    Projection::computeFieldOfViewInFieldCoordinates(theRobotPose, theCameraMatrix, theCameraInfo, theFieldDimensions, polygon);
-    const std::list<SectorWheel::Sector> wheel = calculateObstacleSectors();
-
     //give the referee some time to place the ball
-    bool refereeToleranceNeeded = theGameState.isCornerKick() || theGameState.isKickIn() || theGameState.isGoalKick();
+    const bool refereeToleranceNeeded = theGameState.isCornerKick() || theGameState.isKickIn() || theGameState.isGoalKick();
     if(!refereeToleranceNeeded || theFrameInfo.getTimeSince(theGameState.timeWhenStateStarted) > refereeTolerance)
     {
-      for(size_t i = 0; i < theBallSearchParticles.particles.size();)
+      //builds the polygon of visible field parts of the robot
+      std::vector<Vector2f> polygon;
+      Projection::computeFieldOfViewInFieldCoordinates(theRobotPose, theCameraMatrix, theCameraInfo, theFieldDimensions, polygon);
+      updateFieldOfView(polygon);
+      updateViewSectors();
+
+      std::vector<Vector2f>& particles = theBallSearchParticles.particles;
+      updateVisibility(particles);
+      if(refereeToleranceNeeded)
+      {
+        // Particles that were seen are removed, keeping the order of the others
+        std::size_t remaining = 0;
+        for(std::size_t i = 0; i < particles.size(); ++i)
+          if(!visible[i])
+            particles[remaining++] = particles[i];
+        particles.resize(remaining);
+      }
+      else
       {
-        if(isParticleInView(theBallSearchParticles.particles[i], polygon) && !isBlockedByObstacle(theBallSearchParticles.particles[i], wheel))
-        {
-          if(theGameState.isCornerKick() || theGameState.isKickIn() || theGameState.isGoalKick())
-          {
-            theBallSearchParticles.particles.erase(theBallSearchParticles.particles.begin() + i);
-            continue;
-          }
-          else
-            theBallSearchParticles.particles[i] = createRandomParticle();
-        }
-        i++;
+        for(std::size_t i = 0; i < particles.size(); ++i)
+          if(visible[i])
+            particles[i] = createRandomParticle();
       }
     }
   }
@@ -133,7 +138,26 @@ Vector2f BallSearchParticlesProvider::createRandomParticle() const
            Random::uniform(theFieldDimensions.yPosRightTouchline, theFieldDimensions.yPosLeftTouchline) };
 }
 
-std::list<SectorWheel::Sector> BallSearchParticlesProvider::calculateObstacleSectors() const
+void BallSearchParticlesProvider::updateFieldOfView(const std::vector<Vector2f>& polygon)
+{
+  fieldOfViewEdges.clear();
+  if(polygon.size() < 3)
+    return;
+
+  // The normals must point inwards, which depends on the orientation of the polygon
+  float doubleArea = 0.f;
+  for(std::size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++)
+    doubleArea += polygon[j].x() * polygon[i].y() - polygon[i].x() * polygon[j].y();
+  const float sign = doubleArea >= 0.f ? 1.f : -1.f;
+
+  for(std::size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++)
+  {
+    const Vector2f normal = sign * Vector2f(polygon[j].y() - polygon[i].y(), polygon[i].x() - polygon[j].x());
+    fieldOfViewEdges.emplace_back(normal.x(), normal.y(), normal.dot(polygon[j]));
+  }
+}
+
+void BallSearchParticlesProvider::updateViewSectors()
 {
   SectorWheel sectorWheel;
   sectorWheel.begin(theRobotPose.translation, maxViewDistance);
@@ -148,68 +172,55 @@ std::list<SectorWheel::Sector> BallSearchParticlesProvider::calculateObstacleSec
     const Angle obstacleDirection = (obstacleOnField - theRobotPose.translation).angle();
     sectorWheel.addSector(Rangea(Angle::normalize(obstacleDirection - obstacleRadius), Angle::normalize(obstacleDirection + obstacleRadius)), obstacleDistance, SectorWheel::Sector::obstacle);
   }
-  return sectorWheel.finish();
-}
 
-bool BallSearchParticlesProvider::isParticleInView(const Vector2f& particle, const std::vector<Vector2f>& polygon) const
-{
-  return Geometry::isPointInsideConvexPolygon(polygon.data(), static_cast<int>(polygon.size()), particle);
+  viewSectors.clear();
+  for(const SectorWheel::Sector& sector : sectorWheel.finish())
+    viewSectors.push_back({sector.angleRange, sqr(sector.distance)});
 }
 
-bool BallSearchParticlesProvider::isBlockedByObstacle(const Vector2f& particle, const std::list<SectorWheel::Sector>& wheel) const
+void BallSearchParticlesProvider::updateVisibility(const std::vector<Vector2f>& particles)
 {
-  for(const auto& sector : wheel)
-  {
-    if(Geometry::isPointInsideArc(particle, theRobotPose.translation, sector.angleRange, sector.distance))
+  // The field of view is checked edge by edge for all particles, which the compiler can vectorize
+  visible.assign(particles.size(), fieldOfViewEdges.empty() ? 0 : 1);
+  for(const Vector3f& edge : fieldOfViewEdges)
+    for(std::size_t i = 0; i < particles.size(); ++i)
+      visible[i] &= static_cast<unsigned char>(edge.x() * particles[i].x() + edge.y() * particles[i].y() >= edge.z());
+
+  // Only the remaining particles are checked against the sectors, computing their direction only once
+  for(std::size_t i = 0; i < particles.size(); ++i)
+    if(visible[i])
     {
-      return false;
+      const Vector2f offset = particles[i] - theRobotPose.translation;
+      const float squaredDistance = offset.squaredNorm();
+      const Angle direction = offset.angle();
+      visible[i] = std::any_of(viewSectors.begin(), viewSectors.end(), [&](const ViewSector& sector)
+      {
+        return squaredDistance <= sector.squaredDistance && sector.angleRange.isInside(direction);
+      });
     }
-  }
-  return true;
 }
 
-Vector2f BallSearchParticlesProvider::positionToSearch(const Agent& agent) const
+Vector2f BallSearchParticlesProvider::positionToSearch(const Agent& agent)
 {
-  std::vector<std::vector<unsigned>> grid;
   const unsigned cellCountX = static_cast<unsigned>(theFieldDimensions.xPosOpponentGoalLine * 2 / cellWidth + 1);
   const unsigned cellCountY = static_cast<unsigned>(theFieldDimensions.yPosLeftTouchline * 2 / cellHeight + 1);
-  // building the grid from the upper left to the bottom right corner of the field
-  for(unsigned y = 0; y < cellCountY; y++)
-  {
-    std::vector<unsigned> row;
-    for(unsigned x = 0; x < cellCountX; x++)
-    {
-      row.emplace_back(0);
-    }
-    grid.emplace_back(row);
-  }
+  // the grid is stored row by row, starting at the corner of the own goal line and the right touchline
+  cellCounts.assign(cellCountX * cellCountY, 0);
 
   for(const Vector2f& particle : theBallSearchParticles.particles)
   {
     if(Geometry::isPointInsideConvexPolygon(agent.baseArea.data(), static_cast<int>(agent.baseArea.size()), particle))
     {
-      grid[static_cast<unsigned>((theFieldDimensions.yPosLeftTouchline + particle.y()) / cellHeight)]
-          [static_cast<unsigned>((theFieldDimensions.xPosOpponentGoalLine + particle.x()) / cellWidth)]++;
+      ++cellCounts[static_cast<unsigned>((theFieldDimensions.yPosLeftTouchline + particle.y()) / cellHeight) * cellCountX
+                   + static_cast<unsigned>((theFieldDimensions.xPosOpponentGoalLine + particle.x()) / cellWidth)];
       CROSS("module:BallSearchParticlesProvider:particles", particle.x(), particle.y(), 50, 20, Drawings::solidPen, ColorRGBA::red);
     }
   }
 
-  // find grid cell with most particles
-  unsigned max = 0;
-  unsigned maxIndexI = 0;
-  unsigned maxIndexJ = 0;
-  for(unsigned i = 0; i < cellCountY; i++)
-  {
-    for(unsigned j = 0; j < cellCountX; j++)
-    {
-      if(grid[i][j] > max)
-      {
-        max = grid[i][j];
-        maxIndexI = i;
-        maxIndexJ = j;
-      }
-    }
-  }
+  // find grid cell with most particles (the first one if there are several)
+  const unsigned maxIndex = static_cast<unsigned>(std::max_element(cellCounts.begin(), cellCounts.end()) - cellCounts.begin());
+  const unsigned maxIndexI = maxIndex / cellCountX;
+  const unsigned maxIndexJ = maxIndex % cellCountX;
 
   const Vector2f positionToLookNext = { theFieldDimensions.xPosOwnGoalLine + maxIndexJ * cellWidth, theFieldDimensions.yPosRightTouchline + maxIndexI * cellHeight };
 
@@ -48,6 +48,18 @@ class BallSearchParticlesProvider : public BallSearchParticlesProviderBase
 public:
   void update(BallSearchParticles&) override;
 private:
+  /** A sector around the robot in which it can see up to a certain distance. */
+  struct ViewSector
+  {
+    Rangea angleRange; /**< The angular range of the sector. */
+    float squaredDistance; /**< The squared distance up to which the robot can see in this sector. */
+  };
+
+  std::vector<Vector3f> fieldOfViewEdges; /**< The edges of the field of view as (normal, offset). A point p is inside if normal * p >= offset for all edges. */
+  std::vector<ViewSector> viewSectors; /**< The sectors in which the view is not blocked by obstacles. */
+  std::vector<unsigned char> visible; /**< Which particles can currently be seen? */
+  std::vector<unsigned> cellCounts; /**< The number of particles per grid cell (used by positionToSearch). */
+
   void draw() const;
 
   /**
@@ -63,33 +75,28 @@ private:
   Vector2f createRandomParticle() const;
 
   /**
-   * Calculate a list of sectors. Adds an obstacle sector for each obstacles.
-   * @return A list of sectors.
+   * Converts the field of view into the inequalities of its edges.
+   * @param polygon The part of the field that can be viewed from a robot's perspective. It must be convex.
    */
-  std::list<SectorWheel::Sector> calculateObstacleSectors() const;
+  void updateFieldOfView(const std::vector<Vector2f>& polygon);
 
-  /**
-   * Determines whether a particle can be seen from the robot's perspective.
-   * @param particle The particle.
-   * @param polygon The part of the field that can be viewed from a robot's perspective.
-   * @return Whether the particle can be seen.
-   */
-  bool isParticleInView(const Vector2f& particle, const std::vector<Vector2f>& polygon) const;
+  /** Determines the sectors in which the view is not blocked by obstacles. */
+  void updateViewSectors();
 
   /**
-   * Determines whether the view to a particle is blocked by an obstacle.
-   * @param particle The particle.
-   * @param wheel The sector wheel with obstacles.
-   * @return Whether the particle is blocked by an obstacle.
+   * Determines for all particles at once whether they can be seen from the robot's perspective,
+   * i.e. whether they are inside the field of view and not blocked by an obstacle.
+   * The result is stored in \c visible.
+   * @param particles The particles.
    */
-  bool isBlockedByObstacle(const Vector2f& particle, const std::list<SectorWheel::Sector>& wheel) const;
+  void updateVisibility(const std::vector<Vector2f>& particles);
 
   /**
    * Calculates the position the agent should look at next.
    * @param agent The agent.
    * @return The field coordinates where the agent should search next.
    */
-  Vector2f positionToSearch(const Agent& agent) const;
+  Vector2f positionToSearch(const Agent& agent);
 
   /**
    * Determines whether a particle is inside the agents voronoi region.
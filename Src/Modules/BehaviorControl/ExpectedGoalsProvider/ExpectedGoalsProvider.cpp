@@ -36,6 +36,20 @@ void ExpectedGoalsProvider::update(ExpectedGoals& theExpectedGoals)
     return getRating(pointOnField, isPositioning);
   };
 
+  if(positioningCellSize != positioningGridCellSize)
+  {
+    positioningGridCellSize = positioningCellSize;
+    if(positioningGridCellSize > 0.f)
+      positioningGrid = RatingGrid(gridCornerLower, gridCornerUpper, positioningGridCellSize);
+  }
+  positioningGrid.invalidate();
+  theExpectedGoals.getPositioningRating = [this](const Vector2f& pointOnField) -> float
+  {
+    if(positioningGridCellSize <= 0.f)
+      return getRating(pointOnField, true);
+    return positioningGrid.interpolate(pointOnField, [this](const Vector2f& node) {return getRating(node, true);});
+  };
+
   theExpectedGoals.getOpponentRating = [this](const Vector2f& pointOnField) -> float
   {
     return getOpponentRating(pointOnField);
@@ -14,6 +14,7 @@
 #include "Representations/Configuration/BallSpecification.h"
 #include "Representations/Configuration/FieldDimensions.h"
 #include "Representations/Modeling/GlobalOpponentsModel.h"
+#include "Tools/BehaviorControl/RatingGrid.h"
 #include "Tools/BehaviorControl/SectorWheel.h"
 
 MODULE(ExpectedGoalsProvider,
@@ -29,6 +30,7 @@ MODULE(ExpectedGoalsProvider,
     (Angle)(20_deg) maxOpeningAngle, /**< Opening angle for the goal shot line to be considered free */
     (Angle)(40_deg) maxOpeningAngleOpponent, /**< Opening angle for the goal shot line to be considered free */
     (float)(100.f) cellSize, /**< Size of each grid cell in mm on the field, lower number results in higher resolution for the heatmap */
+    (float)(200.f) positioningCellSize, /**< Distance in mm between the grid nodes from which the positioning ratings are interpolated. 0 evaluates them exactly. */
     (unsigned char)(255) heatmapAlpha, /**< Transparency of the heatmap between 0 (invisible) and 255 (opaque) */
     (ColorRGBA)(213, 17, 48) worstRatingColor, /**< Red color in RGB corresponding to a pass rating value of 0 in the heatmap */
     (ColorRGBA)(0, 104, 180) bestRatingColor, /**< Blue color in RGB corresponding to a pass rating value of 1 in the heatmap */
@@ -48,6 +50,8 @@ private:
   bool isPositioningDrawing = false;
   Vector2i cellsNumber; /**< Resolution for the heatmap i.e. number of grid cells on the corresponding axis */
   std::vector<ColorRGBA> cellColors;
+  RatingGrid positioningGrid; /**< Caches getRating(..., true) for the whole field. */
+  float positioningGridCellSize = 0.f; /**< The cell size positioningGrid was built with. 0 if it was not built. */
 
   const Vector2f goalCenter = Vector2f(theFieldDimensions.xPosOpponentGoalLine, 0.f);
   const Vector2f leftGoalPost = Vector2f(theFieldDimensions.xPosOpponentGoalPost, theFieldDimensions.yPosLeftGoal);
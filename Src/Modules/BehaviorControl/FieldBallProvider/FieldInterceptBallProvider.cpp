@@ -8,7 +8,6 @@
 
 #include "FieldInterceptBallProvider.h"
 #include "Math/Geometry.h"
-#include "Tools/Modeling/BallPhysics.h"
 
 MAKE_MODULE(FieldInterceptBallProvider);
 
@@ -16,10 +15,11 @@ void FieldInterceptBallProvider::update(FieldInterceptBall& theFieldInterceptBal
 {
   // Risky ball estimate shall not be used as goal keeper or in penalty kick|shootout
   useRiskyBallEstimateAllowed = useRiskyBallEstimate && !theGameState.isGoalkeeper() && !theGameState.isPenaltyShootout() && !theGameState.isPenaltyKick();
-  calculateInterceptedBallEndPosition(theFieldInterceptBall);
+  BallRollModel ballRollModel(theBallSpecification.friction);
+  calculateInterceptedBallEndPosition(theFieldInterceptBall, ballRollModel);
 }
 
-void FieldInterceptBallProvider::checkIfBallIsPassingOwnXAxis(Vector2f& intersectionPositionWithOwnXAxis, float& timeUntilIntersectsOwnXAxis, const Vector2f& ballPosition, const Vector2f& ballVelocity, const bool distanceCheck = true)
+void FieldInterceptBallProvider::checkIfBallIsPassingOwnXAxis(Vector2f& intersectionPositionWithOwnXAxis, float& timeUntilIntersectsOwnXAxis, const Vector2f& ballPosition, const Vector2f& ballVelocity, const BallRollModel& ballRollModel, const bool distanceCheck = true)
 {
   intersectionPositionWithOwnXAxis = Vector2f::Zero();
   timeUntilIntersectsOwnXAxis = std::numeric_limits<float>::max();
@@ -36,12 +36,12 @@ void FieldInterceptBallProvider::checkIfBallIsPassingOwnXAxis(Vector2f& intersec
     if(!distanceCheck || distanceToIntersection < distanceToEndPosition)
     {
       intersectionPositionWithOwnXAxis = intersection;
-      timeUntilIntersectsOwnXAxis = BallPhysics::timeForDistance(ballVelocity, distanceToIntersection, theBallSpecification.friction);
+      timeUntilIntersectsOwnXAxis = ballRollModel.getTimeForDistance(distanceToIntersection);
     }
   }
 }
 
-void FieldInterceptBallProvider::checkIfBallIsPassingOwnYAxis(Vector2f& intersectionPositionWithOwnYAxis, float& timeUntilIntersectsOwnYAxis, const Vector2f& ballPosition, const Vector2f& ballVelocity, const bool distanceCheck = true)
+void FieldInterceptBallProvider::checkIfBallIsPassingOwnYAxis(Vector2f& intersectionPositionWithOwnYAxis, float& timeUntilIntersectsOwnYAxis, const Vector2f& ballPosition, const Vector2f& ballVelocity, const BallRollModel& ballRollModel, const bool distanceCheck = true)
 {
   intersectionPositionWithOwnYAxis = Vector2f::Zero();
   timeUntilIntersectsOwnYAxis = std::numeric_limits<float>::max();
@@ -58,12 +58,12 @@ void FieldInterceptBallProvider::checkIfBallIsPassingOwnYAxis(Vector2f& intersec
     if(!distanceCheck || distanceToIntersection < distanceToEndPosition)
     {
       intersectionPositionWithOwnYAxis = intersection;
-      timeUntilIntersectsOwnYAxis = BallPhysics::timeForDistance(ballVelocity, distanceToIntersection, theBallSpecification.friction);
+      timeUntilIntersectsOwnYAxis = ballRollModel.getTimeForDistance(distanceToIntersection);
     }
   }
 }
 
-void FieldInterceptBallProvider::calculateInterceptedBallEndPosition(FieldInterceptBall& theFieldInterceptBall)
+void FieldInterceptBallProvider::calculateInterceptedBallEndPosition(FieldInterceptBall& theFieldInterceptBall, BallRollModel& ballRollModel)
 {
   // TODO: Walking speed should be considered
   // Decide whether an intersection should be done.
@@ -81,10 +81,13 @@ void FieldInterceptBallProvider::calculateInterceptedBallEndPosition(FieldInterc
     const float ballDistanceScaling = Rangef::ZeroOneRange().limit((ballDistance - interpolateRiskyBallEstimateRange.min) / (interpolateRiskyBallEstimateRange.max - interpolateRiskyBallEstimateRange.min));
     ballPosition = ballPosition * (1.f - ballDistanceScaling) + theBallModel.riskyMovingEstimate.position * ballDistanceScaling;
     ballVelocity = ballVelocity * (1.f - ballDistanceScaling) + theBallModel.riskyMovingEstimate.velocity * ballDistanceScaling;
-    endPosition = BallPhysics::getEndPosition(ballPosition, ballVelocity, theBallSpecification.friction);
+    ballRollModel.setBall(ballPosition, ballVelocity);
+    endPosition = ballRollModel.getEndPosition();
   }
-  checkIfBallIsPassingOwnYAxis(theFieldInterceptBall.intersectionPositionWithOwnYAxis, theFieldInterceptBall.timeUntilIntersectsOwnYAxis, ballPosition, ballVelocity);
-  checkIfBallIsPassingOwnXAxis(theFieldInterceptBall.intersectionPositionWithOwnXAxis, theFieldInterceptBall.timeUntilIntersectsOwnXAxis, ballPosition, ballVelocity);
+  else
+    ballRollModel.setBall(ballPosition, ballVelocity);
+  checkIfBallIsPassingOwnYAxis(theFieldInterceptBall.intersectionPositionWithOwnYAxis, theFieldInterceptBall.timeUntilIntersectsOwnYAxis, ballPosition, ballVelocity, ballRollModel);
+  checkIfBallIsPassingOwnXAxis(theFieldInterceptBall.intersectionPositionWithOwnXAxis, theFieldInterceptBall.timeUntilIntersectsOwnXAxis, ballPosition, ballVelocity, ballRollModel);
 
   if(!theFieldInterceptBall.interceptBall)
   {
@@ -18,6 +18,7 @@
 #include "Representations/Modeling/BallModel.h"
 #include "Representations/Modeling/RobotPose.h"
 #include "Representations/Sensing/FallDownState.h"
+#include "Tools/Modeling/BallRollModel.h"
 #include "Framework/Module.h"
 
 MODULE(FieldInterceptBallProvider,
@@ -56,14 +57,16 @@ class FieldInterceptBallProvider : public FieldInterceptBallProviderBase
   /** Predicts ball motion and checks for intersection with the own local y axis
    * @param intersectionPositionWithOwnYAxis The point the ball will intersect with the own relative y-axis
    * @param timeUntilIntersectsOwnYAxis Time until intersection (in s)
-   * @param estimate The ball estimate to be used
+   * @param estimate The ball estimate to be used. It must also have been set in ballRollModel.
+   * @param ballRollModel The motion of the ball.
    */
-  void checkIfBallIsPassingOwnYAxis(Vector2f& intersectionPositionWithOwnYAxis, float& timeUntilIntersectsOwnYAxis, const Vector2f& ballPosition, const Vector2f& ballVelocity, const bool distanceCheck);
+  void checkIfBallIsPassingOwnYAxis(Vector2f& intersectionPositionWithOwnYAxis, float& timeUntilIntersectsOwnYAxis, const Vector2f& ballPosition, const Vector2f& ballVelocity, const BallRollModel& ballRollModel, const bool distanceCheck);
 
-  void checkIfBallIsPassingOwnXAxis(Vector2f& intersectionPositionWithOwnXAxis, float& timeUntilIntersectsOwnXAxis, const Vector2f& ballPosition, const Vector2f& ballVelocity, const bool distanceCheck);
+  void checkIfBallIsPassingOwnXAxis(Vector2f& intersectionPositionWithOwnXAxis, float& timeUntilIntersectsOwnXAxis, const Vector2f& ballPosition, const Vector2f& ballVelocity, const BallRollModel& ballRollModel, const bool distanceCheck);
 
   /** Calculates the position where the ball can be intercepted
    * @param fieldBall The additional ball information for the behavior
+   * @param ballRollModel The model of the ball motion, built from the current ball friction.
    */
-  void calculateInterceptedBallEndPosition(FieldInterceptBall& theFieldInterceptBall);
+  void calculateInterceptedBallEndPosition(FieldInterceptBall& theFieldInterceptBall, BallRollModel& ballRollModel);
 };
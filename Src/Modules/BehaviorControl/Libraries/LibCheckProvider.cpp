@@ -18,6 +18,10 @@ void LibCheckProvider::update(LibCheck& libCheck)
   libCheck.inc = [this](LibCheck::CheckedOutput outputToCheck) {inc(outputToCheck);};
   libCheck.dec = [this](LibCheck::CheckedOutput outputToCheck) {dec(outputToCheck);};
   libCheck.performCheck = [this] {performCheck();};
+
+  libCheck.warnsWithOptions = false;
+  FOREACH_ENUM(LibCheck::CheckedOutput, i)
+    libCheck.warnsWithOptions |= notSetReaction[i] == warn || multipleSetReaction[i] == warn;
 }
 
 void LibCheckProvider::reset()
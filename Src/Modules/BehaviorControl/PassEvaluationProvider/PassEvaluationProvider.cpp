@@ -25,6 +25,20 @@ void PassEvaluationProvider::update(PassEvaluation& thePassEvaluation)
     return getRating(baseOnField, targetOnField, isPositioning);
   };
 
+  if(positioningCellSize != positioningGridCellSize)
+  {
+    positioningGridCellSize = positioningCellSize;
+    if(positioningGridCellSize > 0.f)
+      positioningGrid = RatingGrid(ownFieldCorner, opponentFieldCorner, positioningGridCellSize);
+  }
+  positioningGrid.invalidate();
+  thePassEvaluation.getPositioningRating = [this](const Vector2f& targetOnField) -> float
+  {
+    if(positioningGridCellSize <= 0.f)
+      return getRating(theFieldBall.recentBallPositionOnField(), targetOnField, true);
+    return positioningGrid.interpolate(targetOnField, [this](const Vector2f& node) {return getRating(theFieldBall.recentBallPositionOnField(), node, true);});
+  };
+
   DECLARE_DEBUG_DRAWING("module:PassEvaluationProvider:heatmap", "drawingOnField");
   MODIFY_ONCE("module:PassEvaluationProvider:calcPassTargetFree", calcPassTargetFree);
   MODIFY_ONCE("module:PassEvaluationProvider:calcPassLineFree", calcPassLineFree);
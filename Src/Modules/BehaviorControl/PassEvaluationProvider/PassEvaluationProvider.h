@@ -18,6 +18,7 @@
 #include "Representations/Infrastructure/FrameInfo.h"
 #include "Representations/Modeling/GlobalOpponentsModel.h"
 #include "Representations/Infrastructure/GameState.h"
+#include "Tools/BehaviorControl/RatingGrid.h"
 #include <map>
 
 MODULE(PassEvaluationProvider,
@@ -43,6 +44,7 @@ MODULE(PassEvaluationProvider,
     (float)(200.f) opponentShiftToBall, /**< Shift each opponent's position this far in the direction of the ball, assuming their orientation */
     (float)(100.f) obstacleBlockingRadius, /**< Radius of opponents in which a pass would definitely fail */
     (float)(100.f) cellSize, /**< Size of each grid cell in mm on the field, lower number results in higher resolution for the heatmap */
+    (float)(200.f) positioningCellSize, /**< Distance in mm between the grid nodes from which the positioning ratings are interpolated. 0 evaluates them exactly. */
     (Vector2f)(0.f, 500.f) goalPostShift, /**< Shift the blocking area of a teammate's goal shot on the y axis away from the goal posts */
     (unsigned char)(255) heatmapAlpha, /**< Transparency of the heatmap between 0 (invisible) and 255 (opaque) */
     (ColorRGBA)(213, 17, 48) worstRatingColor, /**< Red color in RGB corresponding to a pass rating value of 0 in the heatmap */
@@ -76,6 +78,8 @@ private:
   std::vector<Vector2f> opponentsOnField;
   Vector2i cellsNumber; /**< Resolution for the heatmap i.e. number of grid cells on the corresponding axis */
   std::vector<ColorRGBA> cellColors;
+  RatingGrid positioningGrid; /**< Caches getRating(ball position, ..., true) for the whole field. */
+  float positioningGridCellSize = 0.f; /**< The cell size positioningGrid was built with. 0 if it was not built. */
 
   std::vector<float> minOpponentDistToBaseList; /**< The distance of the obstacles to the base position. The base position is used as a key. */
 
@@ -119,7 +119,19 @@ void SkillBehaviorControl::update(ActivationGraph&)
                      " location.").c_str(), true, 0.9f);
   }
 
-  beginFrame(theFrameInfo.time);
+  // On the robot, the activation graph is logged. Otherwise, it is only filled when requested or when LibCheck may need it for its warnings.
+#ifdef TARGET_ROBOT
+  bool recordActivationGraph = true;
+#else
+  bool recordActivationGraph = theLibCheck.warnsWithOptions;
+  DEBUG_RESPONSE("representation:ActivationGraph")
+    recordActivationGraph = true;
+#endif
+  bool timeOptions = false;
+  DEBUG_RESPONSE("module:SkillBehaviorControl:timeOptions")
+    timeOptions = true;
+
+  beginFrame(theFrameInfo.time, recordActivationGraph, timeOptions);
   OptionInfos::Option root = static_cast<OptionInfos::Option>(TypeRegistry::getEnumValue(typeid(OptionInfos::Option).name(), "PlaySoccer"));
   MODIFY("module:SkillBehaviorControl:root", root);
   execute(root);
@@ -29,8 +29,8 @@ float Forward::rating(const Vector2f& pos) const
 
   //normal distribution around the base pose
   const float baseRating = std::exp(-0.5f * (pos - base).squaredNorm() / sqr(p.sigmaBase));
-  const float passRating = thePassEvaluation.getRating(theFieldBall.recentBallPositionOnField(), pos, true);
-  const float goalRating = theExpectedGoals.getRating(pos, true);
+  const float passRating = thePassEvaluation.getPositioningRating(pos);
+  const float goalRating = theExpectedGoals.getPositioningRating(pos);
 
   //get distance to next field border
   const float borderDistance = std::min(std::max(0.f, theFieldDimensions.xPosOpponentGoalLine - std::abs(pos.x())),
@@ -77,7 +77,7 @@ float Midfielder::rating(const Vector2f& pos) const
   //in case of a free kick we know that we are the attacking team so we can play offensively
   //search for free spaces to receive a pass
   if(theGameState.isFreeKick() && theGameState.isForOwnTeam())
-    return cellBorderRating * baseRating * thePassEvaluation.getRating(theFieldBall.recentBallPositionOnField(), pos, true) * (p.minGoalRating + (1.f - p.minGoalRating) * theExpectedGoals.getRating(pos, true));
+    return cellBorderRating * baseRating * thePassEvaluation.getPositioningRating(pos) * (p.minGoalRating + (1.f - p.minGoalRating) * theExpectedGoals.getPositioningRating(pos));
 
   // Positions near the last communicated target pose are better
   const Vector2f lastTargetInWorld = agent.lastKnownPose * agent.lastKnownTarget; // Transform from relative to global Coordinates
@@ -7,7 +7,6 @@
 #include "LogDataProvider.h"
 #include "Platform/BHAssert.h"
 #include "Platform/Time.h"
-#include "Debugging/DebugDataStreamer.h"
 #include "Debugging/DebugDrawings3D.h"
 #include "Debugging/Debugging.h"
 #include "Debugging/DebugImages.h"
@@ -30,6 +29,7 @@ LogDataProvider::LogDataProvider() :
   theInstance = this;
   TypeInfo::initCurrent();
   states.fill(unknown);
+  representations.fill(nullptr);
   if(SystemCall::getMode() == SystemCall::logFileReplay)
     OUTPUT(idTypeInfoRequest, bin, '\0');
   ModuleContainer::addMessageHandler(handleMessage);
@@ -83,31 +83,53 @@ bool LogDataProvider::handle(MessageQueue::Message message)
     if(!logTypeInfo)
       logTypeInfo = new TypeInfo(false);
     message.bin() >> *logTypeInfo;
+    for(std::unique_ptr<TypeConverter>& converter : converters)
+      converter.reset();
     return true;
   }
   else if(SystemCall::getMode() == SystemCall::logFileReplay && !logTypeInfo)
     return false;
-  else if(Blackboard::getInstance().exists(TypeRegistry::getEnumName(message.id()) + 2) && // +2 to skip the id of the messageID enums.
-          ModuleGraphRunner::getInstance().getProvider(TypeRegistry::getEnumName(message.id()) + 2) == "LogDataProvider")
+  else if(Streamable* representation = getRepresentation(message.id()); representation)
   {
     if(logTypeInfo)
     {
       if(states[message.id()] == unknown)
       {
         // Check whether the current and the logged specifications are the same.
-        const char* type = TypeRegistry::getEnumName(message.id()) + 2;
+        const char* type = TypeRegistry::getEnumName(message.id()) + 2; // +2 to skip the id of the messageID enums.
         states[message.id()] = TypeInfo::current->areTypesEqual(*logTypeInfo, type, type) ? accept : convert;
         if(states[message.id()] == convert)
           OUTPUT_WARNING(std::string(type) + " has changed and is converted. Some fields will keep their previous values.");
       }
     }
-    readMessage(message, Blackboard::getInstance()[TypeRegistry::getEnumName(message.id()) + 2]);
+    readMessage(message, *representation);
     return true;
   }
   else
     return false;
 }
 
+Streamable* LogDataProvider::getRepresentation(MessageID id)
+{
+  if(id >= numOfDataMessageIDs)
+    return nullptr;
+
+  // The assignment of message ids to representations only changes with the module configuration.
+  const unsigned version = ModuleGraphRunner::getInstance().getConfigurationVersion();
+  if(version != representationsVersion)
+  {
+    representationsVersion = version;
+    for(int i = 0; i < numOfDataMessageIDs; ++i)
+    {
+      const char* name = TypeRegistry::getEnumName(static_cast<MessageID>(i));
+      representations[i] = name && Blackboard::getInstance().exists(name + 2) && // +2 to skip the id of the messageID enums.
+                           ModuleGraphRunner::getInstance().getProvider(name + 2) == "LogDataProvider"
+                           ? &Blackboard::getInstance()[name + 2] : nullptr;
+    }
+  }
+  return representations[id];
+}
+
 void LogDataProvider::readMessage(MessageQueue::Message message, Streamable& representation)
 {
   if(states[message.id()] != convert)
@@ -115,17 +137,13 @@ void LogDataProvider::readMessage(MessageQueue::Message message, Streamable& rep
   else
   {
     ASSERT(logTypeInfo);
-    const char* type = TypeRegistry::getEnumName(message.id()) + 2;
-
-    // Stream into textual representation in memory using type specification of log file.
-    OutMapMemory outMap(true, 16384);
-    auto stream = message.bin();
-    DebugDataStreamer streamer(*logTypeInfo, stream, type);
-    outMap << streamer;
 
-    // Read from textual representation. Errors are suppressed.
-    InMapMemory inMap(outMap.data(), outMap.size(), 0);
-    inMap >> representation;
+    // The conversion plan is created once per type and then converts directly between the binary formats.
+    std::unique_ptr<TypeConverter>& converter = converters[message.id()];
+    if(!converter)
+      converter = std::make_unique<TypeConverter>(*logTypeInfo, *TypeInfo::current, TypeRegistry::getEnumName(message.id()) + 2);
+    if(!converter->convert(message.data(), message.size(), representation))
+      return;
 
     // HACK: This does not work if anything else than the sample format is changed in AudioData.
     if(message.id() == idAudioData)
@@ -87,7 +87,9 @@
 #include "Streaming/MessageIDs.h"
 #include "Framework/Module.h"
 #include "Framework/ModuleGraphRunner.h"
+#include "Streaming/TypeConverter.h"
 #include "Streaming/TypeInfo.h"
+#include <memory>
 #include <unordered_set>
 
 // No verify when replaying logfiles
@@ -197,6 +199,9 @@ private:
   });
 
   std::array<State, numOfDataMessageIDs> states; /**< Should the corresponding message ids be replayed? */
+  std::array<std::unique_ptr<TypeConverter>, numOfDataMessageIDs> converters; /**< The converters for message ids in state "convert". */
+  std::array<Streamable*, numOfDataMessageIDs> representations; /**< The representations this module provides per message id or nullptr. */
+  unsigned representationsVersion = 0; /**< The version of the module configuration "representations" were determined for. */
   TypeInfo* logTypeInfo = nullptr; /**< The specifications of all the types from the log file. */
   bool frameDataComplete; /**< Were all messages of the current frame received? */
   OdometryData lastOdometryData; /**< The last odometry data that was provided. Used for computing offset. */
@@ -293,6 +298,14 @@ private:
    */
   bool handle(MessageQueue::Message message);
 
+  /**
+   * Returns the representation provided by this module that is stored in
+   * messages with a certain id.
+   * @param id The message id.
+   * @return The representation or nullptr if this module does not provide it.
+   */
+  Streamable* getRepresentation(MessageID id);
+
   /**
    * Read a representation from a message.
    * @param message The message to read from.
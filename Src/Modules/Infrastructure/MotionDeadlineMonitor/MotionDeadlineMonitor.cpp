@@ -0,0 +1,134 @@
+/**
+ * @file MotionDeadlineMonitor.cpp
+ *
+ * This file implements a module that monitors whether the motion thread
+ * meets its deadline.
+ */
+
+#include "MotionDeadlineMonitor.h"
+#include "Debugging/Annotation.h"
+#include "Framework/ModuleGraphRunner.h"
+#include "Framework/Settings.h"
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+MAKE_MODULE(MotionDeadlineMonitor);
+
+thread_local MotionDeadlineMonitor* MotionDeadlineMonitor::theInstance = nullptr;
+
+MotionDeadlineMonitor::MotionDeadlineMonitor()
+{
+  theInstance = this;
+  updateParameters();
+}
+
+MotionDeadlineMonitor::~MotionDeadlineMonitor()
+{
+  theInstance = nullptr;
+}
+
+void MotionDeadlineMonitor::update(MotionDeadlineStatus& theMotionDeadlineStatus)
+{
+  updateParameters();
+  theMotionDeadlineStatus = status;
+}
+
+void MotionDeadlineMonitor::updateParameters()
+{
+  status.deadline = static_cast<unsigned>(Global::getSettings().motionCycleTime * deadlineFactor * 1000000.f);
+  status.histogramBinWidth = histogramBinWidth;
+  if(status.latencyHistogram.size() != std::max(numOfHistogramBins, 1u))
+    status.latencyHistogram.assign(std::max(numOfHistogramBins, 1u), 0);
+}
+
+unsigned long long MotionDeadlineMonitor::now()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void MotionDeadlineMonitor::frameDataReceived(unsigned long long arrival)
+{
+  if(theInstance)
+    theInstance->frameDataArrival = arrival ? arrival : now();
+}
+
+void MotionDeadlineMonitor::frameFinished()
+{
+  if(theInstance)
+    theInstance->frameFinished2();
+}
+
+void MotionDeadlineMonitor::frameFinished2()
+{
+  if(!frameDataArrival)
+    return;
+
+  const unsigned long long finished = now();
+  const unsigned latency = finished > frameDataArrival ? static_cast<unsigned>(finished - frameDataArrival) : 0;
+  frameDataArrival = 0;
+
+  status.lastLatency = latency;
+  status.maxLatency = std::max(status.maxLatency, latency);
+  ++status.framesMeasured;
+  const float relativeLatency = static_cast<float>(latency) / static_cast<float>(std::max(status.deadline, 1u));
+  const size_t bin = std::min(static_cast<size_t>(relativeLatency / status.histogramBinWidth), status.latencyHistogram.size() - 1);
+  ++status.latencyHistogram[bin];
+
+  const bool missed = latency > status.deadline;
+  if(missed)
+  {
+    ++status.missedDeadlines;
+    ++status.consecutiveMisses;
+
+    providerTimes.clear();
+    ModuleGraphRunner::getInstance().forEachProviderDuration([this](const char* representation, unsigned duration)
+    {
+      if(duration)
+        providerTimes.emplace_back(representation, duration);
+    });
+    const size_t numOfProviders = std::min(static_cast<size_t>(numOfProvidersAnnotated), providerTimes.size());
+    std::partial_sort(providerTimes.begin(), providerTimes.begin() + numOfProviders, providerTimes.end(),
+                      [](const std::pair<const char*, unsigned>& a, const std::pair<const char*, unsigned>& b) {return a.second > b.second;});
+
+    std::stringstream slowest;
+    for(size_t i = 0; i < numOfProviders; ++i)
+      slowest << (i ? ", " : "") << providerTimes[i].first << " " << providerTimes[i].second << " µs";
+    if(numOfProviders)
+    {
+      status.slowestProvider = providerTimes.front().first;
+      status.slowestProviderTime = providerTimes.front().second;
+    }
+    ANNOTATION("MotionDeadlineMonitor", "Deadline missed: " << latency << " µs > " << status.deadline << " µs (" << slowest.str() << ")");
+  }
+  else
+    status.consecutiveMisses = 0;
+
+  updateSafeMode(missed);
+}
+
+void MotionDeadlineMonitor::updateSafeMode(bool missed)
+{
+  if(theFrameInfo.getTimeSince(secondStart) >= 1000)
+  {
+    secondStart = theFrameInfo.time;
+    missesInSecond = 0;
+  }
+
+  if(missed)
+  {
+    lastMiss = theFrameInfo.time;
+    ++missesInSecond;
+    if(enableSafeMode && !status.safeMode
+       && (status.consecutiveMisses >= consecutiveMissesForSafeMode || missesInSecond >= missesPerSecondForSafeMode))
+    {
+      status.safeMode = true;
+      ANNOTATION("MotionDeadlineMonitor", "Safe mode activated.");
+    }
+  }
+  else if(status.safeMode && theFrameInfo.getTimeSince(lastMiss) >= safeModeRecoveryTime)
+  {
+    status.safeMode = false;
+    ANNOTATION("MotionDeadlineMonitor", "Safe mode deactivated.");
+  }
+}
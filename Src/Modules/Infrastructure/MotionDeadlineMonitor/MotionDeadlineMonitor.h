@@ -0,0 +1,84 @@
+/**
+ * @file MotionDeadlineMonitor.h
+ *
+ * This file declares a module that monitors whether the motion thread
+ * meets its deadline. The time is measured from the arrival of new
+ * sensor data to the moment the joint commands were sent to the robot.
+ * The measurement is triggered by the execution unit of the motion thread
+ * through static methods, similar to the robot providers. Each missed
+ * deadline is annotated together with the slowest providers of that
+ * frame. If deadlines are missed repeatedly, a safe mode can be
+ * activated, in which only standing and the fall engine are used.
+ */
+
+#pragma once
+
+#include "Framework/Module.h"
+#include "Representations/Infrastructure/FrameInfo.h"
+#include "Representations/Infrastructure/MotionDeadlineStatus.h"
+
+MODULE(MotionDeadlineMonitor,
+{,
+  REQUIRES(FrameInfo),
+  PROVIDES(MotionDeadlineStatus),
+  DEFINES_PARAMETERS(
+  {,
+    (float)(1.f) deadlineFactor, /**< The deadline relative to the motion cycle time. */
+    (unsigned)(20) numOfHistogramBins, /**< The number of bins of the latency histogram (including the overflow bin). */
+    (float)(0.1f) histogramBinWidth, /**< The width of each histogram bin relative to the deadline. */
+    (unsigned)(3) numOfProvidersAnnotated, /**< The number of slowest providers mentioned in each annotation. */
+    (bool)(false) enableSafeMode, /**< Switch to the safe mode if deadlines are missed repeatedly? */
+    (unsigned)(5) consecutiveMissesForSafeMode, /**< This many directly successive misses activate the safe mode. */
+    (unsigned)(20) missesPerSecondForSafeMode, /**< This many misses within one second activate the safe mode. */
+    (int)(3000) safeModeRecoveryTime, /**< The safe mode is left after no deadline was missed for this long (in ms). */
+  }),
+});
+
+class MotionDeadlineMonitor : public MotionDeadlineMonitorBase
+{
+  static thread_local MotionDeadlineMonitor* theInstance; /**< The only instance of this module. */
+
+  MotionDeadlineStatus status; /**< The status accumulated, copied to the representation in each frame. */
+  unsigned long long frameDataArrival = 0; /**< When did the data of the current frame arrive (in µs)? 0 if unknown. */
+  std::vector<std::pair<const char*, unsigned>> providerTimes; /**< Buffer for the provider times of the current frame. */
+  unsigned lastMiss = 0; /**< The frame time when the deadline was missed the last time. */
+  unsigned missesInSecond = 0; /**< The number of misses in the current second. */
+  unsigned secondStart = 0; /**< The frame time when the current second started. */
+
+  /**
+   * This method is called when the representation provided needs to be updated.
+   * @param theMotionDeadlineStatus The representation updated.
+   */
+  void update(MotionDeadlineStatus& theMotionDeadlineStatus) override;
+
+  /** Applies the current parameters and settings to the deadline and the histogram. */
+  void updateParameters();
+
+  /** Measures the latency of the current frame (called by static method). */
+  void frameFinished2();
+
+  /**
+   * Updates the safe mode state.
+   * @param missed Was the deadline missed in the current frame?
+   */
+  void updateSafeMode(bool missed);
+
+public:
+  MotionDeadlineMonitor();
+  ~MotionDeadlineMonitor();
+
+  /**
+   * Returns the current time of the clock used for all measurements.
+   * @return The time in µs.
+   */
+  static unsigned long long now();
+
+  /**
+   * Signals that the sensor data for the next frame have arrived.
+   * @param arrival When did they arrive (in µs, see now())? 0 means now.
+   */
+  static void frameDataReceived(unsigned long long arrival = 0);
+
+  /** Signals that the joint commands of the current frame were sent. */
+  static void frameFinished();
+};
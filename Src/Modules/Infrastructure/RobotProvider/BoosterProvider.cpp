@@ -17,6 +17,7 @@
 #include "Platform/Thread.h"
 #include "Platform/Time.h"
 #ifdef TARGET_BOOSTER
+#include <chrono>
 #include <fcntl.h>
 #include <linux/input.h>
 #include <unistd.h>
@@ -132,7 +133,8 @@ void BoosterProvider::robotStatusHandler([[maybe_unused]] const void* msg)
 void BoosterProvider::lowStateHandler2(const booster_interface::msg::LowState& lowState)
 {
   ASSERT(lowState.motor_state_serial().size() == jointMapping.size()); // TODO check whether this works for K1
-  SYNC;
+  LowState& state = lowStates.writeBuffer();
+  JointSensorData& jointSensorData = state.jointSensorData;
   for(size_t joint : {Joints::lWristYaw, Joints::lHand, Joints::rWristYaw, Joints::rHand})
   {
     jointSensorData.angles[joint] = 0_deg;
@@ -156,55 +158,68 @@ void BoosterProvider::lowStateHandler2(const booster_interface::msg::LowState& l
                                     : JointSensorData::criticallyHot;
   }
 
-  if(!armPositionsOK)
-  {
-    if(!shoulderPitchRangeAtStart.isInside(jointSensorData.angles[Joints::lShoulderPitch]) || !shoulderPitchRangeAtStart.isInside(jointSensorData.angles[Joints::rShoulderPitch]))
-    {
-      if(theFrameInfo.getTimeSince(armPositionWarning) > armsWarningTime)
-      {
-        armPositionWarning = theFrameInfo.time;
-        SystemCall::playSound("siren", true);
-        SystemCall::say("Wrong Arm Position");
-        if(!shoulderPitchRangeAtStart.isInside(jointSensorData.angles[Joints::lShoulderPitch]))
-          SystemCall::say("Left Arm");
-        if(!shoulderPitchRangeAtStart.isInside(jointSensorData.angles[Joints::rShoulderPitch]))
-          SystemCall::say("Right Arm");
-      }
-    }
-    else
-    {
-      armPositionsOK = true;
-      if(armPositionWarning != 0)
-        SystemCall::say("Arms are correct");
-    }
-  }
-
+  RawInertialSensorData& rawInertialSensorData = state.rawInertialSensorData;
   rawInertialSensorData.gyro = {lowState.imu_state().gyro()[0], lowState.imu_state().gyro()[1], lowState.imu_state().gyro()[2]};
   rawInertialSensorData.acc = {lowState.imu_state().acc()[0], lowState.imu_state().acc()[1], lowState.imu_state().acc()[2]};
   rawInertialSensorData.angle = {lowState.imu_state().rpy()[0], lowState.imu_state().rpy()[1], lowState.imu_state().rpy()[2]};
 
   jointSensorData.timestamp = Time::getRealSystemTime();
+  state.arrival = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  if(lowStates.publish())
+    overwrittenFrames.fetch_add(1, std::memory_order_relaxed);
   frameDataSignal.post();
 }
 
 void BoosterProvider::robotStatusHandler2(const booster_interface::msg::RobotStatusDdsMsg& robotStatus)
 {
-  SYNC;
-
   const std::vector<booster_interface::msg::RobotDdsBatteryStatus>& batteryStatuses = robotStatus.battery_vec();
   if(!batteryStatuses.empty())
   {
     systemSensorData.batteryLevel = batteryStatuses.front().soc() * 0.01f;
     systemSensorData.batteryCharging = false;
+    systemSensorDatas.writeBuffer() = systemSensorData;
+    systemSensorDatas.publish();
   }
 
-  connectedJoints = 0;
+  size_t connectedJoints = 0;
   for(const booster_interface::msg::RobotDdsJointStatus& joint : robotStatus.joint_vec())
     if(joint.is_connected())
       ++connectedJoints;
+  this->connectedJoints = connectedJoints;
+}
+
+void BoosterProvider::checkArmPositions()
+{
+  const JointSensorData& jointSensorData = lowStates.readBuffer().jointSensorData;
+  if(!shoulderPitchRangeAtStart.isInside(jointSensorData.angles[Joints::lShoulderPitch]) || !shoulderPitchRangeAtStart.isInside(jointSensorData.angles[Joints::rShoulderPitch]))
+  {
+    if(theFrameInfo.getTimeSince(armPositionWarning) > armsWarningTime)
+    {
+      armPositionWarning = theFrameInfo.time;
+      SystemCall::playSound("siren", true);
+      SystemCall::say("Wrong Arm Position");
+      if(!shoulderPitchRangeAtStart.isInside(jointSensorData.angles[Joints::lShoulderPitch]))
+        SystemCall::say("Left Arm");
+      if(!shoulderPitchRangeAtStart.isInside(jointSensorData.angles[Joints::rShoulderPitch]))
+        SystemCall::say("Right Arm");
+    }
+  }
+  else
+  {
+    armPositionsOK = true;
+    if(armPositionWarning != 0)
+      SystemCall::say("Arms are correct");
+  }
 }
 #endif
 
+void BoosterProvider::update(SystemSensorData& theSystemSensorData)
+{
+  theSystemSensorData = systemSensorDatas.readBuffer();
+  theSystemSensorData.missedFrames = missedFrames;
+  theSystemSensorData.overwrittenFrames = overwrittenFrames.load(std::memory_order_relaxed);
+}
+
 void BoosterProvider::waitForFrameData()
 {
   if(theInstance)
@@ -233,27 +248,27 @@ void BoosterProvider::waitForFrameData2()
     }
   }
 
-  bool lowStateReceived = false;
-  if(!frameDataSignal.wait(maxDelayForFrameData))
+  // The signal can be posted for a low state that was already fetched, so only the buffer is trusted.
+  bool lowStateReceived = lowStates.fetch();
+  while(!lowStateReceived && frameDataSignal.wait(maxDelayForFrameData))
+    lowStateReceived = lowStates.fetch();
+  while(frameDataSignal.tryWait());
+  if(!lowStateReceived)
   {
-    if(!theFrameInfo.time && !waitingAnnounced)
+    if(theFrameInfo.time)
+      ++missedFrames;
+    else if(!waitingAnnounced)
     {
       SystemCall::say("Waiting for low level services");
       waitingAnnounced = true;
       robotMode = booster::robot::RobotMode::kUnknown;
     }
   }
-  else
-  {
-    while(frameDataSignal.tryWait());
-    lowStateReceived = true;
-  }
+  else if(!armPositionsOK)
+    checkArmPositions();
+  systemSensorDatas.fetch();
 
-  size_t connectedJoints;
-  {
-    SYNC; // allConnected is set in another thread
-    connectedJoints = this->connectedJoints;
-  }
+  const size_t connectedJoints = this->connectedJoints;
 
   bool canLeaveEmergencyMode = false;
 
@@ -313,6 +328,13 @@ void BoosterProvider::waitForFrameData2()
 #endif
 }
 
+unsigned long long BoosterProvider::getFrameDataArrival()
+{
+  if(!theInstance)
+    return 0;
+  return theInstance->lowStates.readBuffer().arrival;
+}
+
 void BoosterProvider::finishFrame()
 {
   if(theInstance)
@@ -335,7 +357,7 @@ void BoosterProvider::finishFrame2()
        || theJointRequest.angles[index] == SensorData::off
        || theJointRequest.stiffnessData.stiffnesses[index] <= 0)
     {
-      motorCmd.q(jointSensorData.angles[index]);
+      motorCmd.q(lowStates.readBuffer().jointSensorData.angles[index]);
       motorCmd.kp(0.f);
       motorCmd.kd(0.f);
       motorCmd.tau(0.f);
@@ -14,7 +14,7 @@
 
 #include "Framework/Module.h"
 #include "Platform/Semaphore.h"
-#include "Platform/Thread.h"
+#include "Platform/TripleBuffer.h"
 #include "Representations/Configuration/JointCalibration.h"
 #include "Representations/Infrastructure/FrameInfo.h"
 #include "Representations/Infrastructure/JointRequest.h"
@@ -72,15 +72,24 @@ MODULE(BoosterProvider,
 
 class BoosterProvider : public BoosterProviderBase
 {
-  DECLARE_SYNC; /**< Data is received in a different thread, so synchronize access. */
+  /** The data received with a single low state message. */
+  struct LowState
+  {
+    JointSensorData jointSensorData; /**< The joint sensor data received. */
+    RawInertialSensorData rawInertialSensorData; /**< The inertial sensor data received. */
+    unsigned long long arrival = 0; /**< When did the message arrive (in µs of the steady clock)? 0 if never. */
+  };
+
 #ifndef TARGET_BOOSTER
   thread_local
 #endif
   static BoosterProvider* theInstance; /**< The only instance of this module. */
-  JointSensorData jointSensorData; /**< The joint sensor data received. */
-  RawInertialSensorData rawInertialSensorData; /**< The inertial sensor data received. */
-  SystemSensorData systemSensorData; /** The battery status received. */
-  Semaphore frameDataSignal; /**< A signal used for synchronizing lowStateHandler() and waitForFrameData2(). */
+  // Data is received in different threads. It is handed over without locks to avoid priority inversion.
+  TripleBuffer<LowState> lowStates; /**< The low states received. */
+  TripleBuffer<SystemSensorData> systemSensorDatas; /**< The battery statuses received. */
+  Semaphore frameDataSignal; /**< A futex-based signal used for synchronizing lowStateHandler() and waitForFrameData2(). */
+  std::atomic<unsigned> overwrittenFrames = 0; /**< The number of low states that were replaced before the motion thread used them. */
+  unsigned missedFrames = 0; /**< The number of frames in which no low state arrived in time. */
 
 #ifdef TARGET_BOOSTER
   booster::robot::b1::B1LocoClient client; /**< A client for activating custom mode again after emergency mode. */
@@ -90,7 +99,8 @@ class BoosterProvider : public BoosterProviderBase
   booster::robot::RobotMode robotMode = booster::robot::RobotMode::kUnknown; /**< The current client mode of the robot. kUnknown equals emergency mode. */
   booster_interface::msg::LowCmd lowCmd; /**< The current low level joint command. */
   int keyInputHandle; /**< The input events from the keyboard of the robot. */
-  size_t connectedJoints; /**< How many joints are connected? */
+  std::atomic<size_t> connectedJoints; /**< How many joints are connected? */
+  SystemSensorData systemSensorData; /** The battery status received (only used in the thread receiving it). */
   bool waitingForHighLevelServices = false; /**< Waiting for high-level services to connect? */
   bool waitingForLowLevelServices = true; /**< Waiting for low-level services to connect? */
   bool waitingAnnounced = false; /**< Was announced that we are waiting for the robot to be ready? */
@@ -104,16 +114,16 @@ class BoosterProvider : public BoosterProviderBase
    * This method is called when the representation provided needs to be updated.
    * @param theFrameInfo The representation updated.
    */
-  void update(FrameInfo& theFrameInfo) override {SYNC; theFrameInfo.time = jointSensorData.timestamp;}
+  void update(FrameInfo& theFrameInfo) override {theFrameInfo.time = lowStates.readBuffer().jointSensorData.timestamp;}
 
   /**
    * This method is called when the representation provided needs to be updated.
    * @param theJointSensorData The representation updated.
    */
 #ifdef TARGET_BOOSTER
-  void update(JointSensorData& theJointSensorData) override {SYNC; theJointSensorData = jointSensorData;}
+  void update(JointSensorData& theJointSensorData) override {theJointSensorData = lowStates.readBuffer().jointSensorData;}
 #else
-  void update(JointSensorData& theJointSensorData) override {SYNC; static_cast<JointAngles&>(theJointSensorData) = theJointRequest;}
+  void update(JointSensorData& theJointSensorData) override {static_cast<JointAngles&>(theJointSensorData) = theJointRequest;}
 #endif
 
   /**
@@ -126,13 +136,13 @@ class BoosterProvider : public BoosterProviderBase
    * This method is called when the representation provided needs to be updated.
    * @param theRawInertialSensorData The representation updated.
    */
-  void update(RawInertialSensorData& theRawInertialSensorData) override {SYNC; theRawInertialSensorData = rawInertialSensorData;}
+  void update(RawInertialSensorData& theRawInertialSensorData) override {theRawInertialSensorData = lowStates.readBuffer().rawInertialSensorData;}
 
   /**
    * This method is called when the representation provided needs to be updated.
    * @param theSystemSensorData The representation updated.
    */
-  void update(SystemSensorData& theSystemSensorData) override {SYNC; theSystemSensorData = systemSensorData;}
+  void update(SystemSensorData& theSystemSensorData) override;
 
   /**
    * Get the name of the input event that is triggered by key presses.
@@ -164,6 +174,9 @@ class BoosterProvider : public BoosterProviderBase
    * @param robotStatus The low state message.
    */
   void robotStatusHandler2(const booster_interface::msg::RobotStatusDdsMsg& robotStatus);
+
+  /** Warns if the arms are not correctly rotated after starting. */
+  void checkArmPositions();
 #endif
 
   /** Waits for the next data to arrive from the Booster robot (called by static method). */
@@ -181,4 +194,10 @@ public:
 
   /** Send requests to Booster robot. */
   static void finishFrame();
+
+  /**
+   * Returns when the data of the current frame arrived.
+   * @return The arrival time in µs of the steady clock or 0 if unknown.
+   */
+  static unsigned long long getFrameDataArrival();
 };
@@ -2,7 +2,11 @@
  * @file BallStateEstimateFilters.h
  *
  * Different state estimators for rolling and stationary balls.
- * Currently based on a standard Kalman filters
+ * Currently based on a standard Kalman filters.
+ * All hypotheses of one kind are stored as a structure of arrays,
+ * i.e. each quantity is a row and each hypothesis is a column.
+ * This allows to predict and update all of them in a single vectorized
+ * pass.
  *
  * @author Tim Laue
  */
@@ -12,248 +16,374 @@
 #include "Debugging/Debugging.h"
 #include "Tools/Modeling/BallPhysics.h"
 #include "Tools/Modeling/BallLocatorTools.h"
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
 
 /**
- * Generic base class for estimates.
- * Provides just a few members and functions to
- * avoid the duplication of code
+ * Generic base class for sets of estimates.
+ * Provides the members and functions that are shared by
+ * stationary and rolling balls.
+ * @tparam stateSize The number of dimensions of the state. The first
+ *                   two are always the position.
  */
-class BallStateEstimate
+template<int stateSize>
+class BallStateEstimates
 {
 public:
-  float radius = 1.f;                                     /**< Last perceived radius of the ball */
-  int numOfMeasurements = 0;                              /**< The number of measurements that have been fused in this hypothesis */
-  float nllOfMeasurements = 0.f;                          /**< Sum of negative log-likelihoods (NLLs) of integrated measurements, shifted in relation to hypothesis with lowest value (which then has a value of 0) */
-  float nllWeighting = std::numeric_limits<float>::max(); /**< Kind of NLL of hypothesis (NLL of measurements plus NLL at mean of covariance) */
-  Vector2f lastPosition = Vector2f::Zero();               /**< Store position before update, needed for collision detection */
-  unsigned timeOfLastCollision = 0;                       /**< The last point of time when the estimate computation incorporated a collision with the robot */
+  static constexpr int capacity = 64; /**< The maximum number of hypotheses. */
+
+  template<int rows> using Rows = Eigen::Array<float, rows, capacity, Eigen::RowMajor>;
+  using Vector = Eigen::Matrix<float, stateSize, 1>;
+  using Matrix = Eigen::Matrix<float, stateSize, stateSize>;
+
+  int size = 0;                                           /**< The number of hypotheses, i.e. of columns in use */
+  Rows<stateSize> x;                                      /**< The means of all hypotheses */
+  Rows<stateSize * stateSize> P;                          /**< The covariance matrices of all hypotheses. Row r * stateSize + c contains element (r, c). */
+  Rows<2> lastPosition;                                   /**< Store positions before update, needed for collision detection */
+  Rows<1> radius;                                         /**< Last perceived radius of the ball */
+  Rows<1> nllOfMeasurements;                              /**< Sum of negative log-likelihoods (NLLs) of integrated measurements, shifted in relation to hypothesis with lowest value (which then has a value of 0) */
+  Rows<1> nllWeighting;                                   /**< Kind of NLL of hypothesis (NLL of measurements plus NLL at mean of covariance) */
+  std::array<int, capacity> numOfMeasurements;            /**< The number of measurements that have been fused in each hypothesis */
+  std::array<unsigned, capacity> timeOfLastCollision;     /**< The last point of time when the estimate computation incorporated a collision with the robot */
 
   /**
-   * Make sure that destructors of derived objects are virtual.
+   * Adds a new hypothesis with an identity covariance and no measurements.
+   * @return The index of the new hypothesis.
    */
-  virtual ~BallStateEstimate() = default;
+  int add()
+  {
+    ASSERT(size < capacity);
+    const int i = size++;
+    x.col(i).setZero();
+    setCovariance(i, Matrix::Identity());
+    lastPosition.col(i).setZero();
+    radius(i) = 1.f;
+    nllOfMeasurements(i) = 0.f;
+    nllWeighting(i) = std::numeric_limits<float>::max();
+    numOfMeasurements[i] = 0;
+    timeOfLastCollision[i] = 0;
+    return i;
+  }
 
   /**
-   * Updates hypothesis based on a new measurement
-   * and thus updates mean and covariance as well as weight, height, and radius
-   * @param measurement The ball perception in relative field coordinates
-   * @param measurementCov The covariance of the measurement
-   * @param radius The radius of the perceived ball (for scenarios with variable ball sizes)
+   * Removes a hypothesis. The order of the remaining ones is kept.
+   * @param i The index of the hypothesis.
    */
-  void measurementUpdate(const Vector2f& measurement, const Matrix2f& measurementCov, float radius)
+  void remove(int i)
   {
-    // Compute quality of estimate (w.r.t. the current measurement) before integrating the measurement:
-    const Vector2f x = getPosition();
-    const Matrix2f P = getPositionCovariance();
-    const float gain = BallLocatorTools::getNLLOfPosition(measurement, measurementCov, x);
-    ASSERT(std::isfinite(gain));
-    nllOfMeasurements += gain;
-    nllWeighting = nllOfMeasurements + BallLocatorTools::getNLLOfMean(P);
-
-    // Major estimation step, performed by subclass:
-    integrateMeasurement(measurement, measurementCov);
-    // Update statistics and ball radius:
-    this->radius = radius;
-    ++numOfMeasurements;
+    for(--size; i < size; ++i)
+      move(i + 1, i);
   }
 
+  /** Removes all hypotheses. */
+  void clear() { size = 0; }
+
   /**
-   * Measurement integration step of the filter.
-   * Needs to be implemented by each subclass.
-   * @param measurement The ball perception in relative field coordinates
-   * @param measurementCov The covariance of the measurement
+   * Keeps only the hypotheses with the lowest weightings.
+   * @param count The maximum number of hypotheses that remain.
    */
-  virtual void integrateMeasurement(const Vector2f& measurement, const Matrix2f& measurementCov) = 0;
+  void keepBest(int count)
+  {
+    if(size <= count)
+      return;
+    std::array<int, capacity> indices;
+    std::iota(indices.begin(), indices.begin() + size, 0);
+    std::sort(indices.begin(), indices.begin() + size, [this](int a, int b) {return nllWeighting(a) < nllWeighting(b);});
+    const BallStateEstimates other = *this;
+    for(int i = 0; i < count; ++i)
+      copy(other, indices[i], i);
+    size = count;
+  }
 
   /**
-   * Every instance of a filter has to implement this function for getting the ball estimate position
-   * @return The position of the ball (on the field, relative to the robot)
+   * Returns the position of a hypothesis.
+   * @param i The index of the hypothesis.
+   * @return The position of the ball (on the field, relative to the robot).
    */
-  const virtual Vector2f getPosition() const = 0;
+  Vector2f getPosition(int i) const { return Vector2f(x(0, i), x(1, i)); }
 
   /**
-   * Every instance of a filter has to implement this function for getting the ball estimate position uncertainty
-   * @return The filter covariance reading the position estimate
+   * Returns the velocity of a hypothesis.
+   * @param i The index of the hypothesis.
+   * @return The velocity of the ball (on the field, relative to the robot), (0,0) for stationary balls.
    */
-  const virtual Matrix2f getPositionCovariance() const = 0;
+  Vector2f getVelocity(int i) const
+  {
+    if constexpr(stateSize == 4)
+      return Vector2f(x(2, i), x(3, i));
+    else
+      return Vector2f::Zero();
+  }
 
   /**
-   * Every instance of a filter can implement this function for getting the ball estimate velocity
-   * @return The velocity of the ball (on the field, relative to the robot), (0,0) by default
+   * Returns the uncertainty of the position of a hypothesis.
+   * @param i The index of the hypothesis.
+   * @return The upper left part of the covariance matrix.
    */
-  const virtual Vector2f getVelocity() const { return Vector2f::Zero(); }
-};
-
-/**
- * State estimation for a stationary / lying ball.
- * Based on a standard Kalman filter
- */
-class StationaryBallKalmanFilter : public BallStateEstimate
-{
-public:
-  Vector2f x = Vector2f::Zero();       /**< Mean of the estimated stationary ball */
-  Matrix2f P = Matrix2f::Identity();   /**< Covariance matrix of the ball estimate */
+  Matrix2f getPositionCovariance(int i) const
+  {
+    return (Matrix2f() << P(0, i), P(1, i), P(stateSize, i), P(stateSize + 1, i)).finished();
+  }
 
-  /** Returns the mean of the internal estimate
-    * @return Yes, exactly.
-    */
-  const Vector2f getPosition() const { return x; }
+  /**
+   * Returns the covariance matrix of a hypothesis.
+   * @param i The index of the hypothesis.
+   * @return The full covariance matrix.
+   */
+  Matrix getCovariance(int i) const
+  {
+    Matrix cov;
+    for(int r = 0; r < stateSize; ++r)
+      for(int c = 0; c < stateSize; ++c)
+        cov(r, c) = P(r * stateSize + c, i);
+    return cov;
+  }
 
-  /** Returns the covariance of the internal estimate
-   * @return Yes, exactly.
+  /**
+   * Sets the covariance matrix of a hypothesis.
+   * @param i The index of the hypothesis.
+   * @param cov The new covariance matrix.
    */
-  const Matrix2f getPositionCovariance() const { return P; }
+  void setCovariance(int i, const Matrix& cov)
+  {
+    for(int r = 0; r < stateSize; ++r)
+      for(int c = 0; c < stateSize; ++c)
+        P(r * stateSize + c, i) = cov(r, c);
+  }
 
-  /** Moves hypothesis and updates mean and covariance accordingly */
-  void motionUpdate(const Vector4f& squaredProcessCov,
-                    const Vector4f& odometryTranslationCov,
-                    const Matrix2f& fixedOdometryRotation, const Vector2f& fixedOdometryTranslation,
-                    const Matrix2f& fixedOdometryRotationTransposed, const Matrix2f& fixedOdometryRotationDeviationRotation)
+  /**
+   * Updates all hypotheses based on a new measurement
+   * and thus updates means and covariances as well as weights and radii.
+   * @param measurement The ball perception in relative field coordinates
+   * @param measurementCov The covariance of the measurement
+   * @param radius The radius of the perceived ball (for scenarios with variable ball sizes)
+   */
+  void measurementUpdate(const Vector2f& measurement, const Matrix2f& measurementCov, float radius)
   {
-    // save old position
-    lastPosition = x;
+    if(!size)
+      return;
+    const int n = size;
+
+    // Compute quality of estimates (w.r.t. the current measurement) before integrating the measurement,
+    // i.e. BallLocatorTools::getNLLOfPosition and BallLocatorTools::getNLLOfMean for all hypotheses.
+    const Matrix2f measurementCovInv = measurementCov.inverse();
+    Rows<1> dx, dy;
+    dx.head(n) = x.row(0).head(n) - measurement.x();
+    dy.head(n) = x.row(1).head(n) - measurement.y();
+    nllOfMeasurements.head(n) += 0.5f * (measurementCovInv(0, 0) * dx.head(n).square()
+                                         + (measurementCovInv(0, 1) + measurementCovInv(1, 0)) * dx.head(n) * dy.head(n)
+                                         + measurementCovInv(1, 1) * dy.head(n).square());
+    ASSERT(nllOfMeasurements.head(n).isFinite().all());
+    nllWeighting.head(n) = nllOfMeasurements.head(n)
+                           + 0.5f * (P.row(0).head(n) * P.row(stateSize + 1).head(n)
+                                     - P.row(1).head(n) * P.row(stateSize).head(n)).max(0.f).log();
+
+    // Kalman gain K = P.leftCols<2>() * (P.topLeftCorner<2, 2>() + measurementCov).inverse()
+    Rows<1> s00, s01, s10, s11, invDet;
+    s00.head(n) = P.row(0).head(n) + measurementCov(0, 0);
+    s01.head(n) = P.row(1).head(n) + measurementCov(0, 1);
+    s10.head(n) = P.row(stateSize).head(n) + measurementCov(1, 0);
+    s11.head(n) = P.row(stateSize + 1).head(n) + measurementCov(1, 1);
+    invDet.head(n) = (s00.head(n) * s11.head(n) - s01.head(n) * s10.head(n)).inverse();
+    Rows<stateSize> k0, k1;
+    for(int r = 0; r < stateSize; ++r)
+    {
+      k0.row(r).head(n) = (P.row(r * stateSize).head(n) * s11.head(n) - P.row(r * stateSize + 1).head(n) * s10.head(n)) * invDet.head(n);
+      k1.row(r).head(n) = (P.row(r * stateSize + 1).head(n) * s00.head(n) - P.row(r * stateSize).head(n) * s01.head(n)) * invDet.head(n);
+    }
+
+    // x += K * (measurement - x.topRows<2>()), P -= K * P.topRows<2>()
+    const Rows<2 * stateSize> topRows = P.template topRows<2 * stateSize>();
+    for(int r = 0; r < stateSize; ++r)
+    {
+      x.row(r).head(n) -= k0.row(r).head(n) * dx.head(n) + k1.row(r).head(n) * dy.head(n);
+      for(int c = 0; c < stateSize; ++c)
+        P.row(r * stateSize + c).head(n) -= k0.row(r).head(n) * topRows.row(c).head(n) + k1.row(r).head(n) * topRows.row(stateSize + c).head(n);
+    }
 
-    // predict
-    x = fixedOdometryRotation * x + fixedOdometryTranslation;
-    P = fixedOdometryRotation * P * fixedOdometryRotationTransposed;
+    // Update statistics and ball radius:
+    this->radius.head(n) = radius;
+    for(int i = 0; i < n; ++i)
+      ++numOfMeasurements[i];
+  }
 
-    // add process noise
-    P.diagonal() += squaredProcessCov.head<2>();
+  /**
+   * Subtracts the lowest NLL of measurements of two sets of hypotheses from all of them.
+   * @param other The other set of hypotheses.
+   */
+  template<int otherStateSize>
+  void normalizeMeasurementLikelihoods(BallStateEstimates<otherStateSize>& other)
+  {
+    const float lowestNLLOfMeasurements = std::min(size ? nllOfMeasurements.head(size).minCoeff() : std::numeric_limits<float>::max(),
+                                                   other.size ? other.nllOfMeasurements.head(other.size).minCoeff() : std::numeric_limits<float>::max());
+    ASSERT(lowestNLLOfMeasurements < std::numeric_limits<float>::max() || (!size && !other.size));
+    nllOfMeasurements.head(size) -= lowestNLLOfMeasurements;
+    other.nllOfMeasurements.head(other.size) -= lowestNLLOfMeasurements;
+  }
 
-    // add odometry translation noise
-    P.diagonal() += odometryTranslationCov.head<2>();
+  /**
+   * Copies all the information except for the state and the covariance
+   * from a hypothesis of another set.
+   * @param other The other set of hypotheses.
+   * @param from The index of the hypothesis in the other set.
+   * @param to The index of the hypothesis in this set.
+   */
+  template<int otherStateSize>
+  void copyStatistics(const BallStateEstimates<otherStateSize>& other, int from, int to)
+  {
+    lastPosition.col(to) = other.lastPosition.col(from);
+    radius(to) = other.radius(from);
+    nllOfMeasurements(to) = other.nllOfMeasurements(from);
+    nllWeighting(to) = other.nllWeighting(from);
+    numOfMeasurements[to] = other.numOfMeasurements[from];
+    timeOfLastCollision[to] = other.timeOfLastCollision[from];
+  }
 
-    // add noise from odometry rotation (crude approximation)
-    const Vector2f squaredOdometryRotationDeviationTranslation = (fixedOdometryRotationDeviationRotation * x - x).cwiseAbs2();
-    P.diagonal() += squaredOdometryRotationDeviationTranslation;
+protected:
+  /**
+   * Predicts the means and covariances of all hypotheses with the same linear model.
+   * @param A The state transition matrix.
+   * @param u The control vector.
+   * @param squaredProcessCov The process noise added to the diagonal.
+   * @param odometryRotationDeviationRotation The rotation by the deviation of the odometry.
+   *                                          The resulting change of the state is added as noise.
+   */
+  void predict(const Matrix& A, const Vector& u, const Vector& squaredProcessCov, const Matrix& odometryRotationDeviationRotation)
+  {
+    const int n = size;
+
+    // save old positions
+    lastPosition.leftCols(n) = x.template topRows<2>().leftCols(n);
+
+    // x = A * x + u
+    Rows<stateSize> newX;
+    newX.leftCols(n).matrix().noalias() = A * x.leftCols(n).matrix();
+    x.leftCols(n) = newX.leftCols(n).colwise() + u.array();
+
+    // P = A * P * A^T, which is kron(A, A) * P for row-wise stored matrices
+    Eigen::Matrix<float, stateSize * stateSize, stateSize * stateSize> AA;
+    for(int r = 0; r < stateSize; ++r)
+      for(int c = 0; c < stateSize; ++c)
+        AA.template block<stateSize, stateSize>(r * stateSize, c * stateSize) = A(r, c) * A;
+    Rows<stateSize * stateSize> newP;
+    newP.leftCols(n).matrix().noalias() = AA * P.leftCols(n).matrix();
+    P.leftCols(n) = newP.leftCols(n);
+
+    // add process noise, odometry translation noise (included in squaredProcessCov),
+    // and noise from odometry rotation (crude approximation)
+    newX.leftCols(n).matrix().noalias() = (odometryRotationDeviationRotation - Matrix::Identity()) * x.leftCols(n).matrix();
+    for(int r = 0; r < stateSize; ++r)
+      P.row(r * stateSize + r).head(n) += newX.row(r).head(n).square() + squaredProcessCov(r);
   }
 
-  /** Kalman filter measurement update step
-   *  @param measurement The ball perception in relative field coordinates
-   *  @param measurementCov The covariance of the measurement
+private:
+  /**
+   * Copies a hypothesis.
+   * @param other The set of hypotheses to copy from.
+   * @param from The index of the hypothesis in the other set.
+   * @param to The index of the hypothesis in this set.
    */
-  void integrateMeasurement(const Vector2f& measurement, const Matrix2f& measurementCov)
+  void copy(const BallStateEstimates& other, int from, int to)
   {
-    Matrix2f covPlusSensorCov = P;
-    covPlusSensorCov += measurementCov;
-    const Matrix2f K = P * covPlusSensorCov.inverse();
-    const Vector2f innovation = measurement - x;
-    const Vector2f correction = K * innovation;
-    x += correction;
-    P -= K * P;
+    x.col(to) = other.x.col(from);
+    P.col(to) = other.P.col(from);
+    copyStatistics(other, from, to);
   }
+
+  /**
+   * Moves a hypothesis inside this set.
+   * @param from The index of the hypothesis to move.
+   * @param to The index it is moved to.
+   */
+  void move(int from, int to) { copy(*this, from, to); }
 };
 
 /**
- * State estimation for a rolling ball.
- * Based on a standard Kalman filter
+ * State estimation for stationary / lying balls.
+ * Based on standard Kalman filters
  */
-class RollingBallKalmanFilter : public BallStateEstimate
+class StationaryBallKalmanFilters : public BallStateEstimates<2>
 {
 public:
-  Vector4f x = Vector4f::Zero();           /**< Mean of the estimated rolling ball */
-  Matrix4f P = Matrix4f::Identity();       /**< Covariance matrix of the ball estimate */
-
-  /** Empty default constructor */
-  RollingBallKalmanFilter() = default;
-
-  /** Constructor based on stationary filter, useful when a ball is kicked and becomes converted
-   *   @param sbkf The stationary filter
-   *   @param newPosition The position (which might have slightly changed after kick)
-   *   @param newVelocity The velocity
-   *   @param addVelocityCov Covariance of velocity
-   */
-  RollingBallKalmanFilter(const StationaryBallKalmanFilter& sbkf,
-                          const Vector2f& newPosition,
-                          const Vector2f& newVelocity,
-                          const Vector2f& addVelocityCov)
+  /** Moves hypotheses and updates means and covariances accordingly */
+  void motionUpdate(const Vector4f& squaredProcessCov,
+                    const Vector4f& odometryTranslationCov,
+                    const Matrix2f& fixedOdometryRotation, const Vector2f& fixedOdometryTranslation,
+                    const Matrix2f& fixedOdometryRotationDeviationRotation)
   {
-    x << newPosition, newVelocity;
-    P = Matrix4f::Identity();
-    P.topLeftCorner<2, 2>() << sbkf.P;
-    P(2, 2) += addVelocityCov.x();
-    P(3, 3) += addVelocityCov.y();
-    lastPosition = sbkf.x;
-    radius = sbkf.radius;
-    numOfMeasurements = sbkf.numOfMeasurements;
-    nllOfMeasurements = sbkf.nllOfMeasurements;
-    nllWeighting = sbkf.nllWeighting;
+    predict(fixedOdometryRotation, fixedOdometryTranslation,
+            squaredProcessCov.head<2>() + odometryTranslationCov.head<2>(), fixedOdometryRotationDeviationRotation);
   }
+};
 
-  /** Returns the upper part of the mean of the internal estimate
-   * @return Yes, exactly.
-   */
-  const Vector2f getPosition() const { return x.topRows<2>(); }
-
-  /** Returns the covariance of the internal estimate
-   * @return Yes, exactly.
-   */
-  const Matrix2f getPositionCovariance() const { return P.topLeftCorner<2, 2>(); }
-
-  /** Returns the lower part of the mean of the internal estimate
-   * @return Yes, exactly.
-   */
-  const Vector2f getVelocity() const { return x.bottomRows(2); }
-
-  /** Moves hypothesis and updates mean and covariance accordingly */
-  void motionUpdate(const Matrix4f& movingA, const Matrix4f& movingATransposed,
-                    const Vector4f& movingOdometryTranslation, const Vector4f& squaredProcessCov,
+/**
+ * State estimation for rolling balls.
+ * Based on standard Kalman filters
+ */
+class RollingBallKalmanFilters : public BallStateEstimates<4>
+{
+public:
+  /** Moves hypotheses and updates means and covariances accordingly */
+  void motionUpdate(const Matrix4f& movingA, const Vector4f& movingOdometryTranslation, const Vector4f& squaredProcessCov,
                     const Vector4f& odometryTranslationCov, const Matrix4f& movingOdometryRotationDeviationRotation,
                     float friction, float deltaTime)
   {
-    // save old position
-    lastPosition = x.topRows<2>();
-
-    // predict
-    x = movingA * x + movingOdometryTranslation;
-    P = movingA * P * movingATransposed;
-
-    // add process noise
-    P.diagonal() += squaredProcessCov;
-
-    // add odometry translation noise
-    P.diagonal() += odometryTranslationCov;
-
-    // add noise from odometry rotation (crude approximation)
-    const Vector4f squaredOdometryRotationDeviationTranslation = (movingOdometryRotationDeviationRotation * x - x).cwiseAbs2();
-    P.diagonal() += squaredOdometryRotationDeviationTranslation;
+    predict(movingA, movingOdometryTranslation, squaredProcessCov + odometryTranslationCov, movingOdometryRotationDeviationRotation);
 
     // add friction
-    Vector2f newPosition = x.topRows<2>();
-    Vector2f newVelocity = x.bottomRows<2>();
-    BallPhysics::applyFrictionToPositionAndVelocity(newPosition, newVelocity, deltaTime, friction);
-    x << newPosition, newVelocity;
+    for(int i = 0; i < size; ++i)
+    {
+      Vector2f newPosition = getPosition(i);
+      Vector2f newVelocity = getVelocity(i);
+      BallPhysics::applyFrictionToPositionAndVelocity(newPosition, newVelocity, deltaTime, friction);
+      x.col(i) = (Vector4f() << newPosition, newVelocity).finished().array();
+    }
   }
 
-  /** Kalman filter measurement update step
-   *  @param measurement The ball perception in relative field coordinates
-   *  @param measurementCov The covariance of the measurement
+  /** Adds a rolling ball based on a stationary one, useful when a ball is kicked and becomes converted
+   *   @param stationaryBalls The stationary balls
+   *   @param i The index of the stationary ball
+   *   @param newPosition The position (which might have slightly changed after kick)
+   *   @param newVelocity The velocity
+   *   @param addVelocityCov Covariance of velocity
+   *   @return The index of the new rolling ball
    */
-  void integrateMeasurement(const Vector2f& measurement, const Matrix2f& measurementCov)
+  int add(const StationaryBallKalmanFilters& stationaryBalls, int i,
+          const Vector2f& newPosition, const Vector2f& newVelocity, const Vector2f& addVelocityCov)
   {
-    Matrix2f covPlusSensorCov = P.topLeftCorner<2, 2>();
-    covPlusSensorCov += measurementCov;
-    const Matrix4x2f K = P.leftCols<2>() * covPlusSensorCov.inverse();
-    const Vector2f innovation = measurement - x.topRows<2>();
-    const Vector4f correction = K * innovation;
-    x += correction;
-    P -= K * P.topRows<2>();
+    const int j = BallStateEstimates::add();
+    x.col(j) = (Vector4f() << newPosition, newVelocity).finished().array();
+    Matrix4f cov = Matrix4f::Identity();
+    cov.topLeftCorner<2, 2>() = stationaryBalls.getCovariance(i);
+    cov(2, 2) += addVelocityCov.x();
+    cov(3, 3) += addVelocityCov.y();
+    setCovariance(j, cov);
+    copyStatistics(stationaryBalls, i, j);
+    lastPosition.col(j) = stationaryBalls.x.col(i);
+    return j;
   }
 
-  /** Converts to a stationary filter, useful when ball stops
-   *  @return A stationary filter that contains all relevant information from this filter.
-   */
-  const StationaryBallKalmanFilter toStationaryBallKalmanFilter()
-  {
-    StationaryBallKalmanFilter sbkf;
-    // Marginalize over the velocity.
-    sbkf.x = x.topRows<2>();
-    sbkf.P = P.topLeftCorner<2, 2>();
-    sbkf.lastPosition = sbkf.x;
-    sbkf.radius = radius;
-    sbkf.numOfMeasurements = numOfMeasurements;
-    sbkf.nllOfMeasurements = nllOfMeasurements;
-    sbkf.nllWeighting = nllWeighting;
-    return sbkf;
-  }
+  using BallStateEstimates::add;
 };
+
+/**
+ * Adds a stationary ball based on a rolling one, useful when the ball stops.
+ * It contains all relevant information from the rolling ball.
+ * @param stationaryBalls The stationary balls the new one is added to
+ * @param rollingBalls The rolling balls
+ * @param i The index of the rolling ball
+ * @return The index of the new stationary ball
+ */
+inline int addStationaryBall(StationaryBallKalmanFilters& stationaryBalls, const RollingBallKalmanFilters& rollingBalls, int i)
+{
+  const int j = stationaryBalls.add();
+  // Marginalize over the velocity.
+  stationaryBalls.x.col(j) = rollingBalls.x.topRows<2>().col(i);
+  stationaryBalls.setCovariance(j, rollingBalls.getPositionCovariance(i));
+  stationaryBalls.copyStatistics(rollingBalls, i, j);
+  stationaryBalls.lastPosition.col(j) = stationaryBalls.x.col(j);
+  stationaryBalls.timeOfLastCollision[j] = 0;
+  return j;
+}
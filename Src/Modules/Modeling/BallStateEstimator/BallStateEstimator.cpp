@@ -26,11 +26,6 @@
 
 MAKE_MODULE(BallStateEstimator);
 
-bool compareHypothesesWeightings(BallStateEstimate& a, BallStateEstimate& b)
-{
-  return a.nllWeighting < b.nllWeighting;
-}
-
 BallStateEstimator::BallStateEstimator(): timeWhenBallFirstDisappeared(0),
   ballNotSeenButShouldBeSeenCounter(0),
   penaltyBallModelingStartTime(0),
@@ -50,10 +45,9 @@ void BallStateEstimator::reset()
 {
   stationaryBalls.clear();
   rollingBalls.clear();
-  stationaryBalls.reserve(maxNumberOfHypotheses * 2);
-  rollingBalls.reserve(maxNumberOfHypotheses * 2);
-  bestState = nullptr;
-  bestMovingState = nullptr;
+  bestState = -1;
+  bestStateIsRolling = false;
+  bestMovingState = -1;
 }
 
 void BallStateEstimator::update(BallModel& ballModel)
@@ -110,10 +104,8 @@ void BallStateEstimator::update(BallModel& ballModel)
       lastBallPercept = theFilteredBallPercepts.percepts[1];
 
     // add current measurement to all filters
-    for(auto& state : stationaryBalls)
-      state.measurementUpdate(ballPercept.positionOnField, ballPercept.covOnField, ballPercept.radiusOnField);
-    for(auto& state : rollingBalls)
-      state.measurementUpdate(ballPercept.positionOnField, ballPercept.covOnField, ballPercept.radiusOnField);
+    stationaryBalls.measurementUpdate(ballPercept.positionOnField, ballPercept.covOnField, ballPercept.radiusOnField);
+    rollingBalls.measurementUpdate(ballPercept.positionOnField, ballPercept.covOnField, ballPercept.radiusOnField);
 
     // normalize all weights
     normalizeMeasurementLikelihoods();
@@ -128,10 +120,10 @@ void BallStateEstimator::update(BallModel& ballModel)
     createNewFilters(ballPercept.positionOnField, ballPercept.radiusOnField, ballPercept.covOnField);
 
     // If we see a new ball for the first time after multiple seconds without any ball perceptions,
-    // all filter become reset, i.e. the lists are emptied and bestState == nullptr.
+    // all filter become reset, i.e. the lists are emptied and bestState == -1.
     // A newly created filter usually should not be used for model generation (see comment above).
     // However, if this new filter is the only one that we have, we should take it anyway!
-    if(bestState == nullptr)
+    if(bestState < 0)
       findBestState(); // should return stationaryBalls[0], but calling the "official" function is cleaner.
 
     // save percept
@@ -165,7 +157,6 @@ void BallStateEstimator::motionUpdate(BallModel& ballModel)
   // prepare matrices and vectors for stationary filters
   Matrix2f fixedOdometryRotation;
   fixedOdometryRotation << odometryCos, odometrySin, -odometrySin, odometryCos; // a
-  const Matrix2f fixedOdometryRotationTransposed = fixedOdometryRotation.transpose();
   Matrix2f fixedOdometryRotationDeviationRotation;
   fixedOdometryRotationDeviationRotation << odometryDeviationCos, odometryDeviationSin, -odometryDeviationSin, odometryDeviationCos;
   const Vector2f fixedOdometryTranslation = -fixedOdometryRotation * odometryOffset.translation; // u
@@ -181,14 +172,11 @@ void BallStateEstimator::motionUpdate(BallModel& ballModel)
   }
 
   // perform prediction step for all stationary states
-  for(auto& state : stationaryBalls)
-  {
-    state.motionUpdate(squaredProcessCov, odometryTranslationCov,
-                       fixedOdometryRotation, fixedOdometryTranslation, fixedOdometryRotationTransposed,
-                       fixedOdometryRotationDeviationRotation);
-  }
+  stationaryBalls.motionUpdate(squaredProcessCov, odometryTranslationCov,
+                               fixedOdometryRotation, fixedOdometryTranslation,
+                               fixedOdometryRotationDeviationRotation);
   // perform prediction step for all moving states
-  if(rollingBalls.size() > 0)
+  if(rollingBalls.size > 0)
   {
     // prepare matrices and vectors for moving filters
     Matrix4f movingOdometryRotation;
@@ -206,13 +194,9 @@ void BallStateEstimator::motionUpdate(BallModel& ballModel)
     movingMotionMatrix(0, 2) = deltaTime;
     movingMotionMatrix(1, 3) = deltaTime;// first part of "a"
     const Matrix4f movingA = movingOdometryRotation * movingMotionMatrix;
-    const Matrix4f movingATransposed = movingA.transpose();
-    for(auto& state : rollingBalls)
-    {
-      state.motionUpdate(movingA, movingATransposed, movingOdometryTranslation,
-                         squaredProcessCov, odometryTranslationCov, movingOdometryRotationDeviationRotation,
-                         theBallSpecification.friction, deltaTime);
-    }
+    rollingBalls.motionUpdate(movingA, movingOdometryTranslation,
+                              squaredProcessCov, odometryTranslationCov, movingOdometryRotationDeviationRotation,
+                              theBallSpecification.friction, deltaTime);
   }
 
   // odometry update for the buffered ball percept (if it is new enough)
@@ -228,91 +212,66 @@ void BallStateEstimator::motionUpdate(BallModel& ballModel)
   // Check, if some of the rolling balls have stopped and move them to the buffer
   // that contains the stationary balls. They are added to the end of the list, which
   // now might temporarily exceed its limit.
-  auto rBall = rollingBalls.begin();
-  while(rBall != rollingBalls.end())
+  for(int i = 0; i < rollingBalls.size;)
   {
-    if(rBall->getVelocity().norm() < minSpeed)
+    if(rollingBalls.getVelocity(i).norm() < minSpeed)
     {
-      stationaryBalls.push_back(rBall->toStationaryBallKalmanFilter());
-      rBall = rollingBalls.erase(rBall);
-      recomputeBestState = true;  // as pointer bestState might be incorrect after this operation
+      addStationaryBall(stationaryBalls, rollingBalls, i);
+      rollingBalls.remove(i);
+      recomputeBestState = true;  // as index bestState might be incorrect after this operation
     }
     else
     {
-      ++rBall;
+      ++i;
     }
   }
 }
 
 void BallStateEstimator::normalizeMeasurementLikelihoods()
 {
-  float lowestNLLOfMeasurements = std::numeric_limits<float>::max();
-  for(auto& state : rollingBalls)
-  {
-    if(state.nllOfMeasurements < lowestNLLOfMeasurements)
-      lowestNLLOfMeasurements = state.nllOfMeasurements;
-  }
-  for(auto& state : stationaryBalls)
-  {
-    if(state.nllOfMeasurements < lowestNLLOfMeasurements)
-      lowestNLLOfMeasurements = state.nllOfMeasurements;
-  }
-  ASSERT(lowestNLLOfMeasurements < std::numeric_limits<float>::max() || (stationaryBalls.empty() && rollingBalls.empty()));
-  for(auto& state : stationaryBalls)
-    state.nllOfMeasurements -= lowestNLLOfMeasurements;
-  for(auto& state : rollingBalls)
-    state.nllOfMeasurements -= lowestNLLOfMeasurements;
+  stationaryBalls.normalizeMeasurementLikelihoods(rollingBalls);
 }
 
 void BallStateEstimator::findBestState()
 {
-  bestState = nullptr;
-  bestMovingState = nullptr;
-  float bestWeighting = std::numeric_limits<float>::max();
-  float bestMovingWeighting = std::numeric_limits<float>::max();
-  for(auto& state : rollingBalls)
+  bestState = -1;
+  bestStateIsRolling = false;
+  bestMovingState = -1;
+  if(rollingBalls.size > 0)
   {
-    if(bestState == nullptr || state.nllWeighting < bestWeighting)
-    {
-      bestState = &state;
-      bestWeighting = state.nllWeighting;
-    }
-    if(bestMovingState == nullptr || state.nllWeighting < bestMovingWeighting)
-    {
-      bestMovingState = &state;
-      bestMovingWeighting = state.nllWeighting;
-    }
+    rollingBalls.nllWeighting.head(rollingBalls.size).minCoeff(&bestMovingState);
+    bestState = bestMovingState;
+    bestStateIsRolling = true;
   }
-  for(auto& state : stationaryBalls)
-    if(bestState == nullptr || state.nllWeighting < bestWeighting)
+  if(stationaryBalls.size > 0)
+  {
+    int bestStationaryState;
+    const float bestStationaryWeighting = stationaryBalls.nllWeighting.head(stationaryBalls.size).minCoeff(&bestStationaryState);
+    if(bestState < 0 || bestStationaryWeighting < rollingBalls.nllWeighting(bestState))
     {
-      bestState = &state;
-      bestWeighting = state.nllWeighting;
+      bestState = bestStationaryState;
+      bestStateIsRolling = false;
     }
+  }
 }
 
-template <typename T> void BallStateEstimator::pruneBallBuffer(std::vector<T>& balls)
+template<int stateSize> void BallStateEstimator::pruneBallBuffer(BallStateEstimates<stateSize>& balls)
 {
-  if(balls.size() <= maxNumberOfHypotheses - 1)
-    return;
-  std::sort(balls.begin(), balls.end(), compareHypothesesWeightings);
-  while(balls.size() > maxNumberOfHypotheses - 1)
-    balls.pop_back();
+  balls.keepBest(std::min(static_cast<int>(maxNumberOfHypotheses), BallStateEstimates<stateSize>::capacity / 2) - 1);
 }
 
 void BallStateEstimator::createNewFilters(const Vector2f& ballPercept, const float ballPerceptRadius, const Matrix2f& ballPerceptCov)
 {
   // Create a new stationary state estimator
-  StationaryBallKalmanFilter newStationaryBall;
+  const int newStationaryBall = stationaryBalls.add();
   // initialStateWeight is essentially a factor how much worse a new hypothesis is compared to the best one so far.
   // For instance, initialStateWeight = 0.1 means that the hypothesis is 1/10 as likely as the best hypothesis.
-  newStationaryBall.nllOfMeasurements = -std::log(initialStateWeight);
-  newStationaryBall.radius = ballPerceptRadius;
-  newStationaryBall.x = ballPercept;
-  newStationaryBall.P = ballPerceptCov;
-  newStationaryBall.lastPosition = ballPercept;
-  newStationaryBall.numOfMeasurements = 1;
-  stationaryBalls.push_back(newStationaryBall);
+  stationaryBalls.nllOfMeasurements(newStationaryBall) = -std::log(initialStateWeight);
+  stationaryBalls.radius(newStationaryBall) = ballPerceptRadius;
+  stationaryBalls.x.col(newStationaryBall) = ballPercept.array();
+  stationaryBalls.setCovariance(newStationaryBall, ballPerceptCov);
+  stationaryBalls.lastPosition.col(newStationaryBall) = ballPercept.array();
+  stationaryBalls.numOfMeasurements[newStationaryBall] = 1;
 
   // Try to create a new filter for a rolling ball (if a second observation is available)
   if(theFrameInfo.getTimeSince(lastBallPercept.timeWhenSeen) < lastBallPerceptTimeout)
@@ -326,15 +285,14 @@ void BallStateEstimator::createNewFilters(const Vector2f& ballPercept, const flo
     {
       const Matrix2f positionVelocityCov = ballPerceptCov / deltaTime;
       const Matrix2f velocityCov = (ballPerceptCov + lastBallPercept.covOnField) / (deltaTime*deltaTime);
-      RollingBallKalmanFilter newRollingBall;
-      newRollingBall.nllOfMeasurements = -std::log(initialStateWeight);
-      newRollingBall.radius = ballPerceptRadius;
-      newRollingBall.x << ballPercept, ballVelocity;
-      newRollingBall.P << ballPerceptCov, positionVelocityCov,
-                          positionVelocityCov, velocityCov;
-      newRollingBall.lastPosition = ballPercept;
-      newRollingBall.numOfMeasurements = 2;
-      rollingBalls.push_back(newRollingBall);
+      const int newRollingBall = rollingBalls.add();
+      rollingBalls.nllOfMeasurements(newRollingBall) = -std::log(initialStateWeight);
+      rollingBalls.radius(newRollingBall) = ballPerceptRadius;
+      rollingBalls.x.col(newRollingBall) = (Vector4f() << ballPercept, ballVelocity).finished().array();
+      rollingBalls.setCovariance(newRollingBall, (Matrix4f() << ballPerceptCov, positionVelocityCov,
+                                                                positionVelocityCov, velocityCov).finished());
+      rollingBalls.lastPosition.col(newRollingBall) = ballPercept.array();
+      rollingBalls.numOfMeasurements[newRollingBall] = 2;
     }
   }
 }
@@ -342,35 +300,42 @@ void BallStateEstimator::createNewFilters(const Vector2f& ballPercept, const flo
 void BallStateEstimator::generateModel(BallModel& ballModel)
 {
   ballModel.seenPercentage = static_cast<unsigned char>(seenStats.average());
-  if(bestState != nullptr)
+  if(bestState >= 0)
   {
-    ballModel.estimate.position = bestState->getPosition();
-    if(bestState->timeOfLastCollision > ballModel.timeOfLastCollision)
-      ballModel.timeOfLastCollision = bestState->timeOfLastCollision;
-    // <hack>
-    if(bestState->numOfMeasurements < minNumberOfMeasurementsForRollingBalls)
-      ballModel.estimate.velocity = Vector2f::Zero();
+    const auto fill = [&](const auto& balls)
+    {
+      ballModel.estimate.position = balls.getPosition(bestState);
+      if(balls.timeOfLastCollision[bestState] > ballModel.timeOfLastCollision)
+        ballModel.timeOfLastCollision = balls.timeOfLastCollision[bestState];
+      // <hack>
+      if(balls.numOfMeasurements[bestState] < minNumberOfMeasurementsForRollingBalls)
+        ballModel.estimate.velocity = Vector2f::Zero();
+      else
+        ballModel.estimate.velocity = balls.getVelocity(bestState);
+      // <hack-description>This seems to be the best temporary
+      // solution to avoid the generation of quite high velocities due to noise between two measurements.
+      // T.L.
+      // </hack-description>
+      // </hack>
+      ballModel.estimate.covariance = balls.getPositionCovariance(bestState);
+      ballModel.estimate.radius = balls.radius(bestState);
+    };
+    if(bestStateIsRolling)
+      fill(rollingBalls);
     else
-      ballModel.estimate.velocity = bestState->getVelocity();
-    // <hack-description>This seems to be the best temporary
-    // solution to avoid the generation of quite high velocities due to noise between two measurements.
-    // T.L.
-    // </hack-description>
-    // </hack>
-    ballModel.estimate.covariance = bestState->getPositionCovariance();
-    ballModel.estimate.radius = bestState->radius;
+      fill(stationaryBalls);
     Covariance::fixCovariance<2>(ballModel.estimate.covariance);
   }
-  if(bestMovingState != nullptr &&
-     bestMovingState != bestState &&
-     bestMovingState->numOfMeasurements >= minNumberOfMeasurementsForRollingBalls &&
-     bestMovingState->getVelocity().norm() > minSpeed)
+  if(bestMovingState >= 0 &&
+     !(bestStateIsRolling && bestMovingState == bestState) &&
+     rollingBalls.numOfMeasurements[bestMovingState] >= minNumberOfMeasurementsForRollingBalls &&
+     rollingBalls.getVelocity(bestMovingState).norm() > minSpeed)
   {
     ballModel.riskyMovingEstimateIsValid = true;
-    ballModel.riskyMovingEstimate.position = bestMovingState->getPosition();
-    ballModel.riskyMovingEstimate.velocity = bestMovingState->getVelocity();
-    ballModel.riskyMovingEstimate.covariance = bestMovingState->getPositionCovariance();
-    ballModel.riskyMovingEstimate.radius = bestMovingState->radius;
+    ballModel.riskyMovingEstimate.position = rollingBalls.getPosition(bestMovingState);
+    ballModel.riskyMovingEstimate.velocity = rollingBalls.getVelocity(bestMovingState);
+    ballModel.riskyMovingEstimate.covariance = rollingBalls.getPositionCovariance(bestMovingState);
+    ballModel.riskyMovingEstimate.radius = rollingBalls.radius(bestMovingState);
     Covariance::fixCovariance<2>(ballModel.riskyMovingEstimate.covariance);
   }
   else
@@ -460,57 +425,56 @@ bool BallStateEstimator::computeBallModelForPenaltyShootout(BallModel& ballModel
 void BallStateEstimator::integrateCollisionWithFeet()
 {
   BallContactInformation contactInfo;
-  for(auto& state : rollingBalls)
+  for(int i = 0; i < rollingBalls.size; ++i)
   {
-    if(theBallContactChecker.collide(state.getPosition(), state.getVelocity(), state.lastPosition, contactInfo))
+    if(theBallContactChecker.collide(rollingBalls.getPosition(i), rollingBalls.getVelocity(i), rollingBalls.lastPosition.col(i).matrix(), contactInfo))
     {
-      state.x << contactInfo.newPosition, contactInfo.newVelocity;
-      state.P(2, 2) += contactInfo.addVelocityCov.x();
-      state.P(3, 3) += contactInfo.addVelocityCov.y();
-      state.timeOfLastCollision = theFrameInfo.time;
+      rollingBalls.x.col(i) = (Vector4f() << contactInfo.newPosition, contactInfo.newVelocity).finished().array();
+      rollingBalls.P(2 * 4 + 2, i) += contactInfo.addVelocityCov.x();
+      rollingBalls.P(3 * 4 + 3, i) += contactInfo.addVelocityCov.y();
+      rollingBalls.timeOfLastCollision[i] = theFrameInfo.time;
     }
   }
-  auto sBall = stationaryBalls.begin();
-  while(sBall != stationaryBalls.end())
+  for(int i = 0; i < stationaryBalls.size;)
   {
-    if(theBallContactChecker.collide(sBall->getPosition(), sBall->getVelocity(), sBall->lastPosition, contactInfo))
+    if(theBallContactChecker.collide(stationaryBalls.getPosition(i), stationaryBalls.getVelocity(i), stationaryBalls.lastPosition.col(i).matrix(), contactInfo))
     {
       if(contactInfo.newVelocity.norm() < minSpeed) // Ball does not start moving
       {
-        sBall->x = contactInfo.newPosition;
-        sBall->timeOfLastCollision = theFrameInfo.time;
-        ++sBall;
+        stationaryBalls.x.col(i) = contactInfo.newPosition.array();
+        stationaryBalls.timeOfLastCollision[i] = theFrameInfo.time;
+        ++i;
       }
       else // Ball is rolling after collision -> Create a rolling ball and delete stationary ball
       {
-        rollingBalls.emplace_back(*sBall, contactInfo.newPosition, contactInfo.newVelocity, contactInfo.addVelocityCov);
-        rollingBalls.back().timeOfLastCollision = theFrameInfo.time;
-        sBall = stationaryBalls.erase(sBall);
-        recomputeBestState = true;  // as pointer bestState might be incorrect after this operation
+        const int j = rollingBalls.add(stationaryBalls, i, contactInfo.newPosition, contactInfo.newVelocity, contactInfo.addVelocityCov);
+        rollingBalls.timeOfLastCollision[j] = theFrameInfo.time;
+        stationaryBalls.remove(i);
+        recomputeBestState = true;  // as index bestState might be incorrect after this operation
       }
     }
     else
     {
-      ++sBall;
+      ++i;
     }
   }
 }
 
 void BallStateEstimator::plotAndDraw()
 {
-  PLOT("module:BallStateEstimator:stationaryHypotheses", stationaryBalls.size());
-  PLOT("module:BallStateEstimator:movingHypotheses", rollingBalls.size());
+  PLOT("module:BallStateEstimator:stationaryHypotheses", stationaryBalls.size);
+  PLOT("module:BallStateEstimator:movingHypotheses", rollingBalls.size);
 
-  for(const auto& b : stationaryBalls)
+  for(int i = 0; i < stationaryBalls.size; ++i)
   {
-    COVARIANCE_ELLIPSES_2D("module:BallStateEstimator:drawHypotheses", b.P, b.x);
-    CIRCLE("module:BallStateEstimator:drawHypotheses", b.x.x(), b.x.y(), 80, 0, // pen width
+    COVARIANCE_ELLIPSES_2D("module:BallStateEstimator:drawHypotheses", stationaryBalls.getPositionCovariance(i), stationaryBalls.getPosition(i));
+    CIRCLE("module:BallStateEstimator:drawHypotheses", stationaryBalls.x(0, i), stationaryBalls.x(1, i), 80, 0, // pen width
            Drawings::solidPen, ColorRGBA::black, Drawings::solidBrush, ColorRGBA::black);
   }
-  for(const auto& b : rollingBalls)
+  for(int i = 0; i < rollingBalls.size; ++i)
   {
-    COVARIANCE_ELLIPSES_2D("module:BallStateEstimator:drawHypotheses", b.P.topLeftCorner(2, 2), b.x);
-    CIRCLE("module:BallStateEstimator:drawHypotheses", b.x.x(), b.x.y(), 80, 0, // pen width
+    COVARIANCE_ELLIPSES_2D("module:BallStateEstimator:drawHypotheses", rollingBalls.getPositionCovariance(i), rollingBalls.getPosition(i));
+    CIRCLE("module:BallStateEstimator:drawHypotheses", rollingBalls.x(0, i), rollingBalls.x(1, i), 80, 0, // pen width
            Drawings::solidPen, ColorRGBA::red, Drawings::solidBrush, ColorRGBA::red);
   }
 }
@@ -66,7 +66,7 @@ MODULE(BallStateEstimator,
     (int)(700) lastBallPerceptTimeout,                   /**< Threshold. Consider a previously seen ball as valid for velocity computation for this amount of milliseconds. */
     (int)(4) minNumberOfMeasurementsForRollingBalls,     /**< A internal rolling ball hypothesis can only be selected, if it incorporates at least this number of measurements. */
     (float)(80.f) minSpeed,                              /**< Minimum ball speed. Everything below this threshold will become clipped to 0. */
-    (unsigned)(10) maxNumberOfHypotheses,                /**< Do not keep track of more hypothesis per mode than this */
+    (unsigned)(10) maxNumberOfHypotheses,                /**< Do not keep track of more hypothesis per mode than this (at most half of BallStateEstimates::capacity) */
   }),
 });
 
@@ -83,11 +83,12 @@ public:
 
 private:
   unsigned int lastFrameTime;                               /**< The point of time at the last execution of this module */
-  BallStateEstimate* bestState;                             /**< Pointer to the hypothesis that is most likely */
-  BallStateEstimate* bestMovingState;                       /**< Pointer to the moving hypothesis that is most likely */
-  bool recomputeBestState;                                  /**< If true, the bestState pointer is set again. Needed, if balls are removed from a list. */
-  std::vector<StationaryBallKalmanFilter> stationaryBalls;  /**< The list of hypotheses */
-  std::vector<RollingBallKalmanFilter> rollingBalls;        /**< The list of hypotheses */
+  int bestState;                                            /**< Index of the hypothesis that is most likely (-1 if there is none) */
+  bool bestStateIsRolling;                                  /**< Is bestState an index into rollingBalls? Otherwise, it is one into stationaryBalls. */
+  int bestMovingState;                                      /**< Index of the moving hypothesis that is most likely (-1 if there is none) */
+  bool recomputeBestState;                                  /**< If true, the best state indices are set again. Needed, if balls are removed from a list. */
+  StationaryBallKalmanFilters stationaryBalls;              /**< The list of hypotheses */
+  RollingBallKalmanFilters rollingBalls;                    /**< The list of hypotheses */
   RingBufferWithSum<unsigned short, 60> seenStats;          /**< Contains a 100 for time the ball was seen and 0 when it was not, used for statistics in ball model */
   bool ballWasSeenInThisFrame;                              /**< Internal flag to keep some expressions short */
   unsigned timeWhenBallFirstDisappeared;                    /**< A point of time from which on a ball seems to have disappeared (is not seen anymore although it should be) */
@@ -119,7 +120,7 @@ private:
   void integrateCollisionWithFeet();
   void normalizeMeasurementLikelihoods();
   void findBestState();
-  template <typename T> void pruneBallBuffer(std::vector<T>& balls);
+  template<int stateSize> void pruneBallBuffer(BallStateEstimates<stateSize>& balls);
 
   void createNewFilters(const Vector2f& ballPercept, const float ballPerceptRadius, const Matrix2f& ballPerceptCov);
   void plotAndDraw();
@@ -30,6 +30,7 @@
 #include "Representations/Sensing/FootBumperState.h"
 #include "Representations/Sensing/RobotModel.h"
 #include "Representations/Sensing/TorsoMatrix.h"
+#include "Tools/Modeling/ObstacleAssociation.h"
 #include "Math/BHMath.h"
 #include "Math/Geometry.h"
 
@@ -104,12 +105,17 @@ public:
   /** Constructor */
   GlobalOpponentsTracker();
   std::vector<GlobalOpponentsHypothesis> obstacleHypotheses; /**< List of obstacles. */
-  std::vector<bool> merged; /**< This is to merge obstacles once for every "percept" per frame. */
+  std::vector<GlobalOpponentsHypothesis> measurements; /**< The measurements that are merged together with the hypotheses. */
   // Used for writing annotations only once per contact.
   bool armContact[Arms::numOfArms] = { false, false }, footContact[Legs::numOfLegs] = { false, false };
 
 
 private:
+  ObstacleAssociation association; /**< Finds the hypotheses near a position and assigns measurements to them. */
+  std::vector<bool> removed; /**< Which hypotheses were merged into others in mergeOverlapping()? */
+  std::vector<signed char> inImage; /**< Per hypothesis: -1 if not projected into the image yet in this frame, otherwise whether its center is in the image. */
+  std::vector<Vector2f> centersInImage; /**< Per hypothesis: its center in the image, valid if \c inImage is 1. */
+
   int numberOfUnpenalizedOpponents;          /**< The number of opponent robots that are currently in play (== not penalized) */
   int numberOfPenalizedOpponents;            /**< The number of opponent robots that are currently penalized and thus assumed to be standing outside the actual playing area */
 
@@ -158,10 +164,10 @@ private:
   void addPlayerPercepts();
 
   /**
-   * The function tries to merge the measurement with an existing hypothesis.
-   * @param measurement The measurement to merge.
+   * The function tries to merge all measurements with existing hypotheses.
+   * Measurements that cannot be merged are added as new hypotheses.
    */
-  void tryToMerge(const GlobalOpponentsHypothesis& measurement);
+  void tryToMerge();
 
   /** The function will merge overlapping hypotheses to one hypotheses. */
   void mergeOverlapping();
@@ -172,11 +178,17 @@ private:
    * The function checks if any other obstacle is in the shadow of the obstacle closer.
    * @param closer The obstacle that may shadow other obstacles.
    * @param i The index of the obstacle closer in the list obstacleHypotheses.
-   * @param cameraAngleLeft The left camera angle.
-   * @param cameraAngleRight The right camera angle.
+   * @param cameraAngleLeft The left border of the field of view.
+   * @param cameraAngleRight The right border of the field of view.
    */
   bool isAnyObstacleInShadow(GlobalOpponentsHypothesis* closer, const std::size_t i, const float cameraAngleLeft, const float cameraAngleRight);
 
+  /**
+   * Checks whether the center of a hypothesis is in the image. The projection is only calculated once per frame.
+   * @param i The index of the hypothesis in the list obstacleHypotheses.
+   */
+  bool isInImage(const std::size_t i);
+
   /**
    * Computes a merge radius for a given measurement. The farther the measurement, the higher the radius.
    * @param measurement A position in 2D that denotes a measurement of an opponent
@@ -126,8 +126,7 @@ void ObstacleModelProvider::dynamic()
 
 void ObstacleModelProvider::addArmContacts()
 {
-  merged.clear();
-  merged.resize(obstacleHypotheses.size(), false);
+  measurements.clear();
 
   FOREACH_ENUM(Arms::Arm, arm)
   {
@@ -143,17 +142,17 @@ void ObstacleModelProvider::addArmContacts()
       ObstacleHypothesis obstacle(armCov, center, Vector2f::Zero(), Vector2f::Zero(), theFrameInfo.time, Obstacle::unknown, 1);
       obstacle.setLeftRight(theRobotDimensions.robotDepth);
       // Insert valid obstacle.
-      tryToMerge(obstacle);
+      measurements.emplace_back(obstacle);
     }
     else
       armContact[arm] = false;
   };
+  tryToMerge();
 }
 
 void ObstacleModelProvider::addFootContacts()
 {
-  merged.clear();
-  merged.resize(obstacleHypotheses.size(), false);
+  measurements.clear();
 
   FOREACH_ENUM(Legs::Leg, leg)
   {
@@ -169,11 +168,12 @@ void ObstacleModelProvider::addFootContacts()
       ObstacleHypothesis obstacle(feetCov, center, Vector2f::Zero(), Vector2f::Zero(), theFrameInfo.time, Obstacle::unknown, 1);
       obstacle.setLeftRight(theRobotDimensions.robotDepth);
       // Insert valid obstacle.
-      tryToMerge(obstacle);
+      measurements.emplace_back(obstacle);
     }
     else
       footContact[leg] = false;
   };
+  tryToMerge();
 }
 
 void ObstacleModelProvider::addPlayerPercepts()
@@ -181,9 +181,7 @@ void ObstacleModelProvider::addPlayerPercepts()
   if(theObstaclesFieldPercept.obstacles.empty())
     return;
 
-  merged.clear();
-  merged.resize(obstacleHypotheses.size(), false);
-
+  measurements.clear();
   for(const ObstaclesFieldPercept::Obstacle& percept : theObstaclesFieldPercept.obstacles)
   {
     // Too far away?
@@ -202,41 +200,36 @@ void ObstacleModelProvider::addPlayerPercepts()
     // Obstacles have a minimum size
     if((obstacle.left - obstacle.right).squaredNorm() < sqr(2 * theRobotDimensions.robotDepth))
       obstacle.setLeftRight(theRobotDimensions.robotDepth);
-    tryToMerge(obstacle);
+    measurements.emplace_back(obstacle);
   }
+  tryToMerge();
 }
 
-void ObstacleModelProvider::tryToMerge(const ObstacleHypothesis& measurement)
+void ObstacleModelProvider::tryToMerge()
 {
-  if(obstacleHypotheses.empty())
-  {
-    obstacleHypotheses.emplace_back(measurement);
-    merged.push_back(true);
+  if(measurements.empty())
     return;
-  }
 
-  const float mergeDistanceSquared = sqr(calculateMergeRadius(measurement.center, maxMergeRadius));
-  float possibleMergeDistSquared = std::numeric_limits<float>::max();
-  std::size_t atMerge = 0; // Element matching the merge condition
-  // Search for the possible obstacle for merging.
-  for(std::size_t i = 0; i < obstacleHypotheses.size(); ++i)
+  // Each measurement is merged with at most one hypothesis and vice versa. Closer pairs are preferred.
+  association.index(obstacleHypotheses);
+  const std::vector<std::size_t>& assignment = association.assign(measurements, [this](const ObstacleHypothesis& measurement)
   {
-    if(merged[i])
-      continue;
+    return calculateMergeRadius(measurement.center, maxMergeRadius);
+  });
 
-    const float distanceSquared = (measurement.center - obstacleHypotheses[i].center).squaredNorm();
+  for(std::size_t i = 0; i < measurements.size(); ++i)
+  {
+    const ObstacleHypothesis& measurement = measurements[i];
+    const std::size_t atMerge = assignment[i];
 
-    // Found probably matching obstacle.
-    if(distanceSquared <= mergeDistanceSquared && distanceSquared <= possibleMergeDistSquared)
+    // Did not find possible match.
+    if(atMerge == ObstacleAssociation::none)
     {
-      possibleMergeDistSquared = distanceSquared;
-      atMerge = i;
+      obstacleHypotheses.emplace_back(measurement);
+      continue;
     }
-  }
 
-  // Merge
-  if(possibleMergeDistSquared < std::numeric_limits<float>::max())
-  {
+    // Merge
     LINE("module:ObstacleModelProvider:merge", measurement.center.x(), measurement.center.y(),
          obstacleHypotheses[atMerge].center.x(), obstacleHypotheses[atMerge].center.y(), 10, Drawings::dashedPen, ColorRGBA::red);
 
@@ -246,13 +239,7 @@ void ObstacleModelProvider::tryToMerge(const ObstacleHypothesis& measurement)
     obstacleHypotheses[atMerge].determineAndSetType(measurement, teamThreshold, uprightThreshold);
     obstacleHypotheses[atMerge].seenCount += measurement.seenCount;
     obstacleHypotheses[atMerge].notSeenButShouldSeenCount = 0; // Reset that counter.
-    merged[atMerge] = true;
-    return;
   }
-
-  // Did not find possible match.
-  obstacleHypotheses.emplace_back(measurement);
-  merged.push_back(true);
 }
 
 void ObstacleModelProvider::considerTeammates()
@@ -342,40 +329,90 @@ void ObstacleModelProvider::mergeOverlapping()
   if(obstacleHypotheses.size() < 2)
     return;
 
+  // Upper bounds for the half width and the covariance of all hypotheses that can be merged.
+  float maxHalfWidth = 0.f;
+  float maxTrace = 0.f;
+  for(const ObstacleHypothesis& obstacle : obstacleHypotheses)
+  {
+    maxHalfWidth = std::max(maxHalfWidth, (obstacle.left - obstacle.right).norm() * .5f);
+    if(obstacle.seenCount >= minPercepts)
+      maxTrace = std::max(maxTrace, obstacle.covariance.trace());
+  }
+
+  association.index(obstacleHypotheses);
+  removed.assign(obstacleHypotheses.size(), false);
   for(std::size_t i = 0; i < obstacleHypotheses.size(); ++i)
   {
+    if(removed[i])
+      continue;
+
     ObstacleHypothesis& actual = obstacleHypotheses[i];
-    for(std::size_t j = obstacleHypotheses.size() - 1; j > i; --j)
+
+    // The others are checked in descending order. Whenever actual changes, the candidates are determined again,
+    // but only the others that were not checked yet are considered.
+    std::size_t below = obstacleHypotheses.size();
+    bool fused;
+    do
     {
-      const ObstacleHypothesis& other = obstacleHypotheses[j];
-
-      // Continue with the next obstacles if they were last seen almost at the same time, as there are probably really two of them.
-      if(std::max(actual.lastSeen, other.lastSeen) - std::min(actual.lastSeen, other.lastSeen) < mergeOverlapTimeDiff)
-        continue;
-
-      // The sum of the radius of the obstacles.
-      const float overlap = ((actual.left - actual.right).norm() + (other.left - other.right).norm()) * .5f;
-      // The distance of the centers
-      const float distanceOfCenters = (other.center - actual.center).norm();
-
-      // Merge the obstacles.
-      if(((distanceOfCenters <= overlap || distanceOfCenters < 2 * theRobotDimensions.robotDepth) // The obstacles are overlapping
-          || (actual.squaredMahalanobis(other) < sqr(minMahalanobisDistance)
-              && (actual.seenCount >= minPercepts && other.seenCount >= minPercepts))) // they were seen at least minPercepts times
-         && (actual.isUnknown() || actual.isSomeRobot() || other.isUnknown() || other.isSomeRobot()
-             || actual.type == other.type)) // Their type is unknown, someRobot or fallenSomeRobot or their type is equal
+      fused = false;
+
+      // Other obstacles further away cannot overlap. Since the squared Mahalanobis distance is at least the
+      // squared distance divided by the trace of the combined covariance, they also cannot be close with respect to it.
+      float radius = std::max((actual.left - actual.right).norm() * .5f + maxHalfWidth, 2 * theRobotDimensions.robotDepth);
+      if(actual.seenCount >= minPercepts)
+        radius = std::max(radius, minMahalanobisDistance * std::sqrt((actual.covariance.trace() + maxTrace) * .5f));
+
+      const std::vector<std::size_t>& candidates = association.near(actual.center, radius);
+      for(auto j = std::lower_bound(candidates.rbegin(), candidates.rend(), below, std::greater<>()); j != candidates.rend() && *j > i; ++j)
       {
-        Obstacle::fusion2D(actual, other);
-        // Since fusion2D makes all previous positions unusable for a correct calculation.
-        actual.lastObservations.clear();
-        actual.determineAndSetType(other, teamThreshold, uprightThreshold);
-        actual.lastSeen = std::max(actual.lastSeen, other.lastSeen);
-        actual.seenCount = std::max(actual.seenCount, other.seenCount);
-        actual.notSeenButShouldSeenCount = (actual.notSeenButShouldSeenCount + other.notSeenButShouldSeenCount) / 2;
-        obstacleHypotheses.erase(obstacleHypotheses.begin() + j);
+        if(removed[*j])
+          continue;
+
+        const ObstacleHypothesis& other = obstacleHypotheses[*j];
+
+        // Continue with the next obstacles if they were last seen almost at the same time, as there are probably really two of them.
+        if(std::max(actual.lastSeen, other.lastSeen) - std::min(actual.lastSeen, other.lastSeen) < mergeOverlapTimeDiff)
+          continue;
+
+        // The sum of the radius of the obstacles.
+        const float overlap = ((actual.left - actual.right).norm() + (other.left - other.right).norm()) * .5f;
+        // The distance of the centers
+        const float distanceOfCenters = (other.center - actual.center).norm();
+
+        // Merge the obstacles.
+        if(((distanceOfCenters <= overlap || distanceOfCenters < 2 * theRobotDimensions.robotDepth) // The obstacles are overlapping
+            || (actual.squaredMahalanobis(other) < sqr(minMahalanobisDistance)
+                && (actual.seenCount >= minPercepts && other.seenCount >= minPercepts))) // they were seen at least minPercepts times
+           && (actual.isUnknown() || actual.isSomeRobot() || other.isUnknown() || other.isSomeRobot()
+               || actual.type == other.type)) // Their type is unknown, someRobot or fallenSomeRobot or their type is equal
+        {
+          Obstacle::fusion2D(actual, other);
+          // Since fusion2D makes all previous positions unusable for a correct calculation.
+          actual.lastObservations.clear();
+          actual.determineAndSetType(other, teamThreshold, uprightThreshold);
+          actual.lastSeen = std::max(actual.lastSeen, other.lastSeen);
+          actual.seenCount = std::max(actual.seenCount, other.seenCount);
+          actual.notSeenButShouldSeenCount = (actual.notSeenButShouldSeenCount + other.notSeenButShouldSeenCount) / 2;
+          removed[*j] = true;
+          below = *j;
+          fused = true;
+          break;
+        }
       }
     }
+    while(fused);
   }
+
+  // Remove the merged hypotheses while keeping the order of the others.
+  std::size_t numOfRemaining = 0;
+  for(std::size_t i = 0; i < obstacleHypotheses.size(); ++i)
+    if(!removed[i])
+    {
+      if(numOfRemaining != i)
+        obstacleHypotheses[numOfRemaining] = std::move(obstacleHypotheses[i]);
+      ++numOfRemaining;
+    }
+  obstacleHypotheses.erase(obstacleHypotheses.begin() + numOfRemaining, obstacleHypotheses.end());
 }
 
 void ObstacleModelProvider::shouldBeSeen()
@@ -399,20 +436,24 @@ void ObstacleModelProvider::shouldBeSeen()
     LINE("module:ObstacleModelProvider:cameraAngle", 0, 0, camRight.x(), camRight.y(), 10, Drawings::solidPen, cameraColor);
   }
 
+  // Each hypothesis is projected into the image at most once per frame and only if needed.
+  inImage.assign(obstacleHypotheses.size(), -1);
+  centersInImage.resize(obstacleHypotheses.size());
+
   // Iterate over the obstacle hypotheses
   for(std::size_t i = 0; i < obstacleHypotheses.size(); ++i)
   {
     // check whether the obstacle could be seen in the image
     ObstacleHypothesis* closer = &(obstacleHypotheses[i]);
-    Vector2f centerInImage;
 
     // Continue with next obstacle if obstacle was seen in the last 300ms or is not in sight
     if(theFrameInfo.getTimeSince(closer->lastSeen) < recentlySeenTime || !closer->isBetween(cameraAngleLeft, cameraAngleRight) ||
-       !closer->isInImage(centerInImage, theCameraInfo, theCameraMatrix))
+       !isInImage(i))
       continue;
 
     COMPLEX_DRAWING("module:ObstacleModelProvider:obstacleNotSeen")
     {
+      const Vector2f& centerInImage = centersInImage[i];
       Vector2f leftInImage, rightInImage;
       if(Transformation::robotToImage(closer->left, theCameraMatrix, theCameraInfo, leftInImage))
         LARGE_DOT("module:ObstacleModelProvider:obstacleNotSeen", closer->left.x(), closer->left.y(), ColorRGBA::violet, ColorRGBA::black);
@@ -442,10 +483,9 @@ bool ObstacleModelProvider::isAnyObstacleInShadow(ObstacleHypothesis* closer, co
     ObstacleHypothesis* further = &(obstacleHypotheses[j]);
 
     // If the further obstacle was not seen, but is in sight.
-    Vector2f centerInImage;
     if(further->lastSeen != theFrameInfo.time
        && further->isBetween(cameraAngleLeft, cameraAngleRight)
-       && further->isInImage(centerInImage, theCameraInfo, theCameraMatrix))
+       && isInImage(j))
     {
       // Swap further and closer if further obstacle is closer than closer obstacle
       if(further->center.squaredNorm() < closer->center.squaredNorm())
@@ -459,6 +499,13 @@ bool ObstacleModelProvider::isAnyObstacleInShadow(ObstacleHypothesis* closer, co
   return false;
 }
 
+bool ObstacleModelProvider::isInImage(const std::size_t i)
+{
+  if(inImage[i] < 0)
+    inImage[i] = obstacleHypotheses[i].isInImage(centersInImage[i], theCameraInfo, theCameraMatrix) ? 1 : 0;
+  return inImage[i] != 0;
+}
+
 void ObstacleModelProvider::calculateVelocity()
 {
   for(auto& obstacle : obstacleHypotheses)
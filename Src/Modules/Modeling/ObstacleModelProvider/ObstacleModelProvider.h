@@ -31,6 +31,7 @@
 #include "Representations/Sensing/FootBumperState.h"
 #include "Representations/Sensing/RobotModel.h"
 #include "Representations/Sensing/TorsoMatrix.h"
+#include "Tools/Modeling/ObstacleAssociation.h"
 #include "Framework/Module.h"
 
 MODULE(ObstacleModelProvider,
@@ -131,7 +132,11 @@ class ObstacleModelProvider : public ObstacleModelProviderBase
   bool armContact[Arms::numOfArms] = { false, false }, footContact[Legs::numOfLegs] = { false, false };
 
   std::vector<ObstacleHypothesis> obstacleHypotheses; /**< List of obstacles. */
-  std::vector<bool> merged; /**< This is to merge obstacles once for every "percept" per frame. */
+  std::vector<ObstacleHypothesis> measurements; /**< The measurements that are merged together with the hypotheses. */
+  ObstacleAssociation association; /**< Finds the hypotheses near a position and assigns measurements to them. */
+  std::vector<bool> removed; /**< Which hypotheses were merged into others in mergeOverlapping()? */
+  std::vector<signed char> inImage; /**< Per hypothesis: -1 if not projected into the image yet in this frame, otherwise whether its center is in the image. */
+  std::vector<Vector2f> centersInImage; /**< Per hypothesis: its center in the image, valid if \c inImage is 1. */
   std::vector<TeammateMeasurement> teammateMeasurements; /**< Pseudo-measurements from team messages from the last frame. */
 
   /** The function is called when the representation provided needs to be updated. */
@@ -159,10 +164,10 @@ class ObstacleModelProvider : public ObstacleModelProviderBase
   void addPlayerPercepts();
 
   /**
-   * The function tries to merge the measurement with an existing hypothesis.
-   * @param measurement The measurement to merge.
+   * The function tries to merge all measurements with existing hypotheses.
+   * Measurements that cannot be merged are added as new hypotheses.
    */
-  void tryToMerge(const ObstacleHypothesis& measurement);
+  void tryToMerge();
 
   /**< The function fits team and position of obstacles located exclusively near a team member. */
   void considerTeammates();
@@ -175,11 +180,17 @@ class ObstacleModelProvider : public ObstacleModelProviderBase
    * The function checks if any other obstacle is in the shadow of the obstacle closer.
    * @param closer The obstacle that may shadow other obstacles.
    * @param i The index of the obstacle closer in the list obstacleHypotheses.
-   * @param cameraAngleLeft The left camera angle.
-   * @param cameraAngleRight The right camera angle.
+   * @param cameraAngleLeft The left border of the field of view.
+   * @param cameraAngleRight The right border of the field of view.
    */
   bool isAnyObstacleInShadow(ObstacleHypothesis* closer, const std::size_t i, const float cameraAngleLeft, const float cameraAngleRight);
 
+  /**
+   * Checks whether the center of a hypothesis is in the image. The projection is only calculated once per frame.
+   * @param i The index of the hypothesis in the list obstacleHypotheses.
+   */
+  bool isInImage(const std::size_t i);
+
   float calculateMergeRadius(const Vector2f center, const unsigned maxRadius) const
   {
     const float measurementDistance = center.norm() - minMergeDistance;
@@ -18,6 +18,7 @@
 #include "Platform/File.h"
 #include "Platform/SystemCall.h"
 #include "Platform/Thread.h"
+#include "Platform/Time.h"
 #include <algorithm>
 
 MAKE_MODULE(WhistleDetector);
@@ -39,18 +40,20 @@ WhistleDetector::WhistleDetector()
 
   // Setup buffers for pre- and post-processing.
   amplitudes.resize(detector.input(0).dims(0));
-  samples.reserve(amplitudes.size() * 2 - 2);
+  spectrum.resize(amplitudes.size());
+  fftSize = amplitudes.size() * 2 - 2;
+  hopSize = fftSize / 2;
   thresholdBuffer.reserve(useAdaptiveThreshold ? adaptiveWindowSize : 1);
   nnConfidenceBuffer.reserve(useAdaptiveThreshold ? adaptiveWindowSize / 2 : 1);
   pmConfidenceBuffer.reserve(useAdaptiveThreshold ? adaptiveWindowSize / 2 : 1);
 
   // Init FFT.
-  in = fftw_alloc_real(samples.capacity());
-  std::memset(in, 0, sizeof(double) * samples.capacity());
-  out = fftw_alloc_complex(amplitudes.size());
+  in = fftwf_alloc_real(fftSize);
+  std::memset(in, 0, sizeof(float) * fftSize);
+  out = fftwf_alloc_complex(amplitudes.size());
   {
     SYNC;
-    fft = fftw_plan_dft_r2c_1d(static_cast<int>(samples.capacity()), in, out, FFTW_MEASURE);
+    fft = fftwf_plan_dft_r2c_1d(static_cast<int>(fftSize), in, out, FFTW_MEASURE);
   }
 
   chroma.setResolution(500, static_cast<unsigned>(amplitudes.size()));
@@ -59,9 +62,15 @@ WhistleDetector::WhistleDetector()
 WhistleDetector::~WhistleDetector()
 {
   SYNC;
-  fftw_destroy_plan(fft);
-  fftw_free(out);
-  fftw_free(in);
+  fftwf_destroy_plan(fft);
+  fftwf_free(out);
+  fftwf_free(in);
+  if(legacyFFT)
+  {
+    fftw_destroy_plan(legacyFFT);
+    fftw_free(legacyOut);
+    fftw_free(legacyIn);
+  }
 }
 
 void WhistleDetector::update(Whistle& theWhistle)
@@ -76,32 +85,58 @@ void WhistleDetector::update(Whistle& theWhistle)
   DECLARE_PLOT("module:WhistleDetector:threshold");
   DECLARE_PLOT("module:WhistleDetector:amp:mean");
   DECLARE_PLOT("module:WhistleDetector:amp:max");
+  DECLARE_PLOT("module:WhistleDetector:channels");
+  DECLARE_PLOT("module:WhistleDetector:votes");
+  DECLARE_PLOT("module:WhistleDetector:costPerSecond");
+  DECLARE_PLOT("module:WhistleDetector:costPerSecond:legacy");
   DECLARE_DEBUG_RESPONSE("debug images:module:WhistleDetector:fft");
   DECLARE_DEBUG_RESPONSE("debug images:module:WhistleDetector:chroma");
+  DECLARE_DEBUG_RESPONSE("module:WhistleDetector:benchmark");
 
   if(theAudioData.samples.empty())
   {
     // We are currently not recording -> start from scratch once we record again
     detectionCount = 0;
-    samples.clear();
+    bufferedSamples = 0;
     thresholdBuffer.clear();
   }
   else
   {
-    size_t sampleIndex = channel;
-    while(sampleIndex < theAudioData.samples.size())
+    if(channels.size() != theAudioData.channels)
     {
-      samples.push_front(theAudioData.samples[sampleIndex]);
-      sampleIndex += theAudioData.channels;
+      channels.resize(theAudioData.channels);
+      for(Channel& channel : channels)
+        channel.samples.resize(fftSize);
+      bufferedSamples = 0;
+    }
+
+    // Distribute the interleaved samples to the channels. Whenever the buffers are full,
+    // the detection is run and the buffers are shifted by the hop size, i.e. subsequent
+    // FFTs overlap by half of their samples.
+    const size_t numOfChannels = channels.size();
+    const size_t numOfFrames = theAudioData.samples.size() / numOfChannels;
+    for(size_t frame = 0; frame < numOfFrames;)
+    {
+      const size_t n = std::min(fftSize - bufferedSamples, numOfFrames - frame);
+      for(size_t c = 0; c < numOfChannels; ++c)
+      {
+        const AudioData::Sample* src = theAudioData.samples.data() + frame * numOfChannels + c;
+        float* dst = channels[c].samples.data() + bufferedSamples;
+        for(size_t i = 0; i < n; ++i, src += numOfChannels)
+          dst[i] = *src;
+      }
+      frame += n;
+      bufferedSamples += n;
 
-      if(samples.full())
+      if(bufferedSamples == fftSize)
       {
         // Run whistle detection.
         detect(theWhistle);
 
-        // Drop the older half of the samples.
-        while(samples.size() > samples.capacity() / 2)
-          samples.pop_back();
+        // Drop the oldest samples.
+        for(Channel& channel : channels)
+          std::copy(channel.samples.begin() + hopSize, channel.samples.end(), channel.samples.begin());
+        bufferedSamples -= hopSize;
       }
     }
   }
@@ -130,42 +165,144 @@ void WhistleDetector::update(Whistle& theWhistle)
   draw();
 }
 
-void WhistleDetector::detect(Whistle& theWhistle)
+void WhistleDetector::updateWindow()
 {
-  // Copy to input for FFT.
-  STOPWATCH("module:WhistleDetector:samples")
+  window.resize(fftSize);
+  for(size_t i = 0; i < fftSize; ++i)
   {
-    for(size_t i = 0; i < samples.size(); ++i)
-    {
-      const float phase = static_cast<float>(pi * i / samples.capacity());
-      in[i] = samples[samples.size() - 1 - i]
-              * (windowing == hann ? sqr(std::sin(phase))
-                 : windowing == nuttall ? 0.355768f - 0.487396f * std::sin(phase)
+    const float phase = static_cast<float>(pi * i / fftSize);
+    window[i] = windowing == hann ? sqr(std::sin(phase))
+                : windowing == nuttall ? 0.355768f - 0.487396f * std::sin(phase)
                                          + 0.144232f * std::sin(2.f * phase)
                                          - 0.012604f * std::sin(3.f * phase)
-                 : 0.54f - 0.46f * std::cos(2.f * phase));
-    }
+                : 0.54f - 0.46f * std::cos(2.f * phase);
   }
+  windowType = windowing;
+}
 
-  // Run FFT.
-  STOPWATCH("module:WhistleDetector:FFT") fftw_execute(fft);
+unsigned long long WhistleDetector::runLegacyFrontEnd()
+{
+  if(!legacyFFT)
+  {
+    legacyIn = fftw_alloc_real(fftSize);
+    legacyOut = fftw_alloc_complex(amplitudes.size());
+    SYNC;
+    legacyFFT = fftw_plan_dft_r2c_1d(static_cast<int>(fftSize), legacyIn, legacyOut, FFTW_MEASURE);
+  }
+
+  const unsigned long long start = Time::getCurrentThreadTime();
+  const std::vector<float>& samples = channels.front().samples;
+  for(size_t i = 0; i < fftSize; ++i)
+  {
+    const float phase = static_cast<float>(pi * i / fftSize);
+    legacyIn[i] = samples[i]
+                  * (windowing == hann ? sqr(std::sin(phase))
+                     : windowing == nuttall ? 0.355768f - 0.487396f * std::sin(phase)
+                                             + 0.144232f * std::sin(2.f * phase)
+                                             - 0.012604f * std::sin(3.f * phase)
+                     : 0.54f - 0.46f * std::cos(2.f * phase));
+  }
+  fftw_execute(legacyFFT);
+  for(size_t i = 0; i < spectrum.size(); ++i)
+    spectrum[i] = static_cast<float>(std::sqrt(sqr(legacyOut[i][0]) + sqr(legacyOut[i][1])));
+  return Time::getCurrentThreadTime() - start;
+}
+
+void WhistleDetector::detect(Whistle& theWhistle)
+{
+  if(windowType != windowing)
+    updateWindow();
+
+  // The frequency window in which the whistle is searched.
+  const Range<unsigned> pos(static_cast<unsigned>(currentFreq.min * fftSize / theAudioData.sampleRate),
+                            static_cast<unsigned>(currentFreq.max * fftSize / theAudioData.sampleRate));
 
   // These variables are set inside the STOPWATCH, but are also needed outside.
+  unsigned numOfChannelsUsed = 0;
   float relLimitCount;
   auto peak = amplitudes.begin();
+  unsigned votes = 0;
   float pmConfidence;
   float currentMaxAmp = 0.f;
   float currentMeanAmp;
 
+  const unsigned long long start = Time::getCurrentThreadTime();
+  STOPWATCH("module:WhistleDetector:FFT")
+  {
+    std::fill(amplitudes.begin(), amplitudes.end(), 0.f);
+    for(Channel& channel : channels)
+    {
+      channel.used = false;
+      if(!jointChannels && numOfChannelsUsed > 0)
+        continue;
+
+      const float* samples = channel.samples.data();
+      const float* weights = window.data();
+      for(size_t i = 0; i < fftSize; ++i)
+        in[i] = samples[i] * weights[i];
+      fftwf_execute(fft);
+
+      float ampSum = 0.f;
+      for(size_t i = 0; i < spectrum.size(); ++i)
+      {
+        const float amp = std::sqrt(sqr(out[i][0]) + sqr(out[i][1]));
+        spectrum[i] = amp;
+        ampSum += amp;
+      }
+
+      // Ignore the channel if its microphone is probably broken.
+      if(ampSum / spectrum.size() >= channelMinAmplitude)
+        channel.deafCount = 0;
+      else if(channel.deafCount < channelMinDeafCount)
+        ++channel.deafCount;
+      if(channel.deafCount >= channelMinDeafCount)
+        continue;
+
+      channel.used = true;
+      channel.peak = static_cast<unsigned>(std::max_element(spectrum.begin() + pos.min + 1, spectrum.begin() + pos.max) - spectrum.begin());
+      for(size_t i = 0; i < amplitudes.size(); ++i)
+        amplitudes[i] += spectrum[i];
+      ++numOfChannelsUsed;
+    }
+
+    if(numOfChannelsUsed > 0)
+    {
+      theWhistle.channelsUsedForWhistleDetection = numOfChannelsReported;
+      const float scale = 1.f / static_cast<float>(numOfChannelsUsed);
+      for(float& amp : amplitudes)
+        amp *= scale;
+    }
+    else
+    {
+      // Continue with the spectrum of the last channel anyway.
+      amplitudes = spectrum;
+      theWhistle.channelsUsedForWhistleDetection = 0;
+      if(!allDeafAlert)
+      {
+        SystemCall::say("All microphones are probably broken.", true);
+        allDeafAlert = true;
+      }
+    }
+  }
+  const unsigned long long duration = Time::getCurrentThreadTime() - start;
+  PLOT("module:WhistleDetector:channels", numOfChannelsUsed);
+
+  // Compare the cost of the front end per second of audio with the one of the previous implementation.
+  DEBUG_RESPONSE("module:WhistleDetector:benchmark")
+  {
+    const float secondsPerHop = static_cast<float>(hopSize) / static_cast<float>(theAudioData.sampleRate);
+    PLOT("module:WhistleDetector:costPerSecond", static_cast<float>(duration) / 1000.f / secondsPerHop);
+    PLOT("module:WhistleDetector:costPerSecond:legacy", static_cast<float>(runLegacyFrontEnd()) / 1000.f / secondsPerHop);
+  }
+
   STOPWATCH("module:WhistleDetector:amplitudes")
   {
     float ampSum = 0;
     float limitCount = 0;
     for(size_t i = 0; i < amplitudes.size(); ++i)
     {
-      const float amp = static_cast<float>(std::sqrt(sqr(out[i][0]) + sqr(out[i][1])));
+      const float amp = amplitudes[i];
       detector.input(0)[i] = 20.f * std::log10(amp);
-      amplitudes[i] = amp;
       currentMaxAmp = std::max(currentMaxAmp, amp);
       if(amp > limit)
         ++limitCount;
@@ -176,42 +313,22 @@ void WhistleDetector::detect(Whistle& theWhistle)
     PLOT("module:WhistleDetector:amp:max", currentMaxAmp);
     currentMeanAmp = ampSum / amplitudes.size();
     PLOT("module:WhistleDetector:amp:mean", currentMeanAmp);
-
-    //switch to another mic if the current mic is probably broken
-    if(currentMeanAmp >= channelMinAmplitude)
-    {
-      deafCount = 0;
-      theWhistle.channelsUsedForWhistleDetection = numOfChannelsReported;
-    }
-    else if(++deafCount >= channelMinDeafCount)
-    {
-      if(channel < static_cast<unsigned int>(theAudioData.channels - 1))
-      {
-        ++channel;
-        deafCount = 0;
-      }
-      else
-      {
-        theWhistle.channelsUsedForWhistleDetection = 0;
-        if(!allDeafAlert)
-        {
-          SystemCall::say("All microphones are probably broken.", true);
-          allDeafAlert = true;
-        }
-      }
-    }
   }
 
   STOPWATCH("module:WhistleDetector:detect")
   {
     //do WhistleDetection PM
-    const Range<unsigned> pos(static_cast<unsigned>(currentFreq.min * samples.capacity() / theAudioData.sampleRate),
-                              static_cast<unsigned>(currentFreq.max * samples.capacity() / theAudioData.sampleRate));
-
     // find whistle peak between min. freq. position and  max. freq. position
     peak = std::max_element(amplitudes.begin() + pos.min + 1, amplitudes.begin() + pos.max);
     const float ampWeight = useWeightedPMConfidence ? *peak / currentMaxAmp : 1.f;
 
+    // count the channels that agree with the joint peak
+    const unsigned peakIndex = static_cast<unsigned>(peak - amplitudes.begin());
+    for(const Channel& channel : channels)
+      if(channel.used && channel.peak + 1 >= peakIndex && channel.peak <= peakIndex + 1)
+        ++votes;
+    PLOT("module:WhistleDetector:votes", votes);
+
     //get min/max gradients around peakPos
     const Rangef grad(std::abs(*(peak + 1) - *peak) / currentMaxAmp,
                       std::abs(*peak - * (peak - 1)) / currentMaxAmp);
@@ -246,10 +363,11 @@ void WhistleDetector::detect(Whistle& theWhistle)
   const float averageThreshold = thresholdBuffer.average();
   if(thresholdBuffer.full() && confidence > averageThreshold
      && nnConfidenceBuffer.back() > averageThreshold * thresholdRatio
-     && pmConfidenceBuffer.back() > averageThreshold * thresholdRatio)  // whistle detected this frame, min of #attack detections needed
+     && pmConfidenceBuffer.back() > averageThreshold * thresholdRatio
+     && votes >= std::min(minChannelVotes, numOfChannelsUsed))  // whistle detected this frame, min of #attack detections needed
   {
     lastTimeCandidateDetected = theFrameInfo.time;
-    const unsigned detectedWhistleFrequency = static_cast<unsigned>((peak - amplitudes.begin()) * theAudioData.sampleRate / samples.capacity());
+    const unsigned detectedWhistleFrequency = static_cast<unsigned>((peak - amplitudes.begin()) * theAudioData.sampleRate / fftSize);
     if(++detectionCount >= minDetections && confidence / averageThreshold > bestConfidence)
     {
       bestConfidence = confidence / averageThreshold;
@@ -297,8 +415,8 @@ void WhistleDetector::draw()
     };
 
     // transform sample rate to fft size to debug image size
-    const Range<unsigned> xRange(static_cast<unsigned>(currentFreq.min * samples.capacity() / theAudioData.sampleRate * fft.width / amplitudes.size()),
-                                 static_cast<unsigned>(currentFreq.max * samples.capacity() / theAudioData.sampleRate * fft.width / amplitudes.size()));
+    const Range<unsigned> xRange(static_cast<unsigned>(currentFreq.min * fftSize / theAudioData.sampleRate * fft.width / amplitudes.size()),
+                                 static_cast<unsigned>(currentFreq.max * fftSize / theAudioData.sampleRate * fft.width / amplitudes.size()));
 
     // draw main detection rect
     for(unsigned x = xRange.min; x <= xRange.max; ++x)
@@ -317,7 +435,7 @@ void WhistleDetector::draw()
       const unsigned yTemp = std::min(fft.height - 1, static_cast<unsigned>(amplitudes[xTemp]));
 
       // draw vertical grid
-      if(xTemp * theAudioData.sampleRate / samples.capacity() >= grid)
+      if(xTemp * theAudioData.sampleRate / fftSize >= grid)
       {
         drawLine(x, 0, x, fft.height - 1, 0x505050);
         grid += 1000;
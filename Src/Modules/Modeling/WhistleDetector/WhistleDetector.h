@@ -57,23 +57,43 @@ MODULE(WhistleDetector,
     (unsigned) minDetections, /**< The minimum number of detections to accept the whistle. */
     (int) minTimeBetweenWhistles, /**< Minimum time after a whistle was detected to accept the next one (in ms). */
     (unsigned char) numOfChannelsReported, /**< The number of channels reported when listening. */
+    (bool) jointChannels, /**< Are the spectra of all working microphones averaged rather than using only the first working one? */
+    (unsigned) minChannelVotes, /**< The minimum number of working channels whose own peak must agree with the joint peak. */
   }),
 });
 
 class WhistleDetector : public WhistleDetectorBase
 {
-  unsigned channel = 0; /**< The channel, i.e. the microphone, that is used for whistle detection. */
-  RingBuffer<float> samples; /**< The audio samples of that channel to process. */
+  /** The state of a single channel, i.e. microphone. */
+  struct Channel
+  {
+    std::vector<float> samples; /**< The last samples of this channel. The oldest one comes first. */
+    unsigned deafCount = 0; /**< How often was the mean amplitude too low consecutively on this channel? */
+    unsigned peak = 0; /**< The index of the highest amplitude in the frequency window in the last evaluation. */
+    bool used = false; /**< Was this channel part of the last evaluation? */
+  };
+
+  std::vector<Channel> channels; /**< The state of all channels recorded. */
+  size_t fftSize; /**< The number of samples per FFT. */
+  size_t hopSize; /**< The number of new samples per channel between two FFTs. */
+  size_t bufferedSamples = 0; /**< The number of samples per channel currently buffered. */
 
-  fftw_plan fft; /**< The plan to compute the FFT. */
-  double* in = nullptr; /**< The input of the FFT. */
-  fftw_complex* out = nullptr; /**< The output of the FFT. */
+  std::vector<float> window; /**< The precomputed window applied to the input of the FFT. */
+  Windowing windowType = numOfWindowings; /**< The windowing method the window was computed for. */
 
-  std::vector<float> amplitudes; /**< The amplitudes of the different frequencies. */
+  fftwf_plan fft; /**< The single precision plan to compute the FFT. It is reused for all channels. */
+  float* in = nullptr; /**< The input of the FFT. */
+  fftwf_complex* out = nullptr; /**< The output of the FFT. */
+
+  std::vector<float> spectrum; /**< The amplitudes of a single channel. */
+  std::vector<float> amplitudes; /**< The amplitudes of the different frequencies averaged over all channels used. */
   RingBufferWithSum<float, 200> maxAmpHist; /**< The maximum amplitudes of the last 200 FFTs. */
-  unsigned deafCount = 0; /**< How often was the mean amplitude too low consecutively on this channel? */
   bool allDeafAlert = false; /**< Already informed that all microphones are broken? */
 
+  fftw_plan legacyFFT = nullptr; /**< The double precision plan of the previous implementation, only created for benchmarking. */
+  double* legacyIn = nullptr; /**< The input of the legacy FFT. */
+  fftw_complex* legacyOut = nullptr; /**< The output of the legacy FFT. */
+
   Range<unsigned> currentFreq; /**< The frequency window in which it is searched for the whistle. */
   NeuralNetworkONNX::CompiledNN detector; /**< The neural whistle detector. */
   std::unique_ptr<NeuralNetworkONNX::Model> model; /**< The model loaded into the detector. */
@@ -104,6 +124,16 @@ class WhistleDetector : public WhistleDetectorBase
    */
   void detect(Whistle& theWhistle);
 
+  /** Recomputes the window for the current windowing method. */
+  void updateWindow();
+
+  /**
+   * Runs the front end of the previous implementation on the first channel, i.e. it computes
+   * the window per sample and uses a double precision FFT.
+   * @return The thread time consumed in µs.
+   */
+  unsigned long long runLegacyFrontEnd();
+
   /** Creates two debug images. */
   void draw();
 
@@ -97,6 +97,12 @@ void MotionEngine::update(JointRequest& jointRequest)
   MotionRequest motionRequest = theMotionRequest;
   if(forceSitDown)
     motionRequest.motion = MotionRequest::playDead;
+  else if(theMotionDeadlineStatus.safeMode && motionRequest.motion != MotionRequest::playDead)
+  {
+    // Deadlines are missed repeatedly, so only stand (getting up and falling are still handled below).
+    motionRequest.motion = MotionRequest::stand;
+    motionRequest.standHigh = false;
+  }
 
   // 2.1 check if a FallPhase should start ...
   const bool getUp = motionRequest.motion != MotionRequest::playDead && motionRequest.motion != MotionRequest::dive &&
@@ -27,6 +27,7 @@
 #include "Representations/Infrastructure/GameState.h"
 #include "Representations/Infrastructure/JointAngles.h"
 #include "Representations/Infrastructure/JointRequest.h"
+#include "Representations/Infrastructure/MotionDeadlineStatus.h"
 #include "Representations/Infrastructure/StiffnessData.h"
 #include "Representations/MotionControl/ArmKeyFrameGenerator.h"
 #include "Representations/MotionControl/ArmMotionInfo.h"
@@ -93,6 +94,7 @@ MODULE(MotionEngine,
   REQUIRES(JointLimits),
   REQUIRES(JointPlay),
   REQUIRES(KeyframeMotionGenerator),
+  REQUIRES(MotionDeadlineStatus),
   REQUIRES(MotionRequest),
   REQUIRES(OdometryDataPreview),
   REQUIRES(OdometryTranslationRequest),
@@ -390,7 +390,7 @@ void RLWalkingEngine::update(WalkGenerator& walkGenerator)
     Pose2f right;
     Pose2f lastStep;
 
-    const RobotModel lastRobotModel(theJointRequest, theRobotDimensions, theMassCalibration);
+    const RobotModel& lastRobotModel = theRequestedRobotModel;
     left.translate(lastRobotModel.soleLeft.translation.head<2>()).rotate(lastRobotModel.soleLeft.rotation.getZAngle()); // Wrong, because the 0 position is unknown
     right.translate(lastRobotModel.soleRight.translation.head<2>()).rotate(lastRobotModel.soleRight.rotation.getZAngle());
 
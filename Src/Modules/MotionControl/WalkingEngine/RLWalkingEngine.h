@@ -9,7 +9,6 @@
 #include "Framework/Module.h"
 #include "Framework/Settings.h"
 #include "Representations/Configuration/JointLimits.h"
-#include "Representations/Configuration/MassCalibration.h"
 #include "Representations/Configuration/RobotDimensions.h"
 #include "Representations/Infrastructure/FrameInfo.h"
 #include "Representations/Infrastructure/GameState.h"
@@ -106,8 +105,8 @@ MODULE(RLWalkingEngine,
   REQUIRES(InertialData),
   REQUIRES(JointAngles),
   USES(JointRequest),
-  REQUIRES(MassCalibration),
   REQUIRES(OdometryDataPreview),
+  REQUIRES(RequestedRobotModel),
   REQUIRES(RobotDimensions),
   REQUIRES(RobotModel),
   REQUIRES(SolePressureState),
@@ -379,7 +379,7 @@ void WalkPhaseBase::constructorAfterKickOrGetUpCase(const MotionPhase& lastPhase
   constructorInitWithJointRequest(Pose2f(0.f, 0.f, 0.f), WalkKickStep::OverrideFoot::request, WalkKickStep::OverrideFoot::request);
 
   armCompensationAfterKick = 1.f;
-  const RobotModel lastRobotModel(engine.theJointRequest, engine.theRobotDimensions, engine.theMassCalibration);
+  const RobotModel& lastRobotModel = engine.theRequestedRobotModel;
 
   forwardStep = 0.f;
   sideStep = -(isLeftPhase ? lastRobotModel.soleRight.translation.y() + 50.f : lastRobotModel.soleLeft.translation.y() - 50.f);
@@ -154,7 +154,7 @@ void WalkingEngine::update(WalkGenerator& walkGenerator)
 
   DEBUG_RESPONSE("module:WalkingEngine:feetPositions")
   {
-    RobotModel requestedModel(theJointRequest, theRobotDimensions, theMassCalibration);
+    RobotModel requestedModel = theRequestedRobotModel;
     Pose3f& left = requestedModel.soleLeft;
     Pose3f& right = requestedModel.soleRight;
     PLOT("module:WalkingEngine:current:left:x", theRobotModel.soleLeft.translation.x());
@@ -579,7 +579,7 @@ void WalkingEngine::update(WalkGenerator& walkGenerator)
     }
     else
     {
-      const RobotModel lastRobotModel(theJointRequest, theRobotDimensions, theMassCalibration);
+      const RobotModel& lastRobotModel = theRequestedRobotModel;
       left.translate(lastRobotModel.soleLeft.translation.head<2>() + Vector2f(kinematicParameters.torsoOffset, -theRobotDimensions.yHipOffset - kinematicParameters.yHipOffset)).rotate(lastRobotModel.soleLeft.rotation.getZAngle());
       right.translate(lastRobotModel.soleRight.translation.head<2>() + Vector2f(kinematicParameters.torsoOffset, theRobotDimensions.yHipOffset + kinematicParameters.yHipOffset)).rotate(lastRobotModel.soleRight.rotation.getZAngle());
     }
@@ -292,6 +292,7 @@ MODULE(WalkingEngine,
   REQUIRES(MassCalibration),
   REQUIRES(MotionRequest),
   REQUIRES(OdometryDataPreview),
+  REQUIRES(RequestedRobotModel),
   REQUIRES(RobotDimensions),
   REQUIRES(RobotModel),
   REQUIRES(RobotStableState),
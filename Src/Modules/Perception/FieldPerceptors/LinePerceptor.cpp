@@ -16,10 +16,20 @@
 #include "Math/Deviation.h"
 #include "Math/Geometry.h"
 #include "Tools/Math/Transformation.h"
+#include <algorithm>
 #include <ranges>
 
 MAKE_MODULE(LinePerceptor);
 
+/** The directions in which the center circle is sampled, i.e. in steps of 5°. */
+static const std::vector<Vector2f> circleDirections = []
+{
+  std::vector<Vector2f> directions;
+  for(Angle a = 0_deg; a < 360_deg; a += 5_deg)
+    directions.emplace_back(std::cos(a), std::sin(a));
+  return directions;
+}();
+
 void LinePerceptor::update(LinesPercept& linesPercept)
 {
   DECLARE_DEBUG_DRAWING("module:LinePerceptor:spots", "drawingOnImage");
@@ -28,6 +38,7 @@ void LinePerceptor::update(LinesPercept& linesPercept)
   DECLARE_DEBUG_DRAWING("module:LinePerceptor:isWhite", "drawingOnImage");
   linesPercept.lines.clear();
   circleCandidates.clear();
+  inverseCameraMatrix = theCameraMatrix.inverse();
   scanHorizontalScanLines(linesPercept);
   scanVerticalScanLines(linesPercept);
   extendLines(linesPercept);
@@ -42,6 +53,7 @@ void LinePerceptor::update(CirclePercept& circlePercept)
   DECLARE_DEBUG_RESPONSE("module:LinePerceptor:circleErrorStats");
 
   circlePercept.wasSeen = false;
+  inverseCameraMatrix = theCameraMatrix.inverse();
 
   if(!circleCandidates.empty())
   {
@@ -118,6 +130,7 @@ void LinePerceptor::scanHorizontalScanLines(LinesPercept& linesPercept)
 {
   spotsH.resize(theColorScanLineRegionsHorizontal.scanLines.size());
   candidates.clear();
+  activeCandidates.clear();
 
   if(!theFieldBoundary.isValid)
     return;
@@ -157,7 +170,7 @@ void LinePerceptor::scanHorizontalScanLines(LinesPercept& linesPercept)
             Vector2f corrected(theImageCoordinateSystem.toCorrected(thisSpot.image));
             Vector2f otherImage;
             if(Transformation::imageToRobot(corrected, theCameraMatrix, theCameraInfo, thisSpot.field) &&
-               Transformation::robotToImage(Vector2f(thisSpot.field + thisSpot.field.normalized(theFieldDimensions.fieldLinesWidth).rotateLeft()), theCameraMatrix, theCameraInfo, otherImage))
+               fieldToImage(Vector2f(thisSpot.field + thisSpot.field.normalized(theFieldDimensions.fieldLinesWidth).rotateLeft()), otherImage))
             {
               float expectedWidth = (otherImage - corrected).norm();
               if(getAbsoluteDeviation(static_cast<int>(expectedWidth), region->range.right - region->range.left) <= maxLineWidthDeviationPx &&
@@ -185,10 +198,10 @@ void LinePerceptor::scanHorizontalScanLines(LinesPercept& linesPercept)
                   break;
                 }
               }
-              for(Candidate& candidate : candidates)
+              for(const unsigned index : activeCandidates)
               {
-                if(candidate.spots.size() > 1 &&
-                   candidate.getDistance(thisSpot.field) <= maxLineFittingError &&
+                const Candidate& candidate = candidates[index];
+                if(candidate.getDistance(thisSpot.field) <= maxLineFittingError &&
                    isSegmentValid(thisSpot, *candidate.spots.back(), candidate))
                 {
                   if(!circleFitted)
@@ -205,9 +218,7 @@ void LinePerceptor::scanHorizontalScanLines(LinesPercept& linesPercept)
                   }
                   if(!lineFitted)
                   {
-                    thisSpot.candidate = candidate.spots.front()->candidate;
-                    candidate.spots.emplace_back(&thisSpot);
-                    candidate.fitLine();
+                    addSpotToCandidate(thisSpot, index);
                     if(circleFitted)
                       goto hEndAdjacentSearch;
                     lineFitted = true;
@@ -218,14 +229,12 @@ void LinePerceptor::scanHorizontalScanLines(LinesPercept& linesPercept)
                 goto hEndAdjacentSearch;
               for(const Spot& spot : spotsH[scanLineId - 1])
               {
-                Candidate& candidate = candidates[spot.candidate];
+                const Candidate& candidate = candidates[spot.candidate];
                 if(candidate.spots.size() == 1 &&
                    getAbsoluteDeviation(spot.image.x(), thisSpot.image.x()) < getAbsoluteDeviation(spot.image.y(), thisSpot.image.y()) &&
                    isSegmentValid(thisSpot, spot, candidate))
                 {
-                  thisSpot.candidate = candidate.spots.front()->candidate;
-                  candidate.spots.emplace_back(&thisSpot);
-                  candidate.fitLine();
+                  addSpotToCandidate(thisSpot, spot.candidate);
                   goto hEndAdjacentSearch;
                 }
               }
@@ -300,6 +309,7 @@ void LinePerceptor::scanVerticalScanLines(LinesPercept& linesPercept)
 {
   spotsV.resize(theColorScanLineRegionsVerticalClipped.scanLines.size());
   candidates.clear();
+  activeCandidates.clear();
 
   unsigned int scanLineId = 0;
   unsigned int startIndex = highResolutionScan ? 0 : theColorScanLineRegionsVerticalClipped.lowResStart;
@@ -334,7 +344,7 @@ void LinePerceptor::scanVerticalScanLines(LinesPercept& linesPercept)
             Vector2f corrected = theImageCoordinateSystem.toCorrected(thisSpot.image);
             Vector2f otherImage;
             if(Transformation::imageToRobot(corrected, theCameraMatrix, theCameraInfo, thisSpot.field) &&
-               Transformation::robotToImage(Vector2f(thisSpot.field + thisSpot.field.normalized(theFieldDimensions.fieldLinesWidth)), theCameraMatrix, theCameraInfo, otherImage))
+               fieldToImage(Vector2f(thisSpot.field + thisSpot.field.normalized(theFieldDimensions.fieldLinesWidth)), otherImage))
             {
               float expectedHeight = (corrected - otherImage).norm();
               if((before->range.lower - before->range.upper >= static_cast<int>(expectedHeight * GREEN_AROUND_LINE_RATIO) ||
@@ -361,10 +371,10 @@ void LinePerceptor::scanVerticalScanLines(LinesPercept& linesPercept)
                   break;
                 }
               }
-              for(Candidate& candidate : candidates)
+              for(const unsigned index : activeCandidates)
               {
-                if(candidate.spots.size() > 1 &&
-                   candidate.getDistance(thisSpot.field) <= maxLineFittingError &&
+                const Candidate& candidate = candidates[index];
+                if(candidate.getDistance(thisSpot.field) <= maxLineFittingError &&
                    isSegmentValid(thisSpot, *candidate.spots.back(), candidate))
                 {
                   if(!circleFitted)
@@ -381,9 +391,7 @@ void LinePerceptor::scanVerticalScanLines(LinesPercept& linesPercept)
                   }
                   if(!lineFitted)
                   {
-                    thisSpot.candidate = candidate.spots.front()->candidate;
-                    candidate.spots.emplace_back(&thisSpot);
-                    candidate.fitLine();
+                    addSpotToCandidate(thisSpot, index);
                     if(circleFitted)
                       goto vEndAdjacentSearch;
                     lineFitted = true;
@@ -394,14 +402,12 @@ void LinePerceptor::scanVerticalScanLines(LinesPercept& linesPercept)
                 goto vEndAdjacentSearch;
               for(const Spot& spot : spotsV[previousVerticalScanLine(thisSpot, static_cast<int>(scanLineId))])
               {
-                Candidate& candidate = candidates[spot.candidate];
+                const Candidate& candidate = candidates[spot.candidate];
                 if(candidate.spots.size() == 1 &&
                    getAbsoluteDeviation(spot.image.x(), thisSpot.image.x()) > getAbsoluteDeviation(spot.image.y(), thisSpot.image.y()) &&
                    isSegmentValid(thisSpot, spot, candidate))
                 {
-                  thisSpot.candidate = candidate.spots.front()->candidate;
-                  candidate.spots.emplace_back(&thisSpot);
-                  candidate.fitLine();
+                  addSpotToCandidate(thisSpot, spot.candidate);
                   goto vEndAdjacentSearch;
                 }
               }
@@ -662,6 +668,16 @@ void LinePerceptor::trimLine(LinesPercept::Line& line) const
   }
 }
 
+void LinePerceptor::addSpotToCandidate(Spot& spot, unsigned index)
+{
+  Candidate& candidate = candidates[index];
+  spot.candidate = index;
+  candidate.spots.emplace_back(&spot);
+  candidate.fitLine();
+  if(candidate.spots.size() == 2)
+    activeCandidates.insert(std::lower_bound(activeCandidates.begin(), activeCandidates.end(), index), index);
+}
+
 bool LinePerceptor::isSegmentValid(const Spot& a, const Spot& b, const Candidate& candidate)
 {
   Vector2f n0 = (b.field - a.field);
@@ -700,9 +716,13 @@ bool LinePerceptor::isWhite(const Spot& a, const Spot& b, const Vector2f& n0Fiel
   {
     Vector2f pointOnField = a.field;
     unsigned int nonWhiteCount = 0;
+    auto remainingPixels = static_cast<unsigned int>(line.size());
     COMPLEX_DRAWING("module:LinePerceptor:isWhite") debugIsPointWhite = true;
     for(const Vector2i& p : line)
     {
+      // Stop if even the remaining pixels being non-white would not reject the line.
+      if(nonWhiteCount + remainingPixels-- <= maxNonWhitePixels)
+        break;
       if(Transformation::imageToRobot(theImageCoordinateSystem.toCorrected(p), theCameraMatrix, theCameraInfo, pointOnField))
       {
         if(!isPointWhite(pointOnField, p, n0Field))
@@ -776,18 +796,18 @@ bool LinePerceptor::isWhite(const Spot& a, const Spot& b, const Vector2f& n0Fiel
 bool LinePerceptor::correctCircle(CircleCandidate& circle) const
 {
   Vector2f centerInImage;
-  if(!Transformation::robotToImage(circle.center, theCameraMatrix, theCameraInfo, centerInImage))
+  if(!fieldToImage(circle.center, centerInImage))
     return false;
 
   centerInImage = theImageCoordinateSystem.fromCorrected(centerInImage);
 
   circle.fieldSpots.clear();
 
-  for(Angle a = 0_deg; a < 360_deg; a += 5_deg)
+  for(const Vector2f& direction : circleDirections)
   {
-    Vector2f pointOnField(circle.center.x() + std::cos(a) * circle.radius, circle.center.y() + std::sin(a) * circle.radius);
+    Vector2f pointOnField(circle.center.x() + direction.x() * circle.radius, circle.center.y() + direction.y() * circle.radius);
     Vector2f pointInImage;
-    if(Transformation::robotToImage(pointOnField, theCameraMatrix, theCameraInfo, pointInImage))
+    if(fieldToImage(pointOnField, pointInImage))
     {
       auto imageWidth = static_cast<float>(theCameraInfo.width);
       auto imageHeight = static_cast<float>(theCameraInfo.height);
@@ -907,11 +927,11 @@ bool LinePerceptor::correctCircle(CircleCandidate& circle) const
 bool LinePerceptor::isCircleWhite(const Vector2f& center, const float radius) const
 {
   unsigned int whiteCount = 0, count = 0;
-  for(Angle a = 0_deg; a < 360_deg; a += 5_deg)
+  for(const Vector2f& direction : circleDirections)
   {
-    Vector2f pointOnField(center.x() + std::cos(a) * radius, center.y() + std::sin(a) * radius);
+    Vector2f pointOnField(center.x() + direction.x() * radius, center.y() + direction.y() * radius);
     Vector2f pointInImage;
-    if(Transformation::robotToImage(pointOnField, theCameraMatrix, theCameraInfo, pointInImage))
+    if(fieldToImage(pointOnField, pointInImage))
     {
       pointInImage = theImageCoordinateSystem.fromCorrected(pointInImage);
       if(pointInImage.x() >= 0 && pointInImage.x() < static_cast<float>(theCameraInfo.width) &&
@@ -920,8 +940,7 @@ bool LinePerceptor::isCircleWhite(const Vector2f& center, const float radius) co
         CROSS("module:LinePerceptor:circleCheckPoint", pointInImage.x(), pointInImage.y(), 5, 2, Drawings::solidPen, ColorRGBA::black);
         CROSS("module:LinePerceptor:circleCheckPointField", pointOnField.x(), pointOnField.y(), 5, 2, Drawings::solidPen, ColorRGBA::black);
         count++;
-        Vector2f n0(std::cos(a), std::sin(a)); // normal vector pointing outward
-        if(isPointWhite(pointOnField, pointInImage.cast<int>(), n0))
+        if(isPointWhite(pointOnField, pointInImage.cast<int>(), direction)) // normal vector pointing outward
           whiteCount++;
       }
     }
@@ -979,6 +998,11 @@ bool LinePerceptor::isCircleNotALine(const CircleCandidate& candidate, float& li
   return candidate.calculateError() < lineError;
 }
 
+bool LinePerceptor::fieldToImage(const Vector2f& pointOnField, Vector2f& pointInImage) const
+{
+  return Transformation::robotToImage(Vector3f(pointOnField.x(), pointOnField.y(), 0.f), inverseCameraMatrix, theCameraInfo, pointInImage);
+}
+
 bool LinePerceptor::isPointWhite(const Vector2f& pointOnField, const Vector2i& pointInImage, const Vector2f& n0) const
 {
   Vector2f nw = calcWhiteCheckDistance(pointOnField) * n0;
@@ -987,7 +1011,7 @@ bool LinePerceptor::isPointWhite(const Vector2f& pointOnField, const Vector2i& p
   Vector2f referencePointInImage;
   unsigned short luminanceReference = 0, saturationReference = 0;
   bool isOuterPointInImage = false;
-  if(Transformation::robotToImage(outerPointOnField, theCameraMatrix, theCameraInfo, referencePointInImage))
+  if(fieldToImage(outerPointOnField, referencePointInImage))
   {
     referencePointInImage = theImageCoordinateSystem.fromCorrected(referencePointInImage);
     Vector2i integerReferenceInImage = referencePointInImage.cast<int>();
@@ -1005,7 +1029,7 @@ bool LinePerceptor::isPointWhite(const Vector2f& pointOnField, const Vector2i& p
       }
     }
   }
-  if(Transformation::robotToImage(innerPointOnField, theCameraMatrix, theCameraInfo, referencePointInImage))
+  if(fieldToImage(innerPointOnField, referencePointInImage))
   {
     referencePointInImage = theImageCoordinateSystem.fromCorrected(referencePointInImage);
     Vector2i integerReferenceInImage = referencePointInImage.cast<int>();
@@ -263,7 +263,9 @@ private:
   std::vector<std::vector<Spot>> spotsH;
   std::vector<std::vector<Spot>> spotsV;
   std::vector<Candidate> candidates;
+  std::vector<unsigned> activeCandidates; /**< Indices of all line candidates with more than one spot in ascending order. Only these are checked for spots that are not adjacent. */
   std::vector<CircleCandidate> circleCandidates;
+  Pose3f inverseCameraMatrix; /**< The inverse of the camera matrix, cached per frame for projecting field points into the image. */
 
   /** distance in mm where the field next to the line is sampled during white checks */
   const float whiteCheckDistance = theFieldDimensions.fieldLinesWidth * 2;
@@ -306,6 +308,24 @@ private:
    */
   void extendLines(LinesPercept& linesPercept) const;
 
+  /**
+   * Projects a point on the field into the image using the inverse camera
+   * matrix cached for the current frame.
+   *
+   * @param pointOnField the point in robot-relative field coordinates
+   * @param pointInImage the point in corrected image coordinates
+   * @return whether the point is in front of the camera
+   */
+  bool fieldToImage(const Vector2f& pointOnField, Vector2f& pointInImage) const;
+
+  /**
+   * Adds a spot to a line candidate and refits the line.
+   *
+   * @param spot the spot to add
+   * @param index the index of the candidate
+   */
+  void addSpotToCandidate(Spot& spot, unsigned index);
+
   /**
    * Checks whether the given line is extended by robots.
    * If this is the case, the line is trimmed accordingly.
@@ -468,6 +488,7 @@ public:
     spotsH.reserve(20);
     spotsV.reserve(20);
     candidates.reserve(50);
+    activeCandidates.reserve(50);
     circleCandidates.reserve(50);
   }
 };
@@ -26,6 +26,12 @@ void JerseyClassifierProvider2020For2023::update(JerseyClassifier& jerseyClassif
   DECLARE_DEBUG_DRAWING("module:JerseyClassifierProvider2020For2023:jerseyWeights", "drawingOnImage");
   DECLARE_DEBUG_DRAWING("module:JerseyClassifierProvider2020For2023:jerseyClassification", "drawingOnImage");
 
+  // The classifiers only depend on the team colors, so they are set up once per frame.
+  pixelClassifiers[ownFieldPlayer] = getPixelClassifier(theGameState.ownTeam.fieldPlayerColor, theGameState.opponentTeam.fieldPlayerColor, theGameState.opponentTeam.goalkeeperColor, theGameState.ownTeam.goalkeeperColor);
+  pixelClassifiers[opponentFieldPlayer] = getPixelClassifier(theGameState.opponentTeam.fieldPlayerColor, theGameState.ownTeam.fieldPlayerColor, theGameState.opponentTeam.goalkeeperColor, theGameState.ownTeam.goalkeeperColor);
+  pixelClassifiers[ownGoalkeeper] = getPixelClassifier(theGameState.ownTeam.goalkeeperColor, theGameState.ownTeam.fieldPlayerColor, theGameState.opponentTeam.fieldPlayerColor, theGameState.opponentTeam.goalkeeperColor);
+  pixelClassifiers[opponentGoalkeeper] = getPixelClassifier(theGameState.opponentTeam.goalkeeperColor, theGameState.opponentTeam.fieldPlayerColor, theGameState.ownTeam.fieldPlayerColor, theGameState.ownTeam.goalkeeperColor);
+
   jerseyClassifier.detectJersey = [this](const ObstaclesImagePercept::Obstacle& obstacleInImage, ObstaclesFieldPercept::Obstacle& obstacleOnField)
   {
     return detectJersey(obstacleInImage, obstacleOnField);
@@ -119,16 +125,14 @@ void JerseyClassifierProvider2020For2023::detectJersey(const ObstaclesImagePerce
             maxBrightness = std::max(theECImage.grayscaled[static_cast<int>(centerInImage.y()) + whiteScanOffSet * yOffset][static_cast<int>(x)], maxBrightness);
       }
 
-      // Get pixel classifier
-      const std::function<bool(int, int)>& isOwnFieldPlayer = getPixelClassifier(theGameState.ownTeam.fieldPlayerColor, theGameState.opponentTeam.fieldPlayerColor, theGameState.opponentTeam.goalkeeperColor, theGameState.ownTeam.goalkeeperColor, maxBrightness);
-      const std::function<bool(int, int)>& isOpponentFieldPlayer = getPixelClassifier(theGameState.opponentTeam.fieldPlayerColor, theGameState.ownTeam.fieldPlayerColor, theGameState.opponentTeam.goalkeeperColor, theGameState.ownTeam.goalkeeperColor, maxBrightness);
-      const std::function<bool(int, int)>& isOwnGoalkeeper = getPixelClassifier(theGameState.ownTeam.goalkeeperColor, theGameState.ownTeam.fieldPlayerColor, theGameState.opponentTeam.fieldPlayerColor, theGameState.opponentTeam.goalkeeperColor, maxBrightness);
-      const std::function<bool(int, int)>& isOpponentGoalkeeper = getPixelClassifier(theGameState.opponentTeam.goalkeeperColor, theGameState.opponentTeam.fieldPlayerColor, theGameState.ownTeam.fieldPlayerColor, theGameState.ownTeam.goalkeeperColor, maxBrightness);
+      // Pixels must be darker than this to be considered as black (per player type).
+      const int gray = static_cast<int>(maxBrightness * grayRange.min);
+      std::array<int, numOfPlayerTypes> brightnessLimits;
+      for(int i = 0; i < numOfPlayerTypes; ++i)
+        brightnessLimits[i] = !pixelClassifiers[i].checkBrightness ? 256 : pixelClassifiers[i].strictlyDarker ? gray : gray + 1;
 
-      float ownFieldPlayerPixels = 0;
-      float opponentFieldPlayerPixels = 0;
-      float ownGoalkeeperPixels = 0;
-      float opponentGoalkeeperPixels = 0;
+      std::array<float, numOfPlayerTypes> pixels;
+      pixels.fill(0.f);
 
       for(float y = upperInImage.y(); y < lowerInImage.y();
           y += yStep, left = std::max(left + xyStep, 0.f), right = std::min(right + xyStep, static_cast<float>(theCameraInfo.width)))
@@ -137,6 +141,10 @@ void JerseyClassifierProvider2020For2023::detectJersey(const ObstaclesImagePerce
         const float yDiffFromCenter = 2 * (((lowerInImage.y() - upperInImage.y()) / 2) - (y - upperInImage.y())) / (lowerInImage.y() - upperInImage.y());
         const float yFactor = std::abs(yDiffFromCenter) < 0.5f ? 1.f : (1.f - std::abs(yDiffFromCenter)) + 0.5f;
         const float jerseyEnd = relativeJerseyWidth - 0.1f * std::abs(yDiffFromCenter - 0.4f);
+        const int yInt = static_cast<int>(y);
+        const PixelTypes::HuePixel* const hued = theECImage.hued[yInt];
+        const PixelTypes::GrayscaledPixel* const saturated = theECImage.saturated[yInt];
+        const PixelTypes::GrayscaledPixel* const grayscaled = theECImage.grayscaled[yInt];
         for(float x = left; x < right; x += xStep)
         {
           float weight = 1.f;
@@ -149,30 +157,30 @@ void JerseyClassifierProvider2020For2023::detectJersey(const ObstaclesImagePerce
           DOT("module:JerseyClassifierProvider2020For2023:jerseyWeights", static_cast<int>(x), static_cast<int>(y),
               ColorRGBA(static_cast<unsigned  char>(240 - 240 * weight), static_cast<unsigned  char>(240 * weight), static_cast<unsigned  char>(240 * weight), 220),
               ColorRGBA(static_cast<unsigned  char>(240 - 240 * weight), static_cast<unsigned  char>(240 * weight), static_cast<unsigned  char>(240 * weight), 220));
-          if(isOwnFieldPlayer(static_cast<int>(x), static_cast<int>(y)))
-          {
-            ownFieldPlayerPixels += weight;
-            DOT("module:JerseyClassifierProvider2020For2023:jersey", static_cast<int>(x), static_cast<int>(y), ColorRGBA::yellow, ColorRGBA::yellow);
-          }
-          else if(isOpponentFieldPlayer(static_cast<int>(x), static_cast<int>(y)))
-          {
-            opponentFieldPlayerPixels += weight;
-            DOT("module:JerseyClassifierProvider2020For2023:jersey", static_cast<int>(x), static_cast<int>(y), ColorRGBA::blue, ColorRGBA::blue);
-          }
-          else if(isOpponentGoalkeeper(static_cast<int>(x), static_cast<int>(y)))
-          {
-            opponentGoalkeeperPixels += weight;
-            DOT("module:JerseyClassifierProvider2020For2023:jersey", static_cast<int>(x), static_cast<int>(y), ColorRGBA::blue, ColorRGBA::blue);
-          }
-          else if(isOwnGoalkeeper(static_cast<int>(x), static_cast<int>(y)))
-          {
-            ownGoalkeeperPixels += weight;
-            DOT("module:JerseyClassifierProvider2020For2023:jersey", static_cast<int>(x), static_cast<int>(y), ColorRGBA::yellow, ColorRGBA::yellow);
-          }
-          else
-            DOT("module:JerseyClassifierProvider2020For2023:jersey", static_cast<int>(x), static_cast<int>(y), ColorRGBA::green, ColorRGBA::green);
+
+          // Each pixel is only read once and counted for the first class it belongs to.
+          const int xInt = static_cast<int>(x);
+          const unsigned char hue = hued[xInt];
+          const int saturation = saturated[xInt];
+          const int brightness = grayscaled[xInt];
+          int playerType = 0;
+          while(playerType < numOfPlayerTypes
+                && !(pixelClassifiers[playerType].hues[hue] && saturation < pixelClassifiers[playerType].maxSaturation
+                     && brightness < brightnessLimits[playerType]))
+            ++playerType;
+          if(playerType < numOfPlayerTypes)
+            pixels[playerType] += weight;
+          DOT("module:JerseyClassifierProvider2020For2023:jersey", xInt, yInt,
+              playerType == numOfPlayerTypes ? ColorRGBA::green : playerType == ownFieldPlayer || playerType == ownGoalkeeper ? ColorRGBA::yellow : ColorRGBA::blue,
+              playerType == numOfPlayerTypes ? ColorRGBA::green : playerType == ownFieldPlayer || playerType == ownGoalkeeper ? ColorRGBA::yellow : ColorRGBA::blue);
         }
       }
+
+      float& ownFieldPlayerPixels = pixels[ownFieldPlayer];
+      float& opponentFieldPlayerPixels = pixels[opponentFieldPlayer];
+      float& ownGoalkeeperPixels = pixels[ownGoalkeeper];
+      float& opponentGoalkeeperPixels = pixels[opponentGoalkeeper];
+
       // threshold to counter white robot parts or green field background being classified as opponent jersey
       if((theGameState.opponentTeam.fieldPlayerColor == GameState::Team::Color::white || theGameState.opponentTeam.fieldPlayerColor == GameState::Team::Color::green))
       {
@@ -219,100 +227,51 @@ void JerseyClassifierProvider2020For2023::detectJersey(const ObstaclesImagePerce
   }
 }
 
-std::function<bool(int, int)> JerseyClassifierProvider2020For2023::getPixelClassifier(const GameState::Team::Color checkColor,
-                                                                                      const GameState::Team::Color o1,
-                                                                                      const GameState::Team::Color o2,
-                                                                                      const GameState::Team::Color o3,
-                                                                                      const int maxBrightness) const
+JerseyClassifierProvider2020For2023::PixelClassifier JerseyClassifierProvider2020For2023::getPixelClassifier(const GameState::Team::Color checkColor,
+                                                                                                         const GameState::Team::Color o1,
+                                                                                                         const GameState::Team::Color o2,
+                                                                                                         const GameState::Team::Color o3) const
 {
   const int checkHue = jerseyHues[checkColor];
-  const int o1Hue = jerseyHues[o1];
-  const int o2Hue = jerseyHues[o2];
-  const int o3Hue = jerseyHues[o3];
-  const Rangei grayRange = Rangei(static_cast<int>(maxBrightness * this->grayRange.min),
-                                  static_cast<int>(maxBrightness * this->grayRange.max));
+  const bool checkIsBlack = checkColor == GameState::Team::Color::black;
 
-  bool checkIsBlack = checkColor == GameState::Team::Color::black;
-  bool othersAreAllColorful = o1 != GameState::Team::Color::black && o1 != GameState::Team::Color::gray && o1 != GameState::Team::Color::white &&
-                              o2 != GameState::Team::Color::black && o2 != GameState::Team::Color::gray && o2 != GameState::Team::Color::white &&
-                              o3 != GameState::Team::Color::black && o3 != GameState::Team::Color::gray && o3 != GameState::Team::Color::white;
+  PixelClassifier classifier;
+  classifier.hues.fill(true);
+  classifier.maxSaturation = 256;
+  classifier.checkBrightness = checkIsBlack;
+  classifier.strictlyDarker = false;
 
-  // Black jersey is compared to colorful options:
-  if(checkIsBlack && othersAreAllColorful)
-    return [this, grayRange, o1Hue, o2Hue, o3Hue](const int x, const int y)
+  // All conditions must hold for each of the other colors.
+  for(const GameState::Team::Color other : {o1, o2, o3})
+  {
+    const int otherHue = jerseyHues[other];
+    const bool otherIsColorless = other == GameState::Team::Color::gray || other == GameState::Team::Color::white;
+    if(checkIsBlack && otherIsColorless)
     {
-      return theECImage.saturated[y][x] < satThreshold && theECImage.grayscaled[y][x] <= grayRange.min &&
-             std::abs(static_cast<signed char>(theECImage.hued[y][x] - o1Hue)) > hueSimilarityThreshold &&
-             std::abs(static_cast<signed char>(theECImage.hued[y][x] - o2Hue)) > hueSimilarityThreshold &&
-             std::abs(static_cast<signed char>(theECImage.hued[y][x] - o3Hue)) > hueSimilarityThreshold;
-    };
-  // All jerseys are colorful, no black/gray/white involved at all:
-  else if(!checkIsBlack && othersAreAllColorful)
-    return [this, checkHue, o1Hue, o2Hue, o3Hue](const int x, const int y)
+      // Black jersey compared to white or gray: not saturated and dark.
+      classifier.maxSaturation = std::min(classifier.maxSaturation, static_cast<int>(colorDelimiter));
+      classifier.strictlyDarker = true;
+    }
+    else if(checkIsBlack)
     {
-      const int hue = theECImage.hued[y][x];
-      return std::abs(static_cast<signed char>(hue - checkHue)) < std::min(std::abs(static_cast<signed char>(hue - o1Hue)), hueSimilarityThreshold) &&
-             std::abs(static_cast<signed char>(hue - checkHue)) < std::min(std::abs(static_cast<signed char>(hue - o2Hue)), hueSimilarityThreshold) &&
-             std::abs(static_cast<signed char>(hue - checkHue)) < std::min(std::abs(static_cast<signed char>(hue - o3Hue)), hueSimilarityThreshold);
-    };
-  // We check the black jersey against a set of others that contain at least once white or gray
-  else if(checkIsBlack && !othersAreAllColorful)
-    return [this, o1Hue, o2Hue, o3Hue, o1, o2, o3, grayRange](const int x, const int y)
+      // Black jersey compared to a colorful one: not saturated, dark, and not the other hue.
+      classifier.maxSaturation = std::min(classifier.maxSaturation, static_cast<int>(satThreshold));
+      for(int hue = 0; hue < 256; ++hue)
+        classifier.hues[hue] = classifier.hues[hue] && std::abs(static_cast<signed char>(hue - otherHue)) > hueSimilarityThreshold;
+    }
+    else if(otherIsColorless || other == GameState::Team::Color::black)
     {
-      bool checkO1 = false;
-      if(o1 == GameState::Team::Color::gray || o1 == GameState::Team::Color::white)
-        checkO1 = theECImage.saturated[y][x] < colorDelimiter && theECImage.grayscaled[y][x] < grayRange.min;
-      else
-        checkO1 = theECImage.saturated[y][x] < satThreshold && theECImage.grayscaled[y][x] <= grayRange.min &&
-                    std::abs(static_cast<signed char>(theECImage.hued[y][x] - o1Hue)) > hueSimilarityThreshold;
-      if(!checkO1)
-        return false;
-
-      bool checkO2 = false;
-      if(o2 == GameState::Team::Color::gray || o2 == GameState::Team::Color::white)
-        checkO2 = theECImage.saturated[y][x] < colorDelimiter && theECImage.grayscaled[y][x] < grayRange.min;
-      else
-        checkO2 = theECImage.saturated[y][x] < satThreshold && theECImage.grayscaled[y][x] <= grayRange.min &&
-                    std::abs(static_cast<signed char>(theECImage.hued[y][x] - o2Hue)) > hueSimilarityThreshold;
-      if(!checkO2)
-        return false;
-
-      bool checkO3 = false;
-      if(o3 == GameState::Team::Color::gray || o3 == GameState::Team::Color::white)
-        checkO3 = theECImage.saturated[y][x] < colorDelimiter && theECImage.grayscaled[y][x] < grayRange.min;
-      else
-        checkO3 = theECImage.saturated[y][x] < satThreshold && theECImage.grayscaled[y][x] <= grayRange.min &&
-                    std::abs(static_cast<signed char>(theECImage.hued[y][x] - o3Hue)) > hueSimilarityThreshold;
-
-      return checkO3;
-    };
-  // We check a colored jersey against a set of others that contain at least once white or gray or black
-  else //if(!checkIsBlack && !othersAreAllColorful)
-    return [this, checkHue, grayRange, o1Hue, o2Hue, o3Hue, o1, o2, o3](const int x, const int y)
+      // Colored jersey compared to black, white, or gray: the hue must be similar.
+      for(int hue = 0; hue < 256; ++hue)
+        classifier.hues[hue] = classifier.hues[hue] && std::abs(static_cast<signed char>(hue - checkHue)) <= hueSimilarityThreshold;
+    }
+    else
     {
-      const int hue = theECImage.hued[y][x];
-      bool checkO1 = false;
-      if(o1 == GameState::Team::Color::black || o1 == GameState::Team::Color::gray || o1 == GameState::Team::Color::white)
-        checkO1 = std::abs(static_cast<signed char>(theECImage.hued[y][x] - checkHue)) <= hueSimilarityThreshold;
-      else
-        checkO1 = std::abs(static_cast<signed char>(hue - checkHue)) < std::min(std::abs(static_cast<signed char>(hue - o1Hue)), hueSimilarityThreshold);
-      if(!checkO1)
-        return false;
-
-      bool checkO2 = false;
-      if(o2 == GameState::Team::Color::black || o2 == GameState::Team::Color::gray || o2 == GameState::Team::Color::white)
-        checkO2 = std::abs(static_cast<signed char>(theECImage.hued[y][x] - checkHue)) <= hueSimilarityThreshold;
-      else
-        checkO2 = std::abs(static_cast<signed char>(hue - checkHue)) < std::min(std::abs(static_cast<signed char>(hue - o2Hue)), hueSimilarityThreshold);
-      if(!checkO2)
-        return false;
-
-      bool checkO3 = false;
-      if(o3 == GameState::Team::Color::black || o3 == GameState::Team::Color::gray || o3 == GameState::Team::Color::white)
-        checkO3 = std::abs(static_cast<signed char>(theECImage.hued[y][x] - checkHue)) <= hueSimilarityThreshold;
-      else
-        checkO3 = std::abs(static_cast<signed char>(hue - checkHue)) < std::min(std::abs(static_cast<signed char>(hue - o3Hue)), hueSimilarityThreshold);
-
-      return checkO3;
-    };
+      // Colored jersey compared to another colored one: the hue must be more similar than the other one.
+      for(int hue = 0; hue < 256; ++hue)
+        classifier.hues[hue] = classifier.hues[hue]
+                               && std::abs(static_cast<signed char>(hue - checkHue)) < std::min(std::abs(static_cast<signed char>(hue - otherHue)), hueSimilarityThreshold);
+    }
+  }
+  return classifier;
 }
@@ -20,7 +20,7 @@
 #include "Representations/Perception/ObstaclesPercepts/JerseyClassifier.h"
 #include "Framework/Module.h"
 #include "Math/Range.h"
-#include <functional>
+#include <array>
 
 MODULE(JerseyClassifierProvider2020For2023,
 {,
@@ -52,6 +52,30 @@ MODULE(JerseyClassifierProvider2020For2023,
 
 class JerseyClassifierProvider2020For2023 : public JerseyClassifierProvider2020For2023Base
 {
+  /**
+   * A classifier that detects whether a pixel belongs to a specific jersey color.
+   * All conditions only depend on the team colors, except for the brightness limit,
+   * which is relative to the brightest pixel below each jersey.
+   */
+  struct PixelClassifier
+  {
+    std::array<bool, 256> hues; /**< Which hues are accepted? */
+    int maxSaturation; /**< The saturation of a pixel must be lower than this. */
+    bool checkBrightness; /**< Must the pixel be darker than gray? */
+    bool strictlyDarker; /**< Must the pixel be strictly darker than the lower limit of gray (or may it be equal)? */
+  };
+
+  /** The player types in the order in which pixels are checked against their jersey colors. */
+  ENUM(PlayerType,
+  {,
+    ownFieldPlayer,
+    opponentFieldPlayer,
+    opponentGoalkeeper,
+    ownGoalkeeper,
+  });
+
+  std::array<PixelClassifier, numOfPlayerTypes> pixelClassifiers; /**< The classifiers for the current team colors, indexed by PlayerType. */
+
   /**
    * Updates the jersey classifier.
    * @param jerseyClassifier The updated representation.
@@ -78,15 +102,11 @@ class JerseyClassifierProvider2020For2023 : public JerseyClassifierProvider2020F
    * @param o1 A team color index of another color on the pitch.
    * @param o2 A team color index of another color on the pitch.
    * @param o3 A team color index of another color on the pitch.
-   * @param maxBrightness The intensity of the brightest pixel below the jersey. This
-   *                     functions as a reference if one of the two teams uses the
-   *                     jersey color gray.
-   * @return The classifier that detects whether the pixel at (x, y) (the two parameters)
-   *         belongs to the jersey color of teamColor.
+   * @return The classifier that detects whether a pixel belongs to the jersey color
+   *         checkColor.
    */
-  std::function<bool(const int, const int)> getPixelClassifier(const GameState::Team::Color checkColor,
-                                                               const GameState::Team::Color o1,
-                                                               const GameState::Team::Color o2,
-                                                               const GameState::Team::Color o3,
-                                                               const int maxBrightness) const;
+  PixelClassifier getPixelClassifier(const GameState::Team::Color checkColor,
+                                     const GameState::Team::Color o1,
+                                     const GameState::Team::Color o2,
+                                     const GameState::Team::Color o3) const;
 };
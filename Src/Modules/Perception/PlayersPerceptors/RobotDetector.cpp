@@ -158,86 +158,65 @@ void RobotDetector::extractImageObstaclesFromNetwork(std::vector<ObstaclesImageP
   }
 }
 
-void RobotDetector::fillGrayscaleThumbnail()
+unsigned RobotDetector::getScale(const Image<PixelTypes::GrayscaledPixel>& plane) const
 {
-  const auto scale = static_cast<unsigned int>(std::round(std::log2(theECImage.grayscaled.width / networkParameters.inputWidth)));
-  ASSERT(theECImage.grayscaled.width == static_cast<unsigned>(networkParameters.inputWidth) << scale);
-  ASSERT(theECImage.grayscaled.height == static_cast<unsigned>(networkParameters.inputHeight) << scale);
-
-  // Can't shrink directly to NN input because it needs a larger buffer :-(
-  STOPWATCH("module:RobotDetector:shrinkY") Resize::shrinkY(scale, theECImage.grayscaled, grayscaleThumbnail);
-  ASSERT(networkParameters.inputWidth == grayscaleThumbnail.width);
-  ASSERT(networkParameters.inputHeight == grayscaleThumbnail.height);
-  SEND_DEBUG_IMAGE("GrayscaleThumbnail", grayscaleThumbnail);
+  const auto scale = static_cast<unsigned int>(std::round(std::log2(plane.width / networkParameters.inputWidth)));
+  ASSERT(plane.width == static_cast<unsigned>(networkParameters.inputWidth) << scale);
+  ASSERT(plane.height == static_cast<unsigned>(networkParameters.inputHeight) << scale);
+  return scale;
 }
 
-void RobotDetector::fillChromaThumbnails()
+void RobotDetector::sendThumbnails()
 {
-  const auto scale = static_cast<unsigned int>(std::round(std::log2(theECImage.blueChromaticity.width / networkParameters.inputWidth)));
-  ASSERT(scale == static_cast<unsigned int>(std::round(std::log2(theECImage.redChromaticity.width / networkParameters.inputWidth))));
-  ASSERT(theECImage.blueChromaticity.width == theECImage.redChromaticity.width);
-  ASSERT(theECImage.blueChromaticity.width == static_cast<unsigned>(networkParameters.inputWidth) << scale);
-  ASSERT(theECImage.blueChromaticity.height == theECImage.redChromaticity.height);
-  ASSERT(theECImage.blueChromaticity.height == static_cast<unsigned>(networkParameters.inputHeight) << scale);
-  STOPWATCH("module:RobotDetector:shrinkBlueChroma") Resize::shrinkY(scale, theECImage.blueChromaticity, redChromaThumbnail);
-  STOPWATCH("module:RobotDetector:shrinkRedChroma") Resize::shrinkY(scale, theECImage.redChromaticity, blueChromaThumbnail);
-  ASSERT(networkParameters.inputWidth == redChromaThumbnail.width);
-  ASSERT(networkParameters.inputWidth == blueChromaThumbnail.width);
-  ASSERT(networkParameters.inputHeight == redChromaThumbnail.height);
-  ASSERT(networkParameters.inputHeight == blueChromaThumbnail.height);
-  SEND_DEBUG_IMAGE("RedChromaThumbnail", redChromaThumbnail);
-  SEND_DEBUG_IMAGE("BlueChromaThumbnail", blueChromaThumbnail);
+  COMPLEX_IMAGE("GrayscaleThumbnail")
+  {
+    Resize::shrinkY(getScale(theECImage.grayscaled), theECImage.grayscaled, grayscaleThumbnail);
+    SEND_DEBUG_IMAGE("GrayscaleThumbnail", grayscaleThumbnail);
+  }
+  if(networkParameters.inputChannels == 3)
+  {
+    COMPLEX_IMAGE("RedChromaThumbnail")
+    {
+      Resize::shrinkY(getScale(theECImage.blueChromaticity), theECImage.blueChromaticity, redChromaThumbnail);
+      SEND_DEBUG_IMAGE("RedChromaThumbnail", redChromaThumbnail);
+    }
+    COMPLEX_IMAGE("BlueChromaThumbnail")
+    {
+      Resize::shrinkY(getScale(theECImage.redChromaticity), theECImage.redChromaticity, blueChromaThumbnail);
+      SEND_DEBUG_IMAGE("BlueChromaThumbnail", blueChromaThumbnail);
+    }
+  }
 }
 
 void RobotDetector::applyGrayscaleNetwork()
 {
   ASSERT(networkParameters.inputChannels == 1);
-  fillGrayscaleThumbnail();
+  unsigned char* const input = useOnnx ? reinterpret_cast<unsigned char*>(onnxConvModel.input(0).data())
+                                       : reinterpret_cast<unsigned char*>(cnnConvModel.input(0).data());
 
-  if(useOnnx)
-  {
-    // Copy image into input of the model
-    std::memcpy(reinterpret_cast<unsigned char*>(onnxConvModel.input(0).data()), grayscaleThumbnail[0], grayscaleThumbnail.width * grayscaleThumbnail.height * sizeof(unsigned char));
+  // Shrink image directly into the input of the model
+  STOPWATCH("module:RobotDetector:shrinkY") Resize::shrinkYInterleaved(getScale(theECImage.grayscaled), {&theECImage.grayscaled}, input);
+  STOPWATCH("module:RobotDetector:normalizeContrast") PatchUtilities::normalizeContrast<unsigned char>(input, inputImageSize, 0.02f);
+  sendThumbnails();
 
-    STOPWATCH("module:RobotDetector:normalizeContrast") PatchUtilities::normalizeContrast<unsigned char>(
-          reinterpret_cast<unsigned char*>(onnxConvModel.input(0).data()), inputImageSize, 0.02f);
+  if(useOnnx)
     STOPWATCH("module:RobotDetector:apply") onnxConvModel.apply();
-  }
   else
-  {
-    // Copy image into input of the model
-    std::memcpy(reinterpret_cast<unsigned char*>(cnnConvModel.input(0).data()), grayscaleThumbnail[0], grayscaleThumbnail.width * grayscaleThumbnail.height * sizeof(unsigned char));
-
-    STOPWATCH("module:RobotDetector:normalizeContrast") PatchUtilities::normalizeContrast<unsigned char>(
-          reinterpret_cast<unsigned char*>(cnnConvModel.input(0).data()), inputImageSize, 0.02f);
     STOPWATCH("module:RobotDetector:apply") cnnConvModel.apply();
-  }
 }
 
 void RobotDetector::applyColorNetwork()
 {
   ASSERT(networkParameters.inputChannels == 3);
-  fillGrayscaleThumbnail();
-  fillChromaThumbnails();
-
-  PixelTypes::GrayscaledPixel* yPos = grayscaleThumbnail[0];
-  PixelTypes::GrayscaledPixel* uPos = redChromaThumbnail[0];
-  PixelTypes::GrayscaledPixel* vPos = blueChromaThumbnail[0];
-  PixelTypes::GrayscaledPixel* inputPos;
-  if(useOnnx)
-    inputPos = reinterpret_cast<PixelTypes::GrayscaledPixel*>(onnxConvModel.input(0).data());
-  else
-    inputPos = reinterpret_cast<PixelTypes::GrayscaledPixel*>(cnnConvModel.input(0).data());
+  ASSERT(theECImage.blueChromaticity.width == theECImage.redChromaticity.width);
+  ASSERT(theECImage.blueChromaticity.height == theECImage.redChromaticity.height);
+  unsigned char* const input = useOnnx ? reinterpret_cast<unsigned char*>(onnxConvModel.input(0).data())
+                                       : reinterpret_cast<unsigned char*>(cnnConvModel.input(0).data());
 
-  STOPWATCH("module:RobotDetector:copyYUVToInput")
-  {
-    for(unsigned int pos = 0; pos < networkParameters.inputWidth * networkParameters.inputHeight; ++pos, ++yPos, ++uPos, ++vPos, inputPos += 3)
-    {
-      inputPos[0] = yPos[0];
-      inputPos[1] = uPos[0];
-      inputPos[2] = vPos[0];
-    }
-  }
+  // Shrink all three channels directly into the interleaved input of the model. The chroma planes are smaller and are shrunk less.
+  STOPWATCH("module:RobotDetector:shrinkYUV")
+    Resize::shrinkYInterleaved(getScale(theECImage.grayscaled), {&theECImage.grayscaled, &theECImage.blueChromaticity, &theECImage.redChromaticity}, input);
+  sendThumbnails();
 
   if(useOnnx)
     STOPWATCH("module:RobotDetector:apply") onnxConvModel.apply();
@@ -121,9 +121,8 @@ private:
   std::unique_ptr<NeuralNetworkONNX::Model> onnxModel;
   NeuralNetworkONNX::CompiledNN onnxConvModel;
   bool useOnnx;
+  // The thumbnails are only used for debug images. The network input is filled directly.
   Image<PixelTypes::GrayscaledPixel> grayscaleThumbnail;
-  // Splitting into three images and recombining them into one is probably a performance issue
-  // We need to optimize this later
   Image<PixelTypes::GrayscaledPixel> redChromaThumbnail;
   Image<PixelTypes::GrayscaledPixel> blueChromaThumbnail;
   std::vector<ObstaclesImagePercept::Obstacle> obstaclesUpper, obstaclesLower;
@@ -199,16 +198,16 @@ private:
   void extractImageObstaclesFromNetwork(std::vector<ObstaclesImagePercept::Obstacle>& obstacles);
 
   /**
-   * Fill the Y-Thumbnail image with a down-scaled grayscale image.
+   * Determines how often a plane of the image must be halved to obtain the input size of the network.
+   * @param plane The plane, e.g. the grayscale image or one of the smaller chroma planes.
+   * @return The number of halvings.
    */
-   void fillGrayscaleThumbnail();
-
-   /**
-    * Fill the redChroma- and V-Thumbnail images with downscale images of the same size as the grayscale thumbnail.
-    * First sub-samples from the CameraImage to obtain the same resolution vertically and horizontally.
-    * Then downscales to the expected input size.
-    */
-   void fillChromaThumbnails();
+  unsigned getScale(const Image<PixelTypes::GrayscaledPixel>& plane) const;
+
+  /**
+   * Sends the down-scaled channels of the network input as debug images if requested.
+   */
+  void sendThumbnails();
 
   /**
    * Applies the cnnConvModel on the down-scaled grayscale image.
@@ -13,6 +13,8 @@
 #include "Debugging/DebugDrawings.h"
 #include "Tools/Math/Transformation.h"
 #include "Debugging/Annotation.h"
+#include "Debugging/Stopwatch.h"
+#include "ImageProcessing/SIMD.h"
 
 #include <functional>
 #include <list>
@@ -48,19 +50,27 @@ void ScanLineRegionizer::update(ColorScanLineRegionsHorizontal& colorScanLineReg
                      static_cast<const int>(pointInImage.y()) : theCameraInfo.height - 1;
   LINE("module:ScanLineRegionizer:horizontalRegionSplit", 0, middle, theECImage.grayscaled.width, middle, 3, Drawings::PenStyle::dottedPen, ColorRGBA(80, 6, 80));
 
-  for(const ScanGrid::HorizontalLine& horizontalLine : theScanGrid.lowResHorizontalLines)
+  STOPWATCH("module:ScanLineRegionizer:scanHorizontal")
   {
-    yPerScanLine.emplace_back(horizontalLine.y);
-    regionsPerScanLine.emplace_back();
+    if(vectorizedSmoothing)
+      smoothHorizontalScanLines(middle);
 
-    // 2. Detect edges and create temporary regions in between including a representative YHS triple.
-    if(theCameraInfo.camera == CameraInfo::lower || middle < horizontalLine.y)
+    for(std::size_t i = 0; i < theScanGrid.lowResHorizontalLines.size(); ++i)
     {
-      scanHorizontalAdditionalSmoothing(horizontalLine.y, regionsPerScanLine.back(), horizontalLine.left, horizontalLine.right);
-    }
-    else
-    {
-      scanHorizontal(horizontalLine.y, regionsPerScanLine.back(), horizontalLine.left, horizontalLine.right);
+      const ScanGrid::HorizontalLine& horizontalLine = theScanGrid.lowResHorizontalLines[i];
+      const short* smoothed = vectorizedSmoothing ? horizontalSmoothed.data() + i * theECImage.grayscaled.width : nullptr;
+      yPerScanLine.emplace_back(horizontalLine.y);
+      regionsPerScanLine.emplace_back();
+
+      // 2. Detect edges and create temporary regions in between including a representative YHS triple.
+      if(theCameraInfo.camera == CameraInfo::lower || middle < horizontalLine.y)
+      {
+        scanHorizontalAdditionalSmoothing(horizontalLine.y, regionsPerScanLine.back(), horizontalLine.left, horizontalLine.right, smoothed);
+      }
+      else
+      {
+        scanHorizontal(horizontalLine.y, regionsPerScanLine.back(), horizontalLine.left, horizontalLine.right, smoothed);
+      }
     }
   }
 
@@ -110,13 +120,21 @@ void ScanLineRegionizer::update(ColorScanLineRegionsVerticalClipped& colorScanLi
                      static_cast<const int>(pointInImage.y()) : theCameraInfo.height - 1;
   LINE("module:ScanLineRegionizer:verticalRegionSplit", 0, middle, theECImage.grayscaled.width, middle, 3, Drawings::PenStyle::dottedPen, ColorRGBA(80, 6, 80));
 
-  for(std::size_t i = 0; i < theScanGrid.verticalLines.size(); ++i)
+  STOPWATCH("module:ScanLineRegionizer:scanVertical")
   {
-    xPerScanLine[i] = static_cast<unsigned short>(theScanGrid.verticalLines[i].x);
-    const int top = theScanGrid.verticalLines[i].yMin + 1;
+    if(vectorizedSmoothing)
+      smoothVerticalScanLines();
+
+    for(std::size_t i = 0; i < theScanGrid.verticalLines.size(); ++i)
+    {
+      xPerScanLine[i] = static_cast<unsigned short>(theScanGrid.verticalLines[i].x);
+      const int top = theScanGrid.verticalLines[i].yMin + 1;
+      const short* smoothed3 = vectorizedSmoothing ? verticalSmoothed3.data() + i * theECImage.grayscaled.height : nullptr;
+      const short* smoothed5 = vectorizedSmoothing ? verticalSmoothed5.data() + i * theECImage.grayscaled.height : nullptr;
 
-    // 2. Detect edges and create temporary regions in between including a representative YHS triple.
-    scanVertical(theScanGrid.verticalLines[i], middle, top, regionsPerScanLine[i]);
+      // 2. Detect edges and create temporary regions in between including a representative YHS triple.
+      scanVertical(theScanGrid.verticalLines[i], middle, top, regionsPerScanLine[i], smoothed3, smoothed5);
+    }
   }
 
   // 3. Classify field regions.
@@ -133,17 +151,160 @@ void ScanLineRegionizer::update(ColorScanLineRegionsVerticalClipped& colorScanLi
   emplaceInScanLineRegionsVertical(colorScanLineRegionsVerticalClipped, xPerScanLine, regionsPerScanLine);
 }
 
-void ScanLineRegionizer::scanHorizontal(unsigned int y, std::vector<InternalRegion>& regions, const unsigned int leftmostX, const unsigned int rightmostX) const
+/**
+ * Applies the 1D gauss filter [1, 2, 1] or [1, 2, 4, 2, 1] to 16 consecutive pixels.
+ * @tparam filterSize The size of the filter (3 or 5).
+ * @param src The first pixel of the 16 pixels to filter.
+ * @param stride The distance between the filter taps (1 for horizontal, the image width for vertical filtering).
+ * @param dest The 16 results.
+ */
+template<int filterSize>
+static ALWAYSINLINE void smooth16(const PixelTypes::GrayscaledPixel* src, const std::ptrdiff_t stride, short* dest)
+{
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i minus1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src - stride));
+  const __m128i center = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+  const __m128i plus1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + stride));
+  __m128i lo = _mm_add_epi16(_mm_add_epi16(_mm_unpacklo_epi8(minus1, zero), _mm_unpacklo_epi8(plus1, zero)),
+                             _mm_slli_epi16(_mm_unpacklo_epi8(center, zero), 1));
+  __m128i hi = _mm_add_epi16(_mm_add_epi16(_mm_unpackhi_epi8(minus1, zero), _mm_unpackhi_epi8(plus1, zero)),
+                             _mm_slli_epi16(_mm_unpackhi_epi8(center, zero), 1));
+  if constexpr(filterSize == 5)
+  {
+    // [1, 2, 4, 2, 1] = 2 * [0, 1, 2, 1, 0] + [1, 0, 0, 0, 1]
+    const __m128i minus2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src - 2 * stride));
+    const __m128i plus2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * stride));
+    lo = _mm_add_epi16(_mm_slli_epi16(lo, 1), _mm_add_epi16(_mm_unpacklo_epi8(minus2, zero), _mm_unpacklo_epi8(plus2, zero)));
+    hi = _mm_add_epi16(_mm_slli_epi16(hi, 1), _mm_add_epi16(_mm_unpackhi_epi8(minus2, zero), _mm_unpackhi_epi8(plus2, zero)));
+  }
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), lo);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + 8), hi);
+}
+
+/**
+ * Applies the 1D gauss filter [1, 2, 1] or [1, 2, 4, 2, 1] to a single pixel.
+ * This is the scalar equivalent of smooth16 and computes the same values as the
+ * filters defined in the scan methods.
+ */
+template<int filterSize>
+static ALWAYSINLINE short smooth1(const PixelTypes::GrayscaledPixel* src, const std::ptrdiff_t stride)
+{
+  if constexpr(filterSize == 3)
+    return static_cast<short>(src[-stride] + 2 * src[0] + src[stride]);
+  else
+    return static_cast<short>(src[-2 * stride] + 2 * src[-stride] + 4 * src[0] + 2 * src[stride] + src[2 * stride]);
+}
+
+void ScanLineRegionizer::smoothHorizontalScanLines(int middle)
+{
+  const Image<PixelTypes::GrayscaledPixel>& image = theECImage.grayscaled;
+  const std::ptrdiff_t width = image.width;
+  horizontalSmoothed.resize(theScanGrid.lowResHorizontalLines.size() * width);
+
+  for(std::size_t i = 0; i < theScanGrid.lowResHorizontalLines.size(); ++i)
+  {
+    // The scan methods decide on the filter in the same way.
+    const int y = theScanGrid.lowResHorizontalLines[i].y;
+    const bool additionalSmoothing = theCameraInfo.camera == CameraInfo::lower || middle < y;
+    const int radius = additionalSmoothing ? 2 : 1;
+    if(y < radius || y + radius >= static_cast<int>(image.height))
+      continue; // The line will not be scanned.
+
+    const PixelTypes::GrayscaledPixel* src = image[y];
+    short* dest = horizontalSmoothed.data() + i * width;
+    std::ptrdiff_t x = 0;
+    if(additionalSmoothing)
+    {
+      for(; x + 16 <= width; x += 16)
+        smooth16<5>(src + x, width, dest + x);
+      for(; x < width; ++x)
+        dest[x] = smooth1<5>(src + x, width);
+    }
+    else
+    {
+      for(; x + 16 <= width; x += 16)
+        smooth16<3>(src + x, width, dest + x);
+      for(; x < width; ++x)
+        dest[x] = smooth1<3>(src + x, width);
+    }
+  }
+}
+
+void ScanLineRegionizer::smoothVerticalScanLines()
+{
+  const Image<PixelTypes::GrayscaledPixel>& image = theECImage.grayscaled;
+  const std::ptrdiff_t width = image.width;
+  const std::ptrdiff_t height = image.height;
+  const std::size_t numOfScanLines = theScanGrid.verticalLines.size();
+  verticalSmoothed3.resize(numOfScanLines * height);
+  verticalSmoothed5.resize(numOfScanLines * height);
+
+  // Only the rows covered by at least one scan-line are filtered.
+  int rowStart = static_cast<int>(height);
+  int rowEnd = 0;
+  for(const ScanGrid::Line& line : theScanGrid.verticalLines)
+  {
+    rowStart = std::min(rowStart, line.yMin);
+    rowEnd = std::max(rowEnd, line.yMax + 1);
+  }
+  rowStart = std::max(rowStart, 0);
+  rowEnd = std::min(rowEnd, static_cast<int>(height));
+
+  // Rows are filtered in tiles of tileHeight rows, which are then transposed into the per scan-line buffers.
+  constexpr int tileHeight = 8;
+  rowTile.resize(2 * tileHeight * width);
+  for(int tileY = rowStart; tileY < rowEnd; tileY += tileHeight)
+  {
+    const int tileRows = std::min(tileHeight, rowEnd - tileY);
+    for(int r = 0; r < tileRows; ++r)
+    {
+      const PixelTypes::GrayscaledPixel* src = image[tileY + r];
+      short* dest3 = rowTile.data() + r * width;
+      short* dest5 = rowTile.data() + (tileHeight + r) * width;
+      std::ptrdiff_t x = 2;
+      for(; x + 18 <= width; x += 16)
+      {
+        smooth16<3>(src + x, 1, dest3 + x);
+        smooth16<5>(src + x, 1, dest5 + x);
+      }
+      for(; x < width - 2; ++x)
+      {
+        dest3[x] = smooth1<3>(src + x, 1);
+        dest5[x] = smooth1<5>(src + x, 1);
+      }
+      // The 5x5 filter at the image border reaches into the neighboring rows (as it does in the scan methods).
+      dest3[1] = smooth1<3>(src + 1, 1);
+      dest3[width - 2] = smooth1<3>(src + width - 2, 1);
+      dest5[1] = tileY + r > 0 ? smooth1<5>(src + 1, 1) : 0;
+      dest5[width - 2] = tileY + r + 1 < height ? smooth1<5>(src + width - 2, 1) : 0;
+    }
+    for(std::size_t i = 0; i < numOfScanLines; ++i)
+    {
+      const int x = theScanGrid.verticalLines[i].x;
+      if(x < 1 || x + 1 >= width)
+        continue; // The line will not be scanned.
+      short* dest3 = verticalSmoothed3.data() + i * height + tileY;
+      short* dest5 = verticalSmoothed5.data() + i * height + tileY;
+      for(int r = 0; r < tileRows; ++r)
+      {
+        dest3[r] = rowTile[r * width + x];
+        dest5[r] = rowTile[(tileHeight + r) * width + x];
+      }
+    }
+  }
+}
+
+void ScanLineRegionizer::scanHorizontal(unsigned int y, std::vector<InternalRegion>& regions, const unsigned int leftmostX, const unsigned int rightmostX, const short* smoothed) const
 {
   if(y < 1 || y >= theECImage.grayscaled.height - 1)
     return;
   // initialize variables
-  const int scanY = static_cast<int>(y);
   const unsigned int scanStart = leftmostX < theECImage.grayscaled.width - 2 ? leftmostX : theECImage.grayscaled.width - 3;
   bool nextRegionWhite = false;
 
   ScanRun<3> scanRun(true, static_cast<int>(y), scanStart, rightmostX);
   scanRun.leftScanEdgePosition = leftmostX;
+  scanRun.smoothed = smoothed;
 
   // define filter:
   // vertical 1D gauss/sobel smoothing: filter-matrix [[1], [2], [1]]
@@ -167,10 +328,9 @@ void ScanLineRegionizer::scanHorizontal(unsigned int y, std::vector<InternalRegi
   int threshold = thresholdAdaption * static_cast<int>(edgeThreshold);
 
   // Initialize the buffer of smoothed values.
-  const PixelTypes::GrayscaledPixel* luminance = &theECImage.grayscaled[scanY][scanStart];
-  scanRun.leftGaussBuffer[0] = scanRun.gaussV(luminance, theECImage.grayscaled.width);
-  scanRun.leftGaussBuffer[1] = scanRun.gaussV(++luminance, theECImage.grayscaled.width);
-  scanRun.leftGaussBuffer[2] = scanRun.gaussV(++luminance, theECImage.grayscaled.width);
+  scanRun.leftGaussBuffer[0] = scanRun.firstPass(theECImage.grayscaled, scanStart);
+  scanRun.leftGaussBuffer[1] = scanRun.firstPass(theECImage.grayscaled, scanStart + 1);
+  scanRun.leftGaussBuffer[2] = scanRun.firstPass(theECImage.grayscaled, scanStart + 2);
 
   // grid scan stuff
   unsigned int gridX = scanStart + 1;
@@ -189,9 +349,9 @@ void ScanLineRegionizer::scanHorizontal(unsigned int y, std::vector<InternalRegi
   while(gridLineIndex <= theScanGrid.verticalLines.size() && nextGridX < rightmostX)
   {
     bool regionAdded = false;
-    scanRun.rightGaussBuffer[0] = scanRun.gaussV(&theECImage.grayscaled[scanY][nextGridX - 1], theECImage.grayscaled.width);
-    scanRun.rightGaussBuffer[1] = scanRun.gaussV(&theECImage.grayscaled[scanY][nextGridX], theECImage.grayscaled.width);
-    scanRun.rightGaussBuffer[2] = scanRun.gaussV(&theECImage.grayscaled[scanY][nextGridX + 1], theECImage.grayscaled.width);
+    scanRun.rightGaussBuffer[0] = scanRun.firstPass(theECImage.grayscaled, nextGridX - 1);
+    scanRun.rightGaussBuffer[1] = scanRun.firstPass(theECImage.grayscaled, nextGridX);
+    scanRun.rightGaussBuffer[2] = scanRun.firstPass(theECImage.grayscaled, nextGridX + 1);
 
     nextGridValue = scanRun.gaussSecond(scanRun.rightGaussBuffer, 1);
     if(gridValue - nextGridValue >= threshold)  // bright to dark transition
@@ -234,17 +394,17 @@ void ScanLineRegionizer::scanHorizontal(unsigned int y, std::vector<InternalRegi
                        getHorizontalRepresentativeValue(theECImage.saturated, scanRun.leftScanEdgePosition, rightmostX, y));
 }
 
-void ScanLineRegionizer::scanHorizontalAdditionalSmoothing(unsigned int y, std::vector<InternalRegion>& regions, const unsigned int leftmostX, const unsigned int rightmostX) const
+void ScanLineRegionizer::scanHorizontalAdditionalSmoothing(unsigned int y, std::vector<InternalRegion>& regions, const unsigned int leftmostX, const unsigned int rightmostX, const short* smoothed) const
 {
   if(y < 2 || y >= theECImage.grayscaled.height - 2)
     return;
   // initialize variables
-  const int scanY = static_cast<int>(y);
   const unsigned int scanStart = leftmostX < theECImage.grayscaled.width - 4 ? leftmostX : theECImage.grayscaled.width - 5;
   const unsigned int scanStop = rightmostX >= 2 ? rightmostX - 2 : 0;
 
   ScanRun<5> scanRun(true, static_cast<int>(y), scanStart, rightmostX);
   scanRun.leftScanEdgePosition = leftmostX;
+  scanRun.smoothed = smoothed;
 
   // define filter
   // vertical 1D gauss/sobel smoothing: filter-matrix [[1], [2], [4], [2], [1]]
@@ -270,12 +430,8 @@ void ScanLineRegionizer::scanHorizontalAdditionalSmoothing(unsigned int y, std::
   int threshold = thresholdAdaption * static_cast<int>(edgeThreshold);
 
   // Initialize the buffer of smoothed values.
-  const PixelTypes::GrayscaledPixel* luminance = &theECImage.grayscaled[scanY][scanStart];
-  scanRun.leftGaussBuffer[0] = scanRun.gaussV(luminance, theECImage.grayscaled.width);
-  scanRun.leftGaussBuffer[1] = scanRun.gaussV(++luminance, theECImage.grayscaled.width);
-  scanRun.leftGaussBuffer[2] = scanRun.gaussV(++luminance, theECImage.grayscaled.width);
-  scanRun.leftGaussBuffer[3] = scanRun.gaussV(++luminance, theECImage.grayscaled.width);
-  scanRun.leftGaussBuffer[4] = scanRun.gaussV(++luminance, theECImage.grayscaled.width);
+  for(unsigned int i = 0; i < 5; ++i)
+    scanRun.leftGaussBuffer[i] = scanRun.firstPass(theECImage.grayscaled, scanStart + i);
 
   // setup grid scan
   unsigned int gridX = scanStart + 2;
@@ -293,11 +449,8 @@ void ScanLineRegionizer::scanHorizontalAdditionalSmoothing(unsigned int y, std::
 
   while(gridLineIndex <= theScanGrid.verticalLines.size() && nextGridX <= scanStop)
   {
-    scanRun.rightGaussBuffer[0] = scanRun.gaussV(&theECImage.grayscaled[scanY][nextGridX - 2], theECImage.grayscaled.width);
-    scanRun.rightGaussBuffer[1] = scanRun.gaussV(&theECImage.grayscaled[scanY][nextGridX - 1], theECImage.grayscaled.width);
-    scanRun.rightGaussBuffer[2] = scanRun.gaussV(&theECImage.grayscaled[scanY][nextGridX], theECImage.grayscaled.width);
-    scanRun.rightGaussBuffer[3] = scanRun.gaussV(&theECImage.grayscaled[scanY][nextGridX + 1], theECImage.grayscaled.width);
-    scanRun.rightGaussBuffer[4] = scanRun.gaussV(&theECImage.grayscaled[scanY][nextGridX + 2], theECImage.grayscaled.width);
+    for(unsigned int i = 0; i < 5; ++i)
+      scanRun.rightGaussBuffer[i] = scanRun.firstPass(theECImage.grayscaled, nextGridX - 2 + i);
 
     nextGridValue = scanRun.gaussSecond(scanRun.rightGaussBuffer, 2);
     if(gridValue - nextGridValue >= threshold)
@@ -326,7 +479,7 @@ void ScanLineRegionizer::scanHorizontalAdditionalSmoothing(unsigned int y, std::
                        getHorizontalRepresentativeValue(theECImage.saturated, scanRun.leftScanEdgePosition, rightmostX, y));
 }
 
-void ScanLineRegionizer::scanVertical(const ScanGrid::Line& line, int middle, int top, std::vector<InternalRegion>& regions) const
+void ScanLineRegionizer::scanVertical(const ScanGrid::Line& line, int middle, int top, std::vector<InternalRegion>& regions, const short* smoothed3, const short* smoothed5) const
 {
   if(line.x < 1 || static_cast<unsigned int>(line.x + 1) >= theECImage.grayscaled.width || line.yMax <= std::max(2, top))
     return;
@@ -338,7 +491,6 @@ void ScanLineRegionizer::scanVertical(const ScanGrid::Line& line, int middle, in
   ASSERT(top >= 0); // 3x3 filter stop exclusive
   const int lowestY = std::min<int>(line.yMax - 2, static_cast<int>(theECImage.grayscaled.height) - 3); // 5x5 filter start
   const int middleY = std::min(std::max<int>(middle + 1, top + 1), lowestY + 1); // 5x5 filter stop exclusive, 3x3 filter start
-  const PixelTypes::GrayscaledPixel* luminance = &theECImage.grayscaled[lowestY][line.x];
   // grid variables
   int gridY = std::max(lowestY, middleY);
   int gridValue = 0;
@@ -355,6 +507,7 @@ void ScanLineRegionizer::scanVertical(const ScanGrid::Line& line, int middle, in
   {
     ScanRun<5> scanRun(false, static_cast<int>(line.x), lowestY, middleY);
     scanRun.lowerScanEdgePosition = lowerY;
+    scanRun.smoothed = smoothed5;
 
     scanRun.gaussH = [](const PixelTypes::GrayscaledPixel* line) // 5x5 gauss horizontal
     {
@@ -372,20 +525,14 @@ void ScanLineRegionizer::scanVertical(const ScanGrid::Line& line, int middle, in
     // Initialize the buffer of smoothed values.
     scanRun.lowerGaussBuffer = {}; // buffer for the lower grid point and for sobel scans
     scanRun.upperGaussBuffer = {}; // buffer for the upper grid point, centered around grid point -> gridX is at index 2
-    scanRun.lowerGaussBuffer[0] = scanRun.gaussH(luminance + 2 * theECImage.grayscaled.width);
-    scanRun.lowerGaussBuffer[1] = scanRun.gaussH(luminance + theECImage.grayscaled.width);
-    scanRun.lowerGaussBuffer[2] = scanRun.gaussH(luminance);
-    scanRun.lowerGaussBuffer[3] = scanRun.gaussH(luminance -= theECImage.grayscaled.width);
-    scanRun.lowerGaussBuffer[4] = scanRun.gaussH(luminance -= theECImage.grayscaled.width);
+    for(int i = 0; i < 5; ++i)
+      scanRun.lowerGaussBuffer[i] = scanRun.firstPass(theECImage.grayscaled, lowestY + 2 - i);
     gridValue = scanRun.gaussSecond(scanRun.lowerGaussBuffer, 2);
 
     while(nextGridY > middleY && gridYIndex <= theScanGrid.lowResHorizontalLines.size())
     {
-      scanRun.upperGaussBuffer[0] = scanRun.gaussH(&theECImage.grayscaled[nextGridY + 2][line.x]);
-      scanRun.upperGaussBuffer[1] = scanRun.gaussH(&theECImage.grayscaled[nextGridY + 1][line.x]);
-      scanRun.upperGaussBuffer[2] = scanRun.gaussH(&theECImage.grayscaled[nextGridY][line.x]);
-      scanRun.upperGaussBuffer[3] = scanRun.gaussH(&theECImage.grayscaled[nextGridY - 1][line.x]);
-      scanRun.upperGaussBuffer[4] = scanRun.gaussH(&theECImage.grayscaled[nextGridY - 2][line.x]);
+      for(int i = 0; i < 5; ++i)
+        scanRun.upperGaussBuffer[i] = scanRun.firstPass(theECImage.grayscaled, nextGridY + 2 - i);
       nextGridValue = scanRun.gaussSecond(scanRun.upperGaussBuffer, 2);
       if(gridValue - nextGridValue >= threshold)
       {
@@ -413,9 +560,12 @@ void ScanLineRegionizer::scanVertical(const ScanGrid::Line& line, int middle, in
   // switch to 3x3 filter
   if(middleY > top)
   {
-    auto gauss = [](const PixelTypes::GrayscaledPixel* line) // 3x3 gauss horizontal
+    auto gauss = [&](int y) // 3x3 gauss horizontal
     {
-      return static_cast<int>(line[-1] + 2 * line[0] + line[1]);
+      if(smoothed3)
+        return static_cast<int>(smoothed3[y]);
+      const PixelTypes::GrayscaledPixel* pixel = &theECImage.grayscaled[y][line.x];
+      return static_cast<int>(pixel[-1] + 2 * pixel[0] + pixel[1]);
     };
     auto gaussSecond = [](std::array<int, 3>& gaussBuffer, int y) // 3x3 gauss vertical
     {
@@ -427,9 +577,8 @@ void ScanLineRegionizer::scanVertical(const ScanGrid::Line& line, int middle, in
     };
     // Initialize the buffer of smoothed values.
     std::array<int, 3> gaussBuffer {};
-    luminance = &theECImage.grayscaled[gridY][line.x];
-    gaussBuffer[0] = gauss(luminance + theECImage.grayscaled.width);
-    gaussBuffer[1] = gauss(luminance);
+    gaussBuffer[0] = gauss(gridY + 1);
+    gaussBuffer[1] = gauss(gridY);
     int gaussBufferIndex = 2;
     int prevSobelMin = std::numeric_limits<int>::max();
     int prevSobelMax = std::numeric_limits<int>::min();
@@ -441,7 +590,7 @@ void ScanLineRegionizer::scanVertical(const ScanGrid::Line& line, int middle, in
     for(int y = gridY; y > top; --y)
     {
       // This line is one above the current y.
-      gaussBuffer[gaussBufferIndex % 3] = gauss(luminance -= theECImage.grayscaled.width);
+      gaussBuffer[gaussBufferIndex % 3] = gauss(y - 1);
       ++gaussBufferIndex;
       // This gradient is centered around the current y.
       int sobelL = gradient(gaussBuffer, gaussBufferIndex - 2);
@@ -524,11 +673,10 @@ void ScanLineRegionizer::findEdgeInSubLineHorizontal(
 {
   unsigned int edgeXMax = startPos;
   int sobelMax = scanRun.gradient(scanRun.leftGaussBuffer, (filterSize - 1) / 2);
-  const PixelTypes::GrayscaledPixel* luminance = &theECImage.grayscaled[scanRun.scanLinePosition][startPos + 1];
   int gaussBufferIndex = 0;
-  for(unsigned int x = startPos + 1; x < stopPos; ++x, ++luminance, ++gaussBufferIndex)
+  for(unsigned int x = startPos + 1; x < stopPos; ++x, ++gaussBufferIndex)
   {
-    scanRun.leftGaussBuffer[gaussBufferIndex % filterSize] = scanRun.gaussV(luminance, theECImage.grayscaled.width);
+    scanRun.leftGaussBuffer[gaussBufferIndex % filterSize] = scanRun.firstPass(theECImage.grayscaled, x);
     int sobelL = scanRun.gradient(scanRun.leftGaussBuffer, gaussBufferIndex + (filterSize + 1) / 2);
     if((maxEdge && sobelL > sobelMax) || (!maxEdge && sobelL < sobelMax))
     {
@@ -555,11 +703,10 @@ void ScanLineRegionizer::findEdgeInSubLineVertical(
 {
   unsigned int edgeYMax = startPos;
   int sobelMax = scanRun.gradient(scanRun.lowerGaussBuffer, (filterSize - 1) / 2);
-  const PixelTypes::GrayscaledPixel* luminance = &theECImage.grayscaled[startPos - 1][scanRun.scanLinePosition];
   int gaussBufferIndex = 0;
-  for(int y = static_cast<int>(startPos) - 1; y > static_cast<int>(stopPos); --y, ++gaussBufferIndex, luminance -= theECImage.grayscaled.width)
+  for(int y = static_cast<int>(startPos) - 1; y > static_cast<int>(stopPos); --y, ++gaussBufferIndex)
   {
-    scanRun.lowerGaussBuffer[gaussBufferIndex % filterSize] = scanRun.gaussH(luminance);
+    scanRun.lowerGaussBuffer[gaussBufferIndex % filterSize] = scanRun.firstPass(theECImage.grayscaled, y);
     int sobelL = scanRun.gradient(scanRun.lowerGaussBuffer, gaussBufferIndex + (filterSize + 1) / 2);
     if((maxEdge && sobelL > sobelMax) || (!maxEdge && sobelL < sobelMax))
     {
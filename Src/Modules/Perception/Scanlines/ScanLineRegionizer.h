@@ -55,6 +55,7 @@ MODULE(ScanLineRegionizer,
     (short)(20) maxPrelabelRegionSize,                  /**< Maximum region size to prelabel as white */
     (short)(12) maxRegionSizeForStitching,              /**< Maximum size in pixels of a none region between field and white or field and field for stitching */
     (int)(400) estimatedFieldColorInvalidationTime,     /**< Time in ms until the EstimatedFieldColor is invalidated */
+    (bool)(true) vectorizedSmoothing,                   /**< Precompute the first smoothing pass of all scan-lines with SIMD instead of per sample */
       }),
 });
 
@@ -178,6 +179,7 @@ class ScanLineRegionizer : public ScanLineRegionizerBase
     std::array<int, filterSize>& lowerGaussBuffer = leftGaussBuffer; /**< name alias for vertical scan */
     std::array<int, filterSize> rightGaussBuffer; /**< buffer for the right or upper grid point, centered around grid point -> gridX is at index 1 */
     std::array<int, filterSize>& upperGaussBuffer = rightGaussBuffer; /**< name alias for vertical scan */
+    const short* smoothed = nullptr; /**< Precomputed first smoothing pass along the scan-line (indexed by pixel position), nullptr if not available */
 
     ScanRun(bool horizontal, int scanLinePosition, unsigned int scanStart, unsigned int scanStop):
       horizontal(horizontal),
@@ -191,6 +193,20 @@ class ScanLineRegionizer : public ScanLineRegionizerBase
     {
       return !horizontal;
     }
+
+    /**
+     * Returns the result of the first 1D smoothing filter (gaussV for horizontal, gaussH for vertical scans)
+     * at a position on the scan-line, either from the precomputed buffer or computed from the image.
+     * @param image The luminance image.
+     * @param pos The x (horizontal) or y (vertical) coordinate on the scan-line.
+     * @return The smoothed value.
+     */
+    [[nodiscard]] int firstPass(const Image<PixelTypes::GrayscaledPixel>& image, unsigned int pos) const
+    {
+      if(smoothed)
+        return smoothed[pos];
+      return horizontal ? gaussV(&image[scanLinePosition][pos], image.width) : gaussH(&image[pos][scanLinePosition]);
+    }
   };
 
   /**
@@ -205,6 +221,21 @@ class ScanLineRegionizer : public ScanLineRegionizerBase
    */
   void update(ColorScanLineRegionsVerticalClipped& colorScanLineRegionsVerticalClipped) override;
 
+  /**
+   * Applies the vertical 1D gauss filter of the horizontal scans ([1, 2, 1] or [1, 2, 4, 2, 1])
+   * to all horizontal scan-lines at once. The rows are processed 8 pixels per SIMD register,
+   * the results are stored per scan-line in horizontalSmoothed.
+   * @param middle The y coordinate below which the 5x5 filter is used on the upper camera.
+   */
+  void smoothHorizontalScanLines(int middle);
+
+  /**
+   * Applies the horizontal 1D gauss filters of the vertical scans ([1, 2, 1] and [1, 2, 4, 2, 1])
+   * to all image rows covered by vertical scan-lines. Each row is filtered with SIMD and the
+   * results are transposed into per scan-line buffers (verticalSmoothed3 and verticalSmoothed5).
+   */
+  void smoothVerticalScanLines();
+
   /**
    * Creates regions along a horizontal line.
    * Uses a 3x3 pixel range centered around the checked points when comparing samples.
@@ -221,8 +252,9 @@ class ScanLineRegionizer : public ScanLineRegionizerBase
    * @param regions The regions to be filled.
    * @param leftmostX Left-side starting point of the scan-line
    * @param rightmostX Right-side end point of the scan-line
+   * @param smoothed Precomputed vertical smoothing of the scan-line or nullptr
    */
-  void scanHorizontal(unsigned int y, std::vector<InternalRegion>& regions, const unsigned int leftmostX, const unsigned int rightmostX) const;
+  void scanHorizontal(unsigned int y, std::vector<InternalRegion>& regions, const unsigned int leftmostX, const unsigned int rightmostX, const short* smoothed) const;
 
   /**
    * Creates regions along a horizontal line.
@@ -240,8 +272,9 @@ class ScanLineRegionizer : public ScanLineRegionizerBase
    * @param regions The regions to be filled.
    * @param leftmostX Left-side starting point of the scan-line
    * @param rightmostX Right-side end point of the scan-line
+   * @param smoothed Precomputed vertical smoothing of the scan-line or nullptr
    */
-  void scanHorizontalAdditionalSmoothing(unsigned int y, std::vector<InternalRegion>& regions, const unsigned int leftmostX, const unsigned int rightmostX) const;
+  void scanHorizontalAdditionalSmoothing(unsigned int y, std::vector<InternalRegion>& regions, const unsigned int leftmostX, const unsigned int rightmostX, const short* smoothed) const;
 
   /**
    * Creates regions along a vertical scan line.
@@ -249,8 +282,10 @@ class ScanLineRegionizer : public ScanLineRegionizerBase
    * @param middle The y coordinate at which to switch between 5x5 and 3x3 filter
    * @param top The y coordinate (inclusive) below which the useful part of the image is located.
    * @param regions he regions to be filled.
+   * @param smoothed3 Precomputed 3-tap horizontal smoothing of the scan-line or nullptr
+   * @param smoothed5 Precomputed 5-tap horizontal smoothing of the scan-line or nullptr
    */
-  void scanVertical(const ScanGrid::Line& line, int middle, int top, std::vector<InternalRegion>& regions) const;
+  void scanVertical(const ScanGrid::Line& line, int middle, int top, std::vector<InternalRegion>& regions, const short* smoothed3, const short* smoothed5) const;
 
   /**
    * Find an exact edge position in the scanRun in the subsegment designated by startPos and stopPos.
@@ -493,4 +528,9 @@ private:
   PixelTypes::GrayscaledPixel baseSaturation; /**< heuristically approximated average saturation of the image.
   * Used as a min luminance threshold for filtering out irrelevant edges and noise */
   EstimatedFieldColor estimatedFieldColor; /**< Field color range estimated for the current image */
+
+  std::vector<short> horizontalSmoothed; /**< Vertically smoothed rows of all horizontal scan-lines (one image width per scan-line). */
+  std::vector<short> verticalSmoothed3; /**< Horizontally 3-tap smoothed columns of all vertical scan-lines (one image height per scan-line). */
+  std::vector<short> verticalSmoothed5; /**< Horizontally 5-tap smoothed columns of all vertical scan-lines (one image height per scan-line). */
+  std::vector<short> rowTile; /**< Buffer for the rows filtered by smoothVerticalScanLines before they are transposed. */
 };
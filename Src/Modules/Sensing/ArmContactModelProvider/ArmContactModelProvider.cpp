@@ -139,7 +139,7 @@ void ArmContactModelProvider::calculateForce()
 
 Vector3f ArmContactModelProvider::calculateRequestedHandPosition(Arms::Arm arm) const
 {
-  return requestedRobotModel.limbs[arm == Arms::left ? Limbs::wristLeft : Limbs::wristRight].translation;
+  return theRequestedRobotModel.limbs[arm == Arms::left ? Limbs::wristLeft : Limbs::wristRight].translation;
 }
 
 void ArmContactModelProvider::update(ArmContactModel& model)
@@ -168,8 +168,6 @@ void ArmContactModelProvider::update(ArmContactModel& model)
   model.status[Arms::left].armOnBack = theArmMotionRequest.armKeyFrameRequest.arms[Arms::left].motion == ArmKeyFrameRequest::ArmKeyFrameId::back && theArmMotionRequest.armMotion[Arms::left] == ArmMotionRequest::ArmRequest::keyFrame;
   model.status[Arms::right].armOnBack = theArmMotionRequest.armKeyFrameRequest.arms[Arms::right].motion == ArmKeyFrameRequest::ArmKeyFrameId::back && theArmMotionRequest.armMotion[Arms::right] == ArmMotionRequest::ArmRequest::keyFrame;
 
-  requestedRobotModel.setJointData(theJointRequest, theRobotDimensions, theMassCalibration);
-
   angleBuffer[Arms::left].push_front(calculateRequestedHandPosition(Arms::left));
   angleBuffer[Arms::right].push_front(calculateRequestedHandPosition(Arms::right));
 
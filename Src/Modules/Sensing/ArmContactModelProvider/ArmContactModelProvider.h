@@ -19,7 +19,6 @@
 #include "Representations/Configuration/DamageConfiguration.h"
 #include "Representations/Infrastructure/FrameInfo.h"
 #include "Representations/Infrastructure/GameState.h"
-#include "Representations/Infrastructure/JointRequest.h"
 #include "Representations/MotionControl/ArmKeyFrameRequest.h"
 #include "Representations/MotionControl/ArmMotionRequest.h"
 #include "Representations/MotionControl/MotionInfo.h"
@@ -42,10 +41,8 @@ MODULE(ArmContactModelProvider,
   REQUIRES(FrameInfo),
   REQUIRES(GameState),
   REQUIRES(GroundContactState),
-  REQUIRES(MassCalibration),
-  REQUIRES(RobotDimensions),
+  REQUIRES(RequestedRobotModel),
   REQUIRES(RobotModel),
-  USES(JointRequest),
   USES(MotionInfo),
   PROVIDES(ArmContactModel),
   LOADS_PARAMETERS(
@@ -70,8 +67,6 @@ class ArmContactModelProvider: public ArmContactModelProviderBase
   //Timestamp when the arm sound was played last.
   unsigned int lastArmSoundTimestamp = 0;
 
-  RobotModel requestedRobotModel;
-
   //Buffer of the requested hand positions
   RingBuffer<Vector3f> angleBuffer[Arms::numOfArms];
 
@@ -92,7 +92,7 @@ void BoosterFallDownStateProvider::updatePredictedCom()
   {
     Vector2f v = ukf.mean.tail<2>();
     v = v.norm() > maxVelForPrediction ? maxVelForPrediction * v.normalized() : v;
-    UKF<5> ukfPredict = UKF<5>((Vector5f() << ukf.mean.head<3>(), v).finished());
+    FixedUKF<5> ukfPredict = FixedUKF<5>((Vector5f() << ukf.mean.head<3>(), v).finished());
     ukfPredict.cov = Matrix5f(ukf.cov);
 
     const Matrix3f I = calcInertiaTensor(tiltingEdge);
@@ -141,7 +141,7 @@ bool BoosterFallDownStateProvider::isFalling()
   {
     Vector2f v = ukf.mean.tail<2>();
     v = v.norm() > maxVelForPrediction ? maxVelForPrediction * v.normalized() : v;
-    UKF<5> ukfPredict = UKF<5>((Vector5f() << ukf.mean.head<3>(), v).finished());
+    FixedUKF<5> ukfPredict = FixedUKF<5>((Vector5f() << ukf.mean.head<3>(), v).finished());
     ukfPredict.cov = Matrix5f(ukf.cov);
     const Matrix3f I = calcInertiaTensor(tiltingEdge);
     for(float timePast = 0.f; timePast < forwardingTime; timePast += Global::getSettings().motionCycleTime)
@@ -491,7 +491,7 @@ void BoosterFallDownStateProvider::draw() const
   {
     if(theFallDownState->state == FallDownState::upright || theFallDownState->state == FallDownState::staggering)
     {
-      UKF<5> ukfPredict = UKF<5>(Vector5f(ukf.mean));
+      FixedUKF<5> ukfPredict = FixedUKF<5>(Vector5f(ukf.mean));
       ukfPredict.cov = Matrix5f(ukf.cov);
       const Pose3f& originToTorso = tiltingEdge;
       const Matrix3f I = calcInertiaTensor(tiltingEdge);
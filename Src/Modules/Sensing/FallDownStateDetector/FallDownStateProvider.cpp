@@ -107,7 +107,7 @@ bool FallDownStateProvider::isFalling() const
   {
     Vector2f v = ukf.mean.tail<2>();
     v = v.norm() > maxVelForPrediction ? maxVelForPrediction * v.normalized() : v;
-    UKF<5> ukfPredict = UKF<5>((Vector5f() << ukf.mean.head<3>(), v).finished());
+    FixedUKF<5> ukfPredict = FixedUKF<5>((Vector5f() << ukf.mean.head<3>(), v).finished());
     ukfPredict.cov = Matrix5f(ukf.cov);
     for(float timePast = 0.f; timePast < forwardingTime; timePast += Global::getSettings().motionCycleTime)
     {
@@ -453,7 +453,7 @@ void FallDownStateProvider::draw() const
   {
     if(theFallDownState->state == FallDownState::upright || theFallDownState->state == FallDownState::staggering)
     {
-      UKF<5> ukfPredict = UKF<5>(Vector5f(ukf.mean));
+      FixedUKF<5> ukfPredict = FixedUKF<5>(Vector5f(ukf.mean));
       ukfPredict.cov = Matrix5f(ukf.cov);
       const Pose3f& originToTorso = tiltingEdge;
       for(float timePast = 0.f; timePast < forwardingTime; timePast += Global::getSettings().motionCycleTime)
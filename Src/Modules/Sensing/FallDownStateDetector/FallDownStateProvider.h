@@ -81,7 +81,7 @@ private:
   FallDownState::Direction direction; /**< The fall direction. Always computed, even if not falling. */
   float torsoAboveGround; /**< The distance of the torso above the ground (in mm). */
 
-  UKF<5> ukf = UKF<5>(Vector5f::Zero()); // The statevector of the ukf is composed of: com, velocity;
+  FixedUKF<5> ukf = FixedUKF<5>(Vector5f::Zero()); // The statevector of the ukf is composed of: com, velocity;
   Vector5f dynamicNoise;
   Vector5f measurementNoise;
   bool resetFilter = false;
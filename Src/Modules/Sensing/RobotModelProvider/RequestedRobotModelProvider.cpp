@@ -0,0 +1,15 @@
+/**
+ * @file RequestedRobotModelProvider.cpp
+ *
+ * This file implements a module that provides the robot model for the joint request
+ * that was sent last.
+ */
+
+#include "RequestedRobotModelProvider.h"
+
+MAKE_MODULE(RequestedRobotModelProvider);
+
+void RequestedRobotModelProvider::update(RequestedRobotModel& requestedRobotModel)
+{
+  kinematicsCache.update(requestedRobotModel, theJointRequest, theRobotDimensions, theMassCalibration);
+}
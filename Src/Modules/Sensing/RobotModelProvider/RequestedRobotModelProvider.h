@@ -0,0 +1,35 @@
+/**
+ * @file RequestedRobotModelProvider.h
+ *
+ * This file declares a module that provides the robot model for the joint request
+ * that was sent last. Motion modules can share it instead of each computing the
+ * forward kinematics of the same request again.
+ */
+
+#pragma once
+
+#include "Representations/Configuration/MassCalibration.h"
+#include "Representations/Configuration/RobotDimensions.h"
+#include "Representations/Infrastructure/JointRequest.h"
+#include "Representations/Sensing/RobotModel.h"
+#include "Framework/Module.h"
+#include "Tools/Motion/KinematicsCache.h"
+
+MODULE(RequestedRobotModelProvider,
+{,
+  USES(JointRequest),
+  REQUIRES(MassCalibration),
+  REQUIRES(RobotDimensions),
+  PROVIDES(RequestedRobotModel),
+});
+
+class RequestedRobotModelProvider : public RequestedRobotModelProviderBase
+{
+  KinematicsCache kinematicsCache; /**< Recomputes only the chains of the model whose joints changed. */
+
+  /**
+   * This method is called when the representation provided needs to be updated.
+   * @param requestedRobotModel The representation updated.
+   */
+  void update(RequestedRobotModel& requestedRobotModel) override;
+};
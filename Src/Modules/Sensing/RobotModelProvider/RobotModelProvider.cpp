@@ -13,7 +13,7 @@ MAKE_MODULE(RobotModelProvider);
 
 void RobotModelProvider::update(RobotModel& robotModel)
 {
-  robotModel.setJointData(theJointAngles, theRobotDimensions, theMassCalibration);
+  kinematicsCache.update(robotModel, theJointAngles, theRobotDimensions, theMassCalibration);
 
   DEBUG_DRAWING3D("module:RobotModelProvider:massOffsets", "robot")
   {
@@ -13,6 +13,7 @@
 #include "Representations/Infrastructure/JointAngles.h"
 #include "Representations/Sensing/RobotModel.h"
 #include "Framework/Module.h"
+#include "Tools/Motion/KinematicsCache.h"
 
 MODULE(RobotModelProvider,
 {,
@@ -29,6 +30,8 @@ MODULE(RobotModelProvider,
  */
 class RobotModelProvider: public RobotModelProviderBase
 {
+  KinematicsCache kinematicsCache; /**< Recomputes only the chains of the model whose joints changed. */
+
   /** Executes this module
    * @param robotModel The data structure that is filled by this module
    */
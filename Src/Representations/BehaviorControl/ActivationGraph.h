@@ -18,7 +18,7 @@ STREAMABLE(ActivationGraph,
     Node() = default;
     Node(const std::string& option, int depth,
          const std::string& state, int optionTime,
-         int stateTime, const std::vector<std::string>& arguments),
+         int stateTime, std::vector<std::string> arguments),
 
     (std::string) option,
     (int)(0) depth,
@@ -38,11 +38,11 @@ STREAMABLE(ActivationGraph,
 
 inline ActivationGraph::Node::Node(const std::string& option, int depth,
                                    const std::string& state, int optionTime,
-                                   int stateTime, const std::vector<std::string>& arguments) :
+                                   int stateTime, std::vector<std::string> arguments) :
   option(option),
   depth(depth),
   state(state),
   optionTime(optionTime),
   stateTime(stateTime),
-  arguments(arguments)
+  arguments(std::move(arguments))
 {}
@@ -31,4 +31,6 @@ STREAMABLE(LibCheck,
 
   /** Performs checks for the individual behavior */
   FUNCTION(void()) performCheck,
+
+  (bool)(false) warnsWithOptions, /**< Can warnings be printed? They list the active options, i.e. the activation graph must be recorded. */
 });
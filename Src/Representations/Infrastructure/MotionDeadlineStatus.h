@@ -0,0 +1,28 @@
+/**
+ * @file MotionDeadlineStatus.h
+ *
+ * This file declares a representation that describes how well the motion
+ * thread meets its deadline, i.e. the time between the arrival of new
+ * sensor data and sending the joint commands back to the robot.
+ */
+
+#pragma once
+
+#include "Streaming/AutoStreamable.h"
+#include <string>
+#include <vector>
+
+STREAMABLE(MotionDeadlineStatus,
+{,
+  (unsigned)(0) deadline, /**< The deadline for the time between sensor data arrival and command publishing (in µs). */
+  (unsigned)(0) lastLatency, /**< The latency of the previous frame (in µs). */
+  (unsigned)(0) maxLatency, /**< The maximum latency measured so far (in µs). */
+  (unsigned)(0) framesMeasured, /**< The number of frames measured so far. */
+  (unsigned)(0) missedDeadlines, /**< The number of frames that missed the deadline so far. */
+  (unsigned)(0) consecutiveMisses, /**< The number of directly successive frames that missed the deadline. */
+  (std::vector<unsigned>) latencyHistogram, /**< Latencies relative to the deadline. Each bin covers histogramBinWidth, the last one everything above. */
+  (float)(0.1f) histogramBinWidth, /**< The width of each histogram bin relative to the deadline. */
+  (std::string) slowestProvider, /**< The representation whose provider took longest in the last frame that missed the deadline. */
+  (unsigned)(0) slowestProviderTime, /**< The time that provider took (in µs). */
+  (bool)(false) safeMode, /**< Deadlines were missed repeatedly. Motions are restricted to standing (and falling). */
+});
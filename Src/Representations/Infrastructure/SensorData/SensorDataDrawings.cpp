@@ -36,4 +36,6 @@ void SystemSensorData::draw()
   PLOT("representation:SystemSensorData:batteryLevel", batteryLevel);
   PLOT("representation:SystemSensorData:batteryTemperature", batteryTemperature);
   PLOT("representation:SystemSensorData:batteryCharging", batteryCharging);
+  PLOT("representation:SystemSensorData:missedFrames", missedFrames);
+  PLOT("representation:SystemSensorData:overwrittenFrames", overwrittenFrames);
 }
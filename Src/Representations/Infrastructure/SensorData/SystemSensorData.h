@@ -12,4 +12,6 @@ STREAMABLE(SystemSensorData,
   (float)(SensorData::off) batteryLevel, /**< The current of the battery (in %). Range: [0.0, 1.0] */
   (float)(SensorData::off) batteryTemperature, /**< The temperature of the battery (in %, whatever that means...). Range: [0.0, 1.0] */
   (bool)(false) batteryCharging, /**< The battery is charging */
+  (unsigned)(0) missedFrames, /**< The number of frames in which no sensor data arrived in time. */
+  (unsigned)(0) overwrittenFrames, /**< The number of sensor data packages that were replaced by newer ones before they were used. */
 });
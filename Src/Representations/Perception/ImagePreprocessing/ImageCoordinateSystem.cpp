@@ -22,12 +22,13 @@ Vector2f ImageCoordinateSystem::fromCorrected(const Vector2f& correctedCoords, c
   if(y < -cameraInfo.height / 4 || y >= cameraInfo.height * 5 / 4)
     return correctedCoords;
 
+  const float correctedAngle = std::atan((correctedCoords.y() - cameraInfo.opticalCenter.y()) / cameraInfo.focalLengthHeight);
   float factor;
   for(int i = 0; i < 3; ++i)
   {
     factor = a + y * b;
     float lastY = y;
-    y = cameraInfo.opticalCenter.y() + std::tan(std::atan((correctedCoords.y() - cameraInfo.opticalCenter.y()) / cameraInfo.focalLengthHeight) + factor * offset.y()) * cameraInfo.focalLengthHeight;
+    y = cameraInfo.opticalCenter.y() + std::tan(correctedAngle + factor * offset.y()) * cameraInfo.focalLengthHeight;
     if(std::abs(y - lastY) < 0.5f)
       break;
   }
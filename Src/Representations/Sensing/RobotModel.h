@@ -55,3 +55,15 @@ STREAMABLE(RobotModel,
   (SE3WithCov) soleRight,
   (Vector3f)(Vector3f::Zero()) centerOfMass, /**< Position of the center of mass (center of gravity) relative to the robot's origin. */
 });
+
+/**
+ * @struct RequestedRobotModel
+ *
+ * The robot model for the joint request that was sent last, i.e. the one
+ * that is currently executed.
+ */
+STREAMABLE_WITH_BASE(RequestedRobotModel, RobotModel,
+{
+  /** The drawings of the base class show the measured model. */
+  void draw() const {},
+});
@@ -12,6 +12,7 @@
 #include "Framework/ModulePacket.h"
 #include "Framework/Settings.h"
 #include "Modules/Infrastructure/LogDataProvider/LogDataProvider.h"
+#include "Modules/Infrastructure/MotionDeadlineMonitor/MotionDeadlineMonitor.h"
 #include "Platform/Thread.h"
 #include "Platform/Time.h"
 #include "Streaming/Global.h"
@@ -27,6 +28,7 @@ void Motion::afterModules()
 {
   NaoProvider::finishFrame();
   BoosterProvider::finishFrame();
+  MotionDeadlineMonitor::frameFinished();
 }
 
 bool Motion::afterFrame()
@@ -36,9 +38,13 @@ bool Motion::afterFrame()
     BH_TRACE_MSG("before waitForFrameData");
     NaoProvider::waitForFrameData();
     BoosterProvider::waitForFrameData();
+    MotionDeadlineMonitor::frameDataReceived(BoosterProvider::getFrameDataArrival());
   }
   else
+  {
     Thread::sleep(static_cast<unsigned>(Global::getSettings().motionCycleTime * 1000.f));
+    MotionDeadlineMonitor::frameDataReceived();
+  }
 
   return BHExecutionUnit::afterFrame();
 }
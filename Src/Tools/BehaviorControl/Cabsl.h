@@ -106,11 +106,13 @@
 #pragma once
 
 #include <unordered_map>
+#include "Debugging/TimingManager.h"
 #include "Math/Eigen.h" // Not used, but avoids naming conflicts
 #include "Platform/BHAssert.h"
 #include "Platform/SystemCall.h"
 #include "Representations/BehaviorControl/ActivationGraph.h"
 #include "Streaming/FunctionList.h"
+#include "Streaming/Global.h"
 #include "Streaming/InStreams.h"
 #include "Streaming/OutStreams.h"
 #include "Streaming/TypeRegistry.h"
@@ -261,6 +263,8 @@ namespace cabsl
         context.transitionExecuted = false; // no transition executed yet
         context.hasCommonTransition = false; // until one is found, it is assumed that there is no common transition
         ++instance->depth; // increase depth counter for activation graph
+        if(instance->timeOptions)
+          Global::getTimingManager().startTiming(optionName);
       }
 
       /**
@@ -268,6 +272,8 @@ namespace cabsl
        */
       ~OptionExecution()
       {
+        if(instance->timeOptions)
+          Global::getTimingManager().stopTiming(optionName);
         if(!fromSelect || context.stateType != OptionContext::initialState)
         {
           addToActivationGraph(); // add to activation graph if it has not been already
@@ -298,12 +304,15 @@ namespace cabsl
 
       /**
        * Adds a string description containing the current value of an argument to the list of arguments.
-       * The description is only added if the argument is streamable.
+       * The description is only added if the argument is streamable and the activation graph is recorded
+       * in this frame.
        * @tparam U The type of the argument.
        * @param value The current value of the argument.
        */
       template<typename U> typename std::enable_if<isStreamable<U>::value>::type addArgument(const char* name, const U& value) const
       {
+        if(!instance->recordActivationGraph)
+          return;
         name += 1 + static_cast<int>(std::string(name).find_last_of(" )"));
         OutStringStream stream;
         stream << value;
@@ -319,13 +328,13 @@ namespace cabsl
        */
       void addToActivationGraph() const
       {
-        if(!context.addedToGraph && instance->activationGraph)
+        if(!context.addedToGraph && instance->recordActivationGraph)
         {
           instance->activationGraph->graph.emplace_back(optionName, instance->depth,
                                                         context.stateName,
                                                         instance->_currentFrameTime - context.optionStart,
                                                         instance->_currentFrameTime - context.stateStart,
-                                                        arguments);
+                                                        std::move(arguments));
           context.addedToGraph = true;
         }
       }
@@ -337,7 +346,7 @@ namespace cabsl
       const char* name; /**< The name of the option. */
       void (CabslBehavior::*option)(const OptionExecution&); /**< The option method. */
       size_t offsetOfContext; /**< The memory offset of the context within the behavior class. */
-      int index; /**< The index of the option (for the enum of all options). */
+      int index; /**< The index of the option (for the enum of all options and optionsByIndex). */
 
       /** Default constructor, because STL types need one. */
       OptionDescriptor() = default;
@@ -359,6 +368,7 @@ namespace cabsl
     {
     private:
       static std::unordered_map<std::string, const OptionDescriptor*>* optionsByName; /**< All argumentless options, indexed by their names. */
+      static std::vector<const OptionDescriptor*>* optionsByIndex; /**< All argumentless options, indexed by their values in the enum \c Option. */
       static std::vector<void (*)()>* initHandlers; /**< All initialization handlers for options with definitions. */
 
     public:
@@ -368,21 +378,25 @@ namespace cabsl
       ~OptionInfos()
       {
         delete optionsByName;
+        delete optionsByIndex;
         delete initHandlers;
         optionsByName = nullptr;
+        optionsByIndex = nullptr;
         initHandlers = nullptr;
       }
 
       /**
-       * The method prepares the collection of information about all options in optionByIndex
+       * The method prepares the collection of information about all options in optionsByIndex
        * and optionsByName. It also adds a dummy option descriptor at index 0 with the name "none".
        */
       static void init()
       {
         ASSERT(!optionsByName);
         optionsByName = new std::unordered_map<std::string, const OptionDescriptor*>;
+        optionsByIndex = new std::vector<const OptionDescriptor*>;
         static OptionDescriptor descriptor("none", 0, 0);
         (*optionsByName)[descriptor.name] = &descriptor;
+        optionsByIndex->push_back(&descriptor);
         TypeRegistry::addEnum(typeid(Option).name());
         TypeRegistry::addEnumConstant(typeid(Option).name(), "none");
       }
@@ -403,7 +417,9 @@ namespace cabsl
         ASSERT(optionsByName);
         if(optionsByName->find(descriptor.name) == optionsByName->end()) // only register once
         {
+          descriptor.index = static_cast<int>(optionsByIndex->size());
           (*optionsByName)[descriptor.name] = &descriptor;
+          optionsByIndex->push_back(&descriptor);
           TypeRegistry::addEnumConstant(typeid(Option).name(), descriptor.name);
         }
       }
@@ -430,15 +446,7 @@ namespace cabsl
       static bool execute(CabslBehavior* behavior, const std::string& option, bool fromSelect = false)
       {
         auto pair = optionsByName->find(option);
-        if(pair != optionsByName->end())
-        {
-          const OptionDescriptor& descriptor = *pair->second;
-          OptionContext& context = *reinterpret_cast<OptionContext*>(reinterpret_cast<char*>(behavior) + descriptor.offsetOfContext);
-          (behavior->*(descriptor.option))(OptionExecution(descriptor.name, context, behavior, fromSelect));
-          return context.stateType != OptionContext::initialState;
-        }
-        else
-          return false;
+        return pair != optionsByName->end() && execute(behavior, *pair->second, fromSelect);
       }
 
       /**
@@ -451,7 +459,7 @@ namespace cabsl
        */
       static bool execute(CabslBehavior* behavior, Option option, bool fromSelect = false)
       {
-        return execute(behavior, TypeRegistry::getEnumName(option), fromSelect);
+        return option < optionsByIndex->size() && execute(behavior, *(*optionsByIndex)[option], fromSelect);
       }
 
       /**
@@ -469,6 +477,22 @@ namespace cabsl
         return false;
       }
 
+      /**
+       * The method executes the option described by a descriptor.
+       * @param behavior The behavior instance.
+       * @param descriptor The description of the option.
+       * @param fromSelect Was this method called from `select_option`?
+       * @return Was the option actually executed?
+       */
+      static bool execute(CabslBehavior* behavior, const OptionDescriptor& descriptor, bool fromSelect)
+      {
+        if(!descriptor.option)
+          return false;
+        OptionContext& context = *reinterpret_cast<OptionContext*>(reinterpret_cast<char*>(behavior) + descriptor.offsetOfContext);
+        (behavior->*(descriptor.option))(OptionExecution(descriptor.name, context, behavior, fromSelect));
+        return context.stateType != OptionContext::initialState;
+      }
+
       /** Executes all handlers that initialize the definitions. */
       static void executeInitHandlers()
       {
@@ -484,6 +508,8 @@ namespace cabsl
     unsigned lastFrameTime = 0; /**< The timestamp of the last time the behavior was executed. */
     int depth = 0; /**< The depth level of the current option. Used for activation graph. */
     ActivationGraph* activationGraph; /**< The activation graph for debug output. Can be zero if not set. */
+    bool recordActivationGraph = false; /**< Is the activation graph filled in the current frame? */
+    bool timeOptions = false; /**< Is the execution time of each option measured in the current frame? */
 
   protected:
     static thread_local Cabsl* _theInstance; /**< The instance of this behavior used. */
@@ -504,8 +530,12 @@ namespace cabsl
     /**
      * Must be called at the beginning of each behavior execution cycle even if no option is called.
      * @param frameTime The current time in ms.
+     * @param recordActivationGraph Fill the activation graph (if set) in this frame? Otherwise, it stays
+     *                              empty and the arguments of options are not converted to strings.
+     * @param timeOptions Measure the execution time of each option with the timing manager in this frame?
+     *                    The times include the times of the suboptions executed.
      */
-    void beginFrame(unsigned frameTime)
+    void beginFrame(unsigned frameTime, bool recordActivationGraph = true, bool timeOptions = false)
     {
       if(SystemCall::getMode() == SystemCall::logFileReplay && frameTime < lastFrameTime)
         _currentFrameTime = frameTime;
@@ -513,6 +543,8 @@ namespace cabsl
         _currentFrameTime = std::max(frameTime, lastFrameTime + 1);
       if(activationGraph)
         activationGraph->graph.clear();
+      this->recordActivationGraph = recordActivationGraph && activationGraph;
+      this->timeOptions = timeOptions;
       _theInstance = this;
       OptionInfos::executeInitHandlers();
     }
@@ -540,6 +572,8 @@ namespace cabsl
     thread_local Cabsl<CabslBehavior, InFileStream, OutStringStream>* Cabsl<CabslBehavior, InFileStream, OutStringStream>::_theInstance;
   template<typename CabslBehavior, typename InFileStream, typename OutStringStream>
     std::unordered_map<std::string, const typename Cabsl<CabslBehavior, InFileStream, OutStringStream>::OptionDescriptor*>* Cabsl<CabslBehavior, InFileStream, OutStringStream>::OptionInfos::optionsByName;
+  template<typename CabslBehavior, typename InFileStream, typename OutStringStream>
+    std::vector<const typename Cabsl<CabslBehavior, InFileStream, OutStringStream>::OptionDescriptor*>* Cabsl<CabslBehavior, InFileStream, OutStringStream>::OptionInfos::optionsByIndex;
   template<typename CabslBehavior, typename InFileStream, typename OutStringStream>
     std::vector<void (*)()>* Cabsl<CabslBehavior, InFileStream, OutStringStream>::OptionInfos::initHandlers;
   template<typename CabslBehavior, typename InFileStream, typename OutStringStream>
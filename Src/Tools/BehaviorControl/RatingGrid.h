@@ -0,0 +1,115 @@
+/**
+ * @file RatingGrid.h
+ *
+ * This file declares a class that caches a rating function on the nodes of a
+ * regular grid and answers point queries by bilinear interpolation between
+ * the four surrounding nodes. Nodes are only evaluated when a query needs
+ * them, but at most once until the grid is invalidated, i.e. the costs per
+ * frame are bounded by the number of nodes, but are usually much lower.
+ * Points outside of the grid are clamped to its border.
+ */
+
+#pragma once
+
+#include "Math/Eigen.h"
+#include "Platform/BHAssert.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+class RatingGrid
+{
+public:
+  RatingGrid() = default;
+
+  /**
+   * Constructor.
+   * @param lowerCorner The position of the first node (in mm).
+   * @param upperCorner The position up to which the grid extends (in mm).
+   *                    It is covered by the last node if it is not on a node itself.
+   * @param cellSize The distance between two neighboring nodes (in mm).
+   */
+  RatingGrid(const Vector2f& lowerCorner, const Vector2f& upperCorner, float cellSize) :
+    lowerCorner(lowerCorner), cellSize(cellSize),
+    numOfNodes(static_cast<int>(std::ceil((upperCorner.x() - lowerCorner.x()) / cellSize)) + 1,
+               static_cast<int>(std::ceil((upperCorner.y() - lowerCorner.y()) / cellSize)) + 1),
+    values(numOfNodes.x() * numOfNodes.y()),
+    stamps(values.size(), 0)
+  {
+    ASSERT(cellSize > 0.f);
+    ASSERT(numOfNodes.x() > 1 && numOfNodes.y() > 1);
+  }
+
+  /** Marks all nodes as outdated, e.g. once per frame. */
+  void invalidate() {++stamp;}
+
+  /**
+   * Evaluates all nodes that are not up to date, e.g. to draw them or to pay
+   * the costs at a predictable point in time.
+   * @param rating The rating function. It is called with the position of each node.
+   */
+  template<typename Rating>
+  void fill(const Rating& rating)
+  {
+    for(int y = 0; y < numOfNodes.y(); ++y)
+      for(int x = 0; x < numOfNodes.x(); ++x)
+        node(x, y, rating);
+  }
+
+  /**
+   * Interpolates the rating at a position.
+   * @param point The position (in mm).
+   * @param rating The rating function. It is called with the positions of nodes that are not up to date.
+   * @return The interpolated rating.
+   */
+  template<typename Rating>
+  float interpolate(const Vector2f& point, const Rating& rating)
+  {
+    int x, y;
+    float fx, fy;
+    locate(point, x, y, fx, fy);
+    const float lower = (1.f - fx) * node(x, y, rating) + fx * node(x + 1, y, rating);
+    const float upper = (1.f - fx) * node(x, y + 1, rating) + fx * node(x + 1, y + 1, rating);
+    return (1.f - fy) * lower + fy * upper;
+  }
+
+private:
+  Vector2f lowerCorner = Vector2f::Zero(); /**< The position of the first node (in mm). */
+  float cellSize = 1.f; /**< The distance between two neighboring nodes (in mm). */
+  Vector2i numOfNodes = Vector2i(2, 2); /**< The number of nodes in x and y direction. */
+  std::vector<float> values = std::vector<float>(4); /**< The cached ratings of all nodes, row by row. */
+  std::vector<unsigned> stamps = std::vector<unsigned>(4, 0); /**< The stamp when each node was evaluated. */
+  unsigned stamp = 1; /**< Nodes with a different stamp are outdated. */
+
+  /**
+   * Determines the cell that contains a position and the relative position inside it.
+   * @param point The position (in mm).
+   * @param x The x index of the lower left node of the cell.
+   * @param y The y index of the lower left node of the cell.
+   * @param fx The relative x position inside the cell [0 .. 1].
+   * @param fy The relative y position inside the cell [0 .. 1].
+   */
+  void locate(const Vector2f& point, int& x, int& y, float& fx, float& fy) const
+  {
+    const float gx = std::clamp((point.x() - lowerCorner.x()) / cellSize, 0.f, static_cast<float>(numOfNodes.x() - 1));
+    const float gy = std::clamp((point.y() - lowerCorner.y()) / cellSize, 0.f, static_cast<float>(numOfNodes.y() - 1));
+    x = std::min(static_cast<int>(gx), numOfNodes.x() - 2);
+    y = std::min(static_cast<int>(gy), numOfNodes.y() - 2);
+    fx = gx - static_cast<float>(x);
+    fy = gy - static_cast<float>(y);
+  }
+
+  /** Returns the rating of a node and evaluates it first if it is outdated. */
+  template<typename Rating>
+  float node(int x, int y, const Rating& rating)
+  {
+    const std::size_t index = static_cast<std::size_t>(y * numOfNodes.x() + x);
+    if(stamps[index] != stamp)
+    {
+      values[index] = rating(Vector2f(lowerCorner.x() + cellSize * static_cast<float>(x),
+                                      lowerCorner.y() + cellSize * static_cast<float>(y)));
+      stamps[index] = stamp;
+    }
+    return values[index];
+  }
+};
@@ -1133,13 +1133,21 @@ void CompressedTeamCommunication::Base::deselect()
 
 void CompressedTeamCommunicationIn::readBits(void* data, std::size_t bits)
 {
+  // Bit i of the data corresponds to bit i % 8 of byte i / 8. Therefore, the data can be
+  // transferred a byte at a time, which spans at most two bytes in the container.
   std::uint8_t* cdata = reinterpret_cast<std::uint8_t*>(data);
-  for(std::size_t i = 0; i < bits; ++i, ++containerOffset)
+  for(; bits > 0; ++cdata)
   {
-    if(container[containerOffset / 8] & (1 << (containerOffset % 8)))
-      cdata[i / 8] |= 1 << (i % 8);
-    else
-      cdata[i / 8] &= ~(1 << (i % 8));
+    const unsigned int n = static_cast<unsigned int>(std::min<std::size_t>(bits, 8));
+    const unsigned int shift = containerOffset % 8;
+    const std::uint8_t* src = &container[containerOffset / 8];
+    unsigned int value = *src >> shift;
+    if(shift + n > 8)
+      value |= src[1] << (8 - shift);
+    const unsigned int mask = (1u << n) - 1;
+    *cdata = static_cast<std::uint8_t>((*cdata & ~mask) | (value & mask));
+    containerOffset += n;
+    bits -= n;
   }
 }
 
@@ -1372,10 +1380,22 @@ CompressedTeamCommunicationIn::CompressedTeamCommunicationIn(const std::vector<s
 
 void CompressedTeamCommunicationOut::writeBits(const void* data, std::size_t bits)
 {
+  // The same layout as in CompressedTeamCommunicationIn::readBits, i.e. a byte of the
+  // data is written at once.
   const std::uint8_t* cdata = reinterpret_cast<const std::uint8_t*>(data);
   container.resize((containerOffset + bits + 7) / 8, 0);
-  for(std::size_t i = 0; i < bits; ++i, ++containerOffset)
-    container[containerOffset / 8] |= ((cdata[i / 8] >> (i % 8)) & 1) << (containerOffset % 8);
+  for(; bits > 0; ++cdata)
+  {
+    const unsigned int n = static_cast<unsigned int>(std::min<std::size_t>(bits, 8));
+    const unsigned int shift = containerOffset % 8;
+    std::uint8_t* dest = &container[containerOffset / 8];
+    const unsigned int value = *cdata & ((1u << n) - 1);
+    *dest |= static_cast<std::uint8_t>(value << shift);
+    if(shift + n > 8)
+      dest[1] |= static_cast<std::uint8_t>(value >> (8 - shift));
+    containerOffset += n;
+    bits -= n;
+  }
 }
 
 template<typename Integer>
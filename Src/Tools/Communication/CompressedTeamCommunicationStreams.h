@@ -2,6 +2,9 @@
  * @file CompressedTeamCommunicationStreams.h
  *
  * This file declares streams for compressed team communication.
+ * Every message is encoded as a full snapshot. Team messages are broadcast
+ * without acknowledgements, and the GameController's TCM plugin has to decode
+ * each message on its own, so they cannot be encoded relative to an earlier one.
  *
  * @author Arne Hasselbring
  */
@@ -14,6 +17,7 @@
 #include <functional>
 #include <memory>
 #include <stack>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -66,6 +70,13 @@ namespace CompressedTeamCommunication
 
   inline void Type::javaInitialize(Out&, const std::string&) const {}
 
+  /** A string hash that allows looking up members by their C string names without creating temporary strings. */
+  struct NameHash
+  {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view name) const { return std::hash<std::string_view>()(name); }
+  };
+
   struct RecordType : Type
   {
     bool check(const std::string& type) const override;
@@ -74,7 +85,7 @@ namespace CompressedTeamCommunication
     void javaRead(Out& stream, const std::string&, const std::string& identifier, const std::string& indentation) const override;
 
     std::string name; /**< The name of the record type. */
-    std::unordered_map<std::string, const Type*> members; /**< The members of the record and their types. */
+    std::unordered_map<std::string, const Type*, NameHash, std::equal_to<>> members; /**< The members of the record and their types. */
   };
 
   struct ArrayType : Type
@@ -95,13 +95,7 @@ bool Transformation::imageToRobotHorizontalPlane(const Vector2f& pointInImage, f
 bool Transformation::robotToImage(const Vector3f& point, const CameraMatrix& cameraMatrix,
                                   const CameraInfo& cameraInfo, Vector2f& pointInImage)
 {
-  Vector3f pointInCam = cameraMatrix.inverse() * point;
-  if(pointInCam.x() <= 0)
-    return false;
-
-  pointInCam /= pointInCam.x();
-  pointInImage = cameraInfo.opticalCenter - pointInCam.tail<2>().cwiseProduct(Vector2f(cameraInfo.focalLength, cameraInfo.focalLengthHeight));
-  return pointInCam.x() > 0;
+  return robotToImage(point, cameraMatrix.inverse(), cameraInfo, pointInImage);
 }
 
 bool Transformation::robotToImage(const Vector2f& point, const CameraMatrix& cameraMatrix,
@@ -111,6 +105,18 @@ bool Transformation::robotToImage(const Vector2f& point, const CameraMatrix& cam
   return robotToImage(point3D, cameraMatrix, cameraInfo, pointInImage);
 }
 
+bool Transformation::robotToImage(const Vector3f& point, const Pose3f& inverseCameraMatrix,
+                                  const CameraInfo& cameraInfo, Vector2f& pointInImage)
+{
+  Vector3f pointInCam = inverseCameraMatrix * point;
+  if(pointInCam.x() <= 0)
+    return false;
+
+  pointInCam /= pointInCam.x();
+  pointInImage = cameraInfo.opticalCenter - pointInCam.tail<2>().cwiseProduct(Vector2f(cameraInfo.focalLength, cameraInfo.focalLengthHeight));
+  return true;
+}
+
 bool Transformation::robotWithCameraRotationToImage(const Vector2f& point, const CameraMatrix& cameraMatrix,
                                                     const CameraInfo& cameraInfo, Vector2f& pointInImage)
 {
@@ -10,6 +10,7 @@
 
 struct CameraMatrix;
 struct CameraInfo;
+struct Pose3f;
 
 /**
  * The namespace Transformation defines methods for coordinate system transformations.
@@ -81,6 +82,20 @@ namespace Transformation
                                   const CameraInfo& cameraInfo, Vector2f& pointInImage);
   [[nodiscard]] bool robotToImage(const Vector2f& point, const CameraMatrix& cameraMatrix,
                                   const CameraInfo& cameraInfo, Vector2f& pointInImage);
+
+  /**
+   * Calculates where a relative point in the world appears in an image. This
+   * version is meant for projecting many points with the same camera matrix.
+   * @param point The coordinates of the point relative to the robot's origin.
+   * @param inverseCameraMatrix The inverse of the camera matrix of the image.
+   * @param cameraInfo The camera info of the image.
+   * @param pointInImage The resulting point.
+   * @return The result is valid, i.e. the point is in front of the camera. That
+   *         still does not mean that the point is within the bounds of the image.
+   */
+  [[nodiscard]] bool robotToImage(const Vector3f& point, const Pose3f& inverseCameraMatrix,
+                                  const CameraInfo& cameraInfo, Vector2f& pointInImage);
+
   /**
    * Calculated where a point relative to the robot and rotated by the z-axis of
    * the camera appears in the image. The point of this method is to easily manipulate relative
@@ -0,0 +1,102 @@
+/**
+ * @file BallRollModel.cpp
+ *
+ * This file implements a class that answers many questions about the same
+ * rolling ball.
+ */
+
+#include "BallRollModel.h"
+#include "Platform/BHAssert.h"
+#include <cmath>
+#include <limits>
+
+BallRollModel::BallRollModel(float ballFriction, float timeStep, float horizon) :
+  deceleration(-ballFriction * 1000.f), timeStep(timeStep),
+  numOfSteps(static_cast<std::size_t>(std::ceil(horizon / timeStep)) + 1)
+{
+  ASSERT(ballFriction < 0.f);
+  ASSERT(timeStep > 0.f);
+  distances.reserve(numOfSteps);
+}
+
+void BallRollModel::setBall(const Vector2f& position, const Vector2f& velocity)
+{
+  this->position = position;
+  speed = velocity.norm();
+  direction = speed > 0.f ? Vector2f(velocity / speed) : Vector2f::UnitX();
+  timeUntilStop = speed / deceleration;
+  stopDistance = 0.5f * speed * timeUntilStop;
+  endPosition = position + direction * stopDistance;
+
+  distances.clear();
+  for(std::size_t i = 0; i < numOfSteps && static_cast<float>(i) * timeStep < timeUntilStop; ++i)
+    distances.push_back(getDistance(static_cast<float>(i) * timeStep));
+}
+
+void BallRollModel::getPositions(const std::vector<float>& times, std::vector<Vector2f>& positions) const
+{
+  positions.resize(times.size());
+  for(std::size_t i = 0; i < times.size(); ++i)
+    positions[i] = getPosition(times[i]);
+}
+
+float BallRollModel::getTimeForDistance(float distance) const
+{
+  if(distance <= 0.f)
+    return 0.f;
+  if(distance > stopDistance)
+    return std::numeric_limits<float>::max();
+
+  // Solve distance = speed * t - 0.5 * deceleration * t^2 for the smaller t.
+  const float radicand = speed * speed - 2.f * deceleration * distance;
+  return (speed - std::sqrt(std::max(0.f, radicand))) / deceleration;
+}
+
+float BallRollModel::getInterceptTime(const Vector2f& robot, float robotSpeed, float reach) const
+{
+  if(getGap(robot, robotSpeed, reach, 0.f, 0.f) <= 0.f)
+    return 0.f;
+
+  // Search the tabulated times first.
+  float t = 0.f;
+  for(std::size_t i = 1; i < distances.size(); ++i)
+  {
+    const float next = static_cast<float>(i) * timeStep;
+    if(getGap(robot, robotSpeed, reach, next, distances[i]) <= 0.f)
+      return refine(robot, robotSpeed, reach, t, next);
+    t = next;
+  }
+
+  // Continue without the table while the ball is still rolling.
+  for(float next = t + timeStep; next < timeUntilStop; t = next, next += timeStep)
+    if(getGap(robot, robotSpeed, reach, next, getDistance(next)) <= 0.f)
+      return refine(robot, robotSpeed, reach, t, next);
+  if(getGap(robot, robotSpeed, reach, timeUntilStop, stopDistance) <= 0.f)
+    return refine(robot, robotSpeed, reach, t, timeUntilStop);
+
+  // The ball has stopped, so the gap shrinks linearly.
+  if(robotSpeed <= 0.f)
+    return std::numeric_limits<float>::max();
+  return std::max(timeUntilStop, ((endPosition - robot).norm() - reach) / robotSpeed);
+}
+
+void BallRollModel::getInterceptTimes(const std::vector<Vector2f>& robots, float robotSpeed, float reach, std::vector<float>& times) const
+{
+  times.resize(robots.size());
+  for(std::size_t i = 0; i < robots.size(); ++i)
+    times[i] = getInterceptTime(robots[i], robotSpeed, reach);
+}
+
+float BallRollModel::refine(const Vector2f& robot, float robotSpeed, float reach, float start, float end) const
+{
+  // The bisection stops at a resolution of about a millisecond.
+  while(end - start > 0.001f)
+  {
+    const float middle = 0.5f * (start + end);
+    if(getGap(robot, robotSpeed, reach, middle, getDistance(middle)) <= 0.f)
+      end = middle;
+    else
+      start = middle;
+  }
+  return end;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file BallRollModel.h
+ *
+ * This file declares a class that answers many questions about the same
+ * rolling ball, e.g. where it will be at different times or when robots at
+ * different positions could intercept it. It uses the same linear model for
+ * the ball deceleration as BallPhysics. The rolled distances for a fixed time
+ * step are tabulated when the ball is set. All other queries are answered in
+ * closed form.
+ */
+
+#pragma once
+
+#include "Math/Eigen.h"
+#include <vector>
+
+class BallRollModel
+{
+public:
+  /**
+   * Constructor.
+   * @param ballFriction The ball friction (negative force) (in m/s^2).
+   * @param timeStep The time between two entries of the table (in s). Intercept times are
+   *                 searched with this resolution before they are refined.
+   * @param horizon The time covered by the table (in s). Later times are still handled,
+   *                but without the table.
+   */
+  BallRollModel(float ballFriction, float timeStep = 0.05f, float horizon = 10.f);
+
+  /**
+   * Sets the ball all further queries are about.
+   * @param position The ball position (in mm).
+   * @param velocity The ball velocity (in mm/s).
+   */
+  void setBall(const Vector2f& position, const Vector2f& velocity);
+
+  /** Returns the time until the ball stops (in s). */
+  float getTimeUntilStop() const {return timeUntilStop;}
+
+  /** Returns the position where the ball will stop (in mm). */
+  const Vector2f& getEndPosition() const {return endPosition;}
+
+  /**
+   * Computes the position of the ball in t seconds.
+   * @param t The time (in s).
+   * @return The position (in mm).
+   */
+  Vector2f getPosition(float t) const {return position + direction * getDistance(t);}
+
+  /**
+   * Computes the positions of the ball at several times.
+   * @param times The times (in s).
+   * @param positions The positions (in mm). The vector is resized as needed.
+   */
+  void getPositions(const std::vector<float>& times, std::vector<Vector2f>& positions) const;
+
+  /**
+   * Computes the time the ball needs to roll a distance.
+   * @param distance The distance (in mm).
+   * @return The time (in s) or std::numeric_limits<float>::max() if the ball will stop before.
+   */
+  float getTimeForDistance(float distance) const;
+
+  /**
+   * Computes the earliest time when a robot can reach the ball if it moves straight to the
+   * point where the ball will be at that time. Intervals shorter than the time step in which
+   * the robot can reach the ball might be missed.
+   * @param robot The position of the robot (in mm).
+   * @param robotSpeed The speed of the robot (in mm/s).
+   * @param reach The distance from which the robot can touch the ball (in mm).
+   * @return The time (in s) or std::numeric_limits<float>::max() if the robot cannot reach the ball.
+   */
+  float getInterceptTime(const Vector2f& robot, float robotSpeed, float reach = 0.f) const;
+
+  /**
+   * Computes the intercept times for several robots.
+   * @param robots The positions of the robots (in mm).
+   * @param robotSpeed The speed of all robots (in mm/s).
+   * @param reach The distance from which the robots can touch the ball (in mm).
+   * @param times The times (in s), see getInterceptTime. The vector is resized as needed.
+   */
+  void getInterceptTimes(const std::vector<Vector2f>& robots, float robotSpeed, float reach, std::vector<float>& times) const;
+
+private:
+  float deceleration; /**< The deceleration of the ball (in mm/s^2, positive). */
+  float timeStep; /**< The time between two entries of the table (in s). */
+  std::size_t numOfSteps; /**< The maximum number of entries of the table. */
+
+  Vector2f position = Vector2f::Zero(); /**< The position of the ball (in mm). */
+  Vector2f direction = Vector2f::UnitX(); /**< The normalized direction in which the ball rolls. */
+  float speed = 0.f; /**< The speed of the ball (in mm/s). */
+  float timeUntilStop = 0.f; /**< The time until the ball stops (in s). */
+  float stopDistance = 0.f; /**< The distance the ball rolls until it stops (in mm). */
+  Vector2f endPosition = Vector2f::Zero(); /**< The position where the ball stops (in mm). */
+  std::vector<float> distances; /**< The distance rolled after i time steps, while the ball is still rolling (in mm). */
+
+  /** Returns the distance rolled after t seconds (in mm). */
+  float getDistance(float t) const
+  {
+    return t >= timeUntilStop ? stopDistance : (speed - 0.5f * deceleration * t) * t;
+  }
+
+  /**
+   * Returns how far away the ball is from the area a robot can reach after t seconds.
+   * @param distance The distance the ball has rolled at that time (in mm).
+   */
+  float getGap(const Vector2f& robot, float robotSpeed, float reach, float t, float distance) const
+  {
+    return (position + direction * distance - robot).norm() - reach - robotSpeed * t;
+  }
+
+  /**
+   * Searches for the time when the gap becomes zero.
+   * @param start A time with a positive gap (in s).
+   * @param end A later time without a positive gap (in s).
+   */
+  float refine(const Vector2f& robot, float robotSpeed, float reach, float start, float end) const;
+};
@@ -0,0 +1,80 @@
+/**
+ * @file ObstacleAssociation.cpp
+ *
+ * This file implements a class that associates measurements of obstacles with
+ * obstacle hypotheses.
+ */
+
+#include "ObstacleAssociation.h"
+#include "Math/BHMath.h"
+#include <algorithm>
+
+const std::vector<std::size_t>& ObstacleAssociation::near(const Vector2f& center, float radius)
+{
+  candidates.clear();
+  const float radiusSquared = sqr(radius);
+
+  // For only a few entries, checking all of them is cheaper. They are in the order of their indices.
+  if(entries.size() <= maxLinearScanSize)
+  {
+    for(const Entry& entry : entries)
+      if((entry.center - center).squaredNorm() <= radiusSquared)
+        candidates.push_back(entry.index);
+    return candidates;
+  }
+
+  const int xMin = cell(center.x() - radius);
+  const int xMax = cell(center.x() + radius);
+  const int yMin = cell(center.y() - radius);
+  const int yMax = cell(center.y() + radius);
+
+  // If the search area covers more cells than there are entries, checking all entries is cheaper.
+  if((static_cast<float>(xMax) - static_cast<float>(xMin) + 1.f) * (static_cast<float>(yMax) - static_cast<float>(yMin) + 1.f) > static_cast<float>(entries.size()))
+  {
+    for(const Entry& entry : entries)
+      if((entry.center - center).squaredNorm() <= radiusSquared)
+        candidates.push_back(entry.index);
+  }
+  else
+    for(int x = xMin; x <= xMax; ++x)
+      for(int y = yMin; y <= yMax; ++y)
+      {
+        const std::uint64_t cellKey = key(x, y);
+        for(auto entry = std::lower_bound(entries.begin(), entries.end(), cellKey, [](const Entry& entry, std::uint64_t cellKey) {return entry.cell < cellKey;});
+            entry != entries.end() && entry->cell == cellKey; ++entry)
+          if((entry->center - center).squaredNorm() <= radiusSquared)
+            candidates.push_back(entry->index);
+      }
+
+  std::sort(candidates.begin(), candidates.end());
+  return candidates;
+}
+
+void ObstacleAssociation::sortEntries()
+{
+  if(entries.size() > maxLinearScanSize)
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {return a.cell < b.cell || (a.cell == b.cell && a.index < b.index);});
+  positions.resize(entries.size());
+  for(std::size_t i = 0; i < entries.size(); ++i)
+    positions[entries[i].index] = i;
+}
+
+const std::vector<std::size_t>& ObstacleAssociation::assignPairs(std::size_t numOfMeasurements)
+{
+  // Ties are broken by the indices to keep the result independent of the sorting algorithm.
+  std::sort(pairs.begin(), pairs.end(), [](const Pair& a, const Pair& b)
+  {
+    return a.distanceSquared < b.distanceSquared
+           || (a.distanceSquared == b.distanceSquared && (a.measurement < b.measurement || (a.measurement == b.measurement && a.hypothesis < b.hypothesis)));
+  });
+
+  assignment.assign(numOfMeasurements, none);
+  assigned.assign(entries.size(), false);
+  for(const Pair& pair : pairs)
+    if(assignment[pair.measurement] == none && !assigned[pair.hypothesis])
+    {
+      assignment[pair.measurement] = pair.hypothesis;
+      assigned[pair.hypothesis] = true;
+    }
+  return assignment;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file ObstacleAssociation.h
+ *
+ * This file declares a class that associates measurements of obstacles with
+ * obstacle hypotheses. The hypotheses are sorted into a uniform grid, so that
+ * only hypotheses near a measurement are considered. For a few hypotheses,
+ * checking all of them is faster, so the grid is only used for more than
+ * maxLinearScanSize hypotheses. Measurements are assigned
+ * by global nearest neighbour: all gated pairs are assigned in the order of
+ * increasing distance, each measurement and each hypothesis at most once.
+ */
+
+#pragma once
+
+#include "Math/Eigen.h"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+class ObstacleAssociation
+{
+public:
+  static constexpr std::size_t none = std::numeric_limits<std::size_t>::max(); /**< Marks a measurement that was not assigned. */
+  static constexpr std::size_t maxLinearScanSize = 24; /**< Up to this number of hypotheses, all of them are checked instead of using the grid. */
+
+  /**
+   * Constructor.
+   * @param cellSize The edge length of a grid cell (in mm). It should be in the order of the gate radii used.
+   */
+  ObstacleAssociation(float cellSize = 1000.f) : cellSize(cellSize) {}
+
+  /**
+   * Sorts the centers of hypotheses into the grid. This must be called again
+   * whenever hypotheses are added, removed, or moved.
+   * @param hypotheses The hypotheses. Each must have a member "center".
+   */
+  template<typename Hypotheses>
+  void index(const Hypotheses& hypotheses)
+  {
+    entries.clear();
+    const bool useGrid = hypotheses.size() > maxLinearScanSize;
+    for(std::size_t i = 0; i < hypotheses.size(); ++i)
+      entries.push_back({useGrid ? key(hypotheses[i].center) : 0, static_cast<unsigned>(i), hypotheses[i].center});
+    sortEntries();
+  }
+
+  /**
+   * Determines all indexed hypotheses within a radius around a position.
+   * @param center The position.
+   * @param radius The radius.
+   * @return The indices of the hypotheses in ascending order. The vector is reused by the next call.
+   */
+  const std::vector<std::size_t>& near(const Vector2f& center, float radius);
+
+  /**
+   * Assigns measurements to the indexed hypotheses.
+   * @param measurements The measurements. Each must have a member "center".
+   * @param gate A function that returns the gate radius for a measurement.
+   * @return For each measurement the index of the hypothesis assigned or "none". The vector is reused by the next call.
+   */
+  template<typename Measurements, typename Gate>
+  const std::vector<std::size_t>& assign(const Measurements& measurements, const Gate& gate)
+  {
+    pairs.clear();
+    for(std::size_t i = 0; i < measurements.size(); ++i)
+    {
+      const Vector2f& center = measurements[i].center;
+      const float radius = gate(measurements[i]);
+      for(std::size_t hypothesis : near(center, radius))
+        pairs.push_back({i, hypothesis, (center - entryCenter(hypothesis)).squaredNorm()});
+    }
+    return assignPairs(measurements.size());
+  }
+
+private:
+  /** An entry of the grid. */
+  struct Entry
+  {
+    std::uint64_t cell; /**< The key of the cell the hypothesis is in. */
+    unsigned index; /**< The index of the hypothesis. */
+    Vector2f center; /**< The center of the hypothesis. */
+  };
+
+  /** A pair of a measurement and a hypothesis within the gate of the measurement. */
+  struct Pair
+  {
+    std::size_t measurement; /**< The index of the measurement. */
+    std::size_t hypothesis; /**< The index of the hypothesis. */
+    float distanceSquared; /**< The squared distance between both. */
+  };
+
+  float cellSize; /**< The edge length of a grid cell (in mm). */
+  std::vector<Entry> entries; /**< The entries of the grid, sorted by cell and index. */
+  std::vector<std::size_t> positions; /**< The position of each hypothesis in "entries". */
+  std::vector<std::size_t> candidates; /**< The result of near(). */
+  std::vector<Pair> pairs; /**< All gated pairs. */
+  std::vector<std::size_t> assignment; /**< The result of assign(). */
+  std::vector<bool> assigned; /**< Which hypotheses are already assigned? */
+
+  /** Sorts the entries by cell and index if the grid is used and updates "positions". */
+  void sortEntries();
+
+  /**
+   * Assigns the pairs in the order of increasing distance.
+   * @param numOfMeasurements The number of measurements.
+   * @return For each measurement the index of the hypothesis assigned or "none".
+   */
+  const std::vector<std::size_t>& assignPairs(std::size_t numOfMeasurements);
+
+  /** Returns the center of an indexed hypothesis. */
+  const Vector2f& entryCenter(std::size_t hypothesis) const {return entries[positions[hypothesis]].center;}
+
+  /** Returns the key of the cell with the given cell coordinates. */
+  static std::uint64_t key(int x, int y) {return static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32 | static_cast<std::uint32_t>(y);}
+
+  /** Returns the key of the cell that contains a position. */
+  std::uint64_t key(const Vector2f& position) const {return key(cell(position.x()), cell(position.y()));}
+
+  /**
+   * Returns the cell coordinate of a position coordinate. Coordinates far outside of the field
+   * are clamped to a range that can be represented. Not-a-number is mapped to the lower limit.
+   */
+  int cell(float coordinate) const
+  {
+    constexpr float maxCell = static_cast<float>(1 << 30);
+    const float cell = std::floor(coordinate / cellSize);
+    return cell >= maxCell ? static_cast<int>(maxCell) : cell > -maxCell ? static_cast<int>(cell) : -static_cast<int>(maxCell);
+  }
+};
@@ -8,6 +8,7 @@
 
 #include "RobotTrackerUtils.h"
 #include "Debugging/DebugDrawings.h"
+#include <ranges>
 
 Vector4f GlobalRobotTracker::Estimate::measurementModelPercept(const Vector4f& z)
 {
@@ -36,6 +37,14 @@ void GlobalRobotTracker::Estimate::predict(const std::function<void(Vector4f&)>&
   wasSeen = false;
 }
 
+void GlobalRobotTracker::Estimate::predict(std::vector<Estimate>& estimates, const std::function<void(Vector4f&)>& dynamicModel, const Matrix4f& noise)
+{
+  auto filters = std::views::transform(estimates, [](Estimate& estimate) -> FixedUKF<4>& {return estimate.kf;});
+  FixedUKF<4>::predict(filters, dynamicModel, noise);
+  for(Estimate& estimate : estimates)
+    estimate.wasSeen = false;
+}
+
 bool GlobalRobotTracker::Robot::cleanup()
 {
   //if there is only one or none estimate then return true
@@ -21,7 +21,7 @@ namespace GlobalRobotTracker
   // Todo: find a better name
   class Estimate
   {
-    UKF<4> kf;              // filter for position and velocity
+    FixedUKF<4> kf;         // filter for position and velocity
 
     bool isPercept;         // only differentiate here between percepts and estimates that are modeled over time allows us to threat own percepts and estimates send by out teammates the same way further up
 
@@ -69,6 +69,12 @@ namespace GlobalRobotTracker
      */
     void predict(const std::function<void(Vector4f&)>& dynamicModel, const Matrix4f& noise);
 
+    /**
+     * calls the batch predict method of the UKF for all given estimates
+     * resets wasSeen of all of them
+     */
+    static void predict(std::vector<Estimate>& estimates, const std::function<void(Vector4f&)>& dynamicModel, const Matrix4f& noise);
+
     // can in combination with the expected observations and the game controller information be used to determine if this robot is penalized
     bool hasNewMeasurement() const
     {
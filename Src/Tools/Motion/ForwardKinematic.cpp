@@ -14,9 +14,16 @@
 #include "Math/Rotation.h"
 #include "Framework/Settings.h"
 #include "Streaming/Global.h"
+#include <array>
 
 void ForwardKinematic::calculateArmChain(Arms::Arm arm, const JointAngles& joints, const RobotDimensions& robotDimensions,
                                          ENUM_INDEXED_ARRAY(SE3WithCov, Limbs::Limb)& limbs)
+{
+  calculateArmChain(arm, joints, robotDimensions, limbs, Global::getSettings().robotType);
+}
+
+void ForwardKinematic::calculateArmChain(Arms::Arm arm, const JointAngles& joints, const RobotDimensions& robotDimensions,
+                                         ENUM_INDEXED_ARRAY(SE3WithCov, Limbs::Limb)& limbs, Settings::RobotType robotType)
 {
   const int sign = arm == Arms::left ? 1 : -1;
   Limbs::Limb shoulderLimb = arm == Arms::left ? Limbs::shoulderLeft : Limbs::shoulderRight;
@@ -31,7 +38,7 @@ void ForwardKinematic::calculateArmChain(Arms::Arm arm, const JointAngles& joint
   shoulder = SE3WithCov(Pose3f(robotDimensions.armOffset.x(), robotDimensions.armOffset.y() * sign, robotDimensions.armOffset.z())) *= SE3WithCov(
                RotationMatrix::aroundY(joints.angles[shoulderJoint]), Vector3f(0.f, joints.variance[shoulderJoint], 0.f).asDiagonal());
 
-  switch(Global::getSettings().robotType)
+  switch(robotType)
   {
     case Settings::nao:
       biceps = shoulder *
@@ -56,6 +63,12 @@ void ForwardKinematic::calculateArmChain(Arms::Arm arm, const JointAngles& joint
 
 void ForwardKinematic::calculateLegChain(Legs::Leg leg, const JointAngles& joints, const RobotDimensions& robotDimensions,
                                          ENUM_INDEXED_ARRAY(SE3WithCov, Limbs::Limb)& limbs)
+{
+  calculateLegChain(leg, joints, robotDimensions, limbs, Global::getSettings().robotType);
+}
+
+void ForwardKinematic::calculateLegChain(Legs::Leg leg, const JointAngles& joints, const RobotDimensions& robotDimensions,
+                                         ENUM_INDEXED_ARRAY(SE3WithCov, Limbs::Limb)& limbs, Settings::RobotType robotType)
 {
   const int sign = leg == Legs::left ? 1 : -1;
   Limbs::Limb pelvisLimb = leg == Legs::left ? Limbs::pelvisLeft : Limbs::pelvisRight;
@@ -69,7 +82,7 @@ void ForwardKinematic::calculateLegChain(Legs::Leg leg, const JointAngles& joint
   SE3WithCov& ankle = limbs[pelvisLimb + 4];
   SE3WithCov& foot = limbs[pelvisLimb + 5];
 
-  switch(Global::getSettings().robotType)
+  switch(robotType)
   {
     case Settings::nao:
       pelvis = SE3WithCov(Pose3f(0.f, robotDimensions.yHipOffset * sign, 0.f)) *
@@ -103,3 +116,46 @@ void ForwardKinematic::calculateHeadChain(const JointAngles& joints, const Robot
   limbs[Limbs::head] = limbs[Limbs::neck] * SE3WithCov(RotationMatrix::aroundY(joints.angles[Joints::headPitch]),
                                                        Vector3f(0.f, joints.variance[Joints::headPitch], 0.f).asDiagonal());
 }
+
+Matrix6f ForwardKinematic::calculateLegJacobian(Legs::Leg leg, const ENUM_INDEXED_ARRAY(SE3WithCov, Limbs::Limb)& limbs,
+                                                const RobotDimensions& robotDimensions, Settings::RobotType robotType)
+{
+  const int sign = leg == Legs::left ? 1 : -1;
+  const Limbs::Limb pelvisLimb = leg == Legs::left ? Limbs::pelvisLeft : Limbs::pelvisRight;
+  const Pose3f& pelvis = limbs[pelvisLimb];
+  const Pose3f& hip = limbs[pelvisLimb + 1];
+  const Pose3f& thigh = limbs[pelvisLimb + 2];
+  const Pose3f& tibia = limbs[pelvisLimb + 3];
+  const Pose3f& ankle = limbs[pelvisLimb + 4];
+  const Pose3f& foot = limbs[pelvisLimb + 5];
+  const Vector3f sole = foot * Vector3f(0.f, 0.f, -robotDimensions.footHeight);
+
+  // Each joint rotates around an axis of the limb it moves. The joint lies in the origin of that limb.
+  std::array<const Pose3f*, Joints::numOfLegJoints> frames;
+  std::array<Vector3f, Joints::numOfLegJoints> axes;
+  switch(robotType)
+  {
+    case Settings::nao:
+      frames = {&pelvis, &hip, &thigh, &tibia, &ankle, &foot};
+      axes[Joints::hipYawPitch] = RotationMatrix::aroundX(pi_4 * sign) * Vector3f(0.f, 0.f, static_cast<float>(-sign));
+      axes[Joints::hipRoll] = hip.rotation.col(0);
+      axes[Joints::hipPitch] = thigh.rotation.col(1);
+      break;
+    default:
+      frames = {&thigh, &hip, &pelvis, &tibia, &ankle, &foot};
+      axes[Joints::hipYaw] = thigh.rotation.col(2);
+      axes[Joints::hipRoll] = hip.rotation.col(0);
+      axes[Joints::hipPitch] = pelvis.rotation.col(1);
+  }
+  axes[Joints::kneePitch] = tibia.rotation.col(1);
+  axes[Joints::anklePitch] = ankle.rotation.col(1);
+  axes[Joints::ankleRoll] = foot.rotation.col(0);
+
+  Matrix6f jacobian;
+  for(int i = 0; i < Joints::numOfLegJoints; ++i)
+  {
+    jacobian.block<3, 1>(0, i) = axes[i].cross(sole - frames[i]->translation);
+    jacobian.block<3, 1>(3, i) = axes[i];
+  }
+  return jacobian;
+}
@@ -6,8 +6,11 @@
 
 #pragma once
 
+#include "Framework/Settings.h"
+#include "Math/Eigen.h"
 #include "Streaming/EnumIndexedArray.h"
 #include "RobotParts/Arms.h"
+#include "RobotParts/Legs.h"
 #include "RobotParts/Limbs.h"
 
 struct JointAngles;
@@ -17,8 +20,26 @@ struct RobotDimensions;
 namespace ForwardKinematic
 {
   void calculateArmChain(Arms::Arm arm, const JointAngles& joints, const RobotDimensions& robotDimensions, ENUM_INDEXED_ARRAY(SE3WithCov, Limbs::Limb)& limbs);
+  void calculateArmChain(Arms::Arm arm, const JointAngles& joints, const RobotDimensions& robotDimensions, ENUM_INDEXED_ARRAY(SE3WithCov, Limbs::Limb)& limbs,
+                         Settings::RobotType robotType);
 
   void calculateLegChain(Legs::Leg leg, const JointAngles& joints, const RobotDimensions& robotDimensions, ENUM_INDEXED_ARRAY(SE3WithCov, Limbs::Limb)& limbs);
+  void calculateLegChain(Legs::Leg leg, const JointAngles& joints, const RobotDimensions& robotDimensions, ENUM_INDEXED_ARRAY(SE3WithCov, Limbs::Limb)& limbs,
+                         Settings::RobotType robotType);
 
   void calculateHeadChain(const JointAngles& joints, const RobotDimensions& robotDimensions, ENUM_INDEXED_ARRAY(SE3WithCov, Limbs::Limb)& limbs);
+
+  /**
+   * Computes the Jacobian of the sole of a leg with respect to the joints of that leg
+   * from the limb poses previously computed by calculateLegChain.
+   * @param leg The leg.
+   * @param limbs The limb poses of the current joint angles.
+   * @param robotDimensions The dimensions of the robot.
+   * @param robotType The robot type the limb poses were computed for.
+   * @return The Jacobian. The first three rows map the joint velocities (in the order of
+   *         Joints::LegJoint) to the translational velocity of the sole (in mm/s), the last
+   *         three rows to its angular velocity, both relative to the robot's origin.
+   */
+  Matrix6f calculateLegJacobian(Legs::Leg leg, const ENUM_INDEXED_ARRAY(SE3WithCov, Limbs::Limb)& limbs, const RobotDimensions& robotDimensions,
+                                Settings::RobotType robotType);
 };
@@ -9,135 +9,250 @@
 
 #include "InverseDynamic.h"
 #include "Math/Constants.h"
+#include "Platform/BHAssert.h"
 #include "Streaming/Global.h"
-#include <ranges>
 
-std::array<std::vector<InverseDynamic::Node>, Settings::numOfRobotTypes> InverseDynamic::generateKinematicTree()
+void InverseDynamic::KinematicTree::add(Joints::Joint joint, Limbs::Limb parent, Limbs::Limb child, const Vector3f& axis)
 {
-  std::array<std::vector<Node>, Settings::numOfRobotTypes> tree;
-  tree[Settings::nao] =
-  {
-    {Joints::headYaw, Limbs::torso, Limbs::neck},
-    {Joints::headPitch, Limbs::neck, Limbs::head},
-    {Joints::lShoulderPitch, Limbs::torso, Limbs::shoulderLeft},
-    {Joints::lShoulderRoll, Limbs::shoulderLeft, Limbs::bicepsLeft},
-    {Joints::lElbowYaw, Limbs::bicepsLeft, Limbs::elbowLeft},
-    {Joints::lElbowRoll, Limbs::elbowLeft, Limbs::foreArmLeft},
-    {Joints::lWristYaw, Limbs::foreArmLeft, Limbs::wristLeft},
-    {Joints::rShoulderPitch, Limbs::torso, Limbs::shoulderRight},
-    {Joints::rShoulderRoll, Limbs::shoulderRight, Limbs::bicepsRight},
-    {Joints::rElbowYaw, Limbs::bicepsRight, Limbs::elbowRight},
-    {Joints::rElbowRoll, Limbs::elbowRight, Limbs::foreArmRight},
-    {Joints::rWristYaw, Limbs::foreArmRight, Limbs::wristRight},
-    {Joints::lHipYawPitch, Limbs::torso, Limbs::pelvisLeft},
-    {Joints::lHipRoll, Limbs::pelvisLeft, Limbs::hipLeft},
-    {Joints::lHipPitch, Limbs::hipLeft, Limbs::thighLeft},
-    {Joints::lKneePitch, Limbs::thighLeft, Limbs::tibiaLeft},
-    {Joints::lAnklePitch, Limbs::tibiaLeft, Limbs::ankleLeft},
-    {Joints::lAnkleRoll, Limbs::ankleLeft, Limbs::footLeft},
-    {Joints::rHipYawPitch, Limbs::torso, Limbs::pelvisRight},
-    {Joints::rHipRoll, Limbs::pelvisRight, Limbs::hipRight},
-    {Joints::rHipPitch, Limbs::hipRight, Limbs::thighRight},
-    {Joints::rKneePitch, Limbs::thighRight, Limbs::tibiaRight},
-    {Joints::rAnklePitch, Limbs::tibiaRight, Limbs::ankleRight},
-    {Joints::rAnkleRoll, Limbs::ankleRight, Limbs::footRight},
-  };
-  tree[Settings::t1] =
+  int parentNode = numOfNodes - 1;
+  while(parentNode >= 0 && nodes[parentNode].child != parent)
+    --parentNode;
+  ASSERT(parentNode >= 0 || parent == Limbs::torso);
+  nodes[numOfNodes++] = {joint, parent, child, parentNode, axis};
+}
+
+std::array<InverseDynamic::KinematicTree, Settings::numOfRobotTypes> InverseDynamic::generateKinematicTree()
+{
+  const Vector3f x = Vector3f::UnitX();
+  const Vector3f y = Vector3f::UnitY();
+  const Vector3f z = Vector3f::UnitZ();
+
+  std::array<KinematicTree, Settings::numOfRobotTypes> tree;
+  FOREACH_ENUM(Settings::RobotType, robotType)
   {
-    {Joints::headYaw, Limbs::torso, Limbs::neck},
-    {Joints::headPitch, Limbs::neck, Limbs::head},
-    {Joints::lShoulderPitch, Limbs::torso, Limbs::shoulderLeft},
-    {Joints::lShoulderRoll, Limbs::shoulderLeft, Limbs::bicepsLeft},
-    {Joints::lElbowYaw, Limbs::bicepsLeft, Limbs::elbowLeft},
-    {Joints::lElbowRoll, Limbs::elbowLeft, Limbs::foreArmLeft},
-    {Joints::rShoulderPitch, Limbs::torso, Limbs::shoulderRight},
-    {Joints::rShoulderRoll, Limbs::shoulderRight, Limbs::bicepsRight},
-    {Joints::rElbowYaw, Limbs::bicepsRight, Limbs::elbowRight},
-    {Joints::rElbowRoll, Limbs::elbowRight, Limbs::foreArmRight},
-    {Joints::waistYaw, Limbs::torso, Limbs::waist},
-    {Joints::lHipPitch, Limbs::waist, Limbs::pelvisLeft},
-    {Joints::lHipRoll, Limbs::pelvisLeft, Limbs::hipLeft},
-    {Joints::lHipYaw, Limbs::hipLeft, Limbs::thighLeft},
-    {Joints::lKneePitch, Limbs::thighLeft, Limbs::tibiaLeft},
-    {Joints::lAnklePitch, Limbs::tibiaLeft, Limbs::ankleLeft},
-    {Joints::lAnkleRoll, Limbs::ankleLeft, Limbs::footLeft},
-    {Joints::rHipPitch, Limbs::waist, Limbs::pelvisRight},
-    {Joints::rHipRoll, Limbs::pelvisRight, Limbs::hipRight},
-    {Joints::rHipYaw, Limbs::hipRight, Limbs::thighRight},
-    {Joints::rKneePitch, Limbs::thighRight, Limbs::tibiaRight},
-    {Joints::rAnklePitch, Limbs::tibiaRight, Limbs::ankleRight},
-    {Joints::rAnkleRoll, Limbs::ankleRight, Limbs::footRight},
-  };
-
-  tree[Settings::k1] =
+    tree[robotType].add(Joints::headYaw, Limbs::torso, Limbs::neck, z);
+    tree[robotType].add(Joints::headPitch, Limbs::neck, Limbs::head, y);
+  }
+
+  tree[Settings::nao].add(Joints::lShoulderPitch, Limbs::torso, Limbs::shoulderLeft, y);
+  tree[Settings::nao].add(Joints::lShoulderRoll, Limbs::shoulderLeft, Limbs::bicepsLeft, z);
+  tree[Settings::nao].add(Joints::lElbowYaw, Limbs::bicepsLeft, Limbs::elbowLeft, x);
+  tree[Settings::nao].add(Joints::lElbowRoll, Limbs::elbowLeft, Limbs::foreArmLeft, z);
+  tree[Settings::nao].add(Joints::lWristYaw, Limbs::foreArmLeft, Limbs::wristLeft, x);
+  tree[Settings::nao].add(Joints::rShoulderPitch, Limbs::torso, Limbs::shoulderRight, y);
+  tree[Settings::nao].add(Joints::rShoulderRoll, Limbs::shoulderRight, Limbs::bicepsRight, z);
+  tree[Settings::nao].add(Joints::rElbowYaw, Limbs::bicepsRight, Limbs::elbowRight, x);
+  tree[Settings::nao].add(Joints::rElbowRoll, Limbs::elbowRight, Limbs::foreArmRight, z);
+  tree[Settings::nao].add(Joints::rWristYaw, Limbs::foreArmRight, Limbs::wristRight, x);
+  tree[Settings::nao].add(Joints::lHipYawPitch, Limbs::torso, Limbs::pelvisLeft, Vector3f(0.f, std::sqrt(0.5f), -std::sqrt(0.5f)));
+  tree[Settings::nao].add(Joints::lHipRoll, Limbs::pelvisLeft, Limbs::hipLeft, x);
+  tree[Settings::nao].add(Joints::lHipPitch, Limbs::hipLeft, Limbs::thighLeft, y);
+  tree[Settings::nao].add(Joints::lKneePitch, Limbs::thighLeft, Limbs::tibiaLeft, y);
+  tree[Settings::nao].add(Joints::lAnklePitch, Limbs::tibiaLeft, Limbs::ankleLeft, y);
+  tree[Settings::nao].add(Joints::lAnkleRoll, Limbs::ankleLeft, Limbs::footLeft, x);
+  tree[Settings::nao].add(Joints::rHipYawPitch, Limbs::torso, Limbs::pelvisRight, Vector3f(0.f, std::sqrt(0.5f), std::sqrt(0.5f)));
+  tree[Settings::nao].add(Joints::rHipRoll, Limbs::pelvisRight, Limbs::hipRight, x);
+  tree[Settings::nao].add(Joints::rHipPitch, Limbs::hipRight, Limbs::thighRight, y);
+  tree[Settings::nao].add(Joints::rKneePitch, Limbs::thighRight, Limbs::tibiaRight, y);
+  tree[Settings::nao].add(Joints::rAnklePitch, Limbs::tibiaRight, Limbs::ankleRight, y);
+  tree[Settings::nao].add(Joints::rAnkleRoll, Limbs::ankleRight, Limbs::footRight, x);
+
+  // The Booster robots share arms and legs. Only the T1 has a waist. The legs of the K1 are attached to its torso.
+  for(Settings::RobotType robotType : {Settings::t1, Settings::k1})
   {
-    {Joints::headYaw, Limbs::torso, Limbs::neck},
-    {Joints::headPitch, Limbs::neck, Limbs::head},
-    {Joints::lShoulderPitch, Limbs::torso, Limbs::shoulderLeft},
-    {Joints::lShoulderRoll, Limbs::shoulderLeft, Limbs::bicepsLeft},
-    {Joints::lElbowYaw, Limbs::bicepsLeft, Limbs::elbowLeft},
-    {Joints::lElbowRoll, Limbs::elbowLeft, Limbs::foreArmLeft},
-    {Joints::rShoulderPitch, Limbs::torso, Limbs::shoulderRight},
-    {Joints::rShoulderRoll, Limbs::shoulderRight, Limbs::bicepsRight},
-    {Joints::rElbowYaw, Limbs::bicepsRight, Limbs::elbowRight},
-    {Joints::rElbowRoll, Limbs::elbowRight, Limbs::foreArmRight},
-    {Joints::lHipPitch, Limbs::waist, Limbs::pelvisLeft},
-    {Joints::lHipRoll, Limbs::pelvisLeft, Limbs::hipLeft},
-    {Joints::lHipYaw, Limbs::hipLeft, Limbs::thighLeft},
-    {Joints::lKneePitch, Limbs::thighLeft, Limbs::tibiaLeft},
-    {Joints::lAnklePitch, Limbs::tibiaLeft, Limbs::ankleLeft},
-    {Joints::lAnkleRoll, Limbs::ankleLeft, Limbs::footLeft},
-    {Joints::rHipPitch, Limbs::waist, Limbs::pelvisRight},
-    {Joints::rHipRoll, Limbs::pelvisRight, Limbs::hipRight},
-    {Joints::rHipYaw, Limbs::hipRight, Limbs::thighRight},
-    {Joints::rKneePitch, Limbs::thighRight, Limbs::tibiaRight},
-    {Joints::rAnklePitch, Limbs::tibiaRight, Limbs::ankleRight},
-    {Joints::rAnkleRoll, Limbs::ankleRight, Limbs::footRight},
-  };
+    const Limbs::Limb hipBase = robotType == Settings::t1 ? Limbs::waist : Limbs::torso;
+    tree[robotType].add(Joints::lShoulderPitch, Limbs::torso, Limbs::shoulderLeft, y);
+    tree[robotType].add(Joints::lShoulderRoll, Limbs::shoulderLeft, Limbs::bicepsLeft, x);
+    tree[robotType].add(Joints::lElbowYaw, Limbs::bicepsLeft, Limbs::elbowLeft, y);
+    tree[robotType].add(Joints::lElbowRoll, Limbs::elbowLeft, Limbs::foreArmLeft, z);
+    tree[robotType].add(Joints::rShoulderPitch, Limbs::torso, Limbs::shoulderRight, y);
+    tree[robotType].add(Joints::rShoulderRoll, Limbs::shoulderRight, Limbs::bicepsRight, x);
+    tree[robotType].add(Joints::rElbowYaw, Limbs::bicepsRight, Limbs::elbowRight, y);
+    tree[robotType].add(Joints::rElbowRoll, Limbs::elbowRight, Limbs::foreArmRight, z);
+    if(robotType == Settings::t1)
+      tree[robotType].add(Joints::waistYaw, Limbs::torso, Limbs::waist, z);
+    tree[robotType].add(Joints::lHipPitch, hipBase, Limbs::pelvisLeft, y);
+    tree[robotType].add(Joints::lHipRoll, Limbs::pelvisLeft, Limbs::hipLeft, x);
+    tree[robotType].add(Joints::lHipYaw, Limbs::hipLeft, Limbs::thighLeft, z);
+    tree[robotType].add(Joints::lKneePitch, Limbs::thighLeft, Limbs::tibiaLeft, y);
+    tree[robotType].add(Joints::lAnklePitch, Limbs::tibiaLeft, Limbs::ankleLeft, y);
+    tree[robotType].add(Joints::lAnkleRoll, Limbs::ankleLeft, Limbs::footLeft, x);
+    tree[robotType].add(Joints::rHipPitch, hipBase, Limbs::pelvisRight, y);
+    tree[robotType].add(Joints::rHipRoll, Limbs::pelvisRight, Limbs::hipRight, x);
+    tree[robotType].add(Joints::rHipYaw, Limbs::hipRight, Limbs::thighRight, z);
+    tree[robotType].add(Joints::rKneePitch, Limbs::thighRight, Limbs::tibiaRight, y);
+    tree[robotType].add(Joints::rAnklePitch, Limbs::tibiaRight, Limbs::ankleRight, y);
+    tree[robotType].add(Joints::rAnkleRoll, Limbs::ankleRight, Limbs::footRight, x);
+  }
   return tree;
 }
 
-std::array<std::vector<InverseDynamic::Node>, Settings::numOfRobotTypes> InverseDynamic::kinematicTree = generateKinematicTree();
+const std::array<InverseDynamic::KinematicTree, Settings::numOfRobotTypes> InverseDynamic::kinematicTree = generateKinematicTree();
+
+void InverseDynamic::calculateJointTorques(JointDynamics& jointDynamics, const Vector3f& gravityInTorso, const RobotDimensions& robotDimensions, const MassCalibration& massCalibration,
+                                           Settings::RobotType robotType, bool useVelocities, bool useAccelerations)
+{
+  calculate(jointDynamics, nullptr, gravityInTorso, robotDimensions, massCalibration, robotType, useVelocities, useAccelerations);
+}
 
 void InverseDynamic::calculateJointTorques(JointDynamics& jointDynamics, const Vector3f& gravityInTorso, const RobotDimensions& robotDimensions, const MassCalibration& massCalibration)
 {
-  std::array<Body, Limbs::numOfLimbs> bodies;
+  calculate(jointDynamics, nullptr, gravityInTorso, robotDimensions, massCalibration, Global::getSettings().robotType, true, true);
+}
 
-  calculateHeadPoses(bodies, jointDynamics, robotDimensions);
-  calculateArmPoses(bodies, jointDynamics, robotDimensions, true);
-  calculateArmPoses(bodies, jointDynamics, robotDimensions, false);
-  calculateLegPoses(bodies, jointDynamics, robotDimensions, true);
-  calculateLegPoses(bodies, jointDynamics, robotDimensions, false);
+void InverseDynamic::calculateDynamics(JointDynamics& jointDynamics, Dynamics& dynamics, const Vector3f& gravityInTorso, const RobotDimensions& robotDimensions,
+                                       const MassCalibration& massCalibration, Settings::RobotType robotType, bool useVelocities, bool useAccelerations)
+{
+  calculate(jointDynamics, &dynamics, gravityInTorso, robotDimensions, massCalibration, robotType, useVelocities, useAccelerations);
+}
 
-  for(Body& body : bodies)
-    body.parentInBody = body.bodyInParent.inverse();
+void InverseDynamic::calculateDynamics(JointDynamics& jointDynamics, Dynamics& dynamics, const Vector3f& gravityInTorso, const RobotDimensions& robotDimensions,
+                                       const MassCalibration& massCalibration)
+{
+  calculate(jointDynamics, &dynamics, gravityInTorso, robotDimensions, massCalibration, Global::getSettings().robotType, true, true);
+}
 
-  bodies[Limbs::torso].v = SpatialVector3f<true>();
-  bodies[Limbs::torso].a = SpatialVector3f<true>(Vector3f::Zero(), gravityInTorso);
-  bodies[Limbs::torso].f = SpatialVector3f<true>::applyInertia(massCalibration.masses[Limbs::torso], bodies[Limbs::torso].a);
+void InverseDynamic::calculate(JointDynamics& jointDynamics, Dynamics* dynamics, const Vector3f& gravityInTorso, const RobotDimensions& robotDimensions,
+                               const MassCalibration& massCalibration, Settings::RobotType robotType, bool useVelocities, bool useAccelerations)
+{
+  const KinematicTree& tree = kinematicTree[robotType];
+  Bodies bodies;
+
+  calculateHeadPoses(bodies, jointDynamics, robotDimensions);
+  calculateArmPoses(bodies, jointDynamics, robotDimensions, robotType, true);
+  calculateArmPoses(bodies, jointDynamics, robotDimensions, robotType, false);
+  calculateLegPoses(bodies, jointDynamics, robotDimensions, robotType, true);
+  calculateLegPoses(bodies, jointDynamics, robotDimensions, robotType, false);
+
+  // If the mass matrix is calculated, the joint accelerations are applied through it. Without
+  // velocities, the remaining forces are the ones caused by gravity alone.
+  const bool useBodyAccelerations = useAccelerations && !dynamics;
+  const bool separateGravity = dynamics && useVelocities;
+
+  Body& torso = bodies[Limbs::torso];
+  torso.v = SpatialVector3f<true>();
+  torso.a = SpatialVector3f<true>(Vector3f::Zero(), gravityInTorso);
+  torso.f = SpatialVector3f<true>::applyInertia(massCalibration.masses[Limbs::torso], torso.a);
+  torso.aGravity = torso.a;
+
+  // Forward pass: velocities, accelerations and the resulting forces of all bodies.
+  for(int i = 0; i < tree.numOfNodes; ++i)
+  {
+    const Node& node = tree.nodes[i];
+    const Body& parent = bodies[node.parent];
+    Body& body = bodies[node.child];
+    const MassCalibration::MassInfo& massInfo = massCalibration.masses[node.child];
+
+    body.a = toBody(body.bodyInParent, parent.a);
+    if(useBodyAccelerations)
+      body.a.angular += node.axis * jointDynamics.accelerations[node.joint];
+    if(useVelocities)
+    {
+      const SpatialVector3f<true> vj(node.axis * jointDynamics.velocities[node.joint], Vector3f::Zero());
+      body.v = toBody(body.bodyInParent, parent.v) + vj;
+      body.a += body.v.cross(vj);
+      body.f = SpatialVector3f<true>::applyInertia(massInfo, body.a) + body.v.cross(SpatialVector3f<true>::applyInertia(massInfo, body.v));
+    }
+    else
+      body.f = SpatialVector3f<true>::applyInertia(massInfo, body.a);
 
-  for(const Node& node : kinematicTree[Global::getSettings().robotType])
-    forward(bodies, jointDynamics, massCalibration, node);
+    if(dynamics)
+    {
+      if(separateGravity)
+      {
+        body.aGravity = toBody(body.bodyInParent, parent.aGravity);
+        body.fGravity = SpatialVector3f<true>::applyInertia(massInfo, body.aGravity);
+      }
+      body.compositeMass = massInfo.mass;
+      body.compositeMassMoment = massInfo.mass * massInfo.offset;
+      body.compositeInertia = massInfo.inertiaMatrix;
+    }
+  }
 
   jointDynamics.torques.fill(0.f);
-  for(const Node& node : kinematicTree[Global::getSettings().robotType] | std::views::reverse)
-    backward(bodies, jointDynamics, node);
+  if(dynamics)
+  {
+    dynamics->massMatrix.setZero();
+    dynamics->gravityTorques.setZero();
+  }
+
+  // Backward pass: torques, forces propagated to the root and composite inertias.
+  for(int i = tree.numOfNodes - 1; i >= 0; --i)
+  {
+    const Node& node = tree.nodes[i];
+    const Body& body = bodies[node.child];
+    Body& parent = bodies[node.parent];
+
+    jointDynamics.torques[node.joint] += node.axis.dot(body.f.angular);
+    parent.f += SpatialVector3f<false>::applyPose3f(body.bodyInParent, body.f);
+
+    if(!dynamics)
+      continue;
+
+    if(separateGravity)
+    {
+      dynamics->gravityTorques(node.joint) += node.axis.dot(body.fGravity.angular);
+      parent.fGravity += SpatialVector3f<false>::applyPose3f(body.bodyInParent, body.fGravity);
+    }
+
+    // All children were already added to the composite inertia of this body. The force required to accelerate
+    // it around the joint's axis is propagated to the root to get the column of the mass matrix.
+    SpatialVector3f<false> force(body.compositeInertia * node.axis, node.axis.cross(body.compositeMassMoment));
+    dynamics->massMatrix(node.joint, node.joint) = node.axis.dot(force.angular);
+    Limbs::Limb limb = node.child;
+    for(int j = node.parentNode; j >= 0; j = tree.nodes[j].parentNode)
+    {
+      const Node& ancestor = tree.nodes[j];
+      force = SpatialVector3f<false>::applyPose3f(bodies[limb].bodyInParent, force);
+      limb = ancestor.child;
+      dynamics->massMatrix(node.joint, ancestor.joint) = dynamics->massMatrix(ancestor.joint, node.joint) = ancestor.axis.dot(force.angular);
+    }
+
+    // Add the composite inertia of this body to its parent's, which is not needed for the fixed torso.
+    if(node.parentNode >= 0)
+    {
+      const Matrix3f& rotation = body.bodyInParent.rotation;
+      const Vector3f& translation = body.bodyInParent.translation;
+      const Vector3f massMoment = rotation * body.compositeMassMoment;
+      parent.compositeInertia += rotation * body.compositeInertia * rotation.transpose()
+                                 + (2.f * translation.dot(massMoment) + body.compositeMass * translation.squaredNorm()) * Matrix3f::Identity()
+                                 - massMoment * translation.transpose() - translation * massMoment.transpose()
+                                 - body.compositeMass * translation * translation.transpose();
+      parent.compositeMassMoment += massMoment + body.compositeMass * translation;
+      parent.compositeMass += body.compositeMass;
+    }
+  }
+
+  if(dynamics)
+  {
+    dynamics->biasTorques = Eigen::Map<const JointVector>(jointDynamics.torques.data());
+    if(!separateGravity)
+      dynamics->gravityTorques = dynamics->biasTorques;
+    if(useAccelerations)
+      for(int i = 0; i < tree.numOfNodes; ++i)
+        for(int j = 0; j < tree.numOfNodes; ++j)
+          jointDynamics.torques[tree.nodes[i].joint] += dynamics->massMatrix(tree.nodes[i].joint, tree.nodes[j].joint) * jointDynamics.accelerations[tree.nodes[j].joint];
+  }
+}
+
+SpatialVector3f<true> InverseDynamic::toBody(const Pose3f& bodyInParent, const SpatialVector3f<true>& vector)
+{
+  return SpatialVector3f<true>(bodyInParent.rotation.transpose() * vector.angular,
+                               bodyInParent.rotation.transpose() * (vector.linear - bodyInParent.translation.cross(vector.angular)));
 }
 
-void InverseDynamic::calculateHeadPoses(std::array<Body, Limbs::numOfLimbs>& bodies, const JointDynamics& jointDynamics, const RobotDimensions& robotDimensions)
+void InverseDynamic::calculateHeadPoses(Bodies& bodies, const JointDynamics& jointDynamics, const RobotDimensions& robotDimensions)
 {
   // neck in torso
   bodies[Limbs::neck].bodyInParent = Pose3f(RotationMatrix::aroundZ(jointDynamics.angles[Joints::headYaw]),
                                             robotDimensions.hipToNeckOffset);
-  bodies[Limbs::neck].mode = SpatialVector3f<true>(Vector3f(0.0f, 0.0f, 1.0f), Vector3f::Zero());
 
   // head in neck
   bodies[Limbs::head].bodyInParent = Pose3f(RotationMatrix::aroundY(jointDynamics.angles[Joints::headPitch]),
                                             Vector3f::Zero());
-  bodies[Limbs::head].mode = SpatialVector3f<true>(Vector3f(0.0f, 1.0f, 0.0f), Vector3f::Zero());
 }
 
-void InverseDynamic::calculateArmPoses(std::array<Body, Limbs::numOfLimbs>& bodies, const JointDynamics& jointDynamics, const RobotDimensions& robotDimensions, bool left)
+void InverseDynamic::calculateArmPoses(Bodies& bodies, const JointDynamics& jointDynamics, const RobotDimensions& robotDimensions, Settings::RobotType robotType, bool left)
 {
   const float sign = left ? 1.f : -1.f;
   const Limbs::Limb shoulder = left ? Limbs::shoulderLeft : Limbs::shoulderRight;
@@ -146,132 +261,100 @@ void InverseDynamic::calculateArmPoses(std::array<Body, Limbs::numOfLimbs>& bodi
   // shoulder in torso
   bodies[shoulder].bodyInParent = Pose3f(RotationMatrix::aroundY(jointDynamics.angles[arm0]),
                                          Vector3f(robotDimensions.armOffset.x(), robotDimensions.armOffset.y() * sign, robotDimensions.armOffset.z()));
-  bodies[shoulder].mode = SpatialVector3f<true>(Vector3f(0.f, 1.f, 0.f), Vector3f::Zero());
 
-  switch(Global::getSettings().robotType)
+  switch(robotType)
   {
     case Settings::nao:
       // biceps in shoulder
       bodies[shoulder + 1].bodyInParent = Pose3f(RotationMatrix::aroundZ(jointDynamics.angles[arm0 + 1]),
                                                  Vector3f::Zero());
-      bodies[shoulder + 1].mode = SpatialVector3f<true>(Vector3f(0.f, 0.f, 1.f), Vector3f::Zero());
 
       // elbow in biceps
       bodies[shoulder + 2].bodyInParent = Pose3f(RotationMatrix::aroundX(jointDynamics.angles[arm0 + 2]),
                                                  Vector3f(robotDimensions.upperArmLength, robotDimensions.yOffsetElbowToShoulder * sign, 0.f));
-      bodies[shoulder + 2].mode = SpatialVector3f<true>(Vector3f(1.f, 0.f, 0.f), Vector3f::Zero());
 
       // foreArm in elbow
       bodies[shoulder + 3].bodyInParent = Pose3f(RotationMatrix::aroundZ(jointDynamics.angles[arm0 + 3]),
                                                  Vector3f::Zero());
-      bodies[shoulder + 3].mode = SpatialVector3f<true>(Vector3f(0.f, 0.f, 1.f), Vector3f::Zero());
 
       // wrist in foreArm
       bodies[shoulder + 4].bodyInParent = Pose3f(RotationMatrix::aroundX(jointDynamics.angles[arm0 + 4]),
                                                  Vector3f(robotDimensions.xOffsetElbowToWrist, 0.f, 0.f));
-      bodies[shoulder + 4].mode = SpatialVector3f<true>(Vector3f(1.f, 0.f, 0.f), Vector3f::Zero());
       break;
     case Settings::t1:
     case Settings::k1:
       // biceps in shoulder
       bodies[shoulder + 1].bodyInParent = Pose3f(RotationMatrix::aroundX(jointDynamics.angles[arm0 + 1]),
                                                  Vector3f::Zero());
-      bodies[shoulder + 1].mode = SpatialVector3f<true>(Vector3f(1.f, 0.f, 0.f), Vector3f::Zero());
 
       // elbow in biceps
       bodies[shoulder + 2].bodyInParent = Pose3f(RotationMatrix::aroundY(jointDynamics.angles[arm0 + 2]),
                                                  Vector3f(0.f, robotDimensions.upperArmLength * sign, 0.f));
-      bodies[shoulder + 2].mode = SpatialVector3f<true>(Vector3f(0.f, 1.f, 0.f), Vector3f::Zero());
 
       // foreArm in elbow
       bodies[shoulder + 3].bodyInParent = Pose3f(RotationMatrix::aroundZ(jointDynamics.angles[arm0 + 3]),
                                                  Vector3f::Zero());
-      bodies[shoulder + 3].mode = SpatialVector3f<true>(Vector3f(0.f, 0.f, 1.f), Vector3f::Zero());
 
       // no wrist
       break;
   }
 }
 
-void InverseDynamic::calculateLegPoses(std::array<Body, Limbs::numOfLimbs>& bodies, const JointDynamics& jointDynamics, const RobotDimensions& robotDimensions, bool left)
+void InverseDynamic::calculateLegPoses(Bodies& bodies, const JointDynamics& jointDynamics, const RobotDimensions& robotDimensions, Settings::RobotType robotType, bool left)
 {
   const float sign = left ? 1.f : -1.f;
   const Limbs::Limb pelvis = left ? Limbs::pelvisLeft : Limbs::pelvisRight;
   const Joints::Joint leg0 = left ? Joints::lHipYawPitch : Joints::rHipYawPitch;
 
-  switch(Global::getSettings().robotType)
+  switch(robotType)
   {
     case Settings::nao:
     {
       // pelvis in torso
       bodies[pelvis + 0].bodyInParent = Pose3f(RotationMatrix::aroundX(pi_4 * sign) * RotationMatrix::aroundZ(jointDynamics.angles[leg0] * -sign) * RotationMatrix::aroundX(pi_4 * -sign),
                                                Vector3f(0.f, robotDimensions.yHipOffset * sign, 0.f));
-      bodies[pelvis + 0].mode = SpatialVector3f<true>(Vector3f(0.f, std::sqrt(0.5f), -sign * std::sqrt(0.5f)), Vector3f::Zero());
 
       // hip in pelvis
       bodies[pelvis + 1].bodyInParent = Pose3f(RotationMatrix::aroundX(jointDynamics.angles[leg0 + 1]),
                                                Vector3f::Zero());
-      bodies[pelvis + 1].mode = SpatialVector3f<true>(Vector3f(1.f, 0.f, 0.f), Vector3f::Zero());
 
       // thigh in hip
       bodies[pelvis + 2].bodyInParent = Pose3f(RotationMatrix::aroundY(jointDynamics.angles[leg0 + 2]),
                                                Vector3f::Zero());
-      bodies[pelvis + 2].mode = SpatialVector3f<true>(Vector3f(0.f, 1.f, 0.f), Vector3f::Zero());
       break;
     }
     case Settings::t1:
     case Settings::k1:
-      if(left)
+      if(left && robotType == Settings::t1)
       {
         // waist in torso
         bodies[Limbs::waist].bodyInParent = Pose3f(RotationMatrix::aroundZ(jointDynamics.angles[Joints::waistYaw]),
                                                    Vector3f::Zero());
-        bodies[Limbs::waist].mode = SpatialVector3f<true>(Vector3f(0.f, 0.f, 1.f), Vector3f::Zero());
       }
 
-      // pelvis in waist
+      // pelvis in waist (in torso on the K1)
       bodies[pelvis + 0].bodyInParent = Pose3f(RotationMatrix::aroundY(jointDynamics.angles[leg0 + 2]),
                                                Vector3f(0.f, robotDimensions.yHipOffset * sign, 0.f));
-      bodies[pelvis + 0].mode = SpatialVector3f<true>(Vector3f(0.f, 1.f, 0.f), Vector3f::Zero());
 
       // hip in pelvis
       bodies[pelvis + 1].bodyInParent = Pose3f(RotationMatrix::aroundX(jointDynamics.angles[leg0 + 1]),
                                                robotDimensions.hipPitchToRollOffset);
-      bodies[pelvis + 1].mode = SpatialVector3f<true>(Vector3f(1.f, 0.f, 0.f), Vector3f::Zero());
 
       // thigh in hip
       bodies[pelvis + 2].bodyInParent = Pose3f(RotationMatrix::aroundZ(jointDynamics.angles[leg0]),
                                                Vector3f::Zero());
-      bodies[pelvis + 2].mode = SpatialVector3f<true>(Vector3f(0.f, 0.f, 1.f), Vector3f::Zero());
       break;
   }
 
   // tibia in thigh
   bodies[pelvis + 3].bodyInParent = Pose3f(RotationMatrix::aroundY(jointDynamics.angles[leg0 + 3]),
                                            Vector3f(robotDimensions.xOffsetHipToKnee, 0.f, -robotDimensions.upperLegLength));
-  bodies[pelvis + 3].mode = SpatialVector3f<true>(Vector3f(0.f, 1.f, 0.f), Vector3f::Zero());
 
   // ankle in tibia
   bodies[pelvis + 4].bodyInParent = Pose3f(RotationMatrix::aroundY(jointDynamics.angles[leg0 + 4]),
                                            Vector3f(0.f, 0.f, -robotDimensions.lowerLegLength));
-  bodies[pelvis + 4].mode = SpatialVector3f<true>(Vector3f(0.f, 1.f, 0.f), Vector3f::Zero());
 
   // foot in ankle
   bodies[pelvis + 5].bodyInParent = Pose3f(RotationMatrix::aroundX(jointDynamics.angles[leg0 + 5]),
                                            Vector3f(0.f, 0.f, robotDimensions.zOffsetAnklePitchToRoll));
-  bodies[pelvis + 5].mode = SpatialVector3f<true>(Vector3f(1.f, 0.f, 0.f), Vector3f::Zero());
-}
-
-void InverseDynamic::forward(std::array<Body, Limbs::numOfLimbs>& bodies, const JointDynamics& jointDynamics, const MassCalibration& massCalibration, const Node& node)
-{
-  const SpatialVector3f<true> vj = bodies[node.child].mode * jointDynamics.velocities[node.joint];
-  bodies[node.child].v = SpatialVector3f<true>::applyPose3f(bodies[node.child].parentInBody, bodies[node.parent].v) + vj;
-  bodies[node.child].a = SpatialVector3f<true>::applyPose3f(bodies[node.child].parentInBody, bodies[node.parent].a) + bodies[node.child].mode * jointDynamics.accelerations[node.joint] + bodies[node.child].v.cross(vj);
-  bodies[node.child].f = SpatialVector3f<true>::applyInertia(massCalibration.masses[node.child], bodies[node.child].a) + bodies[node.child].v.cross(SpatialVector3f<true>::applyInertia(massCalibration.masses[node.child], bodies[node.child].v));
-}
-
-void InverseDynamic::backward(std::array<Body, Limbs::numOfLimbs>& bodies, JointDynamics& jointDynamics, const Node& node)
-{
-  jointDynamics.torques[node.joint] += bodies[node.child].mode.dot(bodies[node.child].f);
-  bodies[node.parent].f += SpatialVector3f<false>::applyPose3f(bodies[node.child].bodyInParent, bodies[node.child].f);
 }
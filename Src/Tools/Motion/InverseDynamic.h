@@ -2,6 +2,7 @@
  * @file InverseDynamic.h
  *
  * This file declares a class to calculate inverse dynamics using the recursive Newton-Euler algorithm (RNEA).
+ * The joint space mass matrix is calculated in the same pass using the composite rigid body algorithm (CRBA).
  *
  * @author Felix Wenk
  * @author Arne Hasselbring
@@ -22,13 +23,51 @@
 class InverseDynamic
 {
 public:
+  using JointVector = Eigen::Matrix<float, Joints::numOfJoints, 1>;
+  using JointMatrix = Eigen::Matrix<float, Joints::numOfJoints, Joints::numOfJoints>;
+
+  /**
+   * The dynamics in joint space, assuming a stationary torso and only gravity as external force, i.e.
+   * torques = massMatrix * accelerations + biasTorques. Entries of joints a robot type does not have are zero.
+   */
+  struct Dynamics
+  {
+    JointMatrix massMatrix; /**< The joint space mass matrix (in g*mm^2/rad). */
+    JointVector biasTorques; /**< The torques at zero joint accelerations, i.e. gravity plus Coriolis and centrifugal torques if velocities are considered (in uNmm). */
+    JointVector gravityTorques; /**< The torques that compensate gravity (in uNmm). */
+  };
+
   /**
    * Calculates the torques on all joints for given angles, velocties and accelerations, assuming only gravity as external force.
    * @param jointDynamics \c angles, \c velocities and \c accelerations must be filled, \c torques are filled by this function.
    * @param gravityInTorso The direction and length of the gravity (in mm/s^2)
+   * @param robotType The robot type.
+   * @param useVelocities Consider the joint velocities? Otherwise, they are assumed to be zero.
+   * @param useAccelerations Consider the joint accelerations? Otherwise, they are assumed to be zero.
    */
+  static void calculateJointTorques(JointDynamics& jointDynamics, const Vector3f& gravityInTorso, const RobotDimensions& robotDimensions, const MassCalibration& massCalibration,
+                                    Settings::RobotType robotType, bool useVelocities = true, bool useAccelerations = true);
+
+  /** Same as above for the robot type of the current settings, considering velocities and accelerations. */
   static void calculateJointTorques(JointDynamics& jointDynamics, const Vector3f& gravityInTorso, const RobotDimensions& robotDimensions, const MassCalibration& massCalibration);
 
+  /**
+   * Calculates the torques on all joints as \c calculateJointTorques does and, in the same pass, the joint space
+   * mass matrix, the bias torques and the torques that compensate gravity.
+   * @param jointDynamics \c angles, \c velocities and \c accelerations must be filled, \c torques are filled by this function.
+   * @param dynamics The joint space dynamics that are filled by this function.
+   * @param gravityInTorso The direction and length of the gravity (in mm/s^2)
+   * @param robotType The robot type.
+   * @param useVelocities Consider the joint velocities? Otherwise, they are assumed to be zero.
+   * @param useAccelerations Consider the joint accelerations? Otherwise, they are assumed to be zero.
+   */
+  static void calculateDynamics(JointDynamics& jointDynamics, Dynamics& dynamics, const Vector3f& gravityInTorso, const RobotDimensions& robotDimensions,
+                                const MassCalibration& massCalibration, Settings::RobotType robotType, bool useVelocities = true, bool useAccelerations = true);
+
+  /** Same as above for the robot type of the current settings, considering velocities and accelerations. */
+  static void calculateDynamics(JointDynamics& jointDynamics, Dynamics& dynamics, const Vector3f& gravityInTorso, const RobotDimensions& robotDimensions,
+                                const MassCalibration& massCalibration);
+
 private:
   /** A single node in the kinematic tree. */
   struct Node
@@ -36,37 +75,59 @@ private:
     Joints::Joint joint; /**< The joint that links parent to child. */
     Limbs::Limb parent;
     Limbs::Limb child;
+    int parentNode; /**< The index of the node whose child is \c parent or -1 if \c parent is the torso. */
+    Vector3f axis; /**< The axis of the joint in the child's frame, i.e. the angular part of its motion subspace. */
+  };
+
+  /** The kinematic tree of a robot type. Each node is preceded by the node of its parent. */
+  struct KinematicTree
+  {
+    std::array<Node, Joints::numOfJoints> nodes;
+    int numOfNodes = 0;
+
+    /** Appends a node and determines the index of its parent's node. */
+    void add(Joints::Joint joint, Limbs::Limb parent, Limbs::Limb child, const Vector3f& axis);
   };
 
-  /** Helper struct for intermediate results of the RNEA. */
+  /** Helper struct for intermediate results of the RNEA and the CRBA. */
   struct Body
   {
     Pose3f bodyInParent; /**< Pose of the body frame relative to its parent body's frame. */
-    Pose3f parentInBody; /**< Pose of the parent body's frame relative to its own frame. */
-    SpatialVector3f<true> mode; /**< The spatial vector along which the joint between this body and its parent moves. */
 
     SpatialVector3f<true> v; /**< The spatial velocity of this body (in rad/s, mm/s). */
     SpatialVector3f<true> a; /**< The spatial acceleration of this body (in rad/s^2, mm/s^2). */
     SpatialVector3f<false> f; /**< The spatial force exerted on this body (in g*mm^2*rad/s^2 (a.k.a. uNmm), g*mm/s^2 (a.k.a. uN)). */
+    SpatialVector3f<true> aGravity; /**< The spatial acceleration of this body caused by gravity alone (in rad/s^2, mm/s^2). */
+    SpatialVector3f<false> fGravity; /**< The spatial force exerted on this body by gravity alone (in uNmm, uN). */
+
+    float compositeMass; /**< The mass of this body and all bodies it carries (in g). */
+    Vector3f compositeMassMoment; /**< The first mass moment of this body and all bodies it carries relative to its origin (in g*mm). */
+    Matrix3f compositeInertia; /**< The rotational inertia of this body and all bodies it carries relative to its origin (in g*mm^2). */
   };
 
+  using Bodies = std::array<Body, Limbs::numOfLimbs>;
+
   /** Calculates the poses of the head limbs in \c bodies. */
-  static void calculateHeadPoses(std::array<Body, Limbs::numOfLimbs>& bodies, const JointDynamics& jointDynamics, const RobotDimensions& robotDimensions);
+  static void calculateHeadPoses(Bodies& bodies, const JointDynamics& jointDynamics, const RobotDimensions& robotDimensions);
 
   /** Calculates the poses of one arm's limbs in \c bodies. */
-  static void calculateArmPoses(std::array<Body, Limbs::numOfLimbs>& bodies, const JointDynamics& jointDynamics, const RobotDimensions& robotDimensions, bool left);
+  static void calculateArmPoses(Bodies& bodies, const JointDynamics& jointDynamics, const RobotDimensions& robotDimensions, Settings::RobotType robotType, bool left);
 
   /** Calculates the poses of one leg's limbs in \c bodies. */
-  static void calculateLegPoses(std::array<Body, Limbs::numOfLimbs>& bodies, const JointDynamics& jointDynamics, const RobotDimensions& robotDimensions, bool left);
+  static void calculateLegPoses(Bodies& bodies, const JointDynamics& jointDynamics, const RobotDimensions& robotDimensions, Settings::RobotType robotType, bool left);
 
-  /** Performs a forward step of the RNEA on one joint (i.e. calculates spatial velocity and acceleration and the resulting force). */
-  static void forward(std::array<Body, Limbs::numOfLimbs>& bodies, const JointDynamics& jointDynamics, const MassCalibration& massCalibration, const Node& node);
+  /**
+   * Calculates the poses of all bodies and runs the RNEA over the kinematic tree. If \c dynamics is given, the gravity torques
+   * and the mass matrix are determined in the same pass and the joint accelerations are applied through the mass matrix.
+   */
+  static void calculate(JointDynamics& jointDynamics, Dynamics* dynamics, const Vector3f& gravityInTorso, const RobotDimensions& robotDimensions,
+                        const MassCalibration& massCalibration, Settings::RobotType robotType, bool useVelocities, bool useAccelerations);
 
-  /** Performs a backward step of the RNEA on one joint (i.e. propagates forces back to root and accumulates torques). */
-  static void backward(std::array<Body, Limbs::numOfLimbs>& bodies, JointDynamics& jointDynamics, const Node& node);
+  /** Transforms a spatial motion vector from the parent's frame into a body's frame without inverting \c bodyInParent. */
+  static SpatialVector3f<true> toBody(const Pose3f& bodyInParent, const SpatialVector3f<true>& vector);
 
   /** Generate kinematic tree for all supported robots. */
-  static std::array<std::vector<Node>, Settings::numOfRobotTypes> generateKinematicTree();
+  static std::array<KinematicTree, Settings::numOfRobotTypes> generateKinematicTree();
 
-  static std::array<std::vector<Node>, Settings::numOfRobotTypes> kinematicTree; /**< Kinematic trees for all supported robots. */
+  static const std::array<KinematicTree, Settings::numOfRobotTypes> kinematicTree; /**< Kinematic trees for all supported robots. */
 };
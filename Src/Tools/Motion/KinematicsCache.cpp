@@ -0,0 +1,109 @@
+/**
+ * @file KinematicsCache.cpp
+ *
+ * This file implements a class that keeps a robot model up to date with changing
+ * joint angles. Only the kinematic chains whose joints changed are recomputed.
+ */
+
+#include "KinematicsCache.h"
+#include "ForwardKinematic.h"
+#include "Representations/Configuration/MassCalibration.h"
+#include "Representations/Configuration/RobotDimensions.h"
+#include "Representations/Sensing/RobotModel.h"
+#include "Streaming/Global.h"
+
+unsigned KinematicsCache::update(RobotModel& robotModel, const JointAngles& jointAngles, const RobotDimensions& robotDimensions,
+                                 const MassCalibration& massCalibration)
+{
+  return update(robotModel, jointAngles, robotDimensions, massCalibration, Global::getSettings().robotType);
+}
+
+unsigned KinematicsCache::update(RobotModel& robotModel, const JointAngles& jointAngles, const RobotDimensions& robotDimensions,
+                                 const MassCalibration& massCalibration, Settings::RobotType robotType)
+{
+  const JointOffsets jointOffsets = getJointOffsets(robotDimensions);
+  if(this->robotModel != &robotModel || this->robotType != robotType || this->jointOffsets != jointOffsets)
+  {
+    this->robotModel = nullptr;
+    this->robotType = robotType;
+    this->jointOffsets = jointOffsets;
+  }
+
+  unsigned recomputed = 0;
+  for(int i = 0; i < numOfChains; ++i)
+  {
+    const Chain chain = static_cast<Chain>(i);
+    if(!this->robotModel || changed(chain, jointAngles))
+    {
+      switch(chain)
+      {
+        case head:
+          ForwardKinematic::calculateHeadChain(jointAngles, robotDimensions, robotModel.limbs);
+          break;
+        case leftArm:
+        case rightArm:
+          ForwardKinematic::calculateArmChain(chain == leftArm ? Arms::left : Arms::right, jointAngles, robotDimensions, robotModel.limbs, robotType);
+          break;
+        default:
+          ForwardKinematic::calculateLegChain(chain == leftLeg ? Legs::left : Legs::right, jointAngles, robotDimensions, robotModel.limbs, robotType);
+      }
+      ++recomputed;
+    }
+  }
+
+  robotModel.soleLeft = robotModel.limbs[Limbs::footLeft] + Vector3f(0.f, 0.f, -robotDimensions.footHeight);
+  robotModel.soleRight = robotModel.limbs[Limbs::footRight] + Vector3f(0.f, 0.f, -robotDimensions.footHeight);
+  robotModel.updateCenterOfMass(massCalibration);
+
+  this->robotModel = &robotModel;
+  this->jointAngles.angles = jointAngles.angles;
+  this->jointAngles.variance = jointAngles.variance;
+  return recomputed;
+}
+
+Matrix6f KinematicsCache::getLegJacobian(Legs::Leg leg, const RobotDimensions& robotDimensions) const
+{
+  ASSERT(robotModel);
+  return ForwardKinematic::calculateLegJacobian(leg, robotModel->limbs, robotDimensions, robotType);
+}
+
+KinematicsCache::JointOffsets KinematicsCache::getJointOffsets(const RobotDimensions& robotDimensions)
+{
+  JointOffsets offsets;
+  offsets.fill(Vector3f::Zero());
+  offsets[Joints::headYaw] = robotDimensions.hipToNeckOffset;
+  offsets[Joints::lShoulderPitch] = robotDimensions.armOffset;
+  offsets[Joints::lElbowYaw] = Vector3f(robotDimensions.upperArmLength, robotDimensions.yOffsetElbowToShoulder, 0.f);
+  offsets[Joints::lWristYaw] = Vector3f(robotDimensions.xOffsetElbowToWrist, 0.f, 0.f);
+  offsets[Joints::lHipYawPitch] = Vector3f(0.f, robotDimensions.yHipOffset, 0.f);
+  offsets[Joints::lHipPitch] = robotDimensions.hipPitchToRollOffset;
+  offsets[Joints::lKneePitch] = Vector3f(robotDimensions.xOffsetHipToKnee, 0.f, -robotDimensions.upperLegLength);
+  offsets[Joints::lAnklePitch] = Vector3f(0.f, 0.f, -robotDimensions.lowerLegLength);
+  offsets[Joints::lAnkleRoll] = Vector3f(0.f, 0.f, robotDimensions.zOffsetAnklePitchToRoll);
+  return offsets;
+}
+
+bool KinematicsCache::changed(Chain chain, const JointAngles& jointAngles) const
+{
+  auto changed = [&](Joints::Joint first, Joints::Joint last)
+  {
+    for(int joint = first; joint <= last; ++joint)
+      if(jointAngles.angles[joint] != this->jointAngles.angles[joint] || jointAngles.variance[joint] != this->jointAngles.variance[joint])
+        return true;
+    return false;
+  };
+
+  switch(chain)
+  {
+    case head:
+      return changed(Joints::headYaw, Joints::headPitch);
+    case leftArm:
+      return changed(Joints::lShoulderPitch, Joints::lWristYaw);
+    case rightArm:
+      return changed(Joints::rShoulderPitch, Joints::rWristYaw);
+    case leftLeg:
+      return changed(Joints::waistYaw, Joints::waistYaw) || changed(Joints::lHipYawPitch, Joints::lAnkleRoll);
+    default:
+      return changed(Joints::waistYaw, Joints::waistYaw) || changed(Joints::rHipYawPitch, Joints::rAnkleRoll);
+  }
+}
@@ -0,0 +1,91 @@
+/**
+ * @file KinematicsCache.h
+ *
+ * This file declares a class that keeps a robot model up to date with changing
+ * joint angles. Only the kinematic chains whose joints changed are recomputed.
+ */
+
+#pragma once
+
+#include "Framework/Settings.h"
+#include "Math/Eigen.h"
+#include "Representations/Infrastructure/JointAngles.h"
+#include "RobotParts/Joints.h"
+#include "RobotParts/Legs.h"
+#include <array>
+
+struct MassCalibration;
+struct RobotDimensions;
+struct RobotModel;
+
+class KinematicsCache
+{
+public:
+  /** The kinematic chains that are recomputed independently. */
+  enum Chain
+  {
+    head,
+    leftArm,
+    rightArm,
+    leftLeg,
+    rightLeg,
+    numOfChains
+  };
+
+  /**
+   * Updates a robot model from joint angles. Only chains whose joint angles or variances
+   * changed since the previous call are recomputed. The soles and the center of mass are
+   * always updated. All chains are recomputed if the dimensions of the kinematic chains
+   * changed.
+   * @param robotModel The robot model to update. All chains are recomputed if it is not
+   *                   the one passed in the previous call.
+   * @param jointAngles The joint angles.
+   * @param robotDimensions The dimensions of the robot.
+   * @param massCalibration The mass calibration of the robot.
+   * @param robotType The robot type.
+   * @return The number of chains recomputed.
+   */
+  unsigned update(RobotModel& robotModel, const JointAngles& jointAngles, const RobotDimensions& robotDimensions,
+                  const MassCalibration& massCalibration, Settings::RobotType robotType);
+
+  /** Same as above for the robot type of the current settings. */
+  unsigned update(RobotModel& robotModel, const JointAngles& jointAngles, const RobotDimensions& robotDimensions,
+                  const MassCalibration& massCalibration);
+
+  /**
+   * Returns the Jacobian of a sole with respect to the joints of its leg for the model
+   * updated last.
+   * @param leg The leg.
+   * @param robotDimensions The dimensions of the robot.
+   * @return The Jacobian (see ForwardKinematic::calculateLegJacobian).
+   */
+  Matrix6f getLegJacobian(Legs::Leg leg, const RobotDimensions& robotDimensions) const;
+
+  /** Forces the recomputation of all chains in the next update. */
+  void invalidate() {robotModel = nullptr;}
+
+private:
+  const RobotModel* robotModel = nullptr; /**< The model updated last or nullptr if all chains must be recomputed. */
+  Settings::RobotType robotType = Settings::nao; /**< The robot type of the last update. */
+  JointAngles jointAngles; /**< The joint angles of the last update. */
+  using JointOffsets = std::array<Vector3f, Joints::numOfJoints>;
+
+  JointOffsets jointOffsets; /**< The joint offsets of the last update. Only valid if \c robotModel is set. */
+
+  /**
+   * Collects the dimensions the kinematic chains depend on as the offset of each joint from
+   * the previous joint of its chain. The right side is mirrored from the left side and the
+   * offsets of joints that do not depend on the dimensions are zero.
+   * @param robotDimensions The dimensions of the robot.
+   * @return The offsets of all joints.
+   */
+  static JointOffsets getJointOffsets(const RobotDimensions& robotDimensions);
+
+  /**
+   * Checks whether the joints of a chain changed.
+   * @param chain The chain.
+   * @param jointAngles The new joint angles.
+   * @return Did any angle or variance of the joints of the chain change?
+   */
+  bool changed(Chain chain, const JointAngles& jointAngles) const;
+};